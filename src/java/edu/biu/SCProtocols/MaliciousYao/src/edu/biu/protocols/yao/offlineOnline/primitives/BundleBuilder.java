@@ -23,7 +23,6 @@ import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCommitValue;
 import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.CmtCommitter;
 import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitter;
 import edu.biu.scapi.primitives.hash.CryptographicHash;
-import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpSHA1;
 import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpAES;
 
 /**
@@ -160,7 +159,7 @@ public class BundleBuilder {
 	 */
 	private void commitOutputs(byte[] allOutputWireValues) {
 		//Create teh committer object.
-		CryptographicHash hash = new CryptoPpSHA1();
+		CryptographicHash hash = primitives.newCryptographicHash();
 		CmtCommitter committer = new CmtSimpleHashCommitter(null, hash, randomSourceCommitments, hash.getHashedMsgSize());
 		CmtCommitValue commitValue;
 				
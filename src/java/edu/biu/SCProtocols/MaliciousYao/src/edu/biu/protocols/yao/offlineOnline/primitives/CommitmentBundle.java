@@ -43,6 +43,11 @@ public class CommitmentBundle implements Serializable {
 		this.commitmentIds = commitmentsIds;
 		this.decommitments = decommitments;
 		this.decommitmentRandoms = decommitmentRandoms;
+		
+		//There is one commitment for each id. Its size depends on the hash that was used to commit.
+		if (commitmentsIds.length > 0) {
+			this.commitmentSize = commitments.length / commitmentsIds.length;
+		}
 	}
 	
 	
@@ -18,7 +18,6 @@ import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimp
 import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashCommitter;
 import edu.biu.scapi.interactiveMidProtocols.commitmentScheme.simpleHash.CmtSimpleHashDecommitmentMessage;
 import edu.biu.scapi.primitives.hash.CryptographicHash;
-import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpSHA1;
 
 /**
  * This class builds the CommitmentBundle. <p>
@@ -34,6 +33,7 @@ public class CommitmentBundleBuilder {
 	private final CmtCommitter committer;		// The commitment object that used to commit on the keys.
 	private int commitLabel;					// The current wire to commit on.
 	private final int keyLength;				// The size of key, in bytes.
+	private final int cmtSize;					// The size of each commitment, in bytes.
 
 	/**
 	 * A constructor that sets the given arguments.
@@ -43,9 +43,10 @@ public class CommitmentBundleBuilder {
 	 * @param keyLength The size of each key, in bytes.
 	 */
 	public CommitmentBundleBuilder(SecureRandom random, CryptoPrimitives primitives, Channel channel, int keyLength) {
-		//When using threads, the OpenSSLSHA1 causing problems. Thus, we use cryptoPPSHA1.
-		CryptographicHash hash = new CryptoPpSHA1();//primitives.getCryptographicHash();
+		//The builders run in several threads, so each one of them uses its own hash object.
+		CryptographicHash hash = primitives.newCryptographicHash();
 		this.keyLength = keyLength;
+		this.cmtSize = hash.getHashedMsgSize();
 		//Create committer object.
 		try {
 			this.committer = new CmtSimpleHashCommitter(channel, hash, random, hash.getHashedMsgSize());
@@ -65,7 +66,6 @@ public class CommitmentBundleBuilder {
 	 * @return the created CommitmentBundle.
 	 */
 	public CommitmentBundle build(byte[] wires, int[] labels, byte[] commitmentMask, byte[] placementMask) {
-		int cmtSize = 20;
 		int keySize = 16;
 		byte[] commitments = new byte[labels.length * 2 * cmtSize];
 		long[] commitmentIds = new long[labels.length * 2];
@@ -64,6 +64,7 @@ public class OnlineProtocolP2 implements Protocol {
 	
 	private final CryptoPrimitives primitives; 				//Contains some primitives object to use during the protocol. For example, hash function.
 	private final int keyLength;							//The length of each secret key in bytes.
+	private final String commitmentHashName;				//The name of the hash of the commitments on the keys, which the native code resolves.
 	
 	OnlineComputeRoutine computeRoutine;					//The instance that computes the main circuit.
 	/* 
@@ -116,9 +117,16 @@ public class OnlineProtocolP2 implements Protocol {
 	 * @param comm The commitments values.
 	 * @param r The random values used to commit.
 	 * @param x The values to commit on.
+	 * @param validity Output bitmap of (number of commitments + 7)/8 bytes. Bit i (bit i%8 of byte i/8) is set iff commitment i is valid.
+	 * @param hashName The algorithm name of the hash used to commit.
 	 * @return true if the commitments match the values and randoms; false, otherwise.
 	 */
-	private native boolean verifyDecommitment(byte[] comm, byte[] r, byte[] x);
+	private native boolean verifyDecommitment(byte[] comm, byte[] r, byte[] x, byte[] validity, String hashName);
+	
+	/**
+	 * Returns true if the native verification of the decommitments supports the hash of the given algorithm name.
+	 */
+	private native boolean isCommitmentHashSupported(String hashName);
 		
 	/**
 	 * Constructor that sets the parameters. 
@@ -147,6 +155,10 @@ public class OnlineProtocolP2 implements Protocol {
 		this.channel = communication.getChannels()[0];
 		CryptographicHash hash = primitives.getCryptographicHash();
 		this.cmtReceiver = new CmtSimpleHashReceiver(channel, hash, hash.getHashedMsgSize()); 
+		this.commitmentHashName = hash.getAlgorithmName();
+		if (!isCommitmentHashSupported(commitmentHashName)) {
+			throw new IllegalArgumentException("the commitments can not be verified using " + commitmentHashName);
+		}
 		this.mainBucket = mainBucket;
 		this.crBucket = crBucket;
 		this.input = null;
@@ -414,11 +426,12 @@ public class OnlineProtocolP2 implements Protocol {
 			}
 				
 			//Checks that the random values and committed values are indeed lead to the commitments values.
-			boolean valid = verifyDecommitment(commitments, randoms, values);
+			byte[] validity = new byte[(inputLabelsY2.length + 7) / 8];
+			boolean valid = verifyDecommitment(commitments, randoms, values, validity, commitmentHashName);
 				
 			//If the verify failed, there is a cheating. Throw an exception.
 			if (valid == false) {
-				throw new CheatAttemptException("incorrect decommitment!");
+				throw new CheatAttemptException("incorrect decommitment of input key " + firstInvalid(validity, inputLabelsY2.length) + "!");
 			}
 		
 			//Xor the keys with the commitment mask to get the y2 keys.
@@ -574,11 +587,12 @@ public class OnlineProtocolP2 implements Protocol {
 			}
 			
 			//Checks that the random values and committed values are indeed lead to the commitments values.
-			boolean valid = verifyDecommitment(commitmentsArray, randoms, values);
+			byte[] validity = new byte[(inputLabelsP1.length + 7) / 8];
+			boolean valid = verifyDecommitment(commitmentsArray, randoms, values, validity, commitmentHashName);
 			
 			//If the verify failed, there is a cheating. Throw an exception.
 			if (valid == false) {
-				throw new CheatAttemptException("incorrect decommitment!");
+				throw new CheatAttemptException("incorrect decommitment of input key " + firstInvalid(validity, inputLabelsP1.length) + "!");
 			}
 			
 			//Xor the keys with the commitment mask to get the x keys.
@@ -743,6 +757,20 @@ public class OnlineProtocolP2 implements Protocol {
 		}
 		return false;
 	}
+	
+	/**
+	 * Returns the index of the first commitment marked invalid in the given validity bitmap, or -1 if all are valid.
+	 * @param validity The bitmap returned by verifyDecommitment.
+	 * @param size The number of commitments.
+	 */
+	private static int firstInvalid(byte[] validity, int size) {
+		for (int i = 0; i < size; i++) {
+			if ((validity[i / 8] & (1 << (i % 8))) == 0) {
+				return i;
+			}
+		}
+		return -1;
+	}
 
 	/**
 	 * Computes the cheating recovery circuit.
@@ -0,0 +1,338 @@
+package edu.biu.protocols.yao.primitives;
+
+import java.nio.ByteBuffer;
+import java.security.InvalidKeyException;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.security.spec.AlgorithmParameterSpec;
+import java.security.spec.InvalidParameterSpecException;
+
+import javax.crypto.IllegalBlockSizeException;
+import javax.crypto.KeyGenerator;
+import javax.crypto.SecretKey;
+
+import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.BatchPrp;
+
+/**
+ * AES that computes many blocks in a single native call, using AES-NI (and VAES with AVX-512 when the cpu has it). <p>
+ *
+ * Besides the single block functions of {@link AES}, which allow this class to be used wherever a PRP is expected
+ * (for example under PrpFromPrfVarying), this class provides batch functions:
+ * <ul>
+ * <li>{@link #optimizedCompute(byte[], byte[])} and {@link #optimizedInvert(byte[], byte[])} on arrays of many blocks.</li>
+ * <li>{@link #computeBlocks(byte[], int, byte[], int, int)} and {@link #invertBlocks(byte[], int, byte[], int, int)} on blocks at any offset of an array.</li>
+ * <li>{@link #computeBlocks(ByteBuffer, ByteBuffer, int)} and {@link #invertBlocks(ByteBuffer, ByteBuffer, int)} - the PRF on a direct buffer.</li>
+ * <li>{@link #fillCounterBlocks(long, long, ByteBuffer, int)} - the PRF in counter mode, which fills a direct buffer with pseudorandom blocks.</li>
+ * <li>{@link #hashBlocks(ByteBuffer, ByteBuffer, int, long)} - a fixed-key correlation robust hash, used for garbling.</li>
+ * </ul>
+ * The direct buffers are used from their current position and their position is not changed.
+ *
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class AesNiBatchPrf implements AES, BatchPrp {
+
+	private static final int BLOCK_SIZE = 16;
+
+	private native long createKey(byte[] key);		//Expands the given key. Returns 0 if the key size is not valid.
+	private native void deleteKey(long key);		//Deletes the expanded key.
+	private native void encryptBlocks(long key, byte[] in, int inOffset, byte[] out, int outOffset, int numBlocks);
+	private native void decryptBlocks(long key, byte[] in, int inOffset, byte[] out, int outOffset, int numBlocks);
+	private native void encryptBuffer(long key, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int numBlocks);
+	private native void decryptBuffer(long key, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int numBlocks);
+	private native void counterBuffer(long key, long nonce, long counter, ByteBuffer out, int outOffset, int numBlocks);
+	private native void hashBuffer(long key, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int numBlocks, long tweak);
+
+	private long key;			//Pointer to the native expanded key.
+	private SecureRandom random;
+
+	/**
+	 * Default constructor. Uses default implementation of SecureRandom.
+	 */
+	public AesNiBatchPrf(){
+		this(new SecureRandom());
+	}
+
+	/**
+	 * Constructor that lets the user choose the source of randomness to use.
+	 * @param random source of randomness.
+	 */
+	public AesNiBatchPrf(SecureRandom random){
+		this.random = random;
+	}
+
+	/**
+	 * Initializes this AES object with the given secret key.
+	 * @param secretKey secret key.
+	 * @throws InvalidKeyException if the key is not 128/192/256 bits long.
+	 */
+	@Override
+	public void setKey(SecretKey secretKey) throws InvalidKeyException {
+		long newKey = createKey(secretKey.getEncoded());
+		if (newKey == 0){
+			throw new InvalidKeyException("AES key size should be 128/192/256 bits long");
+		}
+
+		if (key != 0){
+			deleteKey(key);
+		}
+		key = newKey;
+	}
+
+	@Override
+	public boolean isKeySet() {
+		return key != 0;
+	}
+
+	@Override
+	public String getAlgorithmName() {
+		return "AES";
+	}
+
+	@Override
+	public int getBlockSize() {
+		//AES works on 128 bit block.
+		return BLOCK_SIZE;
+	}
+
+	/**
+	 * This function should not be used to generate a key for the PRP and it throws UnsupportedOperationException.
+	 * @throws UnsupportedOperationException
+	 */
+	@Override
+	public SecretKey generateKey(AlgorithmParameterSpec keyParams) throws InvalidParameterSpecException {
+		throw new UnsupportedOperationException("To generate a key for this prf object use the generateKey(int keySize) function");
+	}
+
+	/**
+	 * Generates a secret key to initialize this AES object.
+	 * @param keySize is the required secret key size in bits.
+	 * @return the generated secret key.
+	 */
+	@Override
+	public SecretKey generateKey(int keySize) {
+		try {
+			KeyGenerator keyGen = KeyGenerator.getInstance("AES");
+			if (keySize <= 0){
+				keyGen.init(random);
+			} else {
+				keyGen.init(keySize, random);
+			}
+			return keyGen.generateKey();
+		} catch (NoSuchAlgorithmException e) {
+			//Every java platform provides an AES key generator.
+			throw new IllegalStateException(e);
+		}
+	}
+
+	/**
+	 * Computes the permutation on the given block.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff input offset in the inBytes array.
+	 * @param outBytes output bytes. The resulted bytes of compute.
+	 * @param outOff output offset in the outBytes array to put the result from.
+	 */
+	@Override
+	public void computeBlock(byte[] inBytes, int inOff, byte[] outBytes, int outOff) {
+		checkArrays(inBytes, inOff, outBytes, outOff, 1);
+		encryptBlocks(key, inBytes, inOff, outBytes, outOff, 1);
+	}
+
+	/**
+	 * The input and output lengths should be the block size, otherwise, throws an exception.
+	 */
+	@Override
+	public void computeBlock(byte[] inBytes, int inOff, int inLen, byte[] outBytes, int outOff, int outLen) throws IllegalBlockSizeException {
+		if (inLen != BLOCK_SIZE || outLen != BLOCK_SIZE){
+			throw new IllegalBlockSizeException("Wrong size");
+		}
+		computeBlock(inBytes, inOff, outBytes, outOff);
+	}
+
+	/**
+	 * The input length should be the block size, otherwise, throws an exception.
+	 */
+	@Override
+	public void computeBlock(byte[] inBytes, int inOffset, int inLen, byte[] outBytes, int outOffset) throws IllegalBlockSizeException {
+		if (inLen != BLOCK_SIZE){
+			throw new IllegalBlockSizeException("Wrong size");
+		}
+		computeBlock(inBytes, inOffset, outBytes, outOffset);
+	}
+
+	/**
+	 * Inverts the permutation on the given block.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff input offset in the inBytes array.
+	 * @param outBytes output bytes. The resulted bytes of invert.
+	 * @param outOff output offset in the outBytes array to put the result from.
+	 */
+	@Override
+	public void invertBlock(byte[] inBytes, int inOff, byte[] outBytes, int outOff) {
+		checkArrays(inBytes, inOff, outBytes, outOff, 1);
+		decryptBlocks(key, inBytes, inOff, outBytes, outOff, 1);
+	}
+
+	/**
+	 * The length should be the block size, otherwise, throws an exception.
+	 */
+	@Override
+	public void invertBlock(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int len) throws IllegalBlockSizeException {
+		if (len != BLOCK_SIZE){
+			throw new IllegalBlockSizeException("Wrong size");
+		}
+		invertBlock(inBytes, inOff, outBytes, outOff);
+	}
+
+	/**
+	 * Computes the permutation on each block of the given array.
+	 * The output array will contain a concatenation of all the results of computing the blocks.
+	 * @param inBytes input bytes to compute. Should be aligned to the block size.
+	 * @param outBytes output bytes. Should be in the same size as inBytes, and can be inBytes itself.
+	 * @throws IllegalArgumentException if the given input is not aligned to block size or the arrays are not in the same size.
+	 */
+	public void optimizedCompute(byte[] inBytes, byte[] outBytes) {
+		checkAlignedArrays(inBytes, outBytes);
+		encryptBlocks(key, inBytes, 0, outBytes, 0, inBytes.length / BLOCK_SIZE);
+	}
+
+	/**
+	 * Inverts the permutation on each block of the given array.
+	 * @param inBytes input bytes to invert. Should be aligned to the block size.
+	 * @param outBytes output bytes. Should be in the same size as inBytes, and can be inBytes itself.
+	 * @throws IllegalArgumentException if the given input is not aligned to block size or the arrays are not in the same size.
+	 */
+	public void optimizedInvert(byte[] inBytes, byte[] outBytes) {
+		checkAlignedArrays(inBytes, outBytes);
+		decryptBlocks(key, inBytes, 0, outBytes, 0, inBytes.length / BLOCK_SIZE);
+	}
+
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks of the given array.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		checkArrays(inBytes, inOff, outBytes, outOff, numBlocks);
+		encryptBlocks(key, inBytes, inOff, outBytes, outOff, numBlocks);
+	}
+
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks of the given array.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		checkArrays(inBytes, inOff, outBytes, outOff, numBlocks);
+		decryptBlocks(key, inBytes, inOff, outBytes, outOff, numBlocks);
+	}
+
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(ByteBuffer in, ByteBuffer out, int numBlocks) {
+		checkBuffer(in, numBlocks);
+		checkBuffer(out, numBlocks);
+		encryptBuffer(key, in, in.position(), out, out.position(), numBlocks);
+	}
+
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(ByteBuffer in, ByteBuffer out, int numBlocks) {
+		checkBuffer(in, numBlocks);
+		checkBuffer(out, numBlocks);
+		decryptBuffer(key, in, in.position(), out, out.position(), numBlocks);
+	}
+
+	/**
+	 * Fills the given direct buffer with the PRF in counter mode.
+	 * Block i is the permutation on the block whose low 8 bytes are counter + i and high 8 bytes are the nonce (both little endian).
+	 * @param nonce the high half of the blocks.
+	 * @param counter the counter of the first block.
+	 * @param out the buffer to fill, starting at its position.
+	 * @param numBlocks number of blocks to fill.
+	 */
+	public void fillCounterBlocks(long nonce, long counter, ByteBuffer out, int numBlocks) {
+		checkBuffer(out, numBlocks);
+		counterBuffer(key, nonce, counter, out, out.position(), numBlocks);
+	}
+
+	/**
+	 * Computes the fixed-key tweakable circular correlation robust hash H(x, i) = AES(sigma(x) ^ i) ^ sigma(x) on each block,
+	 * where sigma(xL || xR) = (xL ^ xR) || xL. This is the hash of garbling schemes that use AES with a fixed (public) key.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to hash.
+	 * @param tweak the tweak of the first block. Block j uses the tweak + j.
+	 */
+	public void hashBlocks(ByteBuffer in, ByteBuffer out, int numBlocks, long tweak) {
+		checkBuffer(in, numBlocks);
+		checkBuffer(out, numBlocks);
+		hashBuffer(key, in, in.position(), out, out.position(), numBlocks, tweak);
+	}
+
+	private void checkArrays(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		long len = (long) numBlocks * BLOCK_SIZE;
+		if ((numBlocks < 0) || (inOff < 0) || (inOff > inBytes.length - len)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || (outOff > outBytes.length - len)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+	}
+
+	private void checkAlignedArrays(byte[] inBytes, byte[] outBytes) {
+		if ((inBytes.length % BLOCK_SIZE) != 0){
+			throw new IllegalArgumentException("inBytes should be aligned to the block size");
+		}
+		if (outBytes.length != inBytes.length){
+			throw new IllegalArgumentException("outBytes and inBytes must be in the same size");
+		}
+		checkArrays(inBytes, 0, outBytes, 0, inBytes.length / BLOCK_SIZE);
+	}
+
+	private void checkBuffer(ByteBuffer buffer, int numBlocks) {
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (!buffer.isDirect()){
+			throw new IllegalArgumentException("the native code can only use direct buffers");
+		}
+		if ((numBlocks < 0) || ((long) numBlocks * BLOCK_SIZE > buffer.remaining())){
+			throw new IndexOutOfBoundsException("the buffer does not have room for " + numBlocks + " blocks");
+		}
+	}
+
+	/**
+	 * Deletes the native expanded key.
+	 */
+	protected void finalize() throws Throwable {
+		if (key != 0){
+			deleteKey(key);
+			key = 0;
+		}
+		super.finalize();
+	}
+
+	static {
+		//Loads the MaliciousYaoUtil dll.
+		System.loadLibrary("MaliciousYaoUtil");
+	}
+}
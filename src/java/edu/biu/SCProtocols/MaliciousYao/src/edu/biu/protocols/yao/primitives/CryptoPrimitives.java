@@ -33,6 +33,8 @@ public class CryptoPrimitives {
 	private final KeyDerivationFunction kdf;
 	private final MultiKeyEncryptionScheme mes;
 	private final CryptographicHash hash;
+	private final String hashName;		//The name and provider of the hash in CryptographicHashFactory, used to create more hash objects.
+	private final String hashProvider;
 	private final SecureRandom random;
 	private final int statisticalParameter;
 	private final int numOfThreads;
@@ -47,6 +49,8 @@ public class CryptoPrimitives {
 		this.kdf = builder.kdf;
 		this.mes = builder.mes;
 		this.hash = builder.hash;
+		this.hashName = builder.hashName;
+		this.hashProvider = builder.hashProvider;
 		this.random = builder.random;
 		this.statisticalParameter = builder.statisticalParameter;
 		this.numOfThreads = builder.numOfThreads;
@@ -80,6 +84,20 @@ public class CryptoPrimitives {
 		return hash;
 	}
 	
+	/**
+	 * Returns a new object of the default CryptographicHash, created by CryptographicHashFactory with the name and provider of the default hash. <p>
+	 * The hash objects are not thread safe, so code that may run in several threads (like the commitments on the keys) 
+	 * should use its own object rather than the shared one.
+	 */
+	public CryptographicHash newCryptographicHash() {
+		try {
+			return CryptographicHashFactory.getInstance().getObject(hashName, hashProvider);
+		} catch (FactoriesException e) {
+			//Should not occur since the factory already created the default hash with the same name and provider.
+			throw new IllegalStateException(e);
+		}
+	}
+	
 	/**
 	 * Returns the default secure random object.
 	 */
@@ -112,6 +130,8 @@ public class CryptoPrimitives {
 		private KeyDerivationFunction kdf = null;
 		private MultiKeyEncryptionScheme mes = null;
 		private CryptographicHash hash = null;
+		private String hashName = null;
+		private String hashProvider = null;
 		private SecureRandom random = null;
 		private int statisticalParameter = 0;
 		private int numOfThreads;
@@ -141,10 +161,13 @@ public class CryptoPrimitives {
 		}
 
 		/**
-		 * Sets the given CryptographicHash.
+		 * Sets the CryptographicHash of the given name and provider, as CryptographicHashFactory calls them.
+		 * @throws FactoriesException if the factory can not create the hash.
 		 */
-		public Builder hash(CryptographicHash hash) {
-			this.hash = hash;
+		public Builder hash(String hashName, String provider) throws FactoriesException {
+			this.hash = CryptographicHashFactory.getInstance().getObject(hashName, provider);
+			this.hashName = hashName;
+			this.hashProvider = provider;
 			return this;
 		}
 
@@ -185,8 +208,8 @@ public class CryptoPrimitives {
 	 */
 	public static CryptoPrimitives defaultPrimitives() {
 		// Initialize mathematical entities required for protocol.
+		CryptoPrimitives.Builder builder = new CryptoPrimitives.Builder();
 		DlogGroup dlog = null;
-		CryptographicHash hash = null;
 		KeyDerivationFunction kdf = null;
 		MultiKeyEncryptionScheme mes = new AESFixedKeyMultiKeyEncryption();
 		SecureRandom random = new SecureRandom();
@@ -194,19 +217,18 @@ public class CryptoPrimitives {
 		try {
 			//Use the K-233 koblitz curve, SHA-1 and KdfISO18033.
 			dlog = DlogGroupFactory.getInstance().getObject("DlogECF2m(K-233)", "Miracl");
-			//hash = CryptographicHashFactory.getInstance().getObject("SHA-1", "OpenSSL");
-			hash = CryptographicHashFactory.getInstance().getObject("SHA-1", "CryptoPP");
+			//builder.hash("SHA-1", "OpenSSL");
+			builder.hash("SHA-1", "CryptoPP");
 			kdf = KdfFactory.getInstance().getObject("KdfISO18033(SHA-1)");
 		} catch (FactoriesException e) {
 			e.printStackTrace();
 		}
 
 		//Create a CryptoPrimitives object with the created primitives, when statistical parameter = 40 and number of thread = 0. 
-		return new CryptoPrimitives.Builder()
+		return builder
 			.dlog(dlog)
 			.kdf(kdf)
 			.mes(mes)
-			.hash(hash)
 			.random(random)
 			.statisticalParameter(40)
 			.numOfThreads(0)
@@ -219,8 +241,8 @@ public class CryptoPrimitives {
 	 */
 	public static CryptoPrimitives defaultPrimitives(int numThreads) {
 		// Initialize mathematical entities required for protocol.
+		CryptoPrimitives.Builder builder = new CryptoPrimitives.Builder();
 		DlogGroup dlog = null;
-		CryptographicHash hash = null;
 		KeyDerivationFunction kdf = null;
 		MultiKeyEncryptionScheme mes = new AESFixedKeyMultiKeyEncryption();
 		SecureRandom random = new SecureRandom();
@@ -228,19 +250,18 @@ public class CryptoPrimitives {
 		try {
 			//Use the K-233 koblitz curve, SHA-1 and KdfISO18033.
 			dlog = DlogGroupFactory.getInstance().getObject("DlogECF2m(K-233)", "Miracl");
-			//hash = CryptographicHashFactory.getInstance().getObject("SHA-1", "OpenSSL");
-			hash = CryptographicHashFactory.getInstance().getObject("SHA-1", "CryptoPP");
+			//builder.hash("SHA-1", "OpenSSL");
+			builder.hash("SHA-1", "CryptoPP");
 			kdf = KdfFactory.getInstance().getObject("KdfISO18033(SHA-1)");
 		} catch (FactoriesException e) {
 			e.printStackTrace();
 		}
 		
 		//Create a CryptoPrimitives object with the created primitives, when statistical parameter = 40 and the given number of threads. 
-		return new CryptoPrimitives.Builder()
+		return builder
 			.dlog(dlog)
 			.kdf(kdf)
 			.mes(mes)
-			.hash(hash)
 			.random(random)
 			.statisticalParameter(40)
 			.numOfThreads(numThreads)
@@ -42,7 +42,7 @@ import edu.biu.scapi.exceptions.NotAllInputsSetException;
 import edu.biu.scapi.exceptions.PlaintextTooLongException;
 import edu.biu.scapi.primitives.hash.CryptographicHash;
 import edu.biu.scapi.primitives.prg.PseudorandomGenerator;
-import edu.biu.scapi.primitives.prg.openSSL.OpenSSLRC4;
+import edu.biu.scapi.primitives.prg.openSSL.OpenSSLAesCtrPrg;
 
 /**
  * This class is an implementation of the fast extended garbled boolean circuit.<P>
@@ -111,7 +111,11 @@ public class FastGarbledBooleanCircuitExtendedImp implements FastGarbledBooleanC
 
 	/**
 	 * This constructor should be used in case the garbling is done using a MultiKeyEncryptionScheme. <P>
-	 * It gets the inner garbled boolean circuit and the encryption scheme.
+	 * It gets the inner garbled boolean circuit and the encryption scheme.<P>
+	 * The garbling using a seed is done with an {@link OpenSSLAesCtrPrg}, so the seeds given to {@link #garble(byte[])} and to 
+	 * {@link #verify(byte[], byte[], byte[], CryptographicHash, byte[])} should be AES keys (16, 24 or 32 bytes long).
+	 * The circuits garbled from a seed are different than the ones garbled by earlier versions, which used RC4 with seeds of any length.
+	 * In order to use another PRG, call {@link #FastGarbledBooleanCircuitExtendedImp(FastGarbledBooleanCircuit, MultiKeyEncryptionScheme, PseudorandomGenerator)}.
 	 * 
 	 * @param gbc The inner garbled boolean circuit to wrap.
 	 * @param mes The MultiKeyEncryptionScheme to use during garbling.
@@ -120,7 +124,7 @@ public class FastGarbledBooleanCircuitExtendedImp implements FastGarbledBooleanC
 
 		this.gbc = gbc;
 		this.mes = mes;
-		this.prg = new OpenSSLRC4();
+		this.prg = new OpenSSLAesCtrPrg();
 
 		// Input and output indices will be needed multiple times, we hold them as class members to avoid the 
 		// creation of the arrays each time they needed.
@@ -177,8 +181,13 @@ public class FastGarbledBooleanCircuitExtendedImp implements FastGarbledBooleanC
 		return generateInputOutputGates(values);
 	}
 
+	/**
+	 * {@inheritDoc}
+	 * @throws InvalidKeyException In case the seed is an invalid key for the PRG. The default AES-CTR PRG accepts seeds of 16, 24 or 32 bytes.
+	 */
 	@Override
 	public FastCircuitCreationValues garble(byte[] seed) throws InvalidKeyException {
+		checkSeed(seed);
 		// In order to garble using seed, we need two seeds: one for the inner
 		// circuit and one for the extended.
 		// Use the given seed in order to generate two new seeds.
@@ -481,6 +490,16 @@ public class FastGarbledBooleanCircuitExtendedImp implements FastGarbledBooleanC
 		return true;
 	}
 
+	/**
+	 * Checks that the given seed is a valid key for the default AES-CTR PRG, in order to give a clear message.
+	 * Other PRGs check their seeds in their setKey.
+	 */
+	private void checkSeed(byte[] seed) throws InvalidKeyException {
+		if ((prg instanceof OpenSSLAesCtrPrg) && (seed.length != 16) && (seed.length != 24) && (seed.length != 32)){
+			throw new InvalidKeyException("the seed is used as an AES-CTR key, so it should be 16, 24 or 32 bytes long, but it is " + seed.length + " bytes long");
+		}
+	}
+
 	@Override
 	public boolean verify(byte[] seed, byte[] allInputGarbledValues, byte[] allOutputGarbledValues, CryptographicHash hash, byte[] hashedCircuit)
 			throws InvalidKeyException {
@@ -50,7 +50,9 @@ import edu.biu.scapi.securityLevel.Cpa;
  * the encryption scheme is initialized with a suitable key. Then, every message sent via this channel is encrypted and decrypted using the underlying encryption scheme.<p>
  * The user needs not to worry about any of the encryption or decryption tasks. The owner of this channel can rest assure that when an object gets sent over this channel 
  * it gets encrypted with the defined encryption scheme. In the same way, when receiving a message sent over this channel (which was encrypted by the other party) 
- * the owner of the channel receives an already decrypted object. 
+ * the owner of the channel receives an already decrypted object. <p>
+ * An authenticated encryption scheme, such as {@link edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLGCMEncRandomIV}, also makes the channel 
+ * reject modified messages, without a separate mac. 
  *    
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Yael Ejgenberg)
  */
@@ -136,6 +138,10 @@ public class EncryptedChannel extends ChannelDecorator {
 		SymmetricCiphertext cipher = (SymmetricCiphertext)rcvMsg;
 		//Decrypt the encrypted message
 		ByteArrayPlaintext msg = (ByteArrayPlaintext) encScheme.decrypt(cipher);
+		//Authenticated encryption schemes return null if the message was modified.
+		if (msg == null){
+			throw new IOException("The received message failed authentication");
+		}
 		
 		//Deserialize the object. The caller of this function doesn't need to know anything about encryption, therefore he should get
 		//the plain object that was sent by the sender.
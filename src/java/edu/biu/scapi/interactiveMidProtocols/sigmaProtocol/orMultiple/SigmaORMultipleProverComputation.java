@@ -26,6 +26,7 @@ package edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.orMultiple;
 
 import java.security.SecureRandom;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.Enumeration;
 import java.util.Hashtable;
 
@@ -81,26 +82,27 @@ public class SigmaORMultipleProverComputation implements SigmaProverComputation{
 	private Hashtable<Integer, SigmaSimulatorOutput> simulatorsOutput;	// We save this because we calculate it in computeFirstMsg and using 
 																	// it after that, in computeSecondMsg
 	
-	private long[] fieldElements;								//Will hold pointers to the sampled field elements, 
-																//we save the pointers to save the creation of the elements again in computeSecondMsg function.
+	private long arena;											//Pointer to the native memory of the current proof. It holds the sampled field elements,
+																//so they are not created again in computeSecondMsg function, and the interpolated polynomial.
 	
 	//Initializes the field GF2E with a random irreducible polynomial with degree t.
 	private native void initField(int t, int seed);
 	
-	//Creates random field elements to be the challenges.
-	private native byte[][] createRandomFieldElements(int numElements, long[] fieldElements);
+	//Creates random field elements to be the challenges. Their bytes are put one after the other in the given array, t/8 bytes each.
+	//Returns a pointer to the native memory of the proof.
+	private native long createRandomFieldElements(int numElements, byte[] elements);
 	
 	//Interpolates the points to get a polynomial.
-	private native long interpolate(byte[] e, long[] fieldElements, int[] indexes);
+	private native void interpolate(long arena, byte[] e, int[] indexes);
 	
-	//Calculates the challenges for the statements with the witnesses.
-	private native byte[][] getRestChallenges(long polynomial, int[] indexesInI);
+	//Calculates the challenges for the statements with the witnesses. The challenges are put in the given array, t/8 bytes each.
+	private native void getRestChallenges(long arena, int[] indexesInI, byte[] challenges);
 	
-	//Returns the byteArray of the polynomial coefficients.
-	private native byte[][] getPolynomialBytes(long polynomial);
+	//Returns the polynomial coefficients, t/8 bytes each.
+	private native byte[] getPolynomialBytes(long arena);
 	
 	//Deletes the allocated memory of the polynomial and the field elements.
-	private native void deletePointers(long polynomial, long[] fieldElements);
+	private native void deletePointers(long arena);
 	
 	/**
 	 * Constructor that gets the underlying provers.
@@ -164,36 +166,6 @@ public class SigmaORMultipleProverComputation implements SigmaProverComputation{
 		
 	}
 
-	/**
-	 * Align the given array to t length. Adds zeros in the beginning.
-	 * @param array to align
-	 * @return the aligned array.
-	 */
-	private byte[] alignToT(byte[] array) {
-		byte[] alignArr = new byte[t/8];
-		int len = array.length;
-		//in case the array is not aligned, add zeros.
-		if (len < t/8){
-			int diff = t/8 - len; //Number of bytes to fill with zeros.
-			int index = 0;
-			// NTL converts byte array to polynomial in the following way:
-			// x = sum(p[i]*X^(8*i), i = 0..n-1)
-			// This means that the most left byte in the array is the first degree of the polynomial.
-			// So, copy the original array content to the left side of the new array.
-			for (int i=0; i<len; i++){
-				alignArr[index++] = array[i];
-			}
-			//Add zeros in the right side of the array
-			for (int i=0; i<diff; i++){
-				alignArr[index++] = 0;
-			}
-		} else{
-			alignArr = array;
-		}
-		return alignArr;
-		
-	}
-
 	/**
 	 * Computes the first message of the protocol.<p>
 	 * "For every j not in I, SAMPLE a random element ej <- GF[2^t]<p>
@@ -212,17 +184,17 @@ public class SigmaORMultipleProverComputation implements SigmaProverComputation{
 		Hashtable<Integer, SigmaCommonInput> simulatorsInput = input.getSimulatorsInput();
 		
 		//Sample random values for this protocol.
-		fieldElements = new long[len - k];
 		//For every j not in I, sample a random element ej <- GF[2^t]. We sample the random elements in one native call.
-		byte[][] ejs = createRandomFieldElements(len - k, fieldElements);
+		int tBytes = t/8;
+		byte[] ejs = new byte[(len - k) * tBytes];
+		arena = createRandomFieldElements(len - k, ejs);
 		int index = 0;
 		challenges = new byte[len][];
 		
 		//Set the created challenges to the challenges array in the empty indexes.
 		for (int i=0; i<len; i++){
 			if (simulators.get(i) != null){
-				//in case that the sample element's length is not t, add zeros to its beginning.
-				challenges[i] = alignToT(ejs[index]);
+				challenges[i] = Arrays.copyOfRange(ejs, index * tBytes, (index + 1) * tBytes);
 				index++; //increase the index of the sampled challenges array.
 			}
 		}
@@ -280,14 +252,17 @@ public class SigmaORMultipleProverComputation implements SigmaProverComputation{
 			}
 		}
 		//Interpolate the points (0,e) and {(j,ej)} for every j NOT in I to obtain a degree n-k polynomial Q.
-		long polynomial = interpolate(challenge, fieldElements, indexesNotInI);
+		interpolate(arena, challenge, indexesNotInI);
 		
 		//Get the rest of the challenges by computing for every i in I, ei = Q(i).
-		byte[][] jsInI = getRestChallenges(polynomial, indexesInI);
+		int tBytes = t/8;
+		byte[] jsInI = new byte[k * tBytes];
+		getRestChallenges(arena, indexesInI, jsInI);
 		int index = 0;
 		for(int i=0; i<len; i++){
 			if (provers.get(i) != null){
-				challenges[i] = alignToT(jsInI[index++]);
+				challenges[i] = Arrays.copyOfRange(jsInI, index * tBytes, (index + 1) * tBytes);
+				index++;
 			}
 		}
 		
@@ -307,10 +282,11 @@ public class SigmaORMultipleProverComputation implements SigmaProverComputation{
 		}
 		
 		//Get the byte array that represent the polynomial
-		byte[][] polynomBytes = getPolynomialBytes(polynomial);
+		byte[] polynomBytes = getPolynomialBytes(arena);
 		
 		//Delete the allocated memory of the polynomial and the field elements.
-		deletePointers(polynomial, fieldElements);
+		deletePointers(arena);
+		arena = 0;
 		
 		//Create a SigmaORMultipleSecondMsg with the messages array.
 		return new SigmaORMultipleSecondMsg(polynomBytes, secondMessages, challenges);
@@ -39,19 +39,19 @@ import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.utility.SigmaProtocol
  */
 class SigmaORMultipleSecondMsg implements SigmaProtocolMsg {
 	
-	private static final long serialVersionUID = -348217363547929670L;
+	private static final long serialVersionUID = 5372614069312459981L;
 	
-	private byte[][] polynomial;
+	private byte[] polynomial;								//The polynomial coefficients, t/8 bytes each.
 	private ArrayList<SigmaProtocolMsg> z;
 	private byte[][] challenges;
 	
-	SigmaORMultipleSecondMsg(byte[][] polynomBytes, ArrayList<SigmaProtocolMsg> z, byte[][] challenges){
+	SigmaORMultipleSecondMsg(byte[] polynomBytes, ArrayList<SigmaProtocolMsg> z, byte[][] challenges){
 		this.polynomial = polynomBytes;
 		this.z = z;
 		this.challenges = challenges;
 	}
 	
-	byte[][] getPolynomial(){
+	byte[] getPolynomial(){
 		return polynomial;
 	}
 	
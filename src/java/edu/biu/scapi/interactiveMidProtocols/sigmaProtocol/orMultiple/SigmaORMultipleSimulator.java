@@ -26,6 +26,7 @@ package edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.orMultiple;
 
 import java.security.SecureRandom;
 import java.util.ArrayList;
+import java.util.Arrays;
 
 import edu.biu.scapi.exceptions.CheatAttemptException;
 import edu.biu.scapi.interactiveMidProtocols.sigmaProtocol.SigmaSimulator;
@@ -63,20 +64,21 @@ public class SigmaORMultipleSimulator implements SigmaSimulator{
 	//Initializes the field GF2E with a random irreducible polynomial with degree t.
 	private native void initField(int t, int seed);
 	
-	//Creates random field elements to be the challenges.
-	private native byte[][] createRandomFieldElements(int numElements, long[] fieldElements);
+	//Creates random field elements to be the challenges. Their bytes are put one after the other in the given array, t/8 bytes each.
+	//Returns a pointer to the native memory of the simulation.
+	private native long createRandomFieldElements(int numElements, byte[] elements);
 	
 	//Interpolates the points to get a polynomial.
-	private native long interpolate(byte[] e, long[] fieldElements, int[] indexesNotInI);
+	private native void interpolate(long arena, byte[] e, int[] indexesNotInI);
 	
-	//Calculates the challenges for the statements with the witnesses.
-	private native byte[][] getRestChallenges(long polynomial, int start, int end, int[] indexesInI);
+	//Calculates the challenges for the statements with the witnesses. The challenges are put in the given array, t/8 bytes each.
+	private native void getRestChallenges(long arena, int[] indexesInI, byte[] challenges);
 	
-	//Returns the byteArray of the polynomial coefficients.
-	private native byte[][] getPolynomialBytes(long polynomial);
+	//Returns the polynomial coefficients, t/8 bytes each.
+	private native byte[] getPolynomialBytes(long arena);
 	
 	//Deletes the allocated memory of the polynomial and the field elements.
-	private native void deletePointers(long polynomial, long[] fieldElements);
+	private native void deletePointers(long arena);
 	
 	/**
 	 * Constructor that gets the underlying simulators.
@@ -126,15 +128,16 @@ public class SigmaORMultipleSimulator implements SigmaSimulator{
 		SigmaORMultipleCommonInput orInput = (SigmaORMultipleCommonInput) input;
 		
 		int nMinusK = len - orInput.getK();
-		long[] fieldElements = new long[nMinusK];
+		int tBytes = t/8;
 		//For every j = 1 to n-k, sample a random element ej <- GF[2^t]. We sample the random elements in one native call.
-		byte[][] ejs = createRandomFieldElements(nMinusK, fieldElements);
+		byte[] ejs = new byte[nMinusK * tBytes];
+		long arena = createRandomFieldElements(nMinusK, ejs);
 
 		byte[][] challenges = new byte[len][];
 		
 		//Set the created challenges to the challenges array in the first n-k indexes.
 		for (int i=0; i<nMinusK; i++){
-			challenges[i] = alignToT(ejs[i]);
+			challenges[i] = Arrays.copyOfRange(ejs, i * tBytes, (i + 1) * tBytes);
 		}
 		
 		//Create two arrays of indexes. These arrays used for calculate the interpolated polynomial.
@@ -151,12 +154,13 @@ public class SigmaORMultipleSimulator implements SigmaSimulator{
 			}
 		}
 		//Interpolate the points (0,e) and {(j,ej)} for every j=1 to n-k to obtain a degree n-k polynomial Q.
-		long polynomial = interpolate(challenge, fieldElements, indexesNotInI);
+		interpolate(arena, challenge, indexesNotInI);
 				
 		//Get the rest of the challenges by computing for every i = n-k+1 to n, ei = Q(i).
-		byte[][] jsInI = getRestChallenges(polynomial, nMinusK, len, indexesInI);
+		byte[] jsInI = new byte[orInput.getK() * tBytes];
+		getRestChallenges(arena, indexesInI, jsInI);
 		for(int i=nMinusK, j=0; i<len; i++, j++){
-			challenges[i] = alignToT(jsInI[j]);
+			challenges[i] = Arrays.copyOfRange(jsInI, j * tBytes, (j + 1) * tBytes);
 		}
 		
 		ArrayList<SigmaProtocolMsg> aOutputs = new ArrayList<SigmaProtocolMsg>();
@@ -176,46 +180,16 @@ public class SigmaORMultipleSimulator implements SigmaSimulator{
 		}
 		
 		//prepare the input for the sigmaSimulatorOutput.
-		byte[][] polynomBytes = getPolynomialBytes(polynomial);
+		byte[] polynomBytes = getPolynomialBytes(arena);
 		SigmaMultipleMsg first = new SigmaMultipleMsg(aOutputs);
 		SigmaORMultipleSecondMsg second = new SigmaORMultipleSecondMsg(polynomBytes, zOutputs, challenges);
 		
 		//Delete the allocated memory.
-		deletePointers(polynomial, fieldElements);
+		deletePointers(arena);
 		
 		return new SigmaORMultipleSimulatorOutput(first, challenge, second);
 	}
 	
-	/**
-	 * Align the given array to t length. Adds zeros in the beginning.
-	 * @param array to align
-	 * @return the aligned array.
-	 */
-	private byte[] alignToT(byte[] array) {
-		byte[] alignArr = new byte[t/8];
-		int len = array.length;
-		//in case the array is not aligned, add zeros.
-		if (len < t/8){
-			int diff = t/8 - len; //Number of bytes to fill with zeros.
-			int index = 0;
-			// NTL converts byte array to polynomial in the following way:
-			// x = sum(p[i]*X^(8*i), i = 0..n-1)
-			// This means that the most left byte in the array is the first degree of the polynomial.
-			// So, copy the original array content to the left side of the new array.
-			for (int i=0; i<len; i++){
-				alignArr[index++] = array[i];
-			}
-			//Add zeros in the right side of the array
-			for (int i=0; i<diff; i++){
-				alignArr[index++] = 0;
-			}
-		} else{
-			alignArr = array;
-		}
-		return alignArr;
-		
-	}
-	
 	/**
 	 * Computes the simulator computation with a randomly chosen challenge.
 	 * @param input MUST be an instance of SigmaORMultipleCommonInput.
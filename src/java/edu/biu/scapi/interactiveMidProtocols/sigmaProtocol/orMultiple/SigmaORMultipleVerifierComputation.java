@@ -71,7 +71,8 @@ public class SigmaORMultipleVerifierComputation implements SigmaVerifierComputat
 	private native byte[] sampleChallenge(long[] pointer);
 	
 	//Checks if Q is of degree n-k AND Q(i)=ei for all i=1,...,n AND Q(0)=e. This function also deletes the allocated memory.
-	private native boolean checkPolynomialValidity(byte[][] polynomial, int k, long challengePointer, byte[][] challenges);
+	//The polynomial coefficients and the challenges are given one after the other, t/8 bytes each.
+	private native boolean checkPolynomialValidity(byte[] polynomial, int k, long challengePointer, byte[] challenges);
 	
 	//Sets the given challenge in the field.
 	private native void setChallenge(long [] pointer, byte[] challenge);
@@ -224,11 +225,28 @@ public class SigmaORMultipleVerifierComputation implements SigmaVerifierComputat
 		ArrayList<SigmaProtocolMsg> firstMessages = first.getMessages();
 		ArrayList<SigmaProtocolMsg> secondMessages = second.getMessages();
 		
-		byte[][] polynomial = second.getPolynomial();
+		byte[] polynomial = second.getPolynomial();
 		byte[][] challenges = second.getChallenges();
 		
-		//Call native function to check the polynomial validity.
-		verified = verified && checkPolynomialValidity(polynomial, k, challengePointer, challenges);
+		//Put all the challenges in one array to pass them to the native code in one call.
+		//Each challenge should be of size t/8.
+		int tBytes = t/8;
+		byte[] challengesBytes = new byte[challenges.length * tBytes];
+		for (int i = 0; i < challenges.length; i++){
+			if (challenges[i].length != tBytes){
+				verified = false;
+			} else {
+				System.arraycopy(challenges[i], 0, challengesBytes, i * tBytes, tBytes);
+			}
+		}
+		
+		if (polynomial.length % tBytes != 0){
+			verified = false;
+		}
+		
+		//Call native function to check the polynomial validity. 
+		//It is called in any case since it also deletes the allocated memory of the challenge.
+		verified = checkPolynomialValidity(polynomial, k, challengePointer, challengesBytes) && verified;
 		
 		//Compute all verifier checks.
 		for (int i = 0; i < len; i++){
@@ -44,7 +44,9 @@ import edu.biu.scapi.primitives.prf.PseudorandomPermutation;
 
 /**
  * This is an abstract class that manage the common behavior of symmetric encryption using Open SSL library. 
- * We implemented symmetric encryption using OpenSSL with two modes of operations - CBC and CTR, each one has a unique derived class.
+ * We implemented symmetric encryption using OpenSSL with three modes of operations - CBC, CTR and GCM, each one has a unique derived class.<p>
+ * Besides the functions of SymmetricEnc, this class can encrypt and decrypt parts of byte arrays directly into a given output array, 
+ * without any copy or allocation.
  * 
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
@@ -61,8 +63,11 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 	private native long createEncryption();		// Create the native object that does the encryption.
 	private native long createDecryption();		// Create the native object that does the decryption.
 	private native int getIVSize(long enc);		// Return the size of the Iv in the current encryption scheme.
-	private native byte[] encrypt(long enc, byte[] plaintext, byte[] iv);	//Encrypt the given plaintext.
-	private native byte[] decrypt(long dec, byte[] cipher, byte[] iv);		//Decrypt the given ciphertext.
+	private native int getBlockSize(long enc);	// Return the size that the current encryption scheme pads the plaintext to.
+	//Encrypt the given plaintext into the output array. Returns the length of the ciphertext, or -1 if the encryption failed.
+	private native int encrypt(long enc, byte[] in, int inOffset, int inLen, byte[] iv, byte[] out, int outOffset);
+	//Decrypt the given ciphertext into the output array. Returns the length of the plaintext, or -1 if the ciphertext is not valid.
+	private native int decrypt(long dec, byte[] in, int inOffset, int inLen, byte[] iv, byte[] out, int outOffset);
 	private native void deleteNative(long enc, long dec);					//Delete teh native objects.
 	
 	/**
@@ -127,6 +132,14 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 	//Check that the given name is valid for this encryption scheme.
 	protected abstract boolean checkExistance(String prpName);
 	
+	/**
+	 * Returns the size of the tag that is appended to each ciphertext. Authenticated modes override this function.
+	 * @return the size of the tag in bytes.
+	 */
+	protected int getTagSize(){
+		return 0;
+	}
+	
 	/**
 	 * Supply the encryption scheme with a Secret Key.
 	 */
@@ -244,7 +257,7 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 	 * @param plaintext should be an instance of ByteArrayPlaintext.
 	 * @param iv random bytes to use in the encryption of the message.
 	 * @return an IVCiphertext, which contains the IV used and the encrypted data. 
-	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalStateException if no secret key was set, or if the native encryption failed.
 	 * @throws IllegalArgumentException if the given plaintext is not an instance of ByteArrayPlaintext.
 	 * @throws IllegalBlockSizeException if the given IV length is not as the block size.
 	 */
@@ -261,19 +274,104 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 			throw new IllegalArgumentException("plaintext should be instance of ByteArrayPlaintext");
 		}
 		
-		//Call the native function that idoes the encryption. 
-		ByteArrayPlaintext text = (ByteArrayPlaintext)plaintext;
-		byte[] cipher = encrypt(enc, text.getText(), iv);
+		//Call the native function that does the encryption. It writes the ciphertext directly to the array.
+		byte[] text = ((ByteArrayPlaintext)plaintext).getText();
+		byte[] cipher = new byte[getCiphertextSize(text.length)];
+		if (encrypt(enc, text, 0, text.length, iv, cipher, 0) < 0){
+			throw new IllegalStateException("the native encryption failed");
+		}
 
 		//Create and return an IVCiphertext with the iv and encrypted data.
 		return new IVCiphertext(new ByteArraySymCiphertext(cipher), iv);
 	}
+	
+	/**
+	 * Returns the size of the ciphertext of a plaintext of the given size. 
+	 * This is the size of the padded plaintext (in CBC mode), plus the size of the tag (in authenticated modes).
+	 * @param plaintextSize the size of the plaintext in bytes.
+	 * @return the size of the ciphertext in bytes.
+	 * @throws IllegalStateException if no secret key was set, since the block size depends on the key.
+	 */
+	public int getCiphertextSize(int plaintextSize){
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		int blockSize = getBlockSize(enc);
+		
+		//The padding always adds at least one byte, so an aligned plaintext gets an entire block of padding.
+		int paddedSize = (blockSize > 1) ? (plaintextSize / blockSize + 1) * blockSize : plaintextSize;
+		return paddedSize + getTagSize();
+	}
+	
+	/**
+	 * Encrypts a part of the given array with the given iv, and puts the ciphertext in the given output array. 
+	 * The plaintext and the ciphertext are not copied, so this function can be used by callers that keep their own buffers.
+	 * @param in the array that contains the plaintext.
+	 * @param inOffset the offset of the plaintext in the array.
+	 * @param inLen the length of the plaintext.
+	 * @param iv random bytes to use in the encryption of the message.
+	 * @param out the output array. Should have room for getCiphertextSize(inLen) bytes. Can be the input array.
+	 * @param outOffset the offset in the output array to put the ciphertext from.
+	 * @return the length of the ciphertext.
+	 * @throws IllegalStateException if no secret key was set, or if the native encryption failed.
+	 * @throws IllegalBlockSizeException if the given IV length is not as the IV size of this encryption.
+	 */
+	public int encrypt(byte[] in, int inOffset, int inLen, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		if(iv.length != getIVSize(enc)){
+			throw new IllegalBlockSizeException("The length of the IV passed is not equal to the IV size of this encryption");
+		}
+		checkArrays(in, inOffset, inLen, out, outOffset, getCiphertextSize(inLen));
+		
+		int size = encrypt(enc, in, inOffset, inLen, iv, out, outOffset);
+		if (size < 0){
+			throw new IllegalStateException("the native encryption failed");
+		}
+		return size;
+	}
+	
+	/**
+	 * Decrypts a part of the given array with the given iv, and puts the plaintext in the given output array.
+	 * The ciphertext and the plaintext are not copied, so this function can be used by callers that keep their own buffers.
+	 * @param in the array that contains the ciphertext.
+	 * @param inOffset the offset of the ciphertext in the array.
+	 * @param inLen the length of the ciphertext.
+	 * @param iv the iv that the ciphertext was encrypted with.
+	 * @param out the output array. Should have room for inLen bytes. Can be the input array.
+	 * @param outOffset the offset in the output array to put the plaintext from.
+	 * @return the length of the plaintext, or -1 if the ciphertext is not valid (its padding or tag is wrong).
+	 * @throws IllegalStateException if no secret key was set.
+	 * @throws IllegalBlockSizeException if the given IV length is not as the IV size of this encryption.
+	 */
+	public int decrypt(byte[] in, int inOffset, int inLen, byte[] iv, byte[] out, int outOffset) throws IllegalBlockSizeException{
+		if (!isKeySet()){
+			throw new IllegalStateException("no SecretKey was set");
+		}
+		if(iv.length != getIVSize(enc)){
+			throw new IllegalBlockSizeException("The length of the IV passed is not equal to the IV size of this encryption");
+		}
+		checkArrays(in, inOffset, inLen, out, outOffset, inLen);
+		
+		return decrypt(dec, in, inOffset, inLen, iv, out, outOffset);
+	}
+	
+	//Checks that the input and the output are inside the given arrays.
+	private void checkArrays(byte[] in, int inOffset, int inLen, byte[] out, int outOffset, int outLen){
+		if ((inOffset < 0) || (inLen < 0) || (inOffset > in.length - inLen)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOffset < 0) || (outOffset > out.length - outLen)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+	}
 
 	/**
 	 * Decrypts the given ciphertext using the underlying prp as the block cipher function.
 	 * 
 	 * @param ciphertext the given ciphertext to decrypt. MUST be an instance of IVCiphertext.
-	 * @return the plaintext object containing the decrypted ciphertext.
+	 * @return the plaintext object containing the decrypted ciphertext, or null if the ciphertext (or its IV) is not valid.
 	 * @throws IllegalStateException if no secret key was set.
 	 * @throws IllegalArgumentException if the given ciphertext is not an instance of IVCiphertext.
 	 */
@@ -293,8 +391,24 @@ public abstract class OpenSSLEncWithIVAbs implements SymmetricEnc{
 		byte[] iv = ((IVCiphertext) ciphertext).getIv();
 		byte[] cipher = ciphertext.getBytes();
 		
-		//Call the native funcrion that does the decryption.
-		byte[] plaintext = decrypt(dec, cipher, iv);
+		//The ciphertext may come from the other party, and the native decryption reads an IV of the size of the scheme.
+		if ((iv == null) || (iv.length != getIVSize(enc))){
+			return null;
+		}
+		
+		//Call the native function that does the decryption. The plaintext is never longer than the ciphertext.
+		byte[] plaintext = new byte[cipher.length];
+		int size = decrypt(dec, cipher, 0, cipher.length, iv, plaintext, 0);
+		if (size < 0){
+			return null;
+		}
+		
+		//Remove the room of the padding and the tag.
+		if (size < plaintext.length){
+			byte[] text = new byte[size];
+			System.arraycopy(plaintext, 0, text, 0, size);
+			plaintext = text;
+		}
 		 
 		return new ByteArrayPlaintext(plaintext);
 	}
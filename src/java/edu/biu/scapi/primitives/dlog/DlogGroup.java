@@ -98,6 +98,16 @@ public interface DlogGroup {
 	 */
 	public boolean isMember(GroupElement element) throws IllegalArgumentException;
 	
+	/**
+	 * Checks for each of the given elements if it is a member of this Dlog group.<p>
+	 * Implementations may check all the elements together (for example in one native call), 
+	 * so this is faster than calling isMember for each element.
+	 * @param elements possible group elements, for example elements that were received from another party
+	 * @return array that holds in index i whether elements[i] is a member of this group
+	 * @throws IllegalArgumentException if one of the elements doesn't match the group type
+	 */
+	public boolean[] areMembers(GroupElement[] elements) throws IllegalArgumentException;
+	
 	/**
 	 * Checks if the order is a prime number
 	 * @return <code>true<code> if the order is a prime number; <p>
@@ -219,6 +229,26 @@ public interface DlogGroup {
 	 */
 	public GroupElement exponentiateWithPreComputedValues(GroupElement base, BigInteger exponent);
 	
+	/**
+	 * Raises each base to the respective exponent, that is, computes bases[i]^exponents[i] for each i.<p>
+	 * Implementations may compute the exponentiations together (for example in several native threads), 
+	 * so this is faster than calling exponentiate for each base.
+	 * @param bases the bases
+	 * @param exponents the exponents, in the same length as the bases
+	 * @return the exponentiations results
+	 * @throws IllegalArgumentException if the arrays are not in the same length or a base is not an element of this group
+	 */
+	public GroupElement[] exponentiateBatch(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException;
+	
+	/**
+	 * Raises the given base to each of the exponents, using the values that are precomputed for the base 
+	 * (like exponentiateWithPreComputedValues).
+	 * @param base the fixed base
+	 * @param exponents the exponents
+	 * @return the exponentiations results, in the order of the exponents
+	 */
+	public GroupElement[] fixedBaseExponentiateBatch(GroupElement base, BigInteger[] exponents);
+	
 	/**
 	 * This function cleans up any resources used by exponentiateWithPreComputedValues for the requested base.
 	 * It is recommended to call it whenever an application does not need to continue calculating exponentiations for this specific base.   
@@ -239,6 +269,15 @@ public interface DlogGroup {
 	 */
 	public GroupElement encodeByteArrayToGroupElement(byte[] binaryString);
 	
+	/**
+	 * Encodes each of the given byte arrays to a Group Element, like encodeByteArrayToGroupElement.<p>
+	 * Implementations may encode the byte arrays together (for example in several native threads), 
+	 * so this is faster than calling encodeByteArrayToGroupElement for each byte array.
+	 * @param binaryStrings the byte arrays to encode
+	 * @return the encoded group elements, in the order of the byte arrays. The entries of the byte arrays that could not be encoded are null.
+	 */
+	public GroupElement[] encodeByteArraysToGroupElements(byte[][] binaryStrings);
+	
 	/**
 	 * This function decodes a group element to a byte array. This function is guaranteed to work properly ONLY if the group element was obtained as a result of 
 	 * encoding a binary string of length in bytes up to k.<p>
@@ -309,6 +309,53 @@ public abstract class DlogGroupAbs implements primeOrderSubGroup{
 		return w;
 	}
 
+	/**
+	 * Encodes the byte arrays one by one. Groups that can encode them together override this function.
+	 */
+	public GroupElement[] encodeByteArraysToGroupElements(byte[][] binaryStrings) {
+		GroupElement[] elements = new GroupElement[binaryStrings.length];
+		for (int i = 0; i < binaryStrings.length; i++){
+			elements[i] = encodeByteArrayToGroupElement(binaryStrings[i]);
+		}
+		return elements;
+	}
+
+	/**
+	 * Checks the elements one by one. Groups that can check them together override this function.
+	 */
+	public boolean[] areMembers(GroupElement[] elements) throws IllegalArgumentException {
+		boolean[] members = new boolean[elements.length];
+		for (int i = 0; i < elements.length; i++){
+			members[i] = isMember(elements[i]);
+		}
+		return members;
+	}
+
+	/**
+	 * Computes the exponentiations one by one. Groups that can compute them together override this function.
+	 */
+	public GroupElement[] exponentiateBatch(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be the same");
+		}
+		GroupElement[] results = new GroupElement[bases.length];
+		for (int i = 0; i < bases.length; i++){
+			results[i] = exponentiate(bases[i], exponents[i]);
+		}
+		return results;
+	}
+	
+	/**
+	 * Computes the exponentiations one by one. Groups that can compute them together override this function.
+	 */
+	public GroupElement[] fixedBaseExponentiateBatch(GroupElement base, BigInteger[] exponents) {
+		GroupElement[] results = new GroupElement[exponents.length];
+		for (int i = 0; i < exponents.length; i++){
+			results[i] = exponentiateWithPreComputedValues(base, exponents[i]);
+		}
+		return results;
+	}
+	
 	/*
 	 * Computes the product of several exponentiations of the same base and
 	 * distinct exponents. An optimization is used to compute it more quickly by
@@ -64,6 +64,7 @@ public class CryptoPpDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafeP
 	private native boolean validateZpGroup(long group);
 	private native boolean validateZpGenerator(long group);
 	private native boolean validateZpElement(long group, long element);
+	private native boolean[] validateZpElements(long group, long[] elements);
 
 	
 	
@@ -252,6 +253,23 @@ public class CryptoPpDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafeP
 		return validateZpElement(pointerToGroup, ((ZpSafePrimeElementCryptoPp) element).getPointerToElement());
 
 	}
+	
+	/**
+	 * Checks for each of the given elements if it is member of this Dlog group, in one native call.
+	 * @throws IllegalArgumentException if one of the elements does not match this group.
+	 */
+	@Override
+	public boolean[] areMembers(GroupElement[] elements) {
+		long[] nativeElements = new long[elements.length];
+		for (int i = 0; i < elements.length; i++){
+			if (!(elements[i] instanceof ZpSafePrimeElementCryptoPp)) {
+				throw new IllegalArgumentException("element type doesn't match the group type");
+			}
+			nativeElements[i] = ((ZpSafePrimeElementCryptoPp) elements[i]).getPointerToElement();
+		}
+		
+		return validateZpElements(pointerToGroup, nativeElements);
+	}
 
 	/**
 	 * Checks if the given generator is indeed the generator of the group
@@ -109,13 +109,39 @@ public class ECFpPointOpenSSL implements ECFpPoint{
 		}
 	}
 	
+	/**
+	 * Constructor that gets a native point together with its coordinates, which were already taken from the native code 
+	 * (for example by the batch functions of the group, that take the coordinates of many points in one call).
+	 * @param point native element that need to be set.
+	 * @param x the x coordinate of the point, or null if the point is the infinity.
+	 * @param y the y coordinate of the point, or null if the point is the infinity.
+	 */
+	ECFpPointOpenSSL(long point, BigInteger x, BigInteger y) {
+		this.point = point;
+		this.x = x;
+		this.y = y;
+	}
+	
 	/**
 	 * @return the pointer to the native point.
 	 */
 	long getPoint(){
+		if (point == 0){
+			throw new IllegalStateException("the point was released by the end of its element scope");
+		}
 		return point;
 	}
 	
+	/**
+	 * Detaches the native point from this object, so that the group can release it.
+	 * @return the pointer to the native point, or 0 if it was already detached.
+	 */
+	long detachPoint(){
+		long detached = point;
+		point = 0;
+		return detached;
+	}
+	
 	@Override
 	public BigInteger getX() {
 		return x;
@@ -171,7 +197,9 @@ public class ECFpPointOpenSSL implements ECFpPoint{
 	 * Delete the related point in OpenSSL's native code.
 	 */
 	protected void finalize() throws Throwable{
-		//Delete from the dll the dynamic allocation of the point.
-		deletePoint(point);
+		//Delete from the dll the dynamic allocation of the point, unless it was released by an element scope.
+		if (point != 0){
+			deletePoint(point);
+		}
 	}
 }
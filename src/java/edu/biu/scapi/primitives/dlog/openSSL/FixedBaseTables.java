@@ -0,0 +1,148 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog.openSSL;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+
+/**
+ * The native fixed base tables of an OpenSSL group, by the keys of their bases.<p>
+ * The tables are shared by all the threads that use the group. Each exponentiation takes a reference to the table of its base 
+ * and releases it when the native call returns, so a table that is removed while other threads still exponentiate with it 
+ * is deleted only after the last of them is done.<p>
+ * At most getMaxTables() tables are kept (DEFAULT_MAX_TABLES unless it is changed). When a new base passes the bound, 
+ * the table of the least recently used base is removed, and it is computed again if that base is used later.
+ * 
+ * @param <K> the type of the keys of the bases.
+ * @param <B> the type of the bases.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+abstract class FixedBaseTables<K, B> {
+	
+	/**
+	 * A native table and the number of exponentiations that use it.
+	 */
+	static final class Table {
+		final long pointer;			//Pointer to the native table.
+		private int users = 0;		//The number of exponentiations that currently use the table.
+		private boolean removed;	//True when the table is no longer in the map, so the last user deletes it.
+		
+		private Table(long pointer){
+			this.pointer = pointer;
+		}
+	}
+	
+	//The default bound on the number of tables. Each table takes a few MB, depending on the group and the window.
+	static final int DEFAULT_MAX_TABLES = 16;
+	
+	private int maxTables = DEFAULT_MAX_TABLES;
+	//The tables in access order, so the first one is of the least recently used base.
+	private LinkedHashMap<K, Table> tables = new LinkedHashMap<K, Table>(16, 0.75f, true);
+	
+	/**
+	 * Creates the native table of the given base.
+	 */
+	protected abstract long createTable(B base);
+	
+	/**
+	 * Deletes the given native table.
+	 */
+	protected abstract void deleteTable(long table);
+	
+	/**
+	 * Returns the table of the given base, and creates it if this is the first use of the base.
+	 * The caller must pass the returned table to {@link #release(Table)} after the native call that uses it.
+	 */
+	synchronized Table acquire(K key, B base){
+		Table table = tables.get(key);
+		if (table == null){
+			table = new Table(createTable(base));
+			tables.put(key, table);
+			removeLeastRecentlyUsed();
+		}
+		table.users++;
+		return table;
+	}
+	
+	/**
+	 * Releases a table that was returned by {@link #acquire(Object, Object)}. Deletes it if it was removed and this was its last user.
+	 */
+	synchronized void release(Table table){
+		table.users--;
+		if (table.removed && (table.users == 0)){
+			deleteTable(table.pointer);
+		}
+	}
+	
+	/**
+	 * Removes the table of the given base, if there is one. 
+	 * The table is deleted now, or by the last exponentiation that still uses it.
+	 */
+	synchronized void remove(K key){
+		Table table = tables.remove(key);
+		if (table != null){
+			table.removed = true;
+			if (table.users == 0){
+				deleteTable(table.pointer);
+			}
+		}
+	}
+	
+	/**
+	 * Sets the maximal number of tables that are kept. Tables above the new bound are removed.
+	 * @throws IllegalArgumentException if the bound is not positive.
+	 */
+	synchronized void setMaxTables(int maxTables){
+		if (maxTables < 1){
+			throw new IllegalArgumentException("at least one table should be kept");
+		}
+		this.maxTables = maxTables;
+		removeLeastRecentlyUsed();
+	}
+	
+	synchronized int getMaxTables(){
+		return maxTables;
+	}
+	
+	/**
+	 * Removes the tables of the least recently used bases until the number of tables is in the bound.
+	 */
+	private void removeLeastRecentlyUsed(){
+		while (tables.size() > maxTables){
+			remove(tables.keySet().iterator().next());
+		}
+	}
+	
+	/**
+	 * Removes all the tables. Called when the group is finalized, so no exponentiation uses them anymore.
+	 */
+	synchronized void removeAll(){
+		for (K key : new ArrayList<K>(tables.keySet())){
+			remove(key);
+		}
+	}
+}
@@ -0,0 +1,98 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog.openSSL;
+
+import java.util.ArrayList;
+
+import edu.biu.scapi.primitives.dlog.GroupElement;
+
+/**
+ * The open element scopes of each thread that uses an OpenSSL group.<p>
+ * While a thread has an open scope, the elements that the group creates for it are recorded in the scope. 
+ * When the scope ends, the group releases all of them to its native pool in a single call, instead of waiting for each 
+ * element to be finalized. Scopes can be nested; ending a scope releases only the elements of the innermost scope.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+class NativeElementScopes {
+	
+	//The stack of open scopes of each thread. Null when the thread has no open scope, so that tracking is free in that case.
+	private ThreadLocal<ArrayList<ArrayList<GroupElement>>> scopes = new ThreadLocal<ArrayList<ArrayList<GroupElement>>>();
+	
+	/**
+	 * Opens a new scope for the calling thread.
+	 */
+	void begin(){
+		ArrayList<ArrayList<GroupElement>> stack = scopes.get();
+		if (stack == null){
+			stack = new ArrayList<ArrayList<GroupElement>>();
+			scopes.set(stack);
+		}
+		stack.add(new ArrayList<GroupElement>());
+	}
+	
+	/**
+	 * Records the given element in the innermost scope of the calling thread, if there is one.
+	 * @return the given element.
+	 */
+	<T extends GroupElement> T track(T element){
+		ArrayList<ArrayList<GroupElement>> stack = scopes.get();
+		if (stack != null){
+			stack.get(stack.size() - 1).add(element);
+		}
+		return element;
+	}
+	
+	/**
+	 * Closes the innermost scope of the calling thread.
+	 * @param keep elements of the scope that should not be released. They move to the enclosing scope, if there is one.
+	 * @return the elements that should be released.
+	 * @throws IllegalStateException if the thread has no open scope.
+	 */
+	ArrayList<GroupElement> end(GroupElement[] keep){
+		ArrayList<ArrayList<GroupElement>> stack = scopes.get();
+		if (stack == null){
+			throw new IllegalStateException("there is no open element scope in this thread");
+		}
+		
+		ArrayList<GroupElement> released = stack.remove(stack.size() - 1);
+		if (stack.isEmpty()){
+			scopes.remove();
+		}
+		
+		for (GroupElement element : keep){
+			//The elements are compared by identity, since equal elements may be different native objects.
+			for (int i = 0; i < released.size(); i++){
+				if (released.get(i) == element){
+					released.remove(i);
+					track(element);
+					break;
+				}
+			}
+		}
+		return released;
+	}
+}
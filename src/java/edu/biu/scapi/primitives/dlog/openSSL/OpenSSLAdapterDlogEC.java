@@ -27,9 +27,15 @@ package edu.biu.scapi.primitives.dlog.openSSL;
 import java.io.IOException;
 import java.math.BigInteger;
 import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
 
 import edu.biu.scapi.primitives.dlog.DlogGroupEC;
 import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.groupParams.ECF2mGroupParams;
+import edu.biu.scapi.primitives.dlog.groupParams.ECFpGroupParams;
 
 /**
  * An abstract class that implements some common functionalities for both elliptic curve types, Fp and F2m.
@@ -40,6 +46,22 @@ import edu.biu.scapi.primitives.dlog.ECElement;
 public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 
 	protected long curve; //Pointer to the native curve.
+	private NativeElementScopes scopes = new NativeElementScopes(); //The open element scopes of the threads that use the group.
+	
+	//The default memory of the table of each fixed base, in bytes.
+	private static final long DEFAULT_FIXED_BASE_MEMORY = 4 << 20;
+	
+	protected int window = 0;	//The window of the fixed base tables. 0 means the largest window that fits in the memory of the table.
+	protected long fixedBaseMemory = DEFAULT_FIXED_BASE_MEMORY;	//The memory that each fixed base table may take.
+	//The native tables of the bases that were used in exponentiateWithPreComputedValues, by the coordinates of the bases.
+	private FixedBaseTables<List<BigInteger>, ECElement> fixedBaseTables = new FixedBaseTables<List<BigInteger>, ECElement>(){
+		protected long createTable(ECElement base){
+			return createFixedBaseTable(curve, getNativePoint(base), window, fixedBaseMemory);
+		}
+		protected void deleteTable(long table){
+			deleteFixedBaseTable(table);
+		}
+	};
 	
 	//Native functions that calls OpenSSL functionalities regarding the curve.
 	protected native long createInfinityPoint(long curve);							//Creates an infinity point.
@@ -47,9 +69,18 @@ public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 	protected native long exponentiate(long curve, long point, byte[] exponent);	//Raises the given base to the exponent.
 	protected native long multiply(long curve, long point1, long point2);			//Multiplies the given points.
 	protected native boolean checkCurveMembership(long curve, long point);			//Checks if the given point is on the curve.
-	protected native long simultaneousMultiply(long curve, long[] nativePoints, byte[][] exponents);//Raises each base to the respective exponent and multiplies the results.
+	protected native boolean[] checkMembership(long curve, long[] nativePoints);	//Checks for each point if it is on the curve and in the subgroup.
+	protected native long simultaneousMultiply(long curve, long[] nativePoints, byte[] exponents, int exponentSize);//Raises each base to the respective packed exponent and multiplies the results.
 	protected native boolean validate(long curve);									//Validates the curve.
 	protected native long exponentiateWithPreComputedValues(long curve, byte[] exponent);//Raise the given base to the given exponent, using pre computed values.
+	protected native long[] exponentiateBatch(long curve, long[] nativePoints, byte[] exponents, int exponentSize);//Raises each base to the respective packed exponent.
+	protected native long createFixedBaseTable(long curve, long base, int window, long maxBytes);//Precomputes the multiples of the given base.
+	protected native long exponentiateWithTable(long curve, long table, byte[] exponent);//Raises the base of the table to the given exponent.
+	protected native void deleteFixedBaseTable(long table);							//Deletes the table.
+	protected native long[] fixedBaseExponentiateBatch(long curve, long table, byte[] exponents, int exponentSize);//Raises the base of the table (or the generator if the table is 0) to each packed exponent.
+	protected native byte[] encodePoints(long curve, long[] nativePoints, boolean compressed);//Encodes the points one after the other.
+	protected native long[] decodePoints(long curve, byte[] encoded, int encodingSize);//Decodes the points and checks that they are on the curve.
+	protected native void releasePoints(long curve, long[] nativePoints);			//Releases the points to the pool of the native curve.
 	protected native void deleteDlog(long curve);									//Deletes the native curve.
 	
 	/**
@@ -101,6 +132,213 @@ public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 		return curve;
 	}
 	
+	/**
+	 * Sets the window of the tables that exponentiateWithPreComputedValues creates for bases other than the generator.
+	 * Each addition of an exponentiation with the table handles window bits of the exponent, and the table holds 2^(window-1) points 
+	 * for each window. If the table does not fit in its memory (see {@link #setFixedBaseMemory(long)}) a smaller window is used.
+	 * The default (0) is the largest window that fits in the memory. Only tables that are created after the call are affected.
+	 * @param val the window, between 1 and 12.
+	 */
+	public void setWindow(int val){
+		window = val;
+	}
+	
+	/**
+	 * Sets the memory that the table of each fixed base may take, in bytes. The default is 4 MB.
+	 * Only tables that are created after the call are affected.
+	 */
+	public void setFixedBaseMemory(long maxBytes){
+		fixedBaseMemory = maxBytes;
+	}
+	
+	/**
+	 * Sets the maximal number of bases whose tables are kept (16 by default). 
+	 * When another base is used, the table of the least recently used base is deleted, and it is computed again if that base is used later.
+	 * @param maxTables the number of tables, at least 1.
+	 */
+	public void setMaxFixedBaseTables(int maxTables){
+		fixedBaseTables.setMaxTables(maxTables);
+	}
+	
+	/**
+	 * Returns the native table of the given base, and creates it if this is the first use of the base.
+	 * The table is only read by the native code, so it is shared by all the threads that use the group. 
+	 * The caller must release the table with {@link #releaseFixedBaseTable(FixedBaseTables.Table)} after the native call.
+	 */
+	FixedBaseTables.Table acquireFixedBaseTable(ECElement base){
+		return fixedBaseTables.acquire(Arrays.asList(base.getX(), base.getY()), base);
+	}
+	
+	/**
+	 * Releases a table that was returned by acquireFixedBaseTable.
+	 */
+	void releaseFixedBaseTable(FixedBaseTables.Table table){
+		fixedBaseTables.release(table);
+	}
+	
+	/**
+	 * Deletes the table of the given base, if exponentiateWithPreComputedValues created one.
+	 * Exponentiations that other threads are doing with the table finish first, since the last of them deletes it.
+	 */
+	@Override
+	public void endExponentiateWithPreComputedValues(GroupElement base) {
+		if (!(base instanceof ECElement) || base.isInfinity()){
+			return;
+		}
+		fixedBaseTables.remove(Arrays.asList(((ECElement) base).getX(), ((ECElement) base).getY()));
+	}
+	
+	/**
+	 * Checks for each of the given points if it is member of this Dlog group.<p>
+	 * All the points are checked in one native call, by several native threads. A point is a member if it is on the curve and, 
+	 * when the curve has a cofactor, if its order divides the order of the group.
+	 * @throws IllegalArgumentException if one of the elements is not a point of this group.
+	 */
+	@Override
+	public boolean[] areMembers(GroupElement[] elements) throws IllegalArgumentException {
+		long[] nativePoints = new long[elements.length];
+		for (int i = 0; i < elements.length; i++){
+			nativePoints[i] = getNativePoint(elements[i]);
+		}
+		
+		return checkMembership(curve, nativePoints);
+	}
+	
+	/**
+	 * Opens an element scope for the calling thread.<p>
+	 * Until the matching {@link #endElementScope(GroupElement...)}, every element that this group creates for the thread is recorded 
+	 * in the scope. Ending the scope releases the native objects of all of them at once, and the group reuses them for its next results.
+	 * This bounds the native memory of protocols that create many short lived elements in each round, without depending on finalization.<p>
+	 * Scopes can be nested. Elements that are released by the end of their scope must not be used by native operations anymore.
+	 */
+	public void beginElementScope(){
+		scopes.begin();
+	}
+	
+	/**
+	 * Ends the innermost element scope of the calling thread, and releases the native objects of its elements.
+	 * @param keep elements of the scope that are still needed (for example the results of the round). They are not released,
+	 * and they move to the enclosing scope, if there is one.
+	 * @throws IllegalStateException if the calling thread has no open element scope.
+	 */
+	public void endElementScope(GroupElement... keep){
+		ArrayList<GroupElement> released = scopes.end(keep);
+		long[] nativePoints = new long[released.size()];
+		int numPoints = 0;
+		for (GroupElement element : released){
+			long point = (element instanceof ECFpPointOpenSSL) ? ((ECFpPointOpenSSL) element).detachPoint() : ((ECF2mPointOpenSSL) element).detachPoint();
+			if (point != 0){
+				nativePoints[numPoints++] = point;
+			}
+		}
+		releasePoints(curve, Arrays.copyOf(nativePoints, numPoints));
+	}
+	
+	/**
+	 * Records the given element in the open element scope of the calling thread, if there is one.
+	 * @return the given element.
+	 */
+	protected <T extends GroupElement> T track(T element){
+		return scopes.track(element);
+	}
+	
+	/**
+	 * Returns the native point of the given element.
+	 * @throws IllegalArgumentException if the element is not a point of this group.
+	 */
+	protected abstract long getNativePoint(GroupElement element) throws IllegalArgumentException;
+	
+	/**
+	 * Builds a point of this group from the given native point and its coordinates (which are null for the infinity point).
+	 */
+	protected abstract GroupElement createPoint(long nativePoint, BigInteger x, BigInteger y);
+	
+	/**
+	 * Returns the size of the encoding of each point in the array that {@link #encodePoints(GroupElement[], boolean)} returns.<p>
+	 * Points over binary fields are always uncompressed, since OpenSSL can decompress them only in some builds. 
+	 * In these curves the size is the same for both values of compressed.
+	 */
+	public int getEncodingSize(boolean compressed){
+		boolean primeField = groupParams instanceof ECFpGroupParams;
+		int fieldBits = primeField ? ((ECFpGroupParams) groupParams).getP().bitLength() : ((ECF2mGroupParams) groupParams).getM();
+		int fieldSize = (fieldBits + 7) / 8;
+		return (compressed && primeField) ? 1 + fieldSize : 1 + 2 * fieldSize;
+	}
+	
+	/**
+	 * Encodes the given points one after the other, each one in {@link #getEncodingSize(boolean)} bytes.<p>
+	 * The points use the standard encoding of SEC 1 (and the infinity point is all zeros). 
+	 * All the points are converted to affine coordinates together in a single native call, which is much faster than 
+	 * getting the coordinates of each point.
+	 * @param points the points to encode.
+	 * @param compressed whether to encode only x and the sign of y, or both coordinates. Ignored for curves over binary fields.
+	 * @return the encoded points.
+	 */
+	public byte[] encodePoints(GroupElement[] points, boolean compressed){
+		long[] nativePoints = new long[points.length];
+		for (int i = 0; i < points.length; i++){
+			nativePoints[i] = getNativePoint(points[i]);
+		}
+		
+		byte[] encoded = encodePoints(curve, nativePoints, compressed);
+		if (encoded == null){
+			throw new IllegalStateException("the native encoding failed");
+		}
+		return encoded;
+	}
+	
+	/**
+	 * Decodes points that were encoded by {@link #encodePoints(GroupElement[], boolean)}.<p>
+	 * Each point is checked to be on the curve. Note that for curves with a cofactor this does not check that the point is in the subgroup.
+	 * @param encoded the encoded points.
+	 * @param numPoints the number of points in the array.
+	 * @return the decoded points.
+	 * @throws IllegalArgumentException if one of the encodings is not a point on the curve.
+	 */
+	public GroupElement[] decodePoints(byte[] encoded, int numPoints) throws IllegalArgumentException{
+		if ((numPoints <= 0) || (encoded.length % numPoints != 0) || 
+			((encoded.length / numPoints != getEncodingSize(true)) && (encoded.length / numPoints != getEncodingSize(false)))){
+			throw new IllegalArgumentException("the size of the encoded points doesn't match the curve");
+		}
+		
+		long[] nativePoints = decodePoints(curve, encoded, encoded.length / numPoints);
+		if (nativePoints == null){
+			throw new IllegalArgumentException("the encoded values are not points on this curve");
+		}
+		return createPoints(nativePoints);
+	}
+	
+	/**
+	 * Builds the points of the given native results.<p>
+	 * The coordinates of all the points are taken in one native call, instead of two calls for each point.
+	 */
+	protected GroupElement[] createPoints(long[] nativePoints){
+		if (nativePoints == null){
+			throw new IllegalStateException("the native computation failed");
+		}
+		
+		int encodingSize = getEncodingSize(false);
+		int fieldSize = (encodingSize - 1) / 2;
+		byte[] encoded = encodePoints(curve, nativePoints, false);
+		if (encoded == null){
+			throw new IllegalStateException("the native encoding failed");
+		}
+		
+		GroupElement[] points = new GroupElement[nativePoints.length];
+		for (int i = 0; i < nativePoints.length; i++){
+			int offset = i * encodingSize;
+			if (encoded[offset] == 0){
+				//The infinity point.
+				points[i] = createPoint(nativePoints[i], null, null);
+			} else {
+				BigInteger x = new BigInteger(1, Arrays.copyOfRange(encoded, offset + 1, offset + 1 + fieldSize));
+				BigInteger y = new BigInteger(1, Arrays.copyOfRange(encoded, offset + 1 + fieldSize, offset + encodingSize));
+				points[i] = createPoint(nativePoints[i], x, y);
+			}
+		}
+		return points;
+	}
+	
 	@Override
 	@Deprecated
 	public ECElement generateElement(BigInteger x, BigInteger y) throws IllegalArgumentException {
@@ -117,6 +355,9 @@ public abstract class OpenSSLAdapterDlogEC extends DlogGroupEC{
 	 */
 	protected void finalize() throws Throwable {
 
+		// Delete the tables of the fixed bases.
+		fixedBaseTables.removeAll();
+		
 		// Delete from the dll the dynamic allocation.
 		deleteDlog(curve);
 
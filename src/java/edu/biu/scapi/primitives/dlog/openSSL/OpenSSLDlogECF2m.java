@@ -28,6 +28,7 @@ import java.io.IOException;
 import java.math.BigInteger;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
+import java.util.Arrays;
 import java.util.Properties;
 
 import edu.biu.scapi.primitives.dlog.DlogECF2m;
@@ -149,7 +150,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 	public ECElement getInfinity() {
 		//Create an infinity point and return it.
 		long infinity = createInfinityPoint(curve);
-		return new ECF2mPointOpenSSL(curve, infinity);
+		return track(new ECF2mPointOpenSSL(curve, infinity));
 	}
 
 	/**
@@ -175,7 +176,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		// Call the native inverse function.
 		long result = inversePoint(curve, point);
 		// Build a ECF2mPointOpenSSL element from the result.
-		return new ECF2mPointOpenSSL(curve, result);
+		return track(new ECF2mPointOpenSSL(curve, result));
 	}
 
 	@Override
@@ -200,7 +201,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		// Call the native exponentiate function.
 		long result = exponentiate(curve, point, exponent.toByteArray());
 		// Build a ECF2mPointOpenSSL element from the result.
-		return new ECF2mPointOpenSSL(curve, result);
+		return track(new ECF2mPointOpenSSL(curve, result));
 	}
 
 	@Override
@@ -227,7 +228,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		// Call the native multiply function.
 		long result = multiply(curve, point1, point2);
 		// Build a ECF2mPointOpenSSL element from the result.
-		return new ECF2mPointOpenSSL(curve, result);
+		return track(new ECF2mPointOpenSSL(curve, result));
 
 	}
 
@@ -265,7 +266,7 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		if(values.length != 2){
 			throw new IllegalArgumentException("To generate an ECElement you should pass the x and y coordinates of the point");
 		}
-		return new ECF2mPointOpenSSL(values[0], values[1], this, bCheckMembership);
+		return track(new ECF2mPointOpenSSL(values[0], values[1], this, bCheckMembership));
 	}
 
 	@Override
@@ -329,6 +330,8 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
 		}
 		
+		//OpenSSL adds points of binary curves in affine coordinates, so each addition takes a field inversion and a table of multiples 
+		//is not faster than exponentiate. Only the generator uses pre computed values.
 		if (!groupElement.equals(generator)){
 			return exponentiate(groupElement, exponent);
 		}
@@ -341,7 +344,59 @@ public class OpenSSLDlogECF2m extends OpenSSLAdapterDlogEC implements DlogECF2m,
 		// Call the native exponentiate function.
 		long result = exponentiateWithPreComputedValues(curve, exponent.toByteArray());
 		// Build a ECF2mPointOpenSSL element from the result.
-		return new ECF2mPointOpenSSL(curve, result);
+		return track(new ECF2mPointOpenSSL(curve, result));
 		
 	}
+
+	@Override
+	public GroupElement[] exponentiateBatch(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be the same");
+		}
+		
+		long[] nativePoints = new long[bases.length];
+		for (int i = 0; i < bases.length; i++){
+			//If the GroupElement doesn't match the DlogGroup, throw exception.
+			if (!(bases[i] instanceof ECF2mPointOpenSSL)){
+				throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+			}
+			nativePoints[i] = ((ECF2mPointOpenSSL) bases[i]).getPoint();
+		}
+		
+		// Call the native function that computes all the exponentiations, in several native threads.
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		return createPoints(exponentiateBatch(curve, nativePoints, packed.bytes, packed.exponentSize));
+	}
+	
+	@Override
+	public GroupElement[] fixedBaseExponentiateBatch(GroupElement base, BigInteger[] exponents) {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(base instanceof ECF2mPointOpenSSL)){
+			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+		}
+		
+		//Only the generator has native pre computed values.
+		if (!base.equals(generator)){
+			GroupElement[] bases = new GroupElement[exponents.length];
+			Arrays.fill(bases, base);
+			return exponentiateBatch(bases, exponents);
+		}
+		
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		return createPoints(fixedBaseExponentiateBatch(curve, 0, packed.bytes, packed.exponentSize));
+	}
+	
+	@Override
+	protected long getNativePoint(GroupElement element) throws IllegalArgumentException {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(element instanceof ECF2mPointOpenSSL)){
+			throw new IllegalArgumentException("the given element doesn't match the DlogGroup");
+		}
+		return ((ECF2mPointOpenSSL) element).getPoint();
+	}
+	
+	@Override
+	protected GroupElement createPoint(long nativePoint, BigInteger x, BigInteger y) {
+		return track(new ECF2mPointOpenSSL(nativePoint, x, y));
+	}
 }
@@ -28,6 +28,7 @@ import java.io.IOException;
 import java.math.BigInteger;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
+import java.util.Arrays;
 import java.util.Properties;
 
 import edu.biu.scapi.primitives.dlog.DlogECFp;
@@ -49,10 +50,30 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 	
 	//Creates the native curve.
 	private native long createCurve(byte[] p, byte[] a, byte[] b);
+	//Creates the named curve of OpenSSL that has the given parameters, already initialized with its generator and order. Returns 0 if there is no such curve.
+	private native long createNamedCurve(byte[] p, byte[] a, byte[] b, byte[] xg, byte[] yg, byte[] q);
 	//Initializes the native curve with the generator and order.
 	private native int initCurve(long curve, long generator, byte[] q);
-	//Encodes the given byte array into a point. If the given byte array can not be encoded to a point, returns 0.
-	private native long encodeByteArrayToPoint(long curve, byte[] binaryString, int k);
+	//Encodes the given byte array into a point, with the given map or by random padding if the map is 0. If the given byte array can not be encoded to a point, returns 0.
+	private native long encodeByteArrayToPoint(long curve, long map, byte[] binaryString, int k);
+	//Encodes each of the given byte arrays into a point. The entries of the byte arrays that can not be encoded are 0.
+	private native long[] encodeByteArraysToPoints(long curve, long map, byte[][] binaryStrings, int k);
+	//Decodes a point that was encoded with the given map. Returns null if the point is not an encoding of a byte array.
+	private native byte[] decodePointToByteArray(long curve, long map, long point, int k);
+	//Creates the simplified SWU map of the curve. Returns 0 if the curve has no such map.
+	private native long createEncodingMap(long curve);
+	//Deletes the map.
+	private native void deleteEncodingMap(long map);
+	
+	//Pointer to the native map of the deterministic encoding, or 0 for the random encoding. Each reader takes it once, into a local.
+	private volatile long encodingMap;
+	//The native map, once it was created. It is never deleted before finalize, so a thread can keep using it after the encoding changed.
+	private long createdEncodingMap;
+	
+	//If false, the groups that are created are built from their parameters even if OpenSSL has a named curve with the same parameters.
+	private static volatile boolean useNamedCurves = true;
+	//True if the native curve is a named curve of OpenSSL. Set by doInit, which the super constructor calls, so it has no initializer.
+	private boolean namedCurve;
 	
 	/**
 	 * Default constructor. Initializes this object with P-192 NIST curve.
@@ -114,21 +135,53 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		//Now that we have p, we can calculate k which is the maximum length in bytes of a string to be converted to a Group Element of this group. 
 		k = util.calcK(p);	
 		
-		// Create the ECCurve.
-		curve = createCurve(p.toByteArray(), fpParams.getA().mod(p).toByteArray(), fpParams.getB().toByteArray());
+		// Create the ECCurve. If OpenSSL has a named curve with these parameters it is used, since OpenSSL has optimized 
+		// (and constant time) implementations of some named curves, like P-224, P-256 and P-521, that curves which are 
+		// created from their parameters do not use.
+		curve = useNamedCurves ? createNamedCurve(p.toByteArray(), fpParams.getA().mod(p).toByteArray(), fpParams.getB().mod(p).toByteArray(), 
+				fpParams.getXg().toByteArray(), fpParams.getYg().toByteArray(), fpParams.getQ().toByteArray()) : 0;
+		namedCurve = (curve != 0);
+		if (!namedCurve){
+			curve = createCurve(p.toByteArray(), fpParams.getA().mod(p).toByteArray(), fpParams.getB().toByteArray());
+		}
 		
 		// Create the generator.
 		generator  = new ECFpPointOpenSSL(fpParams.getXg(), fpParams.getYg(), this, true);
 		
-		//Initialize the curve with the generator and order.
-		initCurve(curve, ((ECFpPointOpenSSL) generator).getPoint(), fpParams.getQ().toByteArray());
+		//Initialize the curve with the generator and order. A named curve already has them.
+		if (!namedCurve){
+			initCurve(curve, ((ECFpPointOpenSSL) generator).getPoint(), fpParams.getQ().toByteArray());
+		}
+	}
+
+	/**
+	 * Sets whether the groups that are created from now on use the named curve of OpenSSL that has their parameters, if there is one (the default),
+	 * or are always built from their parameters. Building the curves from their parameters is only useful for comparing the two implementations.
+	 * @param use true in order to use the named curves.
+	 */
+	public static void setUseNamedCurves(boolean use){
+		useNamedCurves = use;
+	}
+	
+	/**
+	 * @return true if the groups that are created use the named curves of OpenSSL.
+	 */
+	public static boolean getUseNamedCurves(){
+		return useNamedCurves;
+	}
+	
+	/**
+	 * @return true if this group uses a named curve of OpenSSL, false if its curve was built from its parameters.
+	 */
+	public boolean isNamedCurve(){
+		return namedCurve;
 	}
 
 	@Override
 	public ECElement getInfinity() {
 		//Create an infinity point and return it.
 		long infinity = createInfinityPoint(curve);
-		return new ECFpPointOpenSSL(curve, infinity);
+		return track(new ECFpPointOpenSSL(curve, infinity));
 	}
 
 	/**
@@ -155,7 +208,7 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		// Call the native inverse function.
 		long result = inversePoint(curve, point);
 		// Build a ECFpPointOpenSSL element from the result.
-		return new ECFpPointOpenSSL(curve, result);
+		return track(new ECFpPointOpenSSL(curve, result));
 	}
 
 	@Override
@@ -180,7 +233,7 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		// Call the native exponentiate function.
 		long result = exponentiate(curve, point, exponent.toByteArray());
 		// Build a ECFpPointOpenSSL element from the result.
-		return new ECFpPointOpenSSL(curve, result);
+		return track(new ECFpPointOpenSSL(curve, result));
 	}
 
 	@Override
@@ -207,7 +260,7 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		// Call the native multiply function.
 		long result = multiply(curve, point1, point2);
 		// Build a ECFpPointOpenSSL element from the result.
-		return new ECFpPointOpenSSL(curve, result);
+		return track(new ECFpPointOpenSSL(curve, result));
 
 	}
 
@@ -245,45 +298,104 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		if(values.length != 2){
 			throw new IllegalArgumentException("To generate an ECElement you should pass the x and y coordinates of the point");
 		}
-		return new ECFpPointOpenSSL(values[0], values[1], this, bCheckMembership);
+		return track(new ECFpPointOpenSSL(values[0], values[1], this, bCheckMembership));
 	}
 
+	/**
+	 * Computes the product of several exponentiations with distinct bases.<p>
+	 * The exponents are passed to the native code packed in one array. Up to 128 bases the native code uses the simultaneous 
+	 * exponentiation of OpenSSL. Larger inputs use the bucket method of Pippenger, which needs fewer additions for many bases 
+	 * and is computed by several native threads (curves that OpenSSL implements with its own optimized code always use OpenSSL).
+	 */
 	@Override
 	public GroupElement simultaneousMultipleExponentiations(GroupElement[] groupElements, BigInteger[] exponentiations) {
 		
 		int len = groupElements.length;
 
-		//Create arrays to hold the native points and the exponents' bytes.
+		//Create an array to hold the native points.
 		long[] nativePoints = new long[len];
-		byte[][] exponents = new byte[len][];
 		for (int i = 0; i < len; i++) {
 			// if the GroupElements don't match the DlogGroup, throw exception.
 			if (!(groupElements[i] instanceof ECFpPointOpenSSL)) {
 				throw new IllegalArgumentException("groupElement doesn't match the DlogGroup");
 			}
 			nativePoints[i] = ((ECFpPointOpenSSL) groupElements[i]).getPoint();
-			exponents[i] = exponentiations[i].toByteArray();
 		}
 
-		// Call the native simultaneousMultiply function.
-		long result = simultaneousMultiply(curve, nativePoints, exponents);
+		// Call the native simultaneousMultiply function with the packed exponents.
+		PackedExponents packed = new PackedExponents(exponentiations, getOrder());
+		long result = simultaneousMultiply(curve, nativePoints, packed.bytes, packed.exponentSize);
 		// Build a ECFpPointOpenSSL element from the result value.
-		return new ECFpPointOpenSSL(curve, result);
+		return track(new ECFpPointOpenSSL(curve, result));
 	}
 
 	@Override
 	public GroupElement encodeByteArrayToGroupElement(byte[] binaryString) {
 		//Call a native function that encode the byte array to a point.
-		long point = encodeByteArrayToPoint(curve, binaryString, k);
+		long point = encodeByteArrayToPoint(curve, encodingMap, binaryString, k);
 		
 		//If failed to create a point, return null.
 		if (point == 0)
 			return null;
 		
 		 // Build a ECFpPointOpenSSL element from the result.
-		return new ECFpPointOpenSSL(curve, point);
+		return track(new ECFpPointOpenSSL(curve, point));
 	}
 
+	/**
+	 * Encodes each of the given byte arrays to a point, in one native call and by several native threads.
+	 * @return the encoded points. The entries of the byte arrays that could not be encoded are null.
+	 */
+	@Override
+	public GroupElement[] encodeByteArraysToGroupElements(byte[][] binaryStrings) {
+		long[] nativePoints = encodeByteArraysToPoints(curve, encodingMap, binaryStrings, k);
+		
+		//Build the points that were created, and leave null in the entries that failed.
+		int numPoints = 0;
+		for (long point : nativePoints){
+			if (point != 0){
+				numPoints++;
+			}
+		}
+		long[] created = new long[numPoints];
+		numPoints = 0;
+		for (long point : nativePoints){
+			if (point != 0){
+				created[numPoints++] = point;
+			}
+		}
+		GroupElement[] points = createPoints(created);
+		GroupElement[] elements = new GroupElement[nativePoints.length];
+		numPoints = 0;
+		for (int i = 0; i < nativePoints.length; i++){
+			if (nativePoints[i] != 0){
+				elements[i] = points[numPoints++];
+			}
+		}
+		return elements;
+	}
+	
+	/**
+	 * Chooses how byte arrays are encoded into points by {@link #encodeByteArrayToGroupElement(byte[])}.<p>
+	 * By default a byte array is padded with random bytes into the x coordinate of a point, and the padding is chosen again
+	 * (up to 80 times) until the curve has a point with this x. This is the encoding of the other implementations of this group.<p>
+	 * The deterministic encoding maps the byte array to a point with the simplified SWU map of RFC 9380. It does not use randomness
+	 * and it takes the same operations for every byte array, so its time does not depend on the byte array. 
+	 * Its points can only be decoded by a group that uses the deterministic encoding too.
+	 * @param deterministic true for the deterministic encoding; false for the random encoding.
+	 * @throws UnsupportedOperationException if the curve has no simplified SWU map (when a = 0 or b = 0).
+	 */
+	public synchronized void setDeterministicEncoding(boolean deterministic){
+		if (deterministic && (createdEncodingMap == 0)){
+			createdEncodingMap = createEncodingMap(curve);
+			if (createdEncodingMap == 0){
+				throw new UnsupportedOperationException("the curve has no simplified SWU map");
+			}
+		}
+		//The map is kept after the random encoding is chosen, since other threads may still be encoding with it.
+		encodingMap = deterministic ? createdEncodingMap : 0;
+	}
+	
 	@Override
 	public byte[] decodeGroupElementToByteArray(GroupElement groupElement) {
 		// Checks that the element is the correct object.
@@ -291,6 +403,17 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 			throw new IllegalArgumentException("element type doesn't match the group type");
 		}
 		ECFpPointOpenSSL point = (ECFpPointOpenSSL) groupElement;
+		
+		//A point of the deterministic encoding is decoded by inverting the map.
+		long map = encodingMap;
+		if (map != 0){
+			byte[] decoded = decodePointToByteArray(curve, map, point.getPoint(), k);
+			if (decoded == null){
+				throw new IllegalArgumentException("the element is not an encoding of a byte array");
+			}
+			return decoded;
+		}
+		
 		byte[] xByteArray = point.getX().toByteArray();
 		//The original size is placed in the last byte of x.
 		byte bOriginalSize = xByteArray[xByteArray.length -1];
@@ -315,6 +438,14 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 		return util.mapAnyGroupElementToByteArray(point.getX(), point.getY());
 	}
 
+	/**
+	 * Raises the given base to the given exponent using pre computed values.<p>
+	 * The generator uses the pre computed values of OpenSSL. For any other base a table of its multiples is computed in the first call 
+	 * with the base, and kept until endExponentiateWithPreComputedValues is called with the base (see {@link #setWindow(int)} and 
+	 * {@link #setFixedBaseMemory(long)} for the size of the table). With the table an exponentiation takes one addition for each window 
+	 * of the exponent and no doublings. This is useful for bases that are used many times, like the second generator of Pedersen commitments 
+	 * and the public key of ElGamal.
+	 */
 	@Override
 	public GroupElement exponentiateWithPreComputedValues(GroupElement groupElement, BigInteger exponent) {
 		//If the GroupElement doesn't match the DlogGroup, throw exception.
@@ -322,7 +453,8 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
 		}
 		
-		if (!groupElement.equals(generator)){
+		//The infinity point remains the same after any exponentiate.
+		if (groupElement.isInfinity()){
 			return exponentiate(groupElement, exponent);
 		}
 
@@ -331,9 +463,90 @@ public class OpenSSLDlogECFp extends OpenSSLAdapterDlogEC implements DlogECFp, D
 			exponent = exponent.mod(getOrder());
 		}
 				
-		// Call the native exponentiate function.
-		long result = exponentiateWithPreComputedValues(curve, exponent.toByteArray());
+		// Call the native exponentiate function, with the pre computed values of the generator or with the table of the base.
+		long result;
+		if (groupElement.equals(generator)){
+			result = exponentiateWithPreComputedValues(curve, exponent.toByteArray());
+		} else {
+			FixedBaseTables.Table table = acquireFixedBaseTable((ECFpPointOpenSSL) groupElement);
+			try {
+				result = exponentiateWithTable(curve, table.pointer, exponent.toByteArray());
+			} finally {
+				releaseFixedBaseTable(table);
+			}
+		}
 		// Build a ECFpPointOpenSSL element from the result.
-		return new ECFpPointOpenSSL(curve, result);
+		return track(new ECFpPointOpenSSL(curve, result));
+	}
+
+	@Override
+	public GroupElement[] exponentiateBatch(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be the same");
+		}
+		
+		long[] nativePoints = new long[bases.length];
+		for (int i = 0; i < bases.length; i++){
+			//If the GroupElement doesn't match the DlogGroup, throw exception.
+			if (!(bases[i] instanceof ECFpPointOpenSSL)){
+				throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+			}
+			nativePoints[i] = ((ECFpPointOpenSSL) bases[i]).getPoint();
+		}
+		
+		// Call the native function that computes all the exponentiations, in several native threads.
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		return createPoints(exponentiateBatch(curve, nativePoints, packed.bytes, packed.exponentSize));
+	}
+	
+	@Override
+	public GroupElement[] fixedBaseExponentiateBatch(GroupElement base, BigInteger[] exponents) {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(base instanceof ECFpPointOpenSSL)){
+			throw new IllegalArgumentException("the given base doesn't match the DlogGroup");
+		}
+		
+		//The infinity point has no table.
+		if (base.isInfinity()){
+			GroupElement[] bases = new GroupElement[exponents.length];
+			Arrays.fill(bases, base);
+			return exponentiateBatch(bases, exponents);
+		}
+		
+		//The generator uses the pre computed values of OpenSSL (table 0), and any other base uses its table.
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		if (base.equals(generator)){
+			return createPoints(fixedBaseExponentiateBatch(curve, 0, packed.bytes, packed.exponentSize));
+		}
+		FixedBaseTables.Table table = acquireFixedBaseTable((ECFpPointOpenSSL) base);
+		try {
+			return createPoints(fixedBaseExponentiateBatch(curve, table.pointer, packed.bytes, packed.exponentSize));
+		} finally {
+			releaseFixedBaseTable(table);
+		}
+	}
+	
+	@Override
+	protected long getNativePoint(GroupElement element) throws IllegalArgumentException {
+		//If the GroupElement doesn't match the DlogGroup, throw exception.
+		if (!(element instanceof ECFpPointOpenSSL)){
+			throw new IllegalArgumentException("the given element doesn't match the DlogGroup");
+		}
+		return ((ECFpPointOpenSSL) element).getPoint();
+	}
+	
+	@Override
+	protected GroupElement createPoint(long nativePoint, BigInteger x, BigInteger y) {
+		return track(new ECFpPointOpenSSL(nativePoint, x, y));
+	}
+	
+	/**
+	 * Deletes the native map of the deterministic encoding.
+	 */
+	protected void finalize() throws Throwable {
+		if (createdEncodingMap != 0){
+			deleteEncodingMap(createdEncodingMap);
+		}
+		super.finalize();
 	}
 }
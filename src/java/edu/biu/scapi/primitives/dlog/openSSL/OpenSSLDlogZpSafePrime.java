@@ -27,6 +27,8 @@ package edu.biu.scapi.primitives.dlog.openSSL;
 import java.math.BigInteger;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
+import java.util.ArrayList;
+import java.util.Arrays;
 
 import edu.biu.scapi.primitives.dlog.DlogGroup;
 import edu.biu.scapi.primitives.dlog.DlogGroupAbs;
@@ -62,6 +64,26 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 	private native boolean validateZpGroup(long group);					// Validate the group.
 	private native boolean validateZpGenerator(long group);				// Validate the group's generator.
 	private native boolean validateZpElement(long group, long element);	// Validate the given element.
+	private native boolean[] validateZpElements(long group, long[] elements);// Validate each of the given elements.
+	private native long createFixedBaseTable(long group, long base);	// Precomputes the powers of the given base.
+	private native long exponentiateWithTable(long group, long table, byte[] exponent);// Raise the base of the given table to the exponent.
+	private native void deleteFixedBaseTable(long table);				// Deletes the table.
+	private native long[] exponentiateBatch(long group, long[] elements, byte[] exponents, int exponentSize);// Raise each element to the respective packed exponent.
+	private native long[] fixedBaseExponentiateBatch(long group, long table, byte[] exponents, int exponentSize);// Raise the base of the table to each packed exponent.
+	private native void releaseElements(long group, long[] elements);	// Releases the elements to the pool of the native group.
+
+	// The native tables of the bases that were used in exponentiateWithPreComputedValues, by the values of the bases.
+	private FixedBaseTables<BigInteger, OpenSSLZpSafePrimeElement> fixedBaseTables = new FixedBaseTables<BigInteger, OpenSSLZpSafePrimeElement>(){
+		protected long createTable(OpenSSLZpSafePrimeElement base){
+			return createFixedBaseTable(dlog, base.getNativeElement());
+		}
+		protected void deleteTable(long table){
+			deleteFixedBaseTable(table);
+		}
+	};
+	
+	// The open element scopes of the threads that use the group.
+	private NativeElementScopes scopes = new NativeElementScopes();
 
 	
 	/**
@@ -228,7 +250,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 	 * @return the identity of this Zp group - 1.
 	 */
 	public GroupElement getIdentity() {
-		return new OpenSSLZpSafePrimeElement(BigInteger.ONE, ((ZpGroupParams) groupParams).getP(), false);
+		return track(new OpenSSLZpSafePrimeElement(BigInteger.ONE, ((ZpGroupParams) groupParams).getP(), false));
 	}
 	
 	/**
@@ -239,7 +261,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 	public GroupElement createRandomElement() {
 		//This function overrides the basic implementation of DlogGroupAbs. For the case of Zp Safe Prime this is a more efficient implementation.
 		//It calls the package private constructor of OpenSSLZpSafePrimeElement, which randomly creates an element in Zp.
-		return new OpenSSLZpSafePrimeElement(((ZpGroupParams) groupParams).getP(), random);
+		return track(new OpenSSLZpSafePrimeElement(((ZpGroupParams) groupParams).getP(), random));
 
 	}
 
@@ -259,6 +281,25 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 		return validateZpElement(dlog, ((OpenSSLZpSafePrimeElement) element).getNativeElement());
 
 	}
+	
+	/**
+	 * Checks for each of the given elements if it is member of this Dlog group.<p>
+	 * All the elements are checked in one native call, by several native threads. Since p = 2q+1, each element is checked by
+	 * its Legendre symbol instead of by raising it to q.
+	 * @throws IllegalArgumentException if one of the elements does not match this group.
+	 */
+	@Override
+	public boolean[] areMembers(GroupElement[] elements) {
+		long[] nativeElements = new long[elements.length];
+		for (int i = 0; i < elements.length; i++){
+			if (!(elements[i] instanceof OpenSSLZpSafePrimeElement)) {
+				throw new IllegalArgumentException("element type doesn't match the group type");
+			}
+			nativeElements[i] = ((OpenSSLZpSafePrimeElement) elements[i]).getNativeElement();
+		}
+		
+		return validateZpElements(dlog, nativeElements);
+	}
 
 	/**
 	 * Checks if the given generator is indeed the generator of the group.
@@ -294,7 +335,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 		long invertVal = inverseElement(dlog, ((OpenSSLZpSafePrimeElement) groupElement).getNativeElement());
 		
 		//Build an OpenSSLZpSafePrimeElement element with the result value.
-		OpenSSLZpSafePrimeElement inverseElement = new OpenSSLZpSafePrimeElement(invertVal);
+		OpenSSLZpSafePrimeElement inverseElement = track(new OpenSSLZpSafePrimeElement(invertVal));
 		
 		return inverseElement;
 			
@@ -311,15 +352,161 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 		long exponentiateVal = exponentiateElement(dlog, ((OpenSSLZpSafePrimeElement) base).getNativeElement(), exponent.toByteArray());
 		
 		//Build an OpenSSLZpSafePrimeElement element with the result value.
-		OpenSSLZpSafePrimeElement exponentiateElement = new OpenSSLZpSafePrimeElement(exponentiateVal);
+		OpenSSLZpSafePrimeElement exponentiateElement = track(new OpenSSLZpSafePrimeElement(exponentiateVal));
 		
 		return exponentiateElement;
 			
 	}
 	
+	/**
+	 * Raises the given base to the given exponent using a table of precomputed powers of the base.<p>
+	 * The table is computed in the first call with the base (this costs about as much as 80 exponentiations) and kept until 
+	 * endExponentiateWithPreComputedValues is called with the base. Each exponentiation with the table takes one multiplication for each 
+	 * 5 bits of q and no squarings, which makes it a few times faster than exponentiate. 
+	 * This is useful for the generator and for bases that are used many times, like the public key of ElGamal.
+	 * Like exponentiate, the native exponentiation takes the same multiplications and table reads for every exponent, so the exponent may be secret.
+	 */
+	@Override
 	public GroupElement exponentiateWithPreComputedValues(GroupElement groupElement, BigInteger exponent) {
-		return exponentiate(groupElement, exponent);
+		if (!(groupElement instanceof OpenSSLZpSafePrimeElement)){
+			throw new IllegalArgumentException("element type doesn't match the group type");
+		}
+		
+		//If the exponent is negative, convert it to be the exponent modulus q.
+		if (exponent.compareTo(BigInteger.ZERO) < 0){
+			exponent = exponent.mod(getOrder());
+		}
+		
+		//Call to native exponentiate function. The table is kept while it is used, even if another thread ends it.
+		long exponentiateVal;
+		FixedBaseTables.Table table = acquireFixedBaseTable((OpenSSLZpSafePrimeElement) groupElement);
+		try {
+			exponentiateVal = exponentiateWithTable(dlog, table.pointer, exponent.toByteArray());
+		} finally {
+			fixedBaseTables.release(table);
+		}
+		
+		//Build an OpenSSLZpSafePrimeElement element with the result value.
+		return track(new OpenSSLZpSafePrimeElement(exponentiateVal));
+	}
+	
+	/**
+	 * Returns the native table of the given base, and creates it if this is the first use of the base.
+	 * The table must be released after the native call that uses it.
+	 */
+	private FixedBaseTables.Table acquireFixedBaseTable(OpenSSLZpSafePrimeElement base){
+		return fixedBaseTables.acquire(base.getElementValue(), base);
+	}
+	
+	/**
+	 * Sets the maximal number of bases whose tables are kept (16 by default). Each table of a 2048 bits group takes about 3 MB.
+	 * When another base is used, the table of the least recently used base is deleted, and it is computed again if that base is used later.
+	 * @param maxTables the number of tables, at least 1.
+	 */
+	public void setMaxFixedBaseTables(int maxTables){
+		fixedBaseTables.setMaxTables(maxTables);
+	}
+	
+	/**
+	 * Opens an element scope for the calling thread.<p>
+	 * Until the matching {@link #endElementScope(GroupElement...)}, every element that this group creates for the thread is recorded 
+	 * in the scope. Ending the scope releases the native objects of all of them at once, and the group reuses them for its next results.
+	 * This bounds the native memory of protocols that create many short lived elements in each round, without depending on finalization.<p>
+	 * Scopes can be nested. Elements that are released by the end of their scope must not be used by native operations anymore.
+	 */
+	public void beginElementScope(){
+		scopes.begin();
+	}
+	
+	/**
+	 * Ends the innermost element scope of the calling thread, and releases the native objects of its elements.
+	 * @param keep elements of the scope that are still needed (for example the results of the round). They are not released,
+	 * and they move to the enclosing scope, if there is one.
+	 * @throws IllegalStateException if the calling thread has no open element scope.
+	 */
+	public void endElementScope(GroupElement... keep){
+		ArrayList<GroupElement> released = scopes.end(keep);
+		long[] nativeElements = new long[released.size()];
+		int numElements = 0;
+		for (GroupElement element : released){
+			long nativeElement = ((OpenSSLZpSafePrimeElement) element).detachNativeElement();
+			if (nativeElement != 0){
+				nativeElements[numElements++] = nativeElement;
+			}
+		}
+		releaseElements(dlog, Arrays.copyOf(nativeElements, numElements));
+	}
+	
+	/**
+	 * Records the given element in the open element scope of the calling thread, if there is one.
+	 * @return the given element.
+	 */
+	private OpenSSLZpSafePrimeElement track(OpenSSLZpSafePrimeElement element){
+		return scopes.track(element);
+	}
+	
+	@Override
+	public GroupElement[] exponentiateBatch(GroupElement[] bases, BigInteger[] exponents) throws IllegalArgumentException {
+		if (bases.length != exponents.length){
+			throw new IllegalArgumentException("the number of bases and exponents should be the same");
+		}
+		
+		long[] nativeBases = new long[bases.length];
+		for (int i = 0; i < bases.length; i++){
+			if (!(bases[i] instanceof OpenSSLZpSafePrimeElement)){
+				throw new IllegalArgumentException("element type doesn't match the group type");
+			}
+			nativeBases[i] = ((OpenSSLZpSafePrimeElement) bases[i]).getNativeElement();
+		}
+		
+		//Call to the native function that computes all the exponentiations, in several native threads.
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		return createElements(exponentiateBatch(dlog, nativeBases, packed.bytes, packed.exponentSize));
+	}
+	
+	/**
+	 * Raises the given base to each of the exponents, using the table of precomputed powers of the base 
+	 * (see {@link #exponentiateWithPreComputedValues(GroupElement, BigInteger)}) and several native threads.
+	 */
+	@Override
+	public GroupElement[] fixedBaseExponentiateBatch(GroupElement base, BigInteger[] exponents) {
+		if (!(base instanceof OpenSSLZpSafePrimeElement)){
+			throw new IllegalArgumentException("element type doesn't match the group type");
+		}
+		
+		PackedExponents packed = new PackedExponents(exponents, getOrder());
+		FixedBaseTables.Table table = acquireFixedBaseTable((OpenSSLZpSafePrimeElement) base);
+		try {
+			return createElements(fixedBaseExponentiateBatch(dlog, table.pointer, packed.bytes, packed.exponentSize));
+		} finally {
+			fixedBaseTables.release(table);
+		}
+	}
 	
+	/**
+	 * Builds the elements of the given native results.
+	 */
+	private GroupElement[] createElements(long[] nativeElements){
+		if (nativeElements == null){
+			throw new IllegalStateException("the native exponentiations failed");
+		}
+		GroupElement[] elements = new GroupElement[nativeElements.length];
+		for (int i = 0; i < nativeElements.length; i++){
+			elements[i] = track(new OpenSSLZpSafePrimeElement(nativeElements[i]));
+		}
+		return elements;
+	}
+	
+	/**
+	 * Deletes the table of precomputed powers of the given base.
+	 * Exponentiations that other threads are doing with the table finish first, since the last of them deletes it.
+	 */
+	@Override
+	public void endExponentiateWithPreComputedValues(GroupElement base) {
+		if (!(base instanceof OpenSSLZpSafePrimeElement)){
+			return;
+		}
+		fixedBaseTables.remove(((OpenSSLZpSafePrimeElement) base).getElementValue());
 	}
 
 	@Override
@@ -334,7 +521,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 									  ((OpenSSLZpSafePrimeElement) groupElement2).getNativeElement());
 
 		// Build an OpenSSLZpSafePrimeElement element with the result value.
-		OpenSSLZpSafePrimeElement mulElement = new OpenSSLZpSafePrimeElement(mulVal);
+		OpenSSLZpSafePrimeElement mulElement = track(new OpenSSLZpSafePrimeElement(mulVal));
 		
 		return mulElement;
 			
@@ -366,7 +553,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 	*/
 	@Deprecated public ZpElement generateElement(Boolean bCheckMembership, BigInteger x) {
 
-		return new OpenSSLZpSafePrimeElement(x, ((ZpGroupParams) groupParams).getP(), bCheckMembership);
+		return track(new OpenSSLZpSafePrimeElement(x, ((ZpGroupParams) groupParams).getP(), bCheckMembership));
 	}
 	
 	
@@ -376,7 +563,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 			throw new IllegalArgumentException("To generate an ZpElement you should pass the x value of the point");
 		}
 				
-		return new OpenSSLZpSafePrimeElement(values[0], ((ZpGroupParams) groupParams).getP(), bCheckMembership);
+		return track(new OpenSSLZpSafePrimeElement(values[0], ((ZpGroupParams) groupParams).getP(), bCheckMembership));
 		
 	}
 	
@@ -407,6 +594,9 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 	 */
 	protected void finalize() throws Throwable {
 
+		// Delete the tables of the precomputed powers.
+		fixedBaseTables.removeAll();
+		
 		// Delete from the dll the dynamic allocation of the Integer.
 		deleteDlogZp(dlog);
 
@@ -441,7 +631,7 @@ public class OpenSSLDlogZpSafePrime extends DlogGroupAbs implements DlogZpSafePr
 		BigInteger s = new BigInteger(newString);
 		BigInteger y = (s.add(BigInteger.ONE)).pow(2).mod(((ZpGroupParams) groupParams).getP());
 		//There is no need to check membership since the "element" was generated so that it is always an element.
-		OpenSSLZpSafePrimeElement element = new OpenSSLZpSafePrimeElement(y, ((ZpGroupParams) groupParams).getP(), false);
+		OpenSSLZpSafePrimeElement element = track(new OpenSSLZpSafePrimeElement(y, ((ZpGroupParams) groupParams).getP(), false));
 		return element;
 	}
 	
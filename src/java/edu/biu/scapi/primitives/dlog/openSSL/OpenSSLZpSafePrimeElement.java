@@ -122,14 +122,27 @@ public class OpenSSLZpSafePrimeElement implements ZpSafePrimeElement{
 	 * @return
 	 */
 	long getNativeElement() {
+		if (zpElement == 0){
+			throw new IllegalStateException("the element was released by the end of its element scope");
+		}
 		return zpElement;
 	}
+	
+	/*
+	 * Detaches the native element from this object, so that the group can release it.
+	 * @return the pointer to the native element, or 0 if it was already detached.
+	 */
+	long detachNativeElement() {
+		long detached = zpElement;
+		zpElement = 0;
+		return detached;
+	}
 
 	/**
 	 * @return BigInteger - value of the element
 	 */
 	public BigInteger getElementValue() {
-		return new BigInteger(1, getElement(zpElement));
+		return new BigInteger(1, getElement(getNativeElement()));
 	}
 	
 	/**
@@ -173,8 +186,10 @@ public class OpenSSLZpSafePrimeElement implements ZpSafePrimeElement{
 	 */
 	protected void finalize() throws Throwable {
 
-		// Delete from the dll the dynamic allocation of the Integer.
-		deleteElement(zpElement);
+		// Delete from the dll the dynamic allocation of the Integer, unless it was released by an element scope.
+		if (zpElement != 0){
+			deleteElement(zpElement);
+		}
 
 		super.finalize();
 	}
@@ -0,0 +1,63 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.dlog.openSSL;
+
+import java.math.BigInteger;
+
+/**
+ * The exponents of a batch exponentiation, packed in one array so that they are passed to the native code in a single JNI call.<p>
+ * Each exponent takes exponentSize bytes in big endian. Negative exponents are reduced modulo the order of the group.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+class PackedExponents {
+	
+	final byte[] bytes;			//The packed exponents.
+	final int exponentSize;		//The size of each exponent in bytes.
+	
+	/**
+	 * Packs the given exponents.
+	 * @param exponents the exponents to pack.
+	 * @param order the order of the group.
+	 */
+	PackedExponents(BigInteger[] exponents, BigInteger order){
+		BigInteger[] values = new BigInteger[exponents.length];
+		int maxBits = 1;
+		for (int i = 0; i < exponents.length; i++){
+			values[i] = (exponents[i].signum() < 0) ? exponents[i].mod(order) : exponents[i];
+			maxBits = Math.max(maxBits, values[i].bitLength());
+		}
+		
+		exponentSize = (maxBits + 7) / 8;
+		bytes = new byte[exponents.length * exponentSize];
+		for (int i = 0; i < values.length; i++){
+			//toByteArray may add a leading zero byte for the sign, which is not copied.
+			byte[] value = values[i].toByteArray();
+			int length = Math.min(value.length, exponentSize);
+			System.arraycopy(value, value.length - length, bytes, (i + 1) * exponentSize - length, length);
+		}
+	}
+}
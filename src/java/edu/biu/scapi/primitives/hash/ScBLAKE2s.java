@@ -0,0 +1,189 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+
+package edu.biu.scapi.primitives.hash;
+
+import java.io.ByteArrayOutputStream;
+
+/** 
+ * Concrete class of cryptographicHash for BLAKE2s (RFC 7693) with an output of 32 bytes and no key. <p>
+ * None of the underlying libraries of SCAPI provides BLAKE2s, so this class implements it directly in java.
+ * The MaliciousYao protocol can use it for the commitments on the keys, which are then verified by a native implementation.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public final class ScBLAKE2s implements BLAKE2s {
+	
+	private static final int DIGEST_SIZE = 32;
+	private static final int BLOCK_SIZE = 64;
+	
+	private static final int[] IV = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+	};
+	
+	private static final byte[][] SIGMA = {
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+		{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+		{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+		{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+		{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+		{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+		{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+		{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+		{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+		{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 }
+	};
+	
+	//The message is kept until hashFinal is called, since the last block is compressed differently than the others.
+	private ByteArrayOutputStream message = new ByteArrayOutputStream();
+	
+	private final int[] m = new int[16];
+	private final int[] v = new int[16];
+	
+	/**
+	 * @return the algorithm name - BLAKE2s.
+	 */
+	public String getAlgorithmName() {
+		return "BLAKE2s";
+	}
+
+	/**
+	 * @return the size of the hashed massage in bytes - 32.
+	 */
+	public int getHashedMsgSize() {
+		return DIGEST_SIZE;
+	}
+
+	/**
+	 * Adds the byte array to the existing message to hash. 
+	 * @param in input byte array.
+	 * @param inOffset the offset within the byte array.
+	 * @param inLen the length. The number of bytes to take after the offset.
+	 * */
+	public void update(byte[] in, int inOffset, int inLen) {
+		
+		//Check that the offset and length are correct.
+		if ((inOffset > in.length) || (inOffset+inLen > in.length) || (inOffset<0)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		
+		if (inLen < 0){
+			throw new NegativeArraySizeException("wrong length for the given input buffer");
+		}
+		
+		if (inLen == 0){
+			throw new ArrayIndexOutOfBoundsException("wrong length for the given input buffer");
+		}
+		
+		message.write(in, inOffset, inLen);
+	}
+
+	/** 
+	 * Completes the hash computation and puts the result in the out array.
+	 * @param out the output in byte array.
+	 * @param outOffset the offset which to put the result bytes from.
+	 */
+	public void hashFinal(byte[] out, int outOffset) {
+		
+		//Check that the offset and length are correct.
+		if ((outOffset > out.length) || (outOffset+DIGEST_SIZE > out.length) || (outOffset<0)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		byte[] msg = message.toByteArray();
+		message.reset();
+		
+		int[] h = IV.clone();
+		//Parameter block: digest length, no key, fanout = depth = 1.
+		h[0] ^= 0x01010000 ^ DIGEST_SIZE;
+		
+		//All blocks but the last one, which can be partial (or empty if the message is empty).
+		int offset = 0;
+		while (msg.length - offset > BLOCK_SIZE){
+			compress(h, msg, offset, offset + BLOCK_SIZE, false);
+			offset += BLOCK_SIZE;
+		}
+		byte[] last = new byte[BLOCK_SIZE];
+		System.arraycopy(msg, offset, last, 0, msg.length - offset);
+		compress(h, last, 0, msg.length, true);
+		
+		for (int i = 0; i < 8; i++){
+			out[outOffset + 4*i] = (byte) h[i];
+			out[outOffset + 4*i + 1] = (byte) (h[i] >>> 8);
+			out[outOffset + 4*i + 2] = (byte) (h[i] >>> 16);
+			out[outOffset + 4*i + 3] = (byte) (h[i] >>> 24);
+		}
+	}
+	
+	/**
+	 * Compresses the block that starts at the given offset into h. 
+	 * @param counter The number of bytes hashed up to the end of this block.
+	 * @param last Indicates whether this is the last block.
+	 */
+	private void compress(int[] h, byte[] block, int offset, long counter, boolean last) {
+		for (int i = 0; i < 16; i++){
+			int pos = offset + 4*i;
+			m[i] = (block[pos] & 0xff) | ((block[pos + 1] & 0xff) << 8) | ((block[pos + 2] & 0xff) << 16) | ((block[pos + 3] & 0xff) << 24);
+		}
+		for (int i = 0; i < 8; i++){
+			v[i] = h[i];
+			v[i + 8] = IV[i];
+		}
+		v[12] ^= (int) counter;
+		v[13] ^= (int) (counter >>> 32);
+		if (last){
+			v[14] = ~v[14];
+		}
+		
+		for (int r = 0; r < 10; r++){
+			byte[] s = SIGMA[r];
+			g(0, 4, 8, 12, m[s[0]], m[s[1]]);
+			g(1, 5, 9, 13, m[s[2]], m[s[3]]);
+			g(2, 6, 10, 14, m[s[4]], m[s[5]]);
+			g(3, 7, 11, 15, m[s[6]], m[s[7]]);
+			g(0, 5, 10, 15, m[s[8]], m[s[9]]);
+			g(1, 6, 11, 12, m[s[10]], m[s[11]]);
+			g(2, 7, 8, 13, m[s[12]], m[s[13]]);
+			g(3, 4, 9, 14, m[s[14]], m[s[15]]);
+		}
+		
+		for (int i = 0; i < 8; i++){
+			h[i] ^= v[i] ^ v[i + 8];
+		}
+	}
+	
+	private void g(int a, int b, int c, int d, int x, int y) {
+		v[a] = v[a] + v[b] + x;
+		v[d] = Integer.rotateRight(v[d] ^ v[a], 16);
+		v[c] = v[c] + v[d];
+		v[b] = Integer.rotateRight(v[b] ^ v[c], 12);
+		v[a] = v[a] + v[b] + y;
+		v[d] = Integer.rotateRight(v[d] ^ v[a], 8);
+		v[c] = v[c] + v[d];
+		v[b] = Integer.rotateRight(v[b] ^ v[c], 7);
+	}
+}
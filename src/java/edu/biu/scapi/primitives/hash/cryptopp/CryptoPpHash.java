@@ -65,6 +65,9 @@ public abstract class CryptoPpHash implements CryptographicHash {
 	//deletes the created pointer.
 	private native void deleteHash(long ptr);
 	
+	//hashes each of the given messages of the buffer and puts the digests one after the other in the output. returns false if the hashing failed
+	private native boolean hashMany(long ptr, byte[] buffer, int[] offsets, int[] lengths, byte[] out);
+	
 	private int hashSize;
 	
 	
@@ -164,6 +167,37 @@ public abstract class CryptoPpHash implements CryptographicHash {
 		return hashSize;
 	}
 	
+	/**
+	 * Computes the hashes of many independent messages in one native call. <p>
+	 * Message i is the lengths[i] bytes of the buffer that start at offsets[i], and its digest is put in the out array at offset i * getHashedMsgSize().
+	 * The message that was given to this hash by update is not affected.
+	 * @param buffer the array that contains the messages
+	 * @param offsets the offset of each message in the buffer
+	 * @param lengths the length of each message
+	 * @param out the output array. Should have room for the digests of all the messages
+	 * @throws IllegalStateException if the native hashing failed. Then the content of the output is not defined
+	 */
+	public void hashMany(byte[] buffer, int[] offsets, int[] lengths, byte[] out){
+		
+		//checks that the messages and the output are inside the given arrays
+		if (offsets.length != lengths.length){
+			throw new IllegalArgumentException("there should be one length for each offset");
+		}
+		for (int i = 0; i < offsets.length; i++){
+			if ((offsets[i] < 0) || (lengths[i] < 0) || (offsets[i] > buffer.length - lengths[i])){
+				throw new ArrayIndexOutOfBoundsException("wrong offset or length of message " + i + " for the given input buffer");
+			}
+		}
+		if ((long) offsets.length * hashSize > out.length){
+			throw new ArrayIndexOutOfBoundsException("the output buffer is too small for the digests of all the messages");
+		}
+		
+		//calls the native function
+		if (!hashMany(collHashPtr, buffer, offsets, lengths, out)){
+			throw new IllegalStateException("the native hashing failed");
+		}
+	}
+	
 	
 	/**
 	 * Deletes the related collision resistant hash object
@@ -52,11 +52,11 @@ public class OpenSSLHash implements CryptographicHash {
 	//Returns the OpenSSL's name of the hash.
 	private native String algName(long ptr);
 	
-	//Updates the message to the hash.
-	private native void updateHash(long ptr, byte[] input, long len);
+	//Updates the hash with len bytes of the input, from the given offset.
+	private native void updateHash(long ptr, byte[] input, int offset, int len);
 	
-	//Finishes the hash computation.
-	private native void finalHash(long ptr, byte[] output);
+	//Finishes the hash computation and puts the result in the output, from the given offset.
+	private native void finalHash(long ptr, byte[] output, int offset);
 	
 	//Returns the size of the hashed msg.
 	private native int getDigestSize(long ptr);
@@ -64,6 +64,9 @@ public class OpenSSLHash implements CryptographicHash {
 	//Deletes the created pointer.
 	private native void deleteHash(long ptr);
 	
+	//Hashes each of the given messages of the buffer and puts the digests one after the other in the output. Returns false if the hashing failed.
+	private native boolean hashMany(long ptr, byte[] buffer, int[] offsets, int[] lengths, byte[] out);
+	
 	private int hashSize;
 	
 	/**
@@ -108,18 +111,8 @@ public class OpenSSLHash implements CryptographicHash {
 			throw new ArrayIndexOutOfBoundsException("wrong length for the given input buffer");
 		}
 		
-		//The dll function does the update from offset 0.
-		//If the given offset is greater than 0, copy the relevant bytes to a new array and send it to the dll function.
-		if (inOffset>0){
-			byte[] input = new byte[inLen];
-			System.arraycopy(in, inOffset, input, 0, inLen);
-			//Call the native function
-			updateHash(hash, input, inLen);
-		}else {
-		
-			//If the offset is 0 - calls the native function with the given array.
-			updateHash(hash, in, inLen);
-		}
+		//Call the native function. It reads the bytes directly from the given array, so there is no need to copy them.
+		updateHash(hash, in, inOffset, inLen);
 	}
 
 	/** 
@@ -134,21 +127,8 @@ public class OpenSSLHash implements CryptographicHash {
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
-		//If the offset is greater than 0 - puts the result in a new array and copies it to the out array starting at the outOffset.
-		if (outOffset>0){
-			int length = getDigestSize(hash);
-			byte[] tempOut = new byte[length];
-			//Call the native function finalHash with the temp array.
-			finalHash(hash, tempOut);
-			//Copy the hash result to the out array in the right place.
-			System.arraycopy(tempOut, 0, out, outOffset, length);
-			
-		}else{
-			//Call the native function final. 
-			finalHash(hash, out);
-		}
-		
-
+		//Call the native function final. It puts the result in the out array starting at the outOffset.
+		finalHash(hash, out, outOffset);
 	}
 
 	/** 
@@ -160,6 +140,37 @@ public class OpenSSLHash implements CryptographicHash {
 		return hashSize;
 	}
 	
+	/**
+	 * Computes the hashes of many independent messages in one native call. Large batches are split between native threads.<p>
+	 * Message i is the lengths[i] bytes of the buffer that start at offsets[i], and its digest is put in the out array at offset i * getHashedMsgSize().
+	 * The message that was given to this hash by update is not affected.
+	 * @param buffer the array that contains the messages.
+	 * @param offsets the offset of each message in the buffer.
+	 * @param lengths the length of each message.
+	 * @param out the output array. Should have room for the digests of all the messages.
+	 * @throws IllegalStateException if the native hashing failed. Then the content of the output is not defined.
+	 */
+	public void hashMany(byte[] buffer, int[] offsets, int[] lengths, byte[] out){
+		
+		//Check that the messages and the output are inside the given arrays.
+		if (offsets.length != lengths.length){
+			throw new IllegalArgumentException("there should be one length for each offset");
+		}
+		for (int i = 0; i < offsets.length; i++){
+			if ((offsets[i] < 0) || (lengths[i] < 0) || (offsets[i] > buffer.length - lengths[i])){
+				throw new ArrayIndexOutOfBoundsException("wrong offset or length of message " + i + " for the given input buffer");
+			}
+		}
+		if ((long) offsets.length * hashSize > out.length){
+			throw new ArrayIndexOutOfBoundsException("the output buffer is too small for the digests of all the messages");
+		}
+		
+		//Call the native function. It reads the messages and writes the digests directly, so there is no need to copy them.
+		if (!hashMany(hash, buffer, offsets, lengths, out)){
+			throw new IllegalStateException("the native hashing failed");
+		}
+	}
+	
 	
 	/**
 	 * Deletes the related Cryptographic Hash object.
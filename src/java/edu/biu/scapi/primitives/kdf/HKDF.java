@@ -38,6 +38,7 @@ import org.bouncycastle.util.encoders.Hex;
 import edu.biu.scapi.exceptions.FactoriesException;
 import edu.biu.scapi.generals.Logging;
 import edu.biu.scapi.primitives.prf.Hmac;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLHMAC;
 import edu.biu.scapi.tools.Factories.PrfFactory;
 
 
@@ -250,6 +251,12 @@ public final class HKDF implements KeyDerivationFunction {
 				Logging.getLogger().log(Level.WARNING, e.toString());
 			}
 			
+			//the OpenSSL hmac computes all the rounds below in one native call
+			if (hmac instanceof OpenSSLHMAC){
+				((OpenSSLHMAC) hmac).expand(iv, outBytes, 0, outLen);
+				return new SecretKeySpec(outBytes, "HKDF");
+			}
+			
 			//calculates the first round
 			//K(1) = HMAC(PRK,(CTXinfo,1)) [key=PRK, data=(CTXinfo,1)]
 			if (outLen < hmacLength){
@@ -0,0 +1,165 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+package edu.biu.scapi.primitives.kdf.openSSL;
+
+import javax.crypto.SecretKey;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.bouncycastle.util.encoders.Hex;
+
+import edu.biu.scapi.primitives.hash.CryptographicHash;
+import edu.biu.scapi.primitives.kdf.KeyDerivationFunction;
+
+/** 
+ * Concrete class of key derivation function for HKDF. This class wraps the implementation of OpenSSL library. <p>
+ * Each key is derived in one native call that does both the extract and the expand steps, instead of a call to the underlying hmac 
+ * for each block of the key. Many keys can also be derived together from many salts, by the native threads.<p>
+ * 
+ * deriveKey uses the same fixed salt as {@link edu.biu.scapi.primitives.kdf.HKDF}, so both classes derive the same keys when they use the same hash.
+ * The native functions do not keep any state, so this class is thread safe without synchronization.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public final class OpenSSLHKDF implements KeyDerivationFunction {
+	
+	//The fixed key of the extract step, as in HKDF.
+	private static final byte[] FIXED_SALT = Hex.decode("606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9fa0a1a2a3a4a5a6a7a8a9aaabacadaeaf");
+	
+	private long md;			//Pointer to the native hash. OpenSSL's hashes are static, so it is not deleted.
+	private int hashSize;		//The output size of the hash.
+	
+	//Native functions that implement HKDF using OpenSSL functions.
+	private native long getDigest(String hashName);		//Returns the native hash with the given name, or 0 if there is no such hash.
+	private native int getDigestSize(long md);			//Returns the output size of the hash.
+	private native byte[] deriveNative(long md, byte[] salt, byte[] source, int inOff, int inLen, byte[] info, int outLen);
+	private native byte[] deriveManyNative(long md, byte[][] salts, byte[] source, int inOff, int inLen, byte[] info, int outLen);
+	
+	/**
+	 * Default constructor that uses SHA-1, as the default of OpenSSLHMAC.
+	 */
+	public OpenSSLHKDF(){
+		this("SHA-1");
+	}
+	
+	/**
+	 * Constructor that gets the name of the underlying hash. It can be called from the factory.
+	 * @param hashName the name of the hash, for example SHA-256.
+	 * @throws IllegalArgumentException if OpenSSL does not have a hash with the given name.
+	 */
+	public OpenSSLHKDF(String hashName){
+		//OpenSSL calls the hashes without the hyphen. For example: we call "SHA-1" while OpenSSL calls it "SHA1".
+		md = getDigest(hashName.replace("-", ""));
+		if (md == 0){
+			throw new IllegalArgumentException("OpenSSL does not support the hash " + hashName);
+		}
+		hashSize = getDigestSize(md);
+	}
+	
+	/**
+	 * Constructor that gets a SCAPI CryptographicHash and uses the OpenSSL's hash with the same name.
+	 * @param hash the underlying hash.
+	 * @throws IllegalArgumentException if OpenSSL does not have a hash with the name of the given hash.
+	 */
+	public OpenSSLHKDF(CryptographicHash hash){
+		this(hash.getAlgorithmName());
+	}
+	
+	public SecretKey deriveKey(byte[] entropySource, int inOff, int inLen, int outLen) {
+		//there is no auxiliary information, sends an empty iv.
+		return deriveKey(entropySource, inOff, inLen, outLen, null);
+	}
+	
+	/**
+	 * Derives a new key from the source key material:
+	 * PRK = HMAC(XTS, SKM), and the key is the first outLen bytes of K(1),...,K(t), where K(i) = HMAC(PRK,(K(i-1),CTXinfo,i)).
+	 * @param iv CTXinfo. May be null.
+	 * @throws IllegalStateException if the native derivation failed.
+	 */
+	public SecretKey deriveKey(byte[] entropySource, int inOff, int inLen, int outLen, byte[] iv) {
+		checkArguments(entropySource, inOff, inLen, outLen);
+		
+		byte[] key = deriveNative(md, FIXED_SALT, entropySource, inOff, inLen, (iv == null) ? new byte[0] : iv, outLen);
+		if (key == null){
+			throw new IllegalStateException("the native key derivation failed");
+		}
+		return new SecretKeySpec(key, "HKDF");
+	}
+	
+	/**
+	 * Derives a key for each of the given salts from the same source key material, in one native call.
+	 * Key j is the HKDF of the source with salts[j] as the key of the extract step: PRK(j) = HMAC(salts[j], SKM).
+	 * The keys are split between the native threads.
+	 * @param entropySource the source key material.
+	 * @param inOff the offset within the entropySource to take the bytes from.
+	 * @param inLen the length of the source key material.
+	 * @param salts the keys of the extract step. A null salt is an empty salt.
+	 * @param outLen the required length of each key.
+	 * @param iv CTXinfo. May be null.
+	 * @return the derived keys, in the order of the salts.
+	 * @throws IllegalArgumentException if all the keys together are longer than the maximal array size.
+	 * @throws IllegalStateException if the native derivation failed.
+	 */
+	public SecretKey[] deriveKeys(byte[] entropySource, int inOff, int inLen, byte[][] salts, int outLen, byte[] iv) {
+		checkArguments(entropySource, inOff, inLen, outLen);
+		//The native function returns all the keys in one array.
+		if ((long) salts.length * outLen > Integer.MAX_VALUE){
+			throw new IllegalArgumentException("the keys of " + salts.length + " salts are too long for one call");
+		}
+		
+		byte[][] nativeSalts = new byte[salts.length][];
+		for (int i = 0; i < salts.length; i++){
+			nativeSalts[i] = (salts[i] == null) ? new byte[0] : salts[i];
+		}
+		
+		//The native function returns all the keys one after the other.
+		byte[] keys = deriveManyNative(md, nativeSalts, entropySource, inOff, inLen, (iv == null) ? new byte[0] : iv, outLen);
+		if (keys == null){
+			throw new IllegalStateException("the native key derivation failed");
+		}
+		SecretKey[] result = new SecretKey[salts.length];
+		for (int i = 0; i < salts.length; i++){
+			byte[] key = new byte[outLen];
+			System.arraycopy(keys, i * outLen, key, 0, outLen);
+			result[i] = new SecretKeySpec(key, "HKDF");
+		}
+		return result;
+	}
+	
+	private void checkArguments(byte[] entropySource, int inOff, int inLen, int outLen){
+		//checks that the offset and length are correct
+		if ((inOff < 0) || (inLen < 0) || (inOff > entropySource.length - inLen)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		//HKDF can derive up to 255 blocks of the hash.
+		if ((outLen <= 0) || (outLen > 255 * hashSize)){
+			throw new IllegalArgumentException("the output length should be between 1 and " + 255 * hashSize + " bytes");
+		}
+	}
+	
+	static {
+		//loads the OpenSSL dll.
+		System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
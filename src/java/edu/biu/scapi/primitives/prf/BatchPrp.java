@@ -0,0 +1,80 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prf;
+
+import java.nio.ByteBuffer;
+
+/** 
+ * General interface for pseudorandom permutations with fixed lengths that can compute and invert many consecutive blocks in one call. <p>
+ * The native implementations process all the blocks in a single pass over the pinned memory (ECB over the whole range), 
+ * so that the underlying library can pipeline the blocks, and they do not allocate memory per call. <p>
+ * The direct buffers are used from their current position and their position is not changed.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public interface BatchPrp extends PrpFixed {
+	
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to compute.
+	 * @throws ArrayIndexOutOfBoundsException if one of the arrays does not contain numBlocks blocks from the given offset.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks);
+	
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to invert.
+	 * @throws ArrayIndexOutOfBoundsException if one of the arrays does not contain numBlocks blocks from the given offset.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks);
+	
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to compute.
+	 * @throws IllegalArgumentException if one of the buffers is not direct.
+	 */
+	public void computeBlocks(ByteBuffer in, ByteBuffer out, int numBlocks);
+	
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to invert.
+	 * @throws IllegalArgumentException if one of the buffers is not direct.
+	 */
+	public void invertBlocks(ByteBuffer in, ByteBuffer out, int numBlocks);
+}
@@ -0,0 +1,78 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prf;
+
+import java.nio.ByteBuffer;
+
+/** 
+ * Checks of the arguments of the batch functions of {@link BatchPrp}, which are shared by the native implementations. <p>
+ * The native code reads and writes the given memory without any check, so the checks must be done before the native call.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ */
+public final class BatchPrpChecks {
+	
+	private BatchPrpChecks(){
+	}
+	
+	/**
+	 * Checks that the key of the given prp is set and that both arrays contain numBlocks blocks from the given offsets.
+	 * @throws IllegalStateException if the key is not set.
+	 * @throws ArrayIndexOutOfBoundsException if one of the arrays does not contain numBlocks blocks from the given offset.
+	 */
+	public static void checkArrays(BatchPrp prp, byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		if (!prp.isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		//The length is computed in long so a large number of blocks can not wrap around and pass the checks.
+		long len = (long) numBlocks * prp.getBlockSize();
+		if ((numBlocks < 0) || (inOff < 0) || (inOff > inBytes.length - len)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
+		}
+		if ((outOff < 0) || (outOff > outBytes.length - len)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+	}
+	
+	/**
+	 * Checks that the key of the given prp is set and that the given buffer is direct and has room for numBlocks blocks from its position.
+	 * @throws IllegalStateException if the key is not set.
+	 * @throws IllegalArgumentException if the buffer is not direct.
+	 * @throws IndexOutOfBoundsException if the buffer does not have room for numBlocks blocks.
+	 */
+	public static void checkBuffer(BatchPrp prp, ByteBuffer buffer, int numBlocks){
+		if (!prp.isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (!buffer.isDirect()){
+			throw new IllegalArgumentException("the native code can only use direct buffers");
+		}
+		if ((numBlocks < 0) || ((long) numBlocks * prp.getBlockSize() > buffer.remaining())){
+			throw new IndexOutOfBoundsException("the buffer does not have room for " + numBlocks + " blocks");
+		}
+	}
+}
@@ -26,6 +26,7 @@
 
 package edu.biu.scapi.primitives.prf.cryptopp;
 
+import java.nio.ByteBuffer;
 import java.security.InvalidKeyException;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
@@ -37,6 +38,8 @@ import javax.crypto.KeyGenerator;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.BatchPrp;
+import edu.biu.scapi.primitives.prf.BatchPrpChecks;
 
 /**
  * Concrete class of prf family for AES. This class wraps the implementation of Crypto++.
@@ -44,7 +47,7 @@ import edu.biu.scapi.primitives.prf.AES;
  * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University (Moriya Farbstein)
  *
  */
-public class CryptoPpAES implements AES{
+public class CryptoPpAES implements AES, BatchPrp{
 
 	private boolean isKeySet;
 	private long aesCompute;		//native object used for compute blocks
@@ -55,8 +58,8 @@ public class CryptoPpAES implements AES{
 	private native long createAESCompute();
 	private native long createAESInvert();
 	private native void setNativeKey(long aesCompute, long aesInvert, byte[] key);
-	private native void computeBlock(long aesCompute, byte[] in, byte[] out, int outOffset, boolean forEncrypt);
-	private native void optimizedCompute(long aesCompute, byte[] in, byte[] out, boolean forEncrypt);
+	private native void processBlocks(long aes, byte[] in, int inOffset, byte[] out, int outOffset, int numBlocks, boolean forEncrypt);
+	private native void processBuffer(long aes, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int numBlocks, boolean forEncrypt);
 	private native String getName(long aes);
 	private native int getBlockSize(long aes);
 	private native void deleteAES(long aesCompute, long aesInvert);
@@ -181,23 +184,15 @@ public class CryptoPpAES implements AES{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offset and length are correct.
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
-		// The native AES object needs the message to begin at offset 0.
-		// If the given offset is not 0 copy the msg to a new array. 
-		byte[] newIn = inBytes;
-		if (inOff > 0){
-			newIn = new byte[inBytes.length];
-			System.arraycopy(inBytes, inOff, newIn, 0, inBytes.length);
-		}
-		
-		//Call the native code to perform computeBlock
-		computeBlock(aesCompute, newIn, outBytes, outOff, true);
+		//Call the native code to perform computeBlock. The native code reads the block from the given offset.
+		processBlocks(aesCompute, inBytes, inOff, outBytes, outOff, 1, true);
 	}
 	
 	/** 
@@ -223,7 +218,7 @@ public class CryptoPpAES implements AES{
 			throw new IllegalArgumentException("outBytes and inBytes must be in the same size");
 		}
 			
-		optimizedCompute(aesCompute, inBytes, outBytes, true);
+		processBlocks(aesCompute, inBytes, 0, outBytes, 0, inBytes.length / getBlockSize(), true);
 	}
 
 	/** 
@@ -292,23 +287,15 @@ public class CryptoPpAES implements AES{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offsets are correct 
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
-		// The native AES object needs the message to begin at offset 0.
-		// If the given offset is not 0 copy the msg to a new array. 
-		byte[] newIn = inBytes;
-		if (inOff > 0){
-			newIn = new byte[inBytes.length];
-			System.arraycopy(inBytes, inOff, newIn, 0, inBytes.length);
-		}
-		
-		//Call the native code to perform invert
-		computeBlock(aesInvert, newIn, outBytes, outOff, false);	
+		//Call the native code to perform invert. The native code reads the block from the given offset.
+		processBlocks(aesInvert, inBytes, inOff, outBytes, outOff, 1, false);	
 	}
 	
 	/**
@@ -336,9 +323,59 @@ public class CryptoPpAES implements AES{
 		}
 		
 		//Call the native code to perform invert
-		optimizedCompute(aesInvert, inBytes, outBytes, false);	
+		processBlocks(aesInvert, inBytes, 0, outBytes, 0, inBytes.length / getBlockSize(), false);	
 	}
-
+	
+	/**
+	 * Computes the AES permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(aesCompute, inBytes, inOff, outBytes, outOff, numBlocks, true);
+	}
+	
+	/**
+	 * Inverts the AES permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(aesInvert, inBytes, inOff, outBytes, outOff, numBlocks, false);
+	}
+	
+	/**
+	 * Computes the AES permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(aesCompute, in, in.position(), out, out.position(), numBlocks, true);
+	}
+	
+	/**
+	 * Inverts the AES permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(aesInvert, in, in.position(), out, out.position(), numBlocks, false);
+	}
+	
 	/**
 	 * This function is provided in the interface especially for the sub-family PrpVarying, which may have variable input/output lengths.
 	 * Since in this case, both input and output variables are fixed this function should not normally be called. 
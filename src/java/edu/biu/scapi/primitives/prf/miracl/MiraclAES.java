@@ -24,6 +24,7 @@
 */
 package edu.biu.scapi.primitives.prf.miracl;
 
+import java.nio.ByteBuffer;
 import java.security.InvalidKeyException;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
@@ -35,18 +36,18 @@ import javax.crypto.KeyGenerator;
 import javax.crypto.SecretKey;
 
 import edu.biu.scapi.primitives.prf.AES;
+import edu.biu.scapi.primitives.prf.BatchPrp;
+import edu.biu.scapi.primitives.prf.BatchPrpChecks;
 
-public class MiraclAES implements AES{
+public class MiraclAES implements AES, BatchPrp{
 
 	private boolean isKeySet;
 	private long aes;				//native object used for compute AES permutation
 	private SecureRandom random;
 	
 	private native long createAES(byte[] key);
-	private native void computeBlock(long aes, byte[] in, int inOffset, byte[] out, int outOffset);
-	private native void invertBlock(long aes, byte[] in, int inOffset, byte[] out, int outOffset);
-	private native void optimizedCompute(long aes, byte[] in, byte[] out);
-	private native void optimizedInvert(long aes, byte[] in, byte[] out);
+	private native void processBlocks(long aes, byte[] in, int inOffset, byte[] out, int outOffset, int numBlocks, boolean forEncrypt);
+	private native void processBuffer(long aes, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int numBlocks, boolean forEncrypt);
 	private native void deleteAES(long aes);
 	
 	/**
@@ -163,15 +164,15 @@ public class MiraclAES implements AES{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offset and length are correct.
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
 		//Call the native code to perform computeBlock
-		computeBlock(aes, inBytes, inOff, outBytes, outOff);
+		processBlocks(aes, inBytes, inOff, outBytes, outOff, 1, true);
 	}
 	
 	/** 
@@ -197,7 +198,7 @@ public class MiraclAES implements AES{
 			throw new IllegalArgumentException("outBytes and inBytes must be in the same size");
 		}
 			
-		optimizedCompute(aes, inBytes, outBytes);
+		processBlocks(aes, inBytes, 0, outBytes, 0, inBytes.length / getBlockSize(), true);
 	}
 
 	/** 
@@ -266,15 +267,15 @@ public class MiraclAES implements AES{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offsets are correct 
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
 		//Call the native code to perform invert
-		invertBlock(aes, inBytes, inOff, outBytes, outOff);	
+		processBlocks(aes, inBytes, inOff, outBytes, outOff, 1, false);	
 	}
 	
 	/**
@@ -302,9 +303,59 @@ public class MiraclAES implements AES{
 		}
 		
 		//Call the native code to perform invert
-		optimizedInvert(aes, inBytes, outBytes);	
+		processBlocks(aes, inBytes, 0, outBytes, 0, inBytes.length / getBlockSize(), false);	
 	}
-
+	
+	/**
+	 * Computes the AES permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(aes, inBytes, inOff, outBytes, outOff, numBlocks, true);
+	}
+	
+	/**
+	 * Inverts the AES permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(aes, inBytes, inOff, outBytes, outOff, numBlocks, false);
+	}
+	
+	/**
+	 * Computes the AES permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(aes, in, in.position(), out, out.position(), numBlocks, true);
+	}
+	
+	/**
+	 * Inverts the AES permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(aes, in, in.position(), out, out.position(), numBlocks, false);
+	}
+	
 	/**
 	 * This function is provided in the interface especially for the sub-family PrpVarying, which may have variable input/output lengths.
 	 * Since in this case, both input and output variables are fixed this function should not normally be called. 
@@ -56,8 +56,9 @@ public class OpenSSLHMAC implements Hmac {
 	private native int getNativeBlockSize(long hmac);	//Returns the block size of this Hmac object.
 	private native String getName(long hmac);			//Returns the name of the underlying hash.
 	private native void updateNative(long hmac, byte[] in, int inOffset, int inLen);//Updates the Hmac eith the given in array.
-	private native void updateFinal(long hmac, byte[] out, int outOffset);//Finalize the Hmac operation and puts the result in the given out array.
+	private native boolean updateFinal(long hmac, byte[] out, int outOffset);//Finalize the Hmac operation and puts the result in the given out array. Returns false if it failed.
 	private native void deleteNative(long hmac);		//Deletes the native object.
+	private native boolean expandNative(long hmac, byte[] info, byte[] out, int outOffset, int outLen);//Computes HKDF-Expand with the key of the Hmac. Returns false if it failed.
 	
 	/**
 	 * Default constructor that uses SHA1.
@@ -226,6 +227,7 @@ public class OpenSSLHMAC implements Hmac {
 	 * @param inOffset input offset in the inBytes array
 	 * @param outBytes output bytes. The resulted bytes of compute
 	 * @param outOffset output offset in the outBytes array to put the result from
+	 * @throws IllegalStateException if the native computation failed
 	 */
 	public void computeBlock(byte[] inBytes, int inOffset, int inLen, byte[] outBytes, int outOffset) {
 		if (!isKeySet()){
@@ -243,7 +245,9 @@ public class OpenSSLHMAC implements Hmac {
 		updateNative(hmac, inBytes, inOffset, inLen);
 		
 		//Gets the output results through doFinal.
-		updateFinal(hmac, outBytes, outOffset);
+		if (!updateFinal(hmac, outBytes, outOffset)){
+			throw new IllegalStateException("the native computation failed");
+		}
 	}
 	
 	/**
@@ -363,6 +367,7 @@ public class OpenSSLHMAC implements Hmac {
 	 * @param offset the offset within the message array to take the bytes from.
 	 * @param msgLength the length of the message.
 	 * @return the result tag from the mac operation.
+	 * @throws IllegalStateException if the native computation failed
 	 */
 	public byte[] doFinal(byte[] msg, int offset, int msgLength){
 		if (!isKeySet()){
@@ -373,11 +378,37 @@ public class OpenSSLHMAC implements Hmac {
 		//Creates the tag.
 		byte[] tag = new byte[getMacSize()];
 		//Calls the underlying hmac doFinal function.
-		updateFinal(hmac, tag, 0);
+		if (!updateFinal(hmac, tag, 0)){
+			throw new IllegalStateException("the native computation failed");
+		}
 		//Returns the tag.
 		return tag;
 	}
 	
+	/**
+	 * Computes HKDF-Expand (RFC 5869) in one native call, using the key of this hmac as the pseudorandom key. <p>
+	 * Puts in the out array the first outLen bytes of K(1),...,K(t), where K(i) = HMAC(PRK,(K(i-1),info,i)).
+	 * The native hmac keeps the states of the key pads, so each K(i) costs only the compression functions of its data and of the outer hash.
+	 * @param info the context information. May be null.
+	 * @param out the output array.
+	 * @param outOffset the offset within the output array to put the derived bytes from.
+	 * @param outLen the number of bytes to derive.
+	 * @throws IllegalStateException if the native computation failed. In this case the output bytes are zeroed.
+	 */
+	public void expand(byte[] info, byte[] out, int outOffset, int outLen){
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		//Check that the offset and length are correct.
+		if ((outOffset < 0) || (outLen < 0) || (outOffset > out.length - outLen)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		if (!expandNative(hmac, (info == null) ? new byte[0] : info, out, outOffset, outLen)){
+			throw new IllegalStateException("the native computation failed");
+		}
+	}
+	
 	/**
 	 * Deletes the native object.
 	 */
@@ -24,6 +24,7 @@
 */
 package edu.biu.scapi.primitives.prf.openSSL;
 
+import java.nio.ByteBuffer;
 import java.security.InvalidParameterException;
 import java.security.NoSuchAlgorithmException;
 import java.security.SecureRandom;
@@ -35,9 +36,10 @@ import javax.crypto.KeyGenerator;
 import javax.crypto.SecretKey;
 import javax.crypto.spec.SecretKeySpec;
 
-import edu.biu.scapi.primitives.prf.PrpFixed;
+import edu.biu.scapi.primitives.prf.BatchPrp;
+import edu.biu.scapi.primitives.prf.BatchPrpChecks;
 
-public abstract class OpenSSLPRP implements PrpFixed{
+public abstract class OpenSSLPRP implements BatchPrp{
 	protected long computeP;	//Native object used to compute the prp.
 	protected long invertP;		//Native object used to invert the prp.
 	
@@ -45,10 +47,9 @@ public abstract class OpenSSLPRP implements PrpFixed{
 	private SecureRandom random;
 	
 	//Native functions that call OpenSSL functionalities.
-	private native void computeBlock(long computeP, byte[] in, byte[] out, int outOffset, int blockSize); 	//Computes the PRP on the given in block.
-	private native void invertBlock(long invertP, byte[] in, byte[] out, int outOffset, int blockSize);		//Inverts the PRP on the given in block.
-	private native void doOptimizedCompute(long computeP, byte[] inBytes, byte[] outBytes, int blockSize);	//Computes the PRP on the given in array.
-	private native void doOptimizedInvert(long invertP, byte[] inBytes, byte[] outBytes, int blockSize);	//Inverts the PRP on the given in array.
+	//Computes (with computeP) or inverts (with invertP) the PRP on len bytes of consecutive blocks.
+	private native void processBlocks(long prp, byte[] in, int inOffset, byte[] out, int outOffset, int len);
+	private native void processBuffer(long prp, ByteBuffer in, int inOffset, ByteBuffer out, int outOffset, int len);
 	private native void deleteNative(long computeP, long invertP);											//Deleted the native objects.
 	
 	/**
@@ -151,23 +152,15 @@ public abstract class OpenSSLPRP implements PrpFixed{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offset and length are correct.
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
-		// We copy just the block we need to compute. else, the JNI will copy the whole array for nothing. 
-		byte[] newIn = inBytes;
-		if (inOff > 0){
-			
-			newIn = new byte[getBlockSize()];
-			System.arraycopy(inBytes, inOff, newIn, 0, getBlockSize());
-		}
-		
-		//Call the native code to perform computeBlock.
-		computeBlock(computeP, newIn, outBytes, outOff, getBlockSize());
+		//Call the native code to perform computeBlock. The native code reads the block from the given offset.
+		processBlocks(computeP, inBytes, inOff, outBytes, outOff, getBlockSize());
 	}
 	
 	/** 
@@ -193,7 +186,7 @@ public abstract class OpenSSLPRP implements PrpFixed{
 			throw new IllegalArgumentException("outBytes and inBytes must be in the same size");
 		}
 			
-		doOptimizedCompute(computeP, inBytes, outBytes, getBlockSize());
+		processBlocks(computeP, inBytes, 0, outBytes, 0, inBytes.length);
 	}
 
 	/** 
@@ -262,23 +255,15 @@ public abstract class OpenSSLPRP implements PrpFixed{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		// Checks that the offsets are correct. 
-		if ((inOff > inBytes.length) || (inOff+getBlockSize() > inBytes.length)){
+		if ((inOff < 0) || (inOff > inBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given input buffer");
 		}
-		if ((outOff > outBytes.length) || (outOff+getBlockSize() > outBytes.length)){
+		if ((outOff < 0) || (outOff > outBytes.length - getBlockSize())){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
-		// The native object needs the message to begin at offset 0.
-		// If the given offset is not 0 copy the msg to a new array. 
-		byte[] newIn = inBytes;
-		if (inOff > 0){
-			newIn = new byte[getBlockSize()];
-			System.arraycopy(inBytes, inOff, newIn, 0, getBlockSize());
-		}
-		
-		//Call the native code to perform invert.
-		invertBlock(invertP, newIn, outBytes, outOff, getBlockSize());	
+		//Call the native code to perform invert. The native code reads the block from the given offset.
+		processBlocks(invertP, inBytes, inOff, outBytes, outOff, getBlockSize());	
 	}
 	
 	/**
@@ -306,9 +291,59 @@ public abstract class OpenSSLPRP implements PrpFixed{
 		}
 		
 		//Call the native code to perform invert.
-		doOptimizedInvert(invertP, inBytes, outBytes, getBlockSize());	
+		processBlocks(invertP, inBytes, 0, outBytes, 0, inBytes.length);	
 	}
-
+	
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to compute.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(computeP, inBytes, inOff, outBytes, outOff, numBlocks * getBlockSize());
+	}
+	
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks, using one native call for all the blocks.
+	 * @param inBytes input bytes to invert.
+	 * @param inOff offset of the first block in the inBytes array.
+	 * @param outBytes output bytes. Can be inBytes itself.
+	 * @param outOff offset in the outBytes array to put the result from.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(byte[] inBytes, int inOff, byte[] outBytes, int outOff, int numBlocks){
+		BatchPrpChecks.checkArrays(this, inBytes, inOff, outBytes, outOff, numBlocks);
+		processBlocks(invertP, inBytes, inOff, outBytes, outOff, numBlocks * getBlockSize());
+	}
+	
+	/**
+	 * Computes the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to compute.
+	 */
+	public void computeBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(computeP, in, in.position(), out, out.position(), numBlocks * getBlockSize());
+	}
+	
+	/**
+	 * Inverts the permutation on numBlocks consecutive blocks of the given direct buffer.
+	 * @param in the input blocks, starting at the position of the buffer.
+	 * @param out the output buffer, can be in itself.
+	 * @param numBlocks number of blocks to invert.
+	 */
+	public void invertBlocks(ByteBuffer in, ByteBuffer out, int numBlocks){
+		BatchPrpChecks.checkBuffer(this, in, numBlocks);
+		BatchPrpChecks.checkBuffer(this, out, numBlocks);
+		processBuffer(invertP, in, in.position(), out, out.position(), numBlocks * getBlockSize());
+	}
+	
 	/**
 	 * This function is provided in the interface especially for the sub-family PrpVarying, which may have variable input/output lengths.
 	 * Since in this case, both input and output variables are fixed this function should not normally be called. 
@@ -35,6 +35,7 @@ import javax.crypto.SecretKey;
 
 import edu.biu.scapi.exceptions.FactoriesException;
 import edu.biu.scapi.exceptions.NoMaxException;
+import edu.biu.scapi.primitives.prf.BatchPrp;
 import edu.biu.scapi.primitives.prf.PseudorandomFunction;
 import edu.biu.scapi.primitives.prf.bc.BcAES;
 import edu.biu.scapi.tools.Factories.PrfFactory;
@@ -147,6 +148,19 @@ public class ScPrgFromPrf implements PseudorandomGenerator{
 		}
 
 		int numGeneratedBytes = 0;	//Number of current generated bytes.
+		
+		//A batch prp computes all the whole blocks in one call: 
+		//the counters are written to the output array and the prp is computed on them in place.
+		if (prf instanceof BatchPrp){
+			int numBlocks = outLen / ctr.length;
+			for (int i = 0; i < numBlocks; i++){
+				System.arraycopy(ctr, 0, outBytes, outOffset + i * ctr.length, ctr.length);
+				increaseCtr();
+			}
+			((BatchPrp) prf).computeBlocks(outBytes, outOffset, outBytes, outOffset, numBlocks);
+			numGeneratedBytes = numBlocks * ctr.length;
+		}
+		
 		byte [] generatedBytes = new byte[ctr.length];
 
 		while(numGeneratedBytes < outLen){
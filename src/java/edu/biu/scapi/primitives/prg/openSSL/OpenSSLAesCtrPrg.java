@@ -0,0 +1,202 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+
+package edu.biu.scapi.primitives.prg.openSSL;
+
+import java.nio.ByteBuffer;
+import java.security.InvalidKeyException;
+import java.security.NoSuchAlgorithmException;
+import java.security.SecureRandom;
+import java.security.spec.AlgorithmParameterSpec;
+import java.security.spec.InvalidParameterSpecException;
+
+import javax.crypto.KeyGenerator;
+import javax.crypto.SecretKey;
+
+import edu.biu.scapi.primitives.prg.PseudorandomGenerator;
+
+/**
+ * A pseudorandom generator that uses AES in counter mode, implemented by OpenSSL. <p>
+ * 
+ * The seed is used as the AES key and the stream is AES(0), AES(1), AES(2), ... (where the counter is a 128 bit big endian number).
+ * Unlike RC4, AES-CTR has no known bias and runs with AES-NI, so this class should be used when a large amount of pseudorandom bytes is needed. <p>
+ * 
+ * The native object keeps a buffer of generated bytes for short requests, and generates long requests directly into the output. 
+ * Very long requests are generated by all the threads of the native thread pool.
+ * 
+ * @author Cryptography and Computer Security Research Group Department of Computer Science Bar-Ilan University
+ *
+ */
+public class OpenSSLAesCtrPrg implements PseudorandomGenerator{
+	
+	private long prg; //Pointer to the native PRG.
+	
+	private SecureRandom random;
+	
+	//Native functions that use OpenSSL's AES-CTR implementation.
+	private native long createPrg(byte[] seed);											//Creates the native PRG. Returns 0 if the seed size is not valid.
+	private native boolean getBytes(long prg, byte[] outBytes, int outOffset, int outLen);	//Fills the given array with the next bytes of the stream. Returns false if it failed.
+	private native boolean fillBuffer(long prg, ByteBuffer out, int outOffset, int outLen);	//Fills the given direct buffer with the next bytes of the stream. Returns false if it failed.
+	private native void deletePrg(long prg);											//Deletes the native PRG.
+	
+	/**
+	 * Creates the object using default random.
+	 */
+	public OpenSSLAesCtrPrg(){
+		this(new SecureRandom());
+	}
+	
+	/**
+	 * Creates the object using the given random object.
+	 * @param random source of randomness used to generate keys.
+	 */
+	public OpenSSLAesCtrPrg(SecureRandom random){
+		this.random = random;
+	}
+	
+	/**
+	 * Creates the object using the given random number generator algorithm.
+	 * @param randNumGenAlg
+	 * @throws NoSuchAlgorithmException if the given algorithm is not exist.
+	 */
+	public OpenSSLAesCtrPrg(String randNumGenAlg) throws NoSuchAlgorithmException {
+		this(SecureRandom.getInstance(randNumGenAlg));
+	}
+	
+	/**
+	 * Sets the given seed. The stream starts from its beginning.
+	 * @throws InvalidKeyException if the key is not 128/192/256 bits long.
+	 */
+	public void setKey(SecretKey secretKey) throws InvalidKeyException {
+		long newPrg = createPrg(secretKey.getEncoded());
+		if (newPrg == 0){
+			throw new InvalidKeyException("AES key size should be 128/192/256 bits long");
+		}
+		
+		if (prg != 0){
+			deletePrg(prg);
+		}
+		prg = newPrg;
+	}
+	
+	public boolean isKeySet(){
+		return prg != 0;
+	}
+	
+	/** 
+	 * Returns the name of the algorithm.
+	 * @return - the algorithm name "AES-CTR".
+	 */
+	public String getAlgorithmName() {
+		return "AES-CTR";
+	}
+
+	/**
+	 * This function is not supported in this implementation. Throws exception.
+	 * @throws UnsupportedOperationException 
+	 */
+	public SecretKey generateKey(AlgorithmParameterSpec keyParams) throws InvalidParameterSpecException{
+		throw new UnsupportedOperationException("To generate a key for this prg object use the generateKey(int keySize) function");
+	}
+	
+	/**
+	 * Generates a secret key to initialize this prg object.
+	 * @param keySize is the required secret key size in bits (128, 192 or 256).
+	 * @return the generated secret key 
+	 */
+	public SecretKey generateKey(int keySize){
+		try {
+			KeyGenerator keyGen = KeyGenerator.getInstance("AES");
+			//If the key size is zero or less - uses the default key size as implemented in the provider implementation.
+			if (keySize <= 0){
+				keyGen.init(random);
+			} else {
+				keyGen.init(keySize, random);
+			}
+			return keyGen.generateKey();
+		} catch (NoSuchAlgorithmException e) {
+			//Every java platform provides an AES key generator.
+			throw new IllegalStateException(e);
+		}
+	}
+	
+	/** 
+	 * Streams the next bytes of the generator.
+	 * @param outBytes - output bytes. The result of streaming the bytes.
+	 * @param outOffset - output offset.
+	 * @param outLen - the required output length.
+	 * @throws IllegalStateException if the native generation failed. In this case the output bytes are zeroed.
+	 */
+	public void getPRGBytes(byte[] outBytes, int outOffset,	int outLen){
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		//Checks that the offset and the length are correct.
+		if ((outOffset < 0) || (outLen < 0) || (outOffset > outBytes.length - outLen)){
+			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
+		}
+		
+		if (!getBytes(prg, outBytes, outOffset, outLen)){
+			throw new IllegalStateException("the native generation failed");
+		}
+	}
+	
+	/**
+	 * Fills the given direct buffer with the next bytes of the generator, from its position to its limit. 
+	 * The position of the buffer is not changed.
+	 * @param out a direct buffer to fill.
+	 * @throws IllegalArgumentException if the buffer is not direct.
+	 * @throws IllegalStateException if the native generation failed. In this case the buffer is zeroed.
+	 */
+	public void fillBytes(ByteBuffer out){
+		if (!isKeySet()){
+			throw new IllegalStateException("secret key isn't set");
+		}
+		if (!out.isDirect()){
+			throw new IllegalArgumentException("the native code can only use direct buffers");
+		}
+		
+		if (!fillBuffer(prg, out, out.position(), out.remaining())){
+			throw new IllegalStateException("the native generation failed");
+		}
+	}
+	
+	/**
+	 * Deletes the native PRG.
+	 */
+	protected void finalize() throws Throwable {
+		if (prg != 0){
+			deletePrg(prg);
+			prg = 0;
+		}
+		super.finalize();
+	}
+	
+	static {
+		//Loads the OpenSSL dll.
+		 System.loadLibrary("OpenSSLJavaInterface");
+	}
+}
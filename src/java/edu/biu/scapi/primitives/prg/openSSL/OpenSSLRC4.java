@@ -160,7 +160,8 @@ public class OpenSSLRC4 implements RC4{
 			throw new IllegalStateException("secret key isn't set");
 		}
 		//checks that the offset and the length are correct.
-		if ((outOffset > outBytes.length) || ((outOffset + outLen) > outBytes.length)){
+		//The native code writes directly into the array, so negative values must be rejected too.
+		if ((outOffset < 0) || (outLen < 0) || (outOffset > outBytes.length - outLen)){
 			throw new ArrayIndexOutOfBoundsException("wrong offset for the given output buffer");
 		}
 		
@@ -112,6 +112,27 @@ public interface TrapdoorPermutation {
 	 * @throws IllegalArgumentException if the given element is invalid for this permutation
 	 */
 	public TPElement invert(TPElement tpEl) throws KeyException;
+	
+	/** 
+	 * Computes the operation of this trapdoor permutation on each of the given TPElements.<p>
+	 * Implementations may compute the elements together (for example in several native threads), 
+	 * so this is faster than calling compute for each element.
+	 * @param tpElements - the inputs for the computation
+	 * @return - the results, in the order of the inputs
+	 * @throws IllegalArgumentException if one of the given elements is invalid for this permutation
+	 */
+	public TPElement[] computeBatch(TPElement[] tpElements) throws IllegalArgumentException;
+	
+	/** 
+	 * Inverts the operation of this trapdoor permutation on each of the given TPElements.<p>
+	 * Implementations may invert the elements together (for example in several native threads), 
+	 * so this is faster than calling invert for each element.
+	 * @param tpElements - the inputs to invert
+	 * @return - the results, in the order of the inputs
+	 * @throws KeyException if there is no private key
+	 * @throws IllegalArgumentException if one of the given elements is invalid for this permutation
+	 */
+	public TPElement[] invertBatch(TPElement[] tpElements) throws KeyException;
 
 	/** 
 	 * Computes the hard core predicate of the given tpElement. <p>
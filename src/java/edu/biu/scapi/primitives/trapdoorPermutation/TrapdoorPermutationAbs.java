@@ -28,6 +28,7 @@ package edu.biu.scapi.primitives.trapdoorPermutation;
 
 import java.math.BigInteger;
 import java.security.InvalidKeyException;
+import java.security.KeyException;
 import java.security.PrivateKey;
 import java.security.PublicKey;
 
@@ -78,6 +79,30 @@ public abstract class TrapdoorPermutationAbs implements TrapdoorPermutation {
 	}
 	
 	
+	/**
+	 * Computes the permutation on each of the given elements, one after the other. 
+	 * Derived classes that can compute several elements together should override it.
+	 */
+	public TPElement[] computeBatch(TPElement[] tpElements) throws IllegalArgumentException {
+		TPElement[] results = new TPElement[tpElements.length];
+		for (int i = 0; i < tpElements.length; i++){
+			results[i] = compute(tpElements[i]);
+		}
+		return results;
+	}
+	
+	/**
+	 * Inverts the permutation on each of the given elements, one after the other. 
+	 * Derived classes that can invert several elements together should override it.
+	 */
+	public TPElement[] invertBatch(TPElement[] tpElements) throws KeyException {
+		TPElement[] results = new TPElement[tpElements.length];
+		for (int i = 0; i < tpElements.length; i++){
+			results[i] = invert(tpElements[i]);
+		}
+		return results;
+	}
+	
 	/** 
 	 * Compute the hard core predicate of the given tpElement, by return the least significant bit of the element. 
 	 *
@@ -80,6 +80,10 @@ public final class CryptoPpRSAPermutation extends TrapdoorPermutationAbs impleme
 	private native long computeRSA(long tpr, long x);
 	//inverts RSA permutation
 	private native long invertRSA(long ptr, long y);
+	//computes RSA permutation on several elements
+	private native long[] computeRSABatch(long ptr, long[] x);
+	//inverts RSA permutation on several elements
+	private native long[] invertRSABatch(long ptr, long[] y);
 	
 	//deletes the native object
 	private native void deleteRSA(long ptr);
@@ -269,6 +273,84 @@ public final class CryptoPpRSAPermutation extends TrapdoorPermutationAbs impleme
 		return returnEl; // returns the result TPElement
 	}
 	
+	/** 
+	 * Computes the RSA permutation on each of the given TPElements in one native call, using several threads.
+	 * @param tpElements - the inputs for the computation
+	 * @return - the result elements, in the order of the inputs
+	 * @throws - IllegalArgumentException if one of the given elements is not RSA element or is not smaller than the modulus
+	 */
+	@Override
+	public TPElement[] computeBatch(TPElement[] tpElements) throws IllegalArgumentException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//calls for the native function
+		long[] results = computeRSABatch(tpPtr, getPointers(tpElements)); 
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * Inverts the RSA permutation on each of the given elements in one native call, using several threads. 
+	 * @param tpElements - the inputs to invert
+	 * @return - the results, in the order of the inputs
+	 * @throws KeyException if the private key was not set
+	 * @throws - IllegalArgumentException if one of the given elements is not RSA element or is not smaller than the modulus
+	 */
+	@Override
+	public TPElement[] invertBatch(TPElement[] tpElements) throws IllegalArgumentException, KeyException{
+		
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//If the key set was only the public key and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to decrypt a message, this object must be initialized with private key");
+		}
+		
+		//calls for the native function
+		long[] results = invertRSABatch(tpPtr, getPointers(tpElements)); 
+		
+		return toElements(results);
+	}
+	
+	/**
+	 * @return the pointers to the native objects of the given elements
+	 * @throws IllegalArgumentException if one of the elements is not a RSA element or is not smaller than the modulus
+	 */
+	private long[] getPointers(TPElement[] tpElements){
+		long[] pointers = new long[tpElements.length];
+		for (int i = 0; i < tpElements.length; i++){
+			if (!(tpElements[i] instanceof CryptoPpRSAElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			//crypto++ reduces the elements mod n without checking them, so check them here like the OpenSSL batch does
+			if (tpElements[i].getElement().compareTo(modulus) >= 0){
+				throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+			}
+			pointers[i] = ((CryptoPpRSAElement)tpElements[i]).getPointerToElement();
+		}
+		return pointers;
+	}
+	
+	/**
+	 * @return CryptoPpRSAElements that wrap the given native results
+	 * @throws IllegalStateException if the native computation failed
+	 */
+	private TPElement[] toElements(long[] pointers){
+		if (pointers == null){
+			throw new IllegalStateException("the native computation failed");
+		}
+		TPElement[] elements = new TPElement[pointers.length];
+		for (int i = 0; i < pointers.length; i++){
+			elements[i] = new CryptoPpRSAElement(pointers[i]);
+		}
+		return elements;
+	}
+	
 	/** 
 	 * Checks if the given element is valid for this RSA permutation
 	 * @param tpEl - the element to check
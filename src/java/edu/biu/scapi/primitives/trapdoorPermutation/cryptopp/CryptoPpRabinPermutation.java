@@ -86,6 +86,8 @@ public final class CryptoPpRabinPermutation extends TrapdoorPermutationAbs imple
 	private native long computeRabin(long tpr, long x);
 	//inverts Rabin permutation
 	private native long invertRabin(long ptr, long y);
+	//inverts Rabin permutation on several elements
+	private native long[] invertRabinBatch(long ptr, long[] y);
 
 	//deletes the native object
 	private native void deleteRabin(long ptr);
@@ -261,6 +263,48 @@ public final class CryptoPpRabinPermutation extends TrapdoorPermutationAbs imple
 
 		return returnEl; // returns the result TPElement
 	}
+	
+	/** 
+	 * Inverts the Rabin permutation on each of the given elements in one native call, using several threads.
+	 * @param tpElements - the inputs to invert
+	 * @return - the results, in the order of the inputs
+	 * @throws KeyException if the private key was not set
+	 * @throws IllegalArgumentException if one of the given elements is not Rabin element
+	 * @throws IllegalStateException if the native computation failed
+	 */
+	@Override
+	public TPElement[] invertBatch(TPElement[] tpElements) throws IllegalArgumentException, KeyException{
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		
+		//If the key set was only the public key and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to invert a RabinElement, this object must be initialized with private key");
+		}
+		
+		// get the pointers for the native objects
+		long[] elementsP = new long[tpElements.length];
+		for (int i = 0; i < tpElements.length; i++){
+			if (!(tpElements[i] instanceof CryptoPpRabinElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			elementsP[i] = ((CryptoPpRabinElement)tpElements[i]).getPointerToElement();
+		}
+		
+		//calls the native function
+		long[] results = invertRabinBatch(tpPtr, elementsP);
+		if (results == null){
+			throw new IllegalStateException("the native computation failed");
+		}
+		
+		//creates and initializes RabinElements with the results
+		TPElement[] returnEls = new TPElement[results.length];
+		for (int i = 0; i < results.length; i++){
+			returnEls[i] = new CryptoPpRabinElement(results[i]);
+		}
+		return returnEls;
+	}
 
 	
 	/** 
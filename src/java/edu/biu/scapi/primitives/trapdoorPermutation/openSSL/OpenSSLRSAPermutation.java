@@ -75,6 +75,10 @@ public final class OpenSSLRSAPermutation extends TrapdoorPermutationAbs implemen
 	private native byte[] computeRSA(long tpr, byte[] x);
 	//Inverts RSA permutation.
 	private native byte[] invertRSA(long ptr, byte[] y);
+	//Computes RSA permutation on packed elements.
+	private native byte[] computeRSABatch(long ptr, byte[] elements, int numElements);
+	//Inverts RSA permutation on packed elements.
+	private native byte[] invertRSABatch(long ptr, byte[] elements, int numElements);
 	
 	//Deletes the native object.
 	private native void deleteRSA(long ptr);
@@ -274,6 +278,133 @@ public final class OpenSSLRSAPermutation extends TrapdoorPermutationAbs implemen
 		return returnEl; // return the result TPElement.
 	}
 	
+	/**
+	 * Returns the size in bytes of a packed element of this permutation, which is the size of the modulus.
+	 * @return the size of each element in the arrays of computeBatch(byte[]) and invertBatch(byte[]).
+	 */
+	public int getElementSize(){
+		if (!isKeySet()){
+			throw new IllegalStateException("keys aren't set");
+		}
+		return (modulus.bitLength() + 7) / 8;
+	}
+	
+	/**
+	 * Computes the RSA permutation on each of the given packed elements, in the native threads of the library.
+	 * @param elements - the elements to compute the permutation on. Each element takes getElementSize() bytes (big endian).
+	 * @return the results, packed the same way in one array.
+	 * @throws IllegalArgumentException if the array is not made of whole elements or one of the elements is not smaller than the modulus.
+	 */
+	public byte[] computeBatch(byte[] elements) throws IllegalArgumentException{
+		int numElements = countElements(elements);
+		if (numElements == 0){
+			return new byte[0];
+		}
+		
+		byte[] result = computeRSABatch(rsa, elements, numElements);
+		if (result == null){
+			throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+		}
+		return result;
+	}
+	
+	/**
+	 * Inverts the RSA permutation on each of the given packed elements, in the native threads of the library.<p>
+	 * The inversion uses the CRT values of the private key (if they were given) and blinds each element.
+	 * @param elements - the elements to invert. Each element takes getElementSize() bytes (big endian).
+	 * @return the results, packed the same way in one array.
+	 * @throws KeyException if private key was not set.
+	 * @throws IllegalArgumentException if the array is not made of whole elements or one of the elements is not smaller than the modulus.
+	 */
+	public byte[] invertBatch(byte[] elements) throws IllegalArgumentException, KeyException{
+		int numElements = countElements(elements);
+		
+		//If only the public key was set and not the private key - can't do the invert, throw exception.
+		if (privKey == null && pubKey!=null){
+			throw new KeyException("in order to decrypt a message, this object must be initialized with private key");
+		}
+		if (numElements == 0){
+			return new byte[0];
+		}
+		
+		byte[] result = invertRSABatch(rsa, elements, numElements);
+		if (result == null){
+			throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+		}
+		return result;
+	}
+	
+	/**
+	 * Computes the RSA permutation on each of the given elements in one native call.
+	 * @param tpElements - the inputs for the computation.
+	 * @return the results, in the order of the inputs.
+	 * @throws IllegalArgumentException if one of the given elements is not a RSA element.
+	 */
+	@Override
+	public TPElement[] computeBatch(TPElement[] tpElements) throws IllegalArgumentException{
+		return unpackElements(computeBatch(packElements(tpElements)), tpElements.length);
+	}
+	
+	/**
+	 * Inverts the RSA permutation on each of the given elements in one native call.
+	 * @param tpElements - the inputs to invert.
+	 * @return the results, in the order of the inputs.
+	 * @throws KeyException if private key was not set.
+	 * @throws IllegalArgumentException if one of the given elements is not a RSA element.
+	 */
+	@Override
+	public TPElement[] invertBatch(TPElement[] tpElements) throws IllegalArgumentException, KeyException{
+		return unpackElements(invertBatch(packElements(tpElements)), tpElements.length);
+	}
+	
+	/**
+	 * Returns the number of packed elements in the given array.
+	 */
+	private int countElements(byte[] elements){
+		int size = getElementSize();
+		if (elements.length % size != 0){
+			throw new IllegalArgumentException("the length of the elements array should be a multiple of " + size);
+		}
+		return elements.length / size;
+	}
+	
+	/**
+	 * Packs the values of the given elements into one array, each one in getElementSize() bytes.
+	 */
+	private byte[] packElements(TPElement[] tpElements){
+		int size = getElementSize();
+		byte[] packed = new byte[tpElements.length * size];
+		for (int i = 0; i < tpElements.length; i++){
+			if (!(tpElements[i] instanceof RSAElement)){
+				throw new IllegalArgumentException("trapdoor element type doesn't match the trapdoor permutation type");
+			}
+			byte[] value = ((RSAElement) tpElements[i]).getElement().toByteArray();
+			
+			//Skip the zero byte that BigInteger adds for the sign. Shorter values are padded with zeros in the start.
+			int start = (value[0] == 0) ? 1 : 0;
+			int length = value.length - start;
+			if (length > size){
+				throw new IllegalArgumentException("one of the elements is not smaller than the modulus");
+			}
+			System.arraycopy(value, start, packed, (i + 1) * size - length, length);
+		}
+		return packed;
+	}
+	
+	/**
+	 * Creates RSAElements from the given packed values.
+	 */
+	private TPElement[] unpackElements(byte[] packed, int numElements){
+		int size = getElementSize();
+		TPElement[] results = new TPElement[numElements];
+		byte[] value = new byte[size];
+		for (int i = 0; i < numElements; i++){
+			System.arraycopy(packed, i * size, value, 0, size);
+			results[i] = new RSAElement(modulus, new BigInteger(1, value), false);
+		}
+		return results;
+	}
+	
 	/** 
 	 * Checks if the given element is valid in this RSA permutation.
 	 * @param tpEl - the element to check.
@@ -0,0 +1,104 @@
+package edu.biu.scapi.tests.benchmarks;
+
+import java.math.BigInteger;
+import java.util.Random;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECF2m;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECFp;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogZpSafePrime;
+
+/**
+ * Measures how the exponentiations of the thread safe OpenSSL groups scale when one group instance is shared by several threads. <p>
+ * Each group computes the same exponentiations in one thread and split between the threads, with and without the precomputed values of the base. <p>
+ * Usage: DlogConcurrencyBenchmark [number of threads] [number of exponentiations]
+ */
+public class DlogConcurrencyBenchmark {
+	
+	private static final int WARMUP_ROUNDS = 2;
+	
+	private final DlogGroup dlog;
+	private final GroupElement base;
+	private final BigInteger[] exponents;
+	
+	private DlogConcurrencyBenchmark(DlogGroup dlog, int numExponentiations){
+		this.dlog = dlog;
+		base = dlog.createRandomElement();
+		exponents = new BigInteger[numExponentiations];
+		Random random = new Random();
+		for (int i = 0; i < numExponentiations; i++){
+			exponents[i] = new BigInteger(dlog.getOrder().bitLength(), random);
+		}
+	}
+	
+	/**
+	 * Computes the exponentiations with the given first index, in steps of the given step.
+	 */
+	private void exponentiate(int first, int step, boolean fixedBase){
+		for (int i = first; i < exponents.length; i += step){
+			if (fixedBase){
+				dlog.exponentiateWithPreComputedValues(base, exponents[i]);
+			} else {
+				dlog.exponentiate(base, exponents[i]);
+			}
+		}
+	}
+	
+	/**
+	 * @return the time in ms that all the exponentiations take in the given number of threads
+	 */
+	private long time(ExecutorService pool, final int numThreads, final boolean fixedBase) throws Exception{
+		long start = System.nanoTime();
+		if (numThreads == 1){
+			exponentiate(0, 1, fixedBase);
+		} else {
+			@SuppressWarnings("unchecked")
+			Future<Void>[] results = new Future[numThreads];
+			for (int t = 0; t < numThreads; t++){
+				final int first = t;
+				results[t] = pool.submit(new Callable<Void>() {
+					public Void call(){
+						exponentiate(first, numThreads, fixedBase);
+						return null;
+					}
+				});
+			}
+			for (Future<Void> result : results){
+				result.get();
+			}
+		}
+		return (System.nanoTime() - start) / 1000000;
+	}
+	
+	private void run(String name, ExecutorService pool, int numThreads) throws Exception{
+		for (boolean fixedBase : new boolean[]{false, true}){
+			for (int i = 0; i < WARMUP_ROUNDS; i++){
+				time(pool, numThreads, fixedBase);
+			}
+			long serialTime = time(pool, 1, fixedBase);
+			long parallelTime = time(pool, numThreads, fixedBase);
+			System.out.println(name + (fixedBase ? ", precomputed base" : "") + ": " + exponents.length + " exponentiations took " + 
+					serialTime + " ms in one thread, " + parallelTime + " ms in " + numThreads + " threads");
+		}
+		dlog.endExponentiateWithPreComputedValues(base);
+	}
+
+	public static void main(String[] args) throws Exception {
+		int numThreads = (args.length > 0) ? Integer.parseInt(args[0]) : Runtime.getRuntime().availableProcessors();
+		int numExponentiations = (args.length > 1) ? Integer.parseInt(args[1]) : 256 * numThreads;
+		
+		ExecutorService pool = Executors.newFixedThreadPool(numThreads);
+		try {
+			new DlogConcurrencyBenchmark(new OpenSSLDlogECFp("P-256"), numExponentiations).run("OpenSSL ECFp P-256", pool, numThreads);
+			new DlogConcurrencyBenchmark(new OpenSSLDlogECF2m("B-233"), numExponentiations).run("OpenSSL ECF2m B-233", pool, numThreads);
+			new DlogConcurrencyBenchmark(new OpenSSLDlogZpSafePrime(1024), numExponentiations).run("OpenSSL Zp* 1024 bits", pool, numThreads);
+		} finally {
+			pool.shutdown();
+		}
+	}
+}
@@ -0,0 +1,76 @@
+package edu.biu.scapi.tests.benchmarks;
+
+import java.math.BigInteger;
+import java.util.Random;
+
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECFp;
+
+/**
+ * Compares the named curve implementations of OpenSSL with the curves that are built from their parameters, on the NIST prime curves. <p>
+ * OpenSSLDlogECFp uses the named curve when OpenSSL has one with the parameters of the group, and the optimized implementations
+ * (for example of P-224, P-256 and P-521 on 64 bit platforms) are only used by the named curves. <p>
+ * Usage: NamedCurveBenchmark [number of exponentiations] [curve names...]
+ */
+public class NamedCurveBenchmark {
+	
+	private static final String[] DEFAULT_CURVES = {"P-224", "P-256", "P-384", "P-521"};
+	
+	/**
+	 * @return the time in ms that the exponentiations of the given base take.
+	 */
+	private static long timeExponentiations(OpenSSLDlogECFp dlog, GroupElement base, BigInteger[] exponents, boolean fixedBase){
+		long start = System.nanoTime();
+		for (BigInteger exponent : exponents){
+			if (fixedBase){
+				dlog.exponentiateWithPreComputedValues(base, exponent);
+			} else {
+				dlog.exponentiate(base, exponent);
+			}
+		}
+		return (System.nanoTime() - start) / 1000000;
+	}
+	
+	private static void run(String curveName, int numExponentiations) throws Exception{
+		OpenSSLDlogECFp named = new OpenSSLDlogECFp(curveName);
+		OpenSSLDlogECFp explicit;
+		OpenSSLDlogECFp.setUseNamedCurves(false);
+		try {
+			explicit = new OpenSSLDlogECFp(curveName);
+		} finally {
+			OpenSSLDlogECFp.setUseNamedCurves(true);
+		}
+		
+		BigInteger[] exponents = new BigInteger[numExponentiations];
+		Random random = new Random();
+		for (int i = 0; i < numExponentiations; i++){
+			exponents[i] = new BigInteger(named.getOrder().bitLength(), random);
+		}
+		
+		for (OpenSSLDlogECFp dlog : new OpenSSLDlogECFp[]{named, explicit}){
+			GroupElement base = dlog.createRandomElement();
+			//Warm up, and create the table of the generator.
+			timeExponentiations(dlog, base, exponents, false);
+			timeExponentiations(dlog, dlog.getGenerator(), exponents, true);
+			
+			long variableBaseTime = timeExponentiations(dlog, base, exponents, false);
+			long generatorTime = timeExponentiations(dlog, dlog.getGenerator(), exponents, true);
+			System.out.println(curveName + (dlog.isNamedCurve() ? " named curve" : " from parameters") + ": " + numExponentiations + 
+					" exponentiations took " + variableBaseTime + " ms with a random base, " + generatorTime + " ms with the precomputed generator");
+			dlog.endExponentiateWithPreComputedValues(dlog.getGenerator());
+		}
+	}
+
+	public static void main(String[] args) throws Exception {
+		int numExponentiations = (args.length > 0) ? Integer.parseInt(args[0]) : 1000;
+		String[] curves = DEFAULT_CURVES;
+		if (args.length > 1){
+			curves = new String[args.length - 1];
+			System.arraycopy(args, 1, curves, 0, curves.length);
+		}
+		
+		for (String curveName : curves){
+			run(curveName, numExponentiations);
+		}
+	}
+}
@@ -5,6 +5,11 @@ import static org.junit.Assert.*;
 import java.math.BigInteger;
 import java.util.Arrays;
 import java.util.Random;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
 
 import org.junit.Test;
 
@@ -17,6 +22,13 @@ public abstract class TestDlogGroupInterface {
 	public abstract String getGroupType();
 	protected DlogGroup dlog = createInstance();
 	
+	/**
+	 * Returns true if one instance of the group can be used by several threads at the same time.
+	 */
+	protected boolean isThreadSafe(){
+		return false;
+	}
+	
 
 	@Test
 	public void TestGetGroupType() {
@@ -62,6 +74,23 @@ public abstract class TestDlogGroupInterface {
 		assertEquals(res1, expected_res);
 	}
 	
+	@Test
+	public void TestSimultaneousMultipleExponentiationsManyBases(){
+		// Enough bases for the native implementations to switch to their algorithm for large inputs.
+		int size = 200;
+		GroupElement[] baseArray = new GroupElement[size];
+		BigInteger[] exponentArray = new BigInteger[size];
+		Random random = new Random();
+		GroupElement expected_res = dlog.getIdentity();
+		for (int i = 0; i < size; i++){
+			baseArray[i] = dlog.createRandomElement();
+			exponentArray[i] = new BigInteger(dlog.getOrder().bitLength() - 1, random);
+			expected_res = dlog.multiplyGroupElements(expected_res, dlog.exponentiate(baseArray[i], exponentArray[i]));
+		}
+		
+		assertEquals(expected_res, dlog.simultaneousMultipleExponentiations(baseArray, exponentArray));
+	}
+	
 	@Test
 	public void TestExponentiateWithPreComputedValues(){
 		GroupElement base = dlog.createRandomElement();
@@ -74,6 +103,33 @@ public abstract class TestDlogGroupInterface {
 		assertEquals(expected_res, res);
 	}
 	
+	@Test
+	public void TestExponentiateBatch(){
+		GroupElement generator = dlog.getGenerator();
+		GroupElement[] bases = {dlog.createRandomElement(), dlog.createRandomElement(), generator};
+		BigInteger[] exponents = {BigInteger.valueOf(3), BigInteger.valueOf(-5), dlog.getOrder().subtract(BigInteger.ONE)};
+		
+		GroupElement[] res = dlog.exponentiateBatch(bases, exponents);
+		GroupElement[] fixed_res = dlog.fixedBaseExponentiateBatch(generator, exponents);
+		for (int i = 0; i < bases.length; i++){
+			BigInteger exponent = exponents[i].mod(dlog.getOrder());
+			assertEquals(dlog.exponentiate(bases[i], exponent), res[i]);
+			assertEquals(dlog.exponentiate(generator, exponent), fixed_res[i]);
+		}
+		dlog.endExponentiateWithPreComputedValues(generator);
+	}
+	
+	@Test
+	public void TestAreMembers(){
+		GroupElement[] elements = {dlog.createRandomElement(), dlog.getGenerator(), dlog.getIdentity(), dlog.createRandomElement()};
+		
+		boolean[] members = dlog.areMembers(elements);
+		assertEquals(elements.length, members.length);
+		for (int i = 0; i < elements.length; i++){
+			assertTrue(members[i]);
+		}
+	}
+	
 	@Test
 	public void TestEncodeDecode(){
 		int k = dlog.getMaxLengthOfByteArrayForEncoding();
@@ -86,5 +142,51 @@ public abstract class TestDlogGroupInterface {
 		byte[] res_bytes = dlog.decodeGroupElementToByteArray(ge);
 		assertEquals(new String(bytes), new String(res_bytes));
 	}
+	
+	@Test
+	public void TestConcurrentExponentiations() throws Exception{
+		if (!isThreadSafe())
+			return;
+		
+		final int numThreads = Math.max(2, Runtime.getRuntime().availableProcessors());
+		final int numExponentiations = 64 * numThreads;
+		final GroupElement base = dlog.createRandomElement();
+		final BigInteger[] exponents = new BigInteger[numExponentiations];
+		GroupElement[] expected = new GroupElement[numExponentiations];
+		Random random = new Random();
+		
+		for (int i = 0; i < numExponentiations; i++){
+			exponents[i] = new BigInteger(dlog.getOrder().bitLength(), random);
+			expected[i] = dlog.exponentiate(base, exponents[i]);
+		}
+		
+		ExecutorService pool = Executors.newFixedThreadPool(numThreads);
+		@SuppressWarnings("unchecked")
+		Future<GroupElement[]>[] results = new Future[numThreads];
+		for (int t = 0; t < numThreads; t++){
+			final int first = t;
+			results[t] = pool.submit(new Callable<GroupElement[]>() {
+				//Each thread takes every numThreads'th exponent, and computes it with and without the precomputed values.
+				public GroupElement[] call(){
+					GroupElement[] res = new GroupElement[2 * numExponentiations];
+					for (int i = first; i < numExponentiations; i += numThreads){
+						res[2 * i] = dlog.exponentiate(base, exponents[i]);
+						res[2 * i + 1] = dlog.exponentiateWithPreComputedValues(base, exponents[i]);
+					}
+					return res;
+				}
+			});
+		}
+		for (int t = 0; t < numThreads; t++){
+			GroupElement[] res = results[t].get();
+			for (int i = t; i < numExponentiations; i += numThreads){
+				assertEquals(expected[i], res[2 * i]);
+				assertEquals(expected[i], res[2 * i + 1]);
+			}
+		}
+		pool.shutdown();
+		pool.awaitTermination(1, TimeUnit.MINUTES);
+		dlog.endExponentiateWithPreComputedValues(base);
+	}
 
 }
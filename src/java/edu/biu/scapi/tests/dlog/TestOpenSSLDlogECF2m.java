@@ -3,8 +3,12 @@ package edu.biu.scapi.tests.dlog;
 import static org.junit.Assert.*;
 
 import java.io.IOException;
+import java.math.BigInteger;
+
+import org.junit.Test;
 
 import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECF2m;
 
 public class TestOpenSSLDlogECF2m extends TestDlogGroupInterface{
@@ -22,4 +26,24 @@ public class TestOpenSSLDlogECF2m extends TestDlogGroupInterface{
 		return "ECF2m";
 	}
 	
+	protected boolean isThreadSafe(){
+		return true;
+	}
+	
+	@Test
+	public void TestEncodeDecodePoints(){
+		OpenSSLDlogECF2m ec = (OpenSSLDlogECF2m) dlog;
+		GroupElement[] points = {ec.createRandomElement(), ec.getInfinity(), ec.exponentiate(ec.getGenerator(), BigInteger.TEN)};
+		
+		// The points over binary fields are never compressed, so both values give the same encoding.
+		assertEquals(ec.getEncodingSize(false), ec.getEncodingSize(true));
+		for (boolean compressed : new boolean[]{true, false}){
+			byte[] encoded = ec.encodePoints(points, compressed);
+			assertEquals(points.length * ec.getEncodingSize(compressed), encoded.length);
+			GroupElement[] decoded = ec.decodePoints(encoded, points.length);
+			assertEquals(points[0], decoded[0]);
+			assertTrue(decoded[1].isInfinity());
+			assertEquals(points[2], decoded[2]);
+		}
+	}
 }
\ No newline at end of file
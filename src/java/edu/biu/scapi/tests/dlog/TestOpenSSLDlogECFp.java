@@ -3,8 +3,14 @@ package edu.biu.scapi.tests.dlog;
 import static org.junit.Assert.*;
 
 import java.io.IOException;
+import java.math.BigInteger;
+import java.util.Random;
+
+import org.junit.Test;
 
 import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.ECElement;
+import edu.biu.scapi.primitives.dlog.GroupElement;
 import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogECFp;
 
 public class TestOpenSSLDlogECFp extends TestDlogGroupInterface{
@@ -21,4 +27,113 @@ public class TestOpenSSLDlogECFp extends TestDlogGroupInterface{
 	public String getGroupType(){
 		return "ECFp";
 	}
+	
+	protected boolean isThreadSafe(){
+		return true;
+	}
+	
+	@Test
+	public void TestEncodeDecodePoints(){
+		OpenSSLDlogECFp ec = (OpenSSLDlogECFp) dlog;
+		GroupElement[] points = {ec.createRandomElement(), ec.getInfinity(), ec.exponentiate(ec.getGenerator(), BigInteger.TEN)};
+		
+		for (boolean compressed : new boolean[]{true, false}){
+			byte[] encoded = ec.encodePoints(points, compressed);
+			assertEquals(points.length * ec.getEncodingSize(compressed), encoded.length);
+			GroupElement[] decoded = ec.decodePoints(encoded, points.length);
+			assertEquals(points[0], decoded[0]);
+			assertTrue(decoded[1].isInfinity());
+			assertEquals(points[2], decoded[2]);
+		}
+	}
+	
+	@Test
+	public void TestFixedBaseTables(){
+		OpenSSLDlogECFp ec = (OpenSSLDlogECFp) dlog;
+		BigInteger[] exponents = {BigInteger.ZERO, BigInteger.valueOf(-7), ec.getOrder().subtract(BigInteger.ONE), ec.getOrder().shiftLeft(3).add(BigInteger.TEN)};
+		
+		for (int window : new int[]{1, 4, 0}){
+			ec.setWindow(window);
+			GroupElement base = ec.createRandomElement();
+			GroupElement[] res = ec.fixedBaseExponentiateBatch(base, exponents);
+			for (int i = 0; i < exponents.length; i++){
+				GroupElement expected = ec.exponentiate(base, exponents[i].mod(ec.getOrder()));
+				assertEquals(expected.isInfinity(), res[i].isInfinity());
+				if (!expected.isInfinity()){
+					assertEquals(expected, ec.exponentiateWithPreComputedValues(base, exponents[i]));
+					assertEquals(expected, res[i]);
+				}
+			}
+			ec.endExponentiateWithPreComputedValues(base);
+		}
+	}
+	
+	@Test
+	public void TestDeterministicEncoding(){
+		OpenSSLDlogECFp ec = (OpenSSLDlogECFp) dlog;
+		int k = ec.getMaxLengthOfByteArrayForEncoding();
+		byte[][] strings = {new byte[0], new byte[k], new byte[k + 1], "abc".getBytes()};
+		new Random().nextBytes(strings[1]);
+		
+		ec.setDeterministicEncoding(true);
+		GroupElement[] points = ec.encodeByteArraysToGroupElements(strings);
+		assertNull(points[2]);
+		for (int i : new int[]{0, 1, 3}){
+			assertEquals(ec.encodeByteArrayToGroupElement(strings[i]), points[i]);
+			assertTrue(ec.isMember(points[i]));
+			assertArrayEquals(strings[i], ec.decodeGroupElementToByteArray(points[i]));
+		}
+		ec.setDeterministicEncoding(false);
+		
+		// The map is kept when the random encoding is chosen, and it is used again.
+		ec.setDeterministicEncoding(true);
+		assertEquals(points[3], ec.encodeByteArrayToGroupElement(strings[3]));
+		ec.setDeterministicEncoding(false);
+	}
+	
+	private void assertSamePoint(GroupElement expected, GroupElement actual){
+		ECElement expectedPoint = (ECElement) expected;
+		ECElement actualPoint = (ECElement) actual;
+		assertEquals(expectedPoint.isInfinity(), actualPoint.isInfinity());
+		if (!expectedPoint.isInfinity()){
+			assertEquals(expectedPoint.getX(), actualPoint.getX());
+			assertEquals(expectedPoint.getY(), actualPoint.getY());
+		}
+	}
+	
+	@Test
+	public void TestNamedCurve() throws IOException{
+		OpenSSLDlogECFp named = new OpenSSLDlogECFp("P-256");
+		OpenSSLDlogECFp explicit;
+		OpenSSLDlogECFp.setUseNamedCurves(false);
+		try {
+			explicit = new OpenSSLDlogECFp("P-256");
+		} finally {
+			OpenSSLDlogECFp.setUseNamedCurves(true);
+		}
+		
+		// P-192 (the curve of the other tests) and P-256 are built in curves of OpenSSL.
+		assertTrue(((OpenSSLDlogECFp) dlog).isNamedCurve());
+		assertTrue(named.isNamedCurve());
+		assertFalse(explicit.isNamedCurve());
+		assertSamePoint(named.getGenerator(), explicit.getGenerator());
+		
+		// The named curve gives the same results as the curve that is built from the parameters.
+		ECElement base = (ECElement) named.createRandomElement();
+		GroupElement explicitBase = explicit.generateElement(true, base.getX(), base.getY());
+		BigInteger order = named.getOrder();
+		Random random = new Random();
+		BigInteger[] exponents = {BigInteger.ZERO, BigInteger.ONE, order.subtract(BigInteger.ONE), 
+				new BigInteger(order.bitLength(), random), new BigInteger(order.bitLength(), random)};
+		for (BigInteger exponent : exponents){
+			assertSamePoint(named.exponentiate(base, exponent), explicit.exponentiate(explicitBase, exponent));
+			assertSamePoint(named.exponentiate(named.getGenerator(), exponent), explicit.exponentiate(explicit.getGenerator(), exponent));
+			assertSamePoint(named.exponentiateWithPreComputedValues(base, exponent), explicit.exponentiateWithPreComputedValues(explicitBase, exponent));
+		}
+		assertSamePoint(named.multiplyGroupElements(base, named.getGenerator()), explicit.multiplyGroupElements(explicitBase, explicit.getGenerator()));
+		assertSamePoint(named.simultaneousMultipleExponentiations(new GroupElement[]{base, named.getGenerator()}, new BigInteger[]{exponents[3], exponents[4]}), 
+				explicit.simultaneousMultipleExponentiations(new GroupElement[]{explicitBase, explicit.getGenerator()}, new BigInteger[]{exponents[3], exponents[4]}));
+		named.endExponentiateWithPreComputedValues(base);
+		explicit.endExponentiateWithPreComputedValues(explicitBase);
+	}
 }
\ No newline at end of file
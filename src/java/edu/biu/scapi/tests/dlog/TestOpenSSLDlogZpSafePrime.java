@@ -1,6 +1,15 @@
 package edu.biu.scapi.tests.dlog;
 
+import static org.junit.Assert.*;
+
+import java.math.BigInteger;
+import java.util.Random;
+
+import org.junit.Test;
+
 import edu.biu.scapi.primitives.dlog.DlogGroup;
+import edu.biu.scapi.primitives.dlog.GroupElement;
+import edu.biu.scapi.primitives.dlog.groupParams.ZpGroupParams;
 import edu.biu.scapi.primitives.dlog.openSSL.OpenSSLDlogZpSafePrime;
 
 public class TestOpenSSLDlogZpSafePrime extends TestDlogGroupInterface{
@@ -13,4 +22,103 @@ public class TestOpenSSLDlogZpSafePrime extends TestDlogGroupInterface{
 		return "Zp*";
 	}
 	
+	protected boolean isThreadSafe(){
+		return true;
+	}
+	
+	@Test
+	public void TestElementScope(){
+		OpenSSLDlogZpSafePrime zp = (OpenSSLDlogZpSafePrime) dlog;
+		GroupElement base = zp.createRandomElement();
+		
+		zp.beginElementScope();
+		GroupElement temp = zp.exponentiate(base, BigInteger.TEN);
+		GroupElement result = zp.multiplyGroupElements(temp, base);
+		zp.endElementScope(result);
+		
+		assertEquals(zp.exponentiate(base, BigInteger.valueOf(11)), result);
+		try {
+			zp.exponentiate(temp, BigInteger.TEN);
+			fail("a released element was used");
+		} catch (IllegalStateException e) {
+		}
+	}
+	
+	@Test
+	public void TestFixedBaseTables(){
+		OpenSSLDlogZpSafePrime zp = (OpenSSLDlogZpSafePrime) dlog;
+		BigInteger q = zp.getOrder();
+		BigInteger[] exponents = {BigInteger.ZERO, BigInteger.ONE, q.subtract(BigInteger.ONE), new BigInteger(q.bitLength() - 1, new Random())};
+		
+		// Three bases with room for two tables, so the tables are deleted and computed again.
+		zp.setMaxFixedBaseTables(2);
+		GroupElement[] bases = {zp.createRandomElement(), zp.createRandomElement(), zp.createRandomElement()};
+		for (int round = 0; round < 2; round++){
+			for (GroupElement base : bases){
+				GroupElement[] res = zp.fixedBaseExponentiateBatch(base, exponents);
+				for (int i = 0; i < exponents.length; i++){
+					GroupElement expected = zp.exponentiate(base, exponents[i]);
+					assertEquals(expected, zp.exponentiateWithPreComputedValues(base, exponents[i]));
+					assertEquals(expected, res[i]);
+				}
+			}
+		}
+		// A base can be used again after its table was ended.
+		zp.endExponentiateWithPreComputedValues(bases[0]);
+		assertEquals(zp.exponentiate(bases[0], exponents[3]), zp.exponentiateWithPreComputedValues(bases[0], exponents[3]));
+		zp.endExponentiateWithPreComputedValues(bases[0]);
+		try {
+			zp.setMaxFixedBaseTables(0);
+			fail("no tables can be kept");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+	
+	@Test
+	public void TestEndTableWhileExponentiating() throws InterruptedException{
+		final OpenSSLDlogZpSafePrime zp = (OpenSSLDlogZpSafePrime) dlog;
+		final GroupElement base = zp.createRandomElement();
+		final BigInteger exponent = zp.getOrder().subtract(BigInteger.TEN);
+		final GroupElement expected = zp.exponentiate(base, exponent);
+		final boolean[] failed = new boolean[1];
+		
+		Thread[] threads = new Thread[4];
+		for (int t = 0; t < threads.length; t++){
+			threads[t] = new Thread(){
+				public void run(){
+					for (int i = 0; i < 200; i++){
+						if (!expected.equals(zp.exponentiateWithPreComputedValues(base, exponent))){
+							failed[0] = true;
+						}
+					}
+				}
+			};
+			threads[t].start();
+		}
+		// Ends the table while the other threads use it. Each of them finishes with the table it acquired.
+		for (int i = 0; i < 200; i++){
+			zp.endExponentiateWithPreComputedValues(base);
+		}
+		for (Thread thread : threads){
+			thread.join();
+		}
+		assertFalse(failed[0]);
+		zp.endExponentiateWithPreComputedValues(base);
+	}
+	
+	@Test
+	public void TestAreMembersWithNonMembers(){
+		BigInteger p = ((ZpGroupParams) dlog.getGroupParams()).getP();
+		// p-1 is not a quadratic residue, since p = 3 mod 4.
+		GroupElement[] elements = {dlog.createRandomElement(), dlog.generateElement(false, p.subtract(BigInteger.ONE)), 
+								   dlog.generateElement(false, p), dlog.getIdentity()};
+		
+		boolean[] members = dlog.areMembers(elements);
+		for (int i = 0; i < elements.length; i++){
+			assertEquals(dlog.isMember(elements[i]), members[i]);
+		}
+		assertTrue(members[0]);
+		assertFalse(members[1]);
+		assertFalse(members[2]);
+	}
 }
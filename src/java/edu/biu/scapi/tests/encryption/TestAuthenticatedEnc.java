@@ -0,0 +1,104 @@
+package edu.biu.scapi.tests.encryption;
+
+import static org.junit.Assert.*;
+
+import java.security.InvalidKeyException;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.scapi.midLayer.ciphertext.ByteArraySymCiphertext;
+import edu.biu.scapi.midLayer.ciphertext.IVCiphertext;
+import edu.biu.scapi.midLayer.ciphertext.SymmetricCiphertext;
+import edu.biu.scapi.midLayer.plaintext.ByteArrayPlaintext;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.AuthenticatedEnc;
+
+public abstract class TestAuthenticatedEnc {
+	
+	public abstract AuthenticatedEnc createInstance();
+	
+	/**
+	 * Returns the size of the tag at the end of each ciphertext.
+	 */
+	protected abstract int getTagSize();
+	
+	protected AuthenticatedEnc enc = createInstance();
+	private Random random = new Random();
+	
+	private void setRandomKey() throws InvalidKeyException{
+		enc.setKey(enc.generateKey(128));
+	}
+	
+	// Returns a copy of the given ciphertext, with one bit flipped in the given byte.
+	private IVCiphertext flipBit(IVCiphertext cipher, int index){
+		byte[] bytes = cipher.getBytes().clone();
+		bytes[index] ^= 1;
+		return new IVCiphertext(new ByteArraySymCiphertext(bytes), cipher.getIv());
+	}
+	
+	@Test
+	public void TestRoundTrip() throws InvalidKeyException{
+		setRandomKey();
+		for (int size : new int[]{0, 1, 15, 16, 17, 1000}){
+			byte[] text = new byte[size];
+			random.nextBytes(text);
+			
+			SymmetricCiphertext cipher = enc.encrypt(new ByteArrayPlaintext(text));
+			assertEquals(size + getTagSize(), cipher.getBytes().length);
+			assertArrayEquals(text, ((ByteArrayPlaintext) enc.decrypt(cipher)).getText());
+		}
+	}
+	
+	@Test
+	public void TestTamperedTag() throws InvalidKeyException{
+		setRandomKey();
+		byte[] text = new byte[40];
+		random.nextBytes(text);
+		IVCiphertext cipher = (IVCiphertext) enc.encrypt(new ByteArrayPlaintext(text));
+		
+		int length = cipher.getBytes().length;
+		for (int i = length - getTagSize(); i < length; i++){
+			assertNull(enc.decrypt(flipBit(cipher, i)));
+		}
+	}
+	
+	@Test
+	public void TestTamperedCiphertext() throws InvalidKeyException{
+		setRandomKey();
+		byte[] text = new byte[40];
+		random.nextBytes(text);
+		IVCiphertext cipher = (IVCiphertext) enc.encrypt(new ByteArrayPlaintext(text));
+		
+		for (int i = 0; i < text.length; i++){
+			assertNull(enc.decrypt(flipBit(cipher, i)));
+		}
+		// A changed IV is rejected as well.
+		byte[] iv = cipher.getIv().clone();
+		iv[0] ^= 1;
+		assertNull(enc.decrypt(new IVCiphertext(new ByteArraySymCiphertext(cipher.getBytes()), iv)));
+		
+		// The original ciphertext is still accepted.
+		assertArrayEquals(text, ((ByteArrayPlaintext) enc.decrypt(cipher)).getText());
+	}
+	
+	@Test
+	public void TestWrongIVSize() throws InvalidKeyException{
+		setRandomKey();
+		byte[] text = new byte[40];
+		random.nextBytes(text);
+		IVCiphertext cipher = (IVCiphertext) enc.encrypt(new ByteArrayPlaintext(text));
+		int ivSize = cipher.getIv().length;
+		
+		// A ciphertext that came from the other party with a short or long IV is rejected, and is not read beyond its IV.
+		for (int size : new int[]{0, 1, ivSize - 1, ivSize + 1}){
+			byte[] iv = new byte[size];
+			System.arraycopy(cipher.getIv(), 0, iv, 0, Math.min(size, ivSize));
+			assertNull(enc.decrypt(new IVCiphertext(new ByteArraySymCiphertext(cipher.getBytes()), iv)));
+		}
+	}
+	
+	@Test(expected = IllegalStateException.class)
+	public void TestEncryptWithoutKey(){
+		createInstance().encrypt(new ByteArrayPlaintext(new byte[16]));
+	}
+}
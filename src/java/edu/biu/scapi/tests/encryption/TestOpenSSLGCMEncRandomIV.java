@@ -0,0 +1,50 @@
+package edu.biu.scapi.tests.encryption;
+
+import static org.junit.Assert.*;
+
+import java.security.InvalidKeyException;
+
+import javax.crypto.IllegalBlockSizeException;
+
+import org.junit.Test;
+
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.AuthenticatedEnc;
+import edu.biu.scapi.midLayer.symmetricCrypto.encryption.OpenSSLGCMEncRandomIV;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLAES;
+
+public class TestOpenSSLGCMEncRandomIV extends TestAuthenticatedEnc{
+
+	public AuthenticatedEnc createInstance(){
+		return new OpenSSLGCMEncRandomIV(new OpenSSLAES());
+	}
+	
+	protected int getTagSize(){
+		return 16;
+	}
+	
+	@Test
+	public void TestCiphertextSizeWithoutKey(){
+		try {
+			((OpenSSLGCMEncRandomIV) createInstance()).getCiphertextSize(10);
+			fail("the block size is not known before the key is set");
+		} catch (IllegalStateException e) {
+		}
+	}
+	
+	@Test
+	public void TestTamperedArrays() throws InvalidKeyException, IllegalBlockSizeException{
+		OpenSSLGCMEncRandomIV gcm = (OpenSSLGCMEncRandomIV) enc;
+		gcm.setKey(gcm.generateKey(128));
+		byte[] iv = new byte[12];
+		byte[] text = "authenticated data".getBytes();
+		
+		byte[] cipher = new byte[gcm.getCiphertextSize(text.length)];
+		assertEquals(cipher.length, gcm.encrypt(text, 0, text.length, iv, cipher, 0));
+		cipher[cipher.length - 1] ^= 1;
+		
+		// The decryption fails, and the plaintext of the rejected ciphertext is not left in the output.
+		byte[] out = new byte[cipher.length];
+		assertEquals(-1, gcm.decrypt(cipher, 0, cipher.length, iv, out, 0));
+		assertFalse(new String(out).contains("authenticated"));
+	}
+}
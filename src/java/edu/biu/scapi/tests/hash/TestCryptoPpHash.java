@@ -0,0 +1,17 @@
+package edu.biu.scapi.tests.hash;
+
+import edu.biu.scapi.primitives.hash.CryptographicHash;
+import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpHash;
+import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpSHA1;
+import edu.biu.scapi.primitives.hash.cryptopp.CryptoPpSHA256;
+
+public class TestCryptoPpHash extends TestNativeHashInterface {
+
+	public CryptographicHash createHash(String algorithm){
+		return algorithm.equals("SHA-1") ? new CryptoPpSHA1() : new CryptoPpSHA256();
+	}
+	
+	public void hashMany(CryptographicHash hash, byte[] buffer, int[] offsets, int[] lengths, byte[] out){
+		((CryptoPpHash) hash).hashMany(buffer, offsets, lengths, out);
+	}
+}
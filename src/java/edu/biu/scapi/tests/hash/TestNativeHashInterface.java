@@ -0,0 +1,183 @@
+package edu.biu.scapi.tests.hash;
+
+import static org.junit.Assert.*;
+
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Random;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.hash.CryptographicHash;
+
+/**
+ * Tests the native hashes of a provider against the hashes of the JDK: the hash of one message given in parts at any offsets, 
+ * and the hash of many messages in one native call.
+ */
+public abstract class TestNativeHashInterface {
+	
+	//The hashes that have a multi-buffer implementation, by their JDK names.
+	private static final String[] ALGORITHMS = {"SHA-1", "SHA-256"};
+	
+	//The multi-buffer hash takes runs of at least 4 consecutive messages of the same length.
+	private static final int MULTI_BUFFER_RUN = 4;
+	
+	private Random random = new Random(7693);
+	
+	/**
+	 * @return the hash of this provider that has the given JDK name
+	 */
+	public abstract CryptographicHash createHash(String algorithm);
+	
+	/**
+	 * Calls the hashMany function of the given hash of this provider.
+	 */
+	public abstract void hashMany(CryptographicHash hash, byte[] buffer, int[] offsets, int[] lengths, byte[] out);
+	
+	private static byte[] jdkHash(String algorithm, byte[] buffer, int offset, int length) throws NoSuchAlgorithmException{
+		MessageDigest digest = MessageDigest.getInstance(algorithm);
+		digest.update(buffer, offset, length);
+		return digest.digest();
+	}
+	
+	/**
+	 * @return the hash of the message by update and hashFinal. An empty message is not given to update, which does not accept it.
+	 */
+	private static byte[] hashOne(CryptographicHash hash, byte[] buffer, int offset, int length){
+		if (length > 0){
+			hash.update(buffer, offset, length);
+		}
+		byte[] digest = new byte[hash.getHashedMsgSize()];
+		hash.hashFinal(digest, 0);
+		return digest;
+	}
+	
+	/**
+	 * @return message lengths that mix empty messages, block boundaries, and runs of equal lengths that are shorter than, 
+	 * equal to and longer than the shortest run of the multi-buffer hash
+	 */
+	private static int[] mixedLengths(){
+		List<Integer> lengths = new ArrayList<Integer>();
+		int[] singles = {0, 1, 55, 56, 63, 64, 65, 119, 120, 1000, 0};
+		for (int length : singles){
+			lengths.add(length);
+		}
+		int[][] runs = {{64, MULTI_BUFFER_RUN - 1}, {55, MULTI_BUFFER_RUN}, {0, MULTI_BUFFER_RUN + 1}, {100, 2 * MULTI_BUFFER_RUN + 1}, 
+				{32, 2 * MULTI_BUFFER_RUN}, {1000, MULTI_BUFFER_RUN}};
+		for (int[] run : runs){
+			for (int i = 0; i < run[1]; i++){
+				lengths.add(run[0]);
+			}
+			lengths.add(3);
+		}
+		
+		int[] result = new int[lengths.size()];
+		for (int i = 0; i < result.length; i++){
+			result[i] = lengths.get(i);
+		}
+		return result;
+	}
+	
+	/**
+	 * Checks hashMany on messages of the given lengths, at random non zero offsets of one buffer.
+	 */
+	private void checkHashMany(String algorithm, int[] lengths) throws NoSuchAlgorithmException{
+		CryptographicHash hash = createHash(algorithm);
+		CryptographicHash single = createHash(algorithm);
+		int digestSize = hash.getHashedMsgSize();
+		
+		byte[] buffer = new byte[3000];
+		random.nextBytes(buffer);
+		int[] offsets = new int[lengths.length];
+		for (int i = 0; i < lengths.length; i++){
+			offsets[i] = 1 + random.nextInt(buffer.length - lengths[i]);
+		}
+		
+		byte[] out = new byte[lengths.length * digestSize];
+		hashMany(hash, buffer, offsets, lengths, out);
+		
+		for (int i = 0; i < lengths.length; i++){
+			byte[] digest = Arrays.copyOfRange(out, i * digestSize, (i + 1) * digestSize);
+			String message = algorithm + " message " + i + " of length " + lengths[i];
+			assertArrayEquals(message, hashOne(single, buffer, offsets[i], lengths[i]), digest);
+			assertArrayEquals(message, jdkHash(algorithm, buffer, offsets[i], lengths[i]), digest);
+		}
+	}
+	
+	@Test
+	public void TestHashManyMixedLengths() throws NoSuchAlgorithmException{
+		for (String algorithm : ALGORITHMS){
+			checkHashMany(algorithm, mixedLengths());
+		}
+	}
+	
+	@Test
+	public void TestHashManyLargeBatch() throws NoSuchAlgorithmException{
+		//Enough messages to be split between native threads, with runs of equal lengths that cross the ranges of the threads.
+		int[] lengths = new int[2000];
+		for (int i = 0; i < lengths.length; i++){
+			lengths[i] = (i % 100 < 50) ? 40 : random.nextInt(200);
+		}
+		for (String algorithm : ALGORITHMS){
+			checkHashMany(algorithm, lengths);
+		}
+	}
+	
+	@Test
+	public void TestHashManyEmptyBatch() throws NoSuchAlgorithmException{
+		for (String algorithm : ALGORITHMS){
+			checkHashMany(algorithm, new int[0]);
+		}
+	}
+	
+	@Test
+	public void TestHashManyKeepsUpdatedMessage() throws NoSuchAlgorithmException{
+		for (String algorithm : ALGORITHMS){
+			CryptographicHash hash = createHash(algorithm);
+			byte[] buffer = new byte[200];
+			random.nextBytes(buffer);
+			
+			hash.update(buffer, 0, 100);
+			hashMany(hash, buffer, new int[]{10, 20, 30, 40}, new int[]{50, 50, 50, 50}, new byte[4 * hash.getHashedMsgSize()]);
+			hash.update(buffer, 100, 100);
+			
+			byte[] digest = new byte[hash.getHashedMsgSize()];
+			hash.hashFinal(digest, 0);
+			assertArrayEquals(jdkHash(algorithm, buffer, 0, buffer.length), digest);
+		}
+	}
+	
+	@Test
+	public void TestUpdateAtOffsets() throws NoSuchAlgorithmException{
+		for (String algorithm : ALGORITHMS){
+			CryptographicHash hash = createHash(algorithm);
+			int digestSize = hash.getHashedMsgSize();
+			byte[] buffer = new byte[1000];
+			random.nextBytes(buffer);
+			
+			//The message is buffer[17 .. 917), given in parts that start and end inside blocks.
+			int[] parts = {1, 62, 3, 64, 200, 570};
+			int offset = 17;
+			for (int part : parts){
+				hash.update(buffer, offset, part);
+				offset += part;
+			}
+			
+			//The digest is put at a non zero offset, and the bytes around it are not changed.
+			byte[] out = new byte[digestSize + 13];
+			Arrays.fill(out, (byte) 0x5a);
+			hash.hashFinal(out, 6);
+			
+			byte[] expected = new byte[digestSize + 13];
+			Arrays.fill(expected, (byte) 0x5a);
+			System.arraycopy(jdkHash(algorithm, buffer, 17, offset - 17), 0, expected, 6, digestSize);
+			assertArrayEquals(expected, out);
+			
+			//The hash starts again after hashFinal.
+			assertArrayEquals(jdkHash(algorithm, buffer, 500, 300), hashOne(hash, buffer, 500, 300));
+		}
+	}
+}
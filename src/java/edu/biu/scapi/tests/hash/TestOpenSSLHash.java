@@ -0,0 +1,17 @@
+package edu.biu.scapi.tests.hash;
+
+import edu.biu.scapi.primitives.hash.CryptographicHash;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLHash;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA1;
+import edu.biu.scapi.primitives.hash.openSSL.OpenSSLSHA256;
+
+public class TestOpenSSLHash extends TestNativeHashInterface {
+
+	public CryptographicHash createHash(String algorithm){
+		return algorithm.equals("SHA-1") ? new OpenSSLSHA1() : new OpenSSLSHA256();
+	}
+	
+	public void hashMany(CryptographicHash hash, byte[] buffer, int[] offsets, int[] lengths, byte[] out){
+		((OpenSSLHash) hash).hashMany(buffer, offsets, lengths, out);
+	}
+}
@@ -0,0 +1,87 @@
+package edu.biu.scapi.tests.hash;
+
+import static org.junit.Assert.*;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.hash.ScBLAKE2s;
+
+/**
+ * Tests ScBLAKE2s against known answers: the example of RFC 7693 (appendix B) and the unkeyed 32 bytes BLAKE2s 
+ * of the reference implementation, for the messages that fill one block exactly and that take more than one block.
+ */
+public class TestScBLAKE2s {
+	
+	private ScBLAKE2s blake2s = new ScBLAKE2s();
+	
+	/**
+	 * @return the bytes 0, 1, 2, ... (mod 256) of the given length
+	 */
+	private static byte[] sequence(int length){
+		byte[] msg = new byte[length];
+		for (int i = 0; i < length; i++){
+			msg[i] = (byte) i;
+		}
+		return msg;
+	}
+	
+	private static byte[] fromHex(String hex){
+		byte[] bytes = new byte[hex.length() / 2];
+		for (int i = 0; i < bytes.length; i++){
+			bytes[i] = (byte) Integer.parseInt(hex.substring(2 * i, 2 * i + 2), 16);
+		}
+		return bytes;
+	}
+	
+	private byte[] hash(byte[] msg){
+		if (msg.length > 0){
+			blake2s.update(msg, 0, msg.length);
+		}
+		byte[] digest = new byte[blake2s.getHashedMsgSize()];
+		blake2s.hashFinal(digest, 0);
+		return digest;
+	}
+	
+	@Test
+	public void TestDigestSize(){
+		assertEquals(32, blake2s.getHashedMsgSize());
+	}
+	
+	@Test
+	public void TestRfc7693Example(){
+		assertArrayEquals(fromHex("508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982"), hash("abc".getBytes()));
+	}
+	
+	@Test
+	public void TestEmptyMessage(){
+		assertArrayEquals(fromHex("69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9"), hash(new byte[0]));
+	}
+	
+	@Test
+	public void TestOneFullBlock(){
+		assertArrayEquals(fromHex("56f34e8b96557e90c1f24b52d0c89d51086acf1b00f634cf1dde9233b8eaaa3e"), hash(sequence(64)));
+	}
+	
+	@Test
+	public void TestMultiBlock(){
+		assertArrayEquals(fromHex("1b53ee94aaf34e4b159d48de352c7f0661d0a40edff95a0b1639b4090e974472"), hash(sequence(65)));
+		assertArrayEquals(fromHex("5fdeb59f681d975f52c8e69c5502e02a12a3afcc5836ba58f42784c439228781"), hash(sequence(256)));
+	}
+	
+	@Test
+	public void TestSplitUpdates(){
+		//The message may be given in several parts, at any offsets, and the hash restarts after hashFinal.
+		byte[] msg = sequence(256);
+		blake2s.update(msg, 0, 1);
+		blake2s.update(msg, 1, 100);
+		blake2s.update(msg, 101, 155);
+		byte[] digest = new byte[40];
+		blake2s.hashFinal(digest, 8);
+		
+		byte[] expected = new byte[40];
+		System.arraycopy(fromHex("5fdeb59f681d975f52c8e69c5502e02a12a3afcc5836ba58f42784c439228781"), 0, expected, 8, 32);
+		assertArrayEquals(expected, digest);
+		
+		assertArrayEquals(fromHex("508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982"), hash("abc".getBytes()));
+	}
+}
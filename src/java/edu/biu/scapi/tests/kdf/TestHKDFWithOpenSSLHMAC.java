@@ -0,0 +1,92 @@
+package edu.biu.scapi.tests.kdf;
+
+import static org.junit.Assert.*;
+
+import java.util.Random;
+
+import javax.crypto.spec.SecretKeySpec;
+
+import org.bouncycastle.util.encoders.Hex;
+import org.junit.Test;
+
+import edu.biu.scapi.exceptions.FactoriesException;
+import edu.biu.scapi.primitives.kdf.HKDF;
+import edu.biu.scapi.primitives.prf.bc.BcHMAC;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLHMAC;
+
+/**
+ * HKDF computes all the expand rounds in one native call when its hmac is an OpenSSLHMAC.
+ * These tests check that this path gives the same keys as the rounds computed in java.
+ */
+public class TestHKDFWithOpenSSLHMAC {
+	
+	private static final int[] LENGTHS = {1, 16, 19, 20, 21, 32, 33, 40, 64, 100, 1000};
+	
+	private Random random = new Random();
+	
+	private void testMatchesBcHMAC(String hashName) throws FactoriesException{
+		HKDF openSSLHkdf = new HKDF(new OpenSSLHMAC(hashName));
+		HKDF bcHkdf = new HKDF(new BcHMAC(hashName));
+		byte[] source = new byte[50];
+		random.nextBytes(source);
+		byte[] iv = "context information".getBytes();
+		
+		for (int outLen : LENGTHS){
+			assertArrayEquals(bcHkdf.deriveKey(source, 0, source.length, outLen).getEncoded(), 
+							  openSSLHkdf.deriveKey(source, 0, source.length, outLen).getEncoded());
+			assertArrayEquals(bcHkdf.deriveKey(source, 0, source.length, outLen, iv).getEncoded(), 
+							  openSSLHkdf.deriveKey(source, 0, source.length, outLen, iv).getEncoded());
+		}
+	}
+	
+	@Test
+	public void TestMatchesBcHMACWithSHA1() throws FactoriesException{
+		testMatchesBcHMAC("SHA-1");
+	}
+	
+	@Test
+	public void TestMatchesBcHMACWithSHA256() throws FactoriesException{
+		testMatchesBcHMAC("SHA-256");
+	}
+	
+	@Test
+	public void TestMatchesBcHMACWithSHA512() throws FactoriesException{
+		testMatchesBcHMAC("SHA-512");
+	}
+	
+	/**
+	 * Checks OpenSSLHMAC.expand against test case 1 of RFC 5869, starting from its PRK.
+	 */
+	@Test
+	public void TestExpandRFC5869() throws FactoriesException{
+		OpenSSLHMAC hmac = new OpenSSLHMAC("SHA-256");
+		hmac.setKey(new SecretKeySpec(Hex.decode("077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5"), "HKDF"));
+		byte[] info = Hex.decode("f0f1f2f3f4f5f6f7f8f9");
+		byte[] expected = Hex.decode("3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865");
+		
+		//The output is put at the given offset, and the bytes around it are not changed.
+		byte[] out = new byte[expected.length + 6];
+		hmac.expand(info, out, 3, expected.length);
+		byte[] okm = new byte[expected.length];
+		System.arraycopy(out, 3, okm, 0, okm.length);
+		assertArrayEquals(expected, okm);
+		assertEquals(0, out[2]);
+		assertEquals(0, out[expected.length + 3]);
+		
+		//The hmac can be used again after expand.
+		byte[] again = new byte[expected.length];
+		hmac.expand(info, again, 0, again.length);
+		assertArrayEquals(expected, again);
+	}
+	
+	@Test
+	public void TestExpandWrongOffset() throws FactoriesException{
+		OpenSSLHMAC hmac = new OpenSSLHMAC("SHA-256");
+		hmac.setKey(new SecretKeySpec(new byte[32], "HKDF"));
+		try {
+			hmac.expand(null, new byte[10], 5, 6);
+			fail("the output does not fit in the array");
+		} catch (ArrayIndexOutOfBoundsException e) {
+		}
+	}
+}
@@ -0,0 +1,82 @@
+package edu.biu.scapi.tests.kdf;
+
+import static org.junit.Assert.*;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import org.bouncycastle.util.encoders.Hex;
+import org.junit.Test;
+
+import edu.biu.scapi.exceptions.FactoriesException;
+import edu.biu.scapi.primitives.kdf.HKDF;
+import edu.biu.scapi.primitives.kdf.openSSL.OpenSSLHKDF;
+import edu.biu.scapi.primitives.prf.bc.BcHMAC;
+
+public class TestOpenSSLHKDF {
+	
+	//The fixed salt of HKDF.deriveKey.
+	private static final byte[] FIXED_SALT = Hex.decode("606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9fa0a1a2a3a4a5a6a7a8a9aaabacadaeaf");
+	private static final int[] LENGTHS = {1, 16, 20, 21, 32, 33, 64, 100, 1000};
+	
+	private Random random = new Random();
+	
+	private void testMatchesHKDF(String hashName) throws FactoriesException{
+		HKDF hkdf = new HKDF(new BcHMAC(hashName));
+		OpenSSLHKDF openSSLHkdf = new OpenSSLHKDF(hashName);
+		byte[] source = new byte[50];
+		random.nextBytes(source);
+		byte[] iv = "context information".getBytes();
+		
+		for (int outLen : LENGTHS){
+			assertArrayEquals(hkdf.deriveKey(source, 0, source.length, outLen).getEncoded(), 
+							  openSSLHkdf.deriveKey(source, 0, source.length, outLen).getEncoded());
+			assertArrayEquals(hkdf.deriveKey(source, 5, 30, outLen, iv).getEncoded(), 
+							  openSSLHkdf.deriveKey(source, 5, 30, outLen, iv).getEncoded());
+		}
+	}
+	
+	@Test
+	public void TestMatchesHKDFWithSHA1() throws FactoriesException{
+		testMatchesHKDF("SHA-1");
+	}
+	
+	@Test
+	public void TestMatchesHKDFWithSHA256() throws FactoriesException{
+		testMatchesHKDF("SHA-256");
+	}
+	
+	@Test
+	public void TestDeriveKeys(){
+		OpenSSLHKDF hkdf = new OpenSSLHKDF("SHA-256");
+		byte[] source = new byte[32];
+		random.nextBytes(source);
+		byte[] iv = new byte[8];
+		random.nextBytes(iv);
+		
+		for (int outLen : LENGTHS){
+			//Each key is derived as with a single salt, and the fixed salt gives the key of deriveKey.
+			byte[][] salts = {FIXED_SALT, "salt".getBytes(), null};
+			byte[][] singleSalt = new byte[1][];
+			byte[][] keys = new byte[salts.length][];
+			for (int i = 0; i < salts.length; i++){
+				singleSalt[0] = salts[i];
+				keys[i] = hkdf.deriveKeys(source, 0, source.length, singleSalt, outLen, iv)[0].getEncoded();
+				assertArrayEquals(keys[i], hkdf.deriveKeys(source, 0, source.length, salts, outLen, iv)[i].getEncoded());
+			}
+			assertArrayEquals(hkdf.deriveKey(source, 0, source.length, outLen, iv).getEncoded(), keys[0]);
+			assertFalse(Arrays.equals(keys[0], keys[1]));
+		}
+	}
+	
+	@Test
+	public void TestDeriveKeysTooLong(){
+		OpenSSLHKDF hkdf = new OpenSSLHKDF("SHA-256");
+		int outLen = 255 * 32;
+		try {
+			hkdf.deriveKeys(new byte[16], 0, 16, new byte[Integer.MAX_VALUE / outLen + 1][], outLen, null);
+			fail("the keys do not fit in one array");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+}
@@ -0,0 +1,182 @@
+package edu.biu.scapi.tests.prf;
+
+import static org.junit.Assert.*;
+
+import java.nio.ByteBuffer;
+import java.security.GeneralSecurityException;
+import java.util.Arrays;
+import java.util.Random;
+
+import javax.crypto.Cipher;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.prf.BatchPrp;
+import edu.biu.scapi.primitives.prf.cryptopp.CryptoPpAES;
+import edu.biu.scapi.primitives.prf.miracl.MiraclAES;
+import edu.biu.scapi.primitives.prf.openSSL.OpenSSLAES;
+
+/**
+ * Tests that the batch functions of the native AES implementations (OpenSSL, Crypto++ and Miracl) agree with each other and 
+ * with the AES of the JDK, on arrays at non zero offsets and on direct buffers, and that invertBlocks inverts computeBlocks.
+ */
+public class TestBatchPrp {
+	
+	private static final int BLOCK_SIZE = 16;
+	private static final int[] KEY_SIZES = {16, 24, 32};
+	private static final int[] NUM_BLOCKS = {0, 1, 2, 7, 8, 9, 100};
+	
+	private Random random = new Random(197);
+	
+	private static BatchPrp[] createPrps(byte[] key) throws GeneralSecurityException{
+		BatchPrp[] prps = {new OpenSSLAES(), new CryptoPpAES(), new MiraclAES()};
+		for (BatchPrp prp : prps){
+			prp.setKey(new SecretKeySpec(key, "AES"));
+		}
+		return prps;
+	}
+	
+	private byte[] randomBytes(int length){
+		byte[] bytes = new byte[length];
+		random.nextBytes(bytes);
+		return bytes;
+	}
+	
+	/**
+	 * @return the given blocks computed by the AES of the JDK
+	 */
+	private static byte[] jdkCompute(byte[] key, byte[] blocks) throws GeneralSecurityException{
+		Cipher cipher = Cipher.getInstance("AES/ECB/NoPadding");
+		cipher.init(Cipher.ENCRYPT_MODE, new SecretKeySpec(key, "AES"));
+		return (blocks.length == 0) ? new byte[0] : cipher.doFinal(blocks);
+	}
+	
+	@Test
+	public void TestArraysAtOffsets() throws GeneralSecurityException{
+		for (int keySize : KEY_SIZES){
+			byte[] key = randomBytes(keySize);
+			BatchPrp[] prps = createPrps(key);
+			for (int numBlocks : NUM_BLOCKS){
+				int len = numBlocks * BLOCK_SIZE;
+				byte[] blocks = randomBytes(len);
+				
+				//Blocks at offsets that are not aligned to the block size, with bytes around them that should not change.
+				byte[] in = randomBytes(len + 11);
+				System.arraycopy(blocks, 0, in, 5, len);
+				byte[] inCopy = in.clone();
+				
+				byte[] expected = null;
+				for (BatchPrp prp : prps){
+					String message = prp.getAlgorithmName() + " with " + numBlocks + " blocks and a key of " + keySize + " bytes";
+					byte[] out = randomBytes(len + 9);
+					byte[] outCopy = out.clone();
+					prp.computeBlocks(in, 5, out, 3, numBlocks);
+					assertArrayEquals(message, inCopy, in);
+					assertArrayEquals(message, Arrays.copyOfRange(outCopy, 0, 3), Arrays.copyOfRange(out, 0, 3));
+					assertArrayEquals(message, Arrays.copyOfRange(outCopy, len + 3, len + 9), Arrays.copyOfRange(out, len + 3, len + 9));
+					
+					byte[] computed = Arrays.copyOfRange(out, 3, len + 3);
+					if (expected == null){
+						expected = computed;
+						if (keySize == 16){
+							assertArrayEquals(message, jdkCompute(key, blocks), computed);
+						}
+					}
+					assertArrayEquals(message, expected, computed);
+					
+					byte[] inverted = new byte[len + 2];
+					prp.invertBlocks(out, 3, inverted, 2, numBlocks);
+					assertArrayEquals(message, blocks, Arrays.copyOfRange(inverted, 2, len + 2));
+				}
+			}
+		}
+	}
+	
+	@Test
+	public void TestInPlace() throws GeneralSecurityException{
+		byte[] key = randomBytes(16);
+		byte[] blocks = randomBytes(9 * BLOCK_SIZE);
+		byte[] expected = jdkCompute(key, blocks);
+		for (BatchPrp prp : createPrps(key)){
+			byte[] inOut = new byte[blocks.length + 1];
+			System.arraycopy(blocks, 0, inOut, 1, blocks.length);
+			prp.computeBlocks(inOut, 1, inOut, 1, 9);
+			assertArrayEquals(prp.getAlgorithmName(), expected, Arrays.copyOfRange(inOut, 1, inOut.length));
+			prp.invertBlocks(inOut, 1, inOut, 1, 9);
+			assertArrayEquals(prp.getAlgorithmName(), blocks, Arrays.copyOfRange(inOut, 1, inOut.length));
+		}
+	}
+	
+	@Test
+	public void TestDirectBuffers() throws GeneralSecurityException{
+		for (int keySize : KEY_SIZES){
+			byte[] key = randomBytes(keySize);
+			BatchPrp[] prps = createPrps(key);
+			for (int numBlocks : NUM_BLOCKS){
+				int len = numBlocks * BLOCK_SIZE;
+				byte[] blocks = randomBytes(len);
+				
+				byte[] expected = new byte[len];
+				prps[0].computeBlocks(blocks, 0, expected, 0, numBlocks);
+				for (BatchPrp prp : prps){
+					String message = prp.getAlgorithmName() + " with " + numBlocks + " blocks and a key of " + keySize + " bytes";
+					
+					//The buffers are used from their positions, which are not changed.
+					ByteBuffer in = ByteBuffer.allocateDirect(len + 7);
+					in.position(7);
+					in.put(blocks);
+					in.position(7);
+					ByteBuffer out = ByteBuffer.allocateDirect(len + 5);
+					out.position(5);
+					
+					prp.computeBlocks(in, out, numBlocks);
+					assertEquals(message, 7, in.position());
+					assertEquals(message, 5, out.position());
+					byte[] computed = new byte[len];
+					out.get(computed);
+					assertArrayEquals(message, expected, computed);
+					
+					out.position(5);
+					ByteBuffer inverted = ByteBuffer.allocateDirect(len + 3);
+					inverted.position(3);
+					prp.invertBlocks(out, inverted, numBlocks);
+					byte[] result = new byte[len];
+					inverted.get(result);
+					assertArrayEquals(message, blocks, result);
+				}
+			}
+		}
+	}
+	
+	@Test
+	public void TestWrongArguments() throws GeneralSecurityException{
+		for (BatchPrp prp : createPrps(randomBytes(16))){
+			byte[] array = new byte[4 * BLOCK_SIZE];
+			int[][] wrong = {{1, 0, 4}, {0, 1, 4}, {-1, 0, 1}, {0, -1, 1}, {0, 0, -1}, {0, 0, 5}, {0, 0, Integer.MAX_VALUE / 8}};
+			for (int[] args : wrong){
+				try {
+					prp.computeBlocks(array, args[0], array, args[1], args[2]);
+					fail(prp.getAlgorithmName() + " should reject " + Arrays.toString(args));
+				} catch (ArrayIndexOutOfBoundsException e){
+				}
+				try {
+					prp.invertBlocks(array, args[0], array, args[1], args[2]);
+					fail(prp.getAlgorithmName() + " should reject " + Arrays.toString(args));
+				} catch (ArrayIndexOutOfBoundsException e){
+				}
+			}
+			
+			try {
+				prp.computeBlocks(ByteBuffer.allocate(BLOCK_SIZE), ByteBuffer.allocateDirect(BLOCK_SIZE), 1);
+				fail(prp.getAlgorithmName() + " should reject a buffer that is not direct");
+			} catch (IllegalArgumentException e){
+			}
+			try {
+				prp.invertBlocks(ByteBuffer.allocateDirect(BLOCK_SIZE), ByteBuffer.allocateDirect(BLOCK_SIZE), 2);
+				fail(prp.getAlgorithmName() + " should reject a buffer that is too small");
+			} catch (IndexOutOfBoundsException e){
+			}
+		}
+	}
+}
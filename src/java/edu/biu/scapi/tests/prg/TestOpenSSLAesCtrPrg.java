@@ -0,0 +1,145 @@
+package edu.biu.scapi.tests.prg;
+
+import static org.junit.Assert.*;
+
+import java.nio.ByteBuffer;
+import java.security.InvalidKeyException;
+
+import javax.crypto.Cipher;
+import javax.crypto.SecretKey;
+import javax.crypto.spec.IvParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.prg.openSSL.OpenSSLAesCtrPrg;
+
+/**
+ * The stream of OpenSSLAesCtrPrg should not depend on how the requests are split between the internal buffer (short requests), 
+ * the in place generation (at least 4KB) and the generation by the thread pool (at least 256KB).
+ */
+public class TestOpenSSLAesCtrPrg {
+	
+	//Sizes that take the bytes from the buffer, cross its end, generate in place and use the thread pool.
+	private static final int[] SIZES = {1, 15, 16, 17, 0, 4095, 4096, 4097, 33, 5000, 1 << 18, 7, (1 << 18) + 5, 100, 1 << 20, 3};
+	
+	/**
+	 * @return the first len bytes of AES-CTR with the given key, starting from a zero counter.
+	 */
+	private byte[] expectedStream(SecretKey key, int len) throws Exception{
+		Cipher aes = Cipher.getInstance("AES/CTR/NoPadding");
+		aes.init(Cipher.ENCRYPT_MODE, new SecretKeySpec(key.getEncoded(), "AES"), new IvParameterSpec(new byte[16]));
+		return aes.doFinal(new byte[len]);
+	}
+	
+	private int totalSize(){
+		int total = 0;
+		for (int size : SIZES){
+			total += size;
+		}
+		return total;
+	}
+	
+	private void testArrays(int keySize) throws Exception{
+		OpenSSLAesCtrPrg prg = new OpenSSLAesCtrPrg();
+		SecretKey key = prg.generateKey(keySize);
+		prg.setKey(key);
+		byte[] expected = expectedStream(key, totalSize());
+		
+		int done = 0;
+		for (int size : SIZES){
+			//The bytes are put at an offset, and the bytes around them are not changed.
+			byte[] out = new byte[size + 6];
+			prg.getPRGBytes(out, 3, size);
+			for (int i = 0; i < size; i++){
+				assertEquals(expected[done + i], out[3 + i]);
+			}
+			assertEquals(0, out[2]);
+			assertEquals(0, out[size + 3]);
+			done += size;
+		}
+	}
+	
+	@Test
+	public void TestMixedSizes128() throws Exception{
+		testArrays(128);
+	}
+	
+	@Test
+	public void TestMixedSizes256() throws Exception{
+		testArrays(256);
+	}
+	
+	@Test
+	public void TestFillBytes() throws Exception{
+		OpenSSLAesCtrPrg prg = new OpenSSLAesCtrPrg();
+		SecretKey key = prg.generateKey(128);
+		prg.setKey(key);
+		byte[] expected = expectedStream(key, totalSize());
+		
+		int done = 0;
+		for (int i = 0; i < SIZES.length; i++){
+			int size = SIZES[i];
+			//Mix direct buffers and arrays. The buffer is filled from its position to its limit, and its position is not changed.
+			if (i % 2 == 0){
+				ByteBuffer buffer = ByteBuffer.allocateDirect(size + 6);
+				buffer.position(3);
+				buffer.limit(size + 3);
+				prg.fillBytes(buffer);
+				assertEquals(3, buffer.position());
+				for (int j = 0; j < size; j++){
+					assertEquals(expected[done + j], buffer.get(3 + j));
+				}
+				assertEquals(0, buffer.get(2));
+				assertEquals(0, buffer.get(size + 3));
+			} else {
+				byte[] out = new byte[size];
+				prg.getPRGBytes(out, 0, size);
+				for (int j = 0; j < size; j++){
+					assertEquals(expected[done + j], out[j]);
+				}
+			}
+			done += size;
+		}
+	}
+	
+	@Test
+	public void TestSetKeyRestartsStream() throws Exception{
+		OpenSSLAesCtrPrg prg = new OpenSSLAesCtrPrg();
+		SecretKey key = prg.generateKey(128);
+		prg.setKey(key);
+		byte[] first = new byte[100];
+		prg.getPRGBytes(first, 0, first.length);
+		
+		prg.setKey(key);
+		byte[] again = new byte[100];
+		prg.getPRGBytes(again, 0, again.length);
+		assertArrayEquals(first, again);
+	}
+	
+	@Test
+	public void TestWrongArguments() throws Exception{
+		OpenSSLAesCtrPrg prg = new OpenSSLAesCtrPrg();
+		try {
+			prg.getPRGBytes(new byte[16], 0, 16);
+			fail("the key is not set");
+		} catch (IllegalStateException e) {
+		}
+		try {
+			prg.setKey(new SecretKeySpec(new byte[20], "AES"));
+			fail("the key size is not valid");
+		} catch (InvalidKeyException e) {
+		}
+		prg.setKey(prg.generateKey(128));
+		try {
+			prg.getPRGBytes(new byte[16], 10, 7);
+			fail("the output does not fit in the array");
+		} catch (ArrayIndexOutOfBoundsException e) {
+		}
+		try {
+			prg.fillBytes(ByteBuffer.allocate(16));
+			fail("the buffer is not direct");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+}
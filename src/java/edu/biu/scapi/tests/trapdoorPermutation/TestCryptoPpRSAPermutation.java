@@ -0,0 +1,11 @@
+package edu.biu.scapi.tests.trapdoorPermutation;
+
+import edu.biu.scapi.primitives.trapdoorPermutation.TrapdoorPermutation;
+import edu.biu.scapi.primitives.trapdoorPermutation.cryptopp.CryptoPpRSAPermutation;
+
+public class TestCryptoPpRSAPermutation extends TestRSAPermutationInterface {
+
+	public TrapdoorPermutation createInstance(){
+		return new CryptoPpRSAPermutation();
+	}
+}
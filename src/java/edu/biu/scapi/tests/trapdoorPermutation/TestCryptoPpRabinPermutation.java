@@ -0,0 +1,118 @@
+package edu.biu.scapi.tests.trapdoorPermutation;
+
+import static org.junit.Assert.*;
+
+import java.math.BigInteger;
+import java.security.InvalidKeyException;
+import java.security.KeyException;
+import java.security.KeyPair;
+import java.security.SecureRandom;
+import java.security.spec.InvalidParameterSpecException;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.trapdoorPermutation.RabinKeyGenParameterSpec;
+import edu.biu.scapi.primitives.trapdoorPermutation.RabinPrivateKey;
+import edu.biu.scapi.primitives.trapdoorPermutation.TPElement;
+import edu.biu.scapi.primitives.trapdoorPermutation.cryptopp.CryptoPpRabinPermutation;
+
+/**
+ * Tests the inversion of the Crypto++ Rabin permutation, which takes the square roots mod p and mod q with precomputed values.
+ */
+public class TestCryptoPpRabinPermutation {
+	
+	private static final int NUM_ELEMENTS = 20;
+	
+	private CryptoPpRabinPermutation rabin;
+	private BigInteger n, p, q;
+	private SecureRandom random = new SecureRandom();
+	
+	@Before
+	public void setUp() throws InvalidParameterSpecException, InvalidKeyException{
+		rabin = new CryptoPpRabinPermutation();
+		KeyPair pair = rabin.generateKey(new RabinKeyGenParameterSpec(1024));
+		rabin.setKey(pair.getPublic(), pair.getPrivate());
+		
+		RabinPrivateKey privateKey = (RabinPrivateKey) pair.getPrivate();
+		p = privateKey.getPrime1();
+		q = privateKey.getPrime2();
+		n = p.multiply(q);
+	}
+	
+	/**
+	 * @return a random quadratic residue mod n, that is a quadratic residue mod p and mod q
+	 */
+	private BigInteger randomResidue(){
+		BigInteger r;
+		do {
+			r = new BigInteger(n.bitLength(), random).mod(n);
+		} while (!r.gcd(n).equals(BigInteger.ONE));
+		return r.multiply(r).mod(n);
+	}
+	
+	/**
+	 * @return the value that equals a mod p and b mod q
+	 */
+	private BigInteger crt(BigInteger a, BigInteger b){
+		BigInteger pInverse = p.modInverse(q);
+		return a.add(p.multiply(b.subtract(a).multiply(pInverse).mod(q))).mod(n);
+	}
+	
+	/**
+	 * @return values that are not quadratic residues mod p, mod q or both
+	 */
+	private BigInteger[] nonResidues(){
+		BigInteger x = randomResidue();
+		//p = q = 3 mod 4, so -x is not a quadratic residue mod p and mod q.
+		BigInteger minusX = n.subtract(x);
+		return new BigInteger[]{minusX, crt(x, minusX), crt(minusX, x)};
+	}
+	
+	@Test
+	public void TestKeyIsBlum(){
+		BigInteger four = BigInteger.valueOf(4);
+		assertEquals(BigInteger.valueOf(3), p.mod(four));
+		assertEquals(BigInteger.valueOf(3), q.mod(four));
+	}
+	
+	@Test
+	public void TestInvertCompute() throws KeyException{
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			BigInteger x = randomResidue();
+			TPElement y = rabin.compute(rabin.generateUncheckedTPElement(x));
+			assertEquals(x.multiply(x).mod(n), y.getElement());
+			assertEquals(x, rabin.invert(y).getElement());
+		}
+	}
+	
+	@Test
+	public void TestInvertNonResidue() throws KeyException{
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			for (BigInteger x : nonResidues()){
+				assertEquals(BigInteger.ZERO, rabin.invert(rabin.generateUncheckedTPElement(x)).getElement());
+			}
+		}
+	}
+	
+	@Test
+	public void TestInvertBatch() throws KeyException{
+		//Mix residues and non residues, so that both kinds of results are in the batch.
+		TPElement[] elements = new TPElement[4 * NUM_ELEMENTS];
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			elements[4 * i] = rabin.generateUncheckedTPElement(randomResidue());
+			BigInteger[] nonResidues = nonResidues();
+			for (int j = 0; j < nonResidues.length; j++){
+				elements[4 * i + j + 1] = rabin.generateUncheckedTPElement(nonResidues[j]);
+			}
+		}
+		
+		TPElement[] results = rabin.invertBatch(elements);
+		assertEquals(elements.length, results.length);
+		for (int i = 0; i < elements.length; i++){
+			assertEquals(rabin.invert(elements[i]).getElement(), results[i].getElement());
+		}
+		
+		assertEquals(0, rabin.invertBatch(new TPElement[0]).length);
+	}
+}
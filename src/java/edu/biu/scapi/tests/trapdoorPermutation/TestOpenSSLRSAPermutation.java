@@ -0,0 +1,126 @@
+package edu.biu.scapi.tests.trapdoorPermutation;
+
+import static org.junit.Assert.*;
+
+import java.math.BigInteger;
+import java.security.KeyException;
+import java.util.Arrays;
+
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.trapdoorPermutation.TPElement;
+import edu.biu.scapi.primitives.trapdoorPermutation.TrapdoorPermutation;
+import edu.biu.scapi.primitives.trapdoorPermutation.openSSL.OpenSSLRSAPermutation;
+
+public class TestOpenSSLRSAPermutation extends TestRSAPermutationInterface {
+
+	public TrapdoorPermutation createInstance(){
+		return new OpenSSLRSAPermutation();
+	}
+	
+	/**
+	 * @return the given values packed in one array, each one in size bytes (big endian)
+	 */
+	private byte[] pack(BigInteger[] values, int size){
+		byte[] packed = new byte[values.length * size];
+		for (int i = 0; i < values.length; i++){
+			byte[] value = values[i].toByteArray();
+			int start = (value[0] == 0) ? 1 : 0;
+			int length = value.length - start;
+			System.arraycopy(value, start, packed, (i + 1) * size - length, length);
+		}
+		return packed;
+	}
+	
+	/**
+	 * @return the values of the given packed array
+	 */
+	private BigInteger[] unpack(byte[] packed, int size){
+		BigInteger[] values = new BigInteger[packed.length / size];
+		for (int i = 0; i < values.length; i++){
+			values[i] = new BigInteger(1, Arrays.copyOfRange(packed, i * size, (i + 1) * size));
+		}
+		return values;
+	}
+	
+	private BigInteger[] randomValues(){
+		BigInteger[] values = new BigInteger[NUM_ELEMENTS];
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			values[i] = randomValue(i);
+		}
+		return values;
+	}
+	
+	@Test
+	public void TestElementSize(){
+		assertEquals(128, ((OpenSSLRSAPermutation) rsa).getElementSize());
+	}
+	
+	@Test
+	public void TestPackedBatch() throws KeyException{
+		OpenSSLRSAPermutation openSSLRsa = (OpenSSLRSAPermutation) rsa;
+		int size = openSSLRsa.getElementSize();
+		BigInteger[] values = randomValues();
+		
+		byte[] computed = openSSLRsa.computeBatch(pack(values, size));
+		byte[] inverted = openSSLRsa.invertBatch(pack(values, size));
+		assertEquals(values.length * size, computed.length);
+		assertEquals(values.length * size, inverted.length);
+		
+		BigInteger[] computedValues = unpack(computed, size);
+		BigInteger[] invertedValues = unpack(inverted, size);
+		for (int i = 0; i < values.length; i++){
+			TPElement element = rsa.generateUncheckedTPElement(values[i]);
+			assertEquals(rsa.compute(element).getElement(), computedValues[i]);
+			assertEquals(rsa.invert(element).getElement(), invertedValues[i]);
+		}
+		
+		//The results are packed the same way as the inputs, so they can be inverted back.
+		assertArrayEquals(pack(values, size), openSSLRsa.invertBatch(computed));
+	}
+	
+	@Test
+	public void TestPackedEmptyBatch() throws KeyException{
+		OpenSSLRSAPermutation openSSLRsa = (OpenSSLRSAPermutation) rsa;
+		assertEquals(0, openSSLRsa.computeBatch(new byte[0]).length);
+		assertEquals(0, openSSLRsa.invertBatch(new byte[0]).length);
+	}
+	
+	@Test
+	public void TestPackedBatchNotSmallerThanModulus() throws KeyException{
+		OpenSSLRSAPermutation openSSLRsa = (OpenSSLRSAPermutation) rsa;
+		int size = openSSLRsa.getElementSize();
+		BigInteger[] values = randomValues();
+		
+		for (BigInteger x : new BigInteger[]{n, n.add(BigInteger.ONE)}){
+			values[NUM_ELEMENTS / 2] = x;
+			byte[] packed = pack(values, size);
+			try {
+				openSSLRsa.computeBatch(packed);
+				fail("an element that is not smaller than the modulus should be rejected");
+			} catch (IllegalArgumentException e){
+			}
+			try {
+				openSSLRsa.invertBatch(packed);
+				fail("an element that is not smaller than the modulus should be rejected");
+			} catch (IllegalArgumentException e){
+			}
+		}
+	}
+	
+	@Test
+	public void TestPackedBatchPartialElement() throws KeyException{
+		OpenSSLRSAPermutation openSSLRsa = (OpenSSLRSAPermutation) rsa;
+		byte[] packed = new byte[openSSLRsa.getElementSize() + 1];
+		try {
+			openSSLRsa.computeBatch(packed);
+			fail("an array that is not made of whole elements should be rejected");
+		} catch (IllegalArgumentException e){
+		}
+		try {
+			openSSLRsa.invertBatch(packed);
+			fail("an array that is not made of whole elements should be rejected");
+		} catch (IllegalArgumentException e){
+		}
+	}
+}
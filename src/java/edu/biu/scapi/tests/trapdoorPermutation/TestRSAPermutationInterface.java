@@ -0,0 +1,124 @@
+package edu.biu.scapi.tests.trapdoorPermutation;
+
+import static org.junit.Assert.*;
+
+import java.math.BigInteger;
+import java.security.InvalidKeyException;
+import java.security.KeyException;
+import java.security.KeyPair;
+import java.security.SecureRandom;
+import java.security.interfaces.RSAPublicKey;
+import java.security.spec.InvalidParameterSpecException;
+import java.security.spec.RSAKeyGenParameterSpec;
+
+import org.junit.Before;
+import org.junit.Test;
+
+import edu.biu.scapi.primitives.trapdoorPermutation.TPElement;
+import edu.biu.scapi.primitives.trapdoorPermutation.TrapdoorPermutation;
+
+/**
+ * Tests the batch computations of the RSA permutations against the computations of one element.
+ */
+public abstract class TestRSAPermutationInterface {
+	
+	protected static final int NUM_ELEMENTS = 20;
+	
+	public abstract TrapdoorPermutation createInstance();
+	
+	protected TrapdoorPermutation rsa = createInstance();
+	protected BigInteger n;
+	protected SecureRandom random = new SecureRandom();
+	
+	@Before
+	public void setUp() throws InvalidParameterSpecException, InvalidKeyException{
+		KeyPair pair = rsa.generateKey(new RSAKeyGenParameterSpec(1024, RSAKeyGenParameterSpec.F4));
+		rsa.setKey(pair.getPublic(), pair.getPrivate());
+		n = ((RSAPublicKey) pair.getPublic()).getModulus();
+	}
+	
+	/**
+	 * @return a random value between 1 to n-1. Some of the values are short, so that the batches have elements of different lengths.
+	 */
+	protected BigInteger randomValue(int i){
+		BigInteger x;
+		do {
+			x = new BigInteger(n.bitLength(), random).mod(n);
+			if (i % 4 == 3){
+				x = x.shiftRight(8 * (i % 16) + 8);
+			}
+		} while (x.signum() == 0);
+		return x;
+	}
+	
+	protected TPElement[] randomElements(){
+		TPElement[] elements = new TPElement[NUM_ELEMENTS];
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			elements[i] = rsa.generateUncheckedTPElement(randomValue(i));
+		}
+		return elements;
+	}
+	
+	@Test
+	public void TestInvertCompute() throws KeyException{
+		for (int i = 0; i < NUM_ELEMENTS; i++){
+			BigInteger x = randomValue(i);
+			TPElement y = rsa.compute(rsa.generateUncheckedTPElement(x));
+			assertEquals(x.modPow(RSAKeyGenParameterSpec.F4, n), y.getElement());
+			assertEquals(x, rsa.invert(y).getElement());
+		}
+	}
+	
+	@Test
+	public void TestComputeBatch(){
+		TPElement[] elements = randomElements();
+		TPElement[] results = rsa.computeBatch(elements);
+		assertEquals(elements.length, results.length);
+		for (int i = 0; i < elements.length; i++){
+			assertEquals(rsa.compute(elements[i]).getElement(), results[i].getElement());
+		}
+	}
+	
+	@Test
+	public void TestInvertBatch() throws KeyException{
+		TPElement[] elements = randomElements();
+		TPElement[] results = rsa.invertBatch(elements);
+		assertEquals(elements.length, results.length);
+		for (int i = 0; i < elements.length; i++){
+			assertEquals(rsa.invert(elements[i]).getElement(), results[i].getElement());
+		}
+	}
+	
+	@Test
+	public void TestInvertComputeBatch() throws KeyException{
+		TPElement[] elements = randomElements();
+		TPElement[] results = rsa.invertBatch(rsa.computeBatch(elements));
+		for (int i = 0; i < elements.length; i++){
+			assertEquals(elements[i].getElement(), results[i].getElement());
+		}
+	}
+	
+	@Test
+	public void TestEmptyBatch() throws KeyException{
+		assertEquals(0, rsa.computeBatch(new TPElement[0]).length);
+		assertEquals(0, rsa.invertBatch(new TPElement[0]).length);
+	}
+	
+	@Test
+	public void TestBatchElementNotSmallerThanModulus() throws KeyException{
+		for (BigInteger x : new BigInteger[]{n, n.add(BigInteger.ONE)}){
+			TPElement[] elements = randomElements();
+			elements[NUM_ELEMENTS / 2] = rsa.generateUncheckedTPElement(x);
+			try {
+				rsa.computeBatch(elements);
+				fail("an element that is not smaller than the modulus should be rejected");
+			} catch (IllegalArgumentException e){
+			}
+			try {
+				rsa.invertBatch(elements);
+				fail("an element that is not smaller than the modulus should be rejected");
+			} catch (IllegalArgumentException e){
+			}
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#include "CpuFeatures.h"
+#ifndef _MSC_VER
+#include <cpuid.h>
+#endif
+
+bool hasAvx2(){
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7){
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	bool avx2 = (info[1] & (1 << 5)) != 0;
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	//The OS should also save the ymm registers.
+	return avx2 && osxsave && ((_xgetbv(0) & 6) == 6);
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool hasShaNi(){
+	unsigned int info[4] = { 0, 0, 0, 0 };
+#ifdef _MSC_VER
+	__cpuid((int*)info, 0);
+	if (info[0] < 7){
+		return false;
+	}
+	__cpuidex((int*)info, 7, 0);
+#else
+	if (!__get_cpuid_count(7, 0, &info[0], &info[1], &info[2], &info[3])){
+		return false;
+	}
+#endif
+	//The SHA extensions are bit 29 of ebx.
+	return (info[1] & (1 << 29)) != 0;
+}
+
+bool hasVaes(){
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7){
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	//AVX-512F is bit 16 of ebx and VAES is bit 9 of ecx.
+	bool vaes = ((info[1] & (1 << 16)) != 0) && ((info[2] & (1 << 9)) != 0);
+	__cpuid(info, 1);
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	//The OS should also save the opmask and zmm registers.
+	return vaes && osxsave && ((_xgetbv(0) & 0xe6) == 0xe6);
+#else
+	return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("vaes");
+#endif
+}
@@ -0,0 +1,23 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+/**
+* Checks of the instruction sets of the host, shared by the native libraries that have optimized code paths.
+* Functions that use an instruction set are marked with its target, so the rest of the library is still built for any host.
+*/
+#ifdef _MSC_VER
+#include <intrin.h>
+#define AVX2_TARGET
+#define VAES_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define VAES_TARGET __attribute__((target("aes,vaes,avx512f")))
+#endif
+
+bool hasAvx2();
+
+bool hasShaNi();
+
+bool hasVaes();
+
+#endif
@@ -0,0 +1,282 @@
+#include "MultiBufferHash.h"
+#include <immintrin.h>
+#include <string.h>
+#include <vector>
+#include <openssl/sha.h>
+
+using namespace std;
+
+/*
+ * Builds the padded messages of one group of HASH_LANES messages as big endian words, word-major:
+ * words[(b*16 + t)*HASH_LANES + lane] is word t of block b of the message of the given lane.
+ * The message of a lane is parts1[lane] followed by parts2[lane].
+ * Lanes after numMessages get a copy of the first message so that all lanes do the same work.
+ */
+static void loadLanes(const unsigned char* const* parts1, int len1, const unsigned char* const* parts2, int len2, int numMessages,
+	int numBlocks, vector<unsigned char>& padded, vector<unsigned int>& words){
+
+	int msgLen = len1 + len2;
+	int paddedLen = numBlocks * 64;
+	unsigned long long bitLen = (unsigned long long) msgLen * 8;
+
+	for (int lane = 0; lane < HASH_LANES; lane++){
+		int j = (lane < numMessages) ? lane : 0;
+		unsigned char* msg = &padded[0];
+		memcpy(msg, parts1[j], len1);
+		if (len2 > 0){
+			memcpy(msg + len1, parts2[j], len2);
+		}
+		//Merkle-Damgard padding: 0x80, zeros and the length in bits as a big endian 64 bit number.
+		memset(msg + msgLen, 0, paddedLen - msgLen);
+		msg[msgLen] = 0x80;
+		for (int i = 0; i < 8; i++){
+			msg[paddedLen - 1 - i] = (unsigned char)(bitLen >> (8 * i));
+		}
+
+		for (int w = 0; w < paddedLen / 4; w++){
+			words[w*HASH_LANES + lane] = ((unsigned int)msg[4*w] << 24) | ((unsigned int)msg[4*w + 1] << 16) |
+										 ((unsigned int)msg[4*w + 2] << 8) | (unsigned int)msg[4*w + 3];
+		}
+	}
+}
+
+/*
+ * Writes the big endian state words of the first numMessages lanes as digests.
+ */
+static void storeLanes(const unsigned int* state, int numWords, int numMessages, unsigned char* digests){
+	for (int lane = 0; lane < numMessages; lane++){
+		unsigned char* out = digests + lane * numWords * 4;
+		for (int w = 0; w < numWords; w++){
+			unsigned int v = state[w*HASH_LANES + lane];
+			out[4*w] = (unsigned char)(v >> 24);
+			out[4*w + 1] = (unsigned char)(v >> 16);
+			out[4*w + 2] = (unsigned char)(v >> 8);
+			out[4*w + 3] = (unsigned char)v;
+		}
+	}
+}
+
+static int numPaddedBlocks(int msgLen){
+	//The padding needs at least 9 bytes: 0x80 and the 64 bit length.
+	return (msgLen + 9 + 63) / 64;
+}
+
+#define ROTL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+#define SET1(c) _mm256_set1_epi32((int)(c))
+
+/*
+ * SHA-1 of HASH_LANES messages of numBlocks blocks each, one message in each 32 bit lane.
+ */
+AVX2_TARGET static void sha1Lanes(const unsigned int* words, int numBlocks, unsigned int* state){
+	__m256i h0 = SET1(0x67452301), h1 = SET1(0xEFCDAB89), h2 = SET1(0x98BADCFE), h3 = SET1(0x10325476), h4 = SET1(0xC3D2E1F0);
+
+	for (int b = 0; b < numBlocks; b++){
+		__m256i w[16];
+		for (int t = 0; t < 16; t++){
+			w[t] = _mm256_loadu_si256((const __m256i*)(words + (b*16 + t)*HASH_LANES));
+		}
+
+		__m256i a = h0, bb = h1, c = h2, d = h3, e = h4;
+		for (int t = 0; t < 80; t++){
+			if (t >= 16){
+				__m256i x = _mm256_xor_si256(_mm256_xor_si256(w[(t - 3) & 15], w[(t - 8) & 15]), _mm256_xor_si256(w[(t - 14) & 15], w[t & 15]));
+				w[t & 15] = ROTL(x, 1);
+			}
+
+			__m256i f, k;
+			if (t < 20){
+				f = _mm256_xor_si256(d, _mm256_and_si256(bb, _mm256_xor_si256(c, d)));
+				k = SET1(0x5A827999);
+			} else if (t < 40){
+				f = _mm256_xor_si256(_mm256_xor_si256(bb, c), d);
+				k = SET1(0x6ED9EBA1);
+			} else if (t < 60){
+				f = _mm256_or_si256(_mm256_and_si256(bb, c), _mm256_and_si256(d, _mm256_or_si256(bb, c)));
+				k = SET1(0x8F1BBCDC);
+			} else {
+				f = _mm256_xor_si256(_mm256_xor_si256(bb, c), d);
+				k = SET1(0xCA62C1D6);
+			}
+
+			__m256i temp = _mm256_add_epi32(_mm256_add_epi32(ROTL(a, 5), f), _mm256_add_epi32(_mm256_add_epi32(e, k), w[t & 15]));
+			e = d;
+			d = c;
+			c = ROTL(bb, 30);
+			bb = a;
+			a = temp;
+		}
+
+		h0 = _mm256_add_epi32(h0, a);
+		h1 = _mm256_add_epi32(h1, bb);
+		h2 = _mm256_add_epi32(h2, c);
+		h3 = _mm256_add_epi32(h3, d);
+		h4 = _mm256_add_epi32(h4, e);
+	}
+
+	_mm256_storeu_si256((__m256i*)(state), h0);
+	_mm256_storeu_si256((__m256i*)(state + HASH_LANES), h1);
+	_mm256_storeu_si256((__m256i*)(state + 2*HASH_LANES), h2);
+	_mm256_storeu_si256((__m256i*)(state + 3*HASH_LANES), h3);
+	_mm256_storeu_si256((__m256i*)(state + 4*HASH_LANES), h4);
+}
+
+static const unsigned int SHA256_K[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const unsigned int SHA256_IV[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/*
+ * SHA-256 of HASH_LANES messages of numBlocks blocks each, one message in each 32 bit lane.
+ */
+AVX2_TARGET static void sha256Lanes(const unsigned int* words, int numBlocks, unsigned int* state){
+	__m256i h[8];
+	for (int i = 0; i < 8; i++){
+		h[i] = SET1(SHA256_IV[i]);
+	}
+
+	for (int b = 0; b < numBlocks; b++){
+		__m256i w[16];
+		for (int t = 0; t < 16; t++){
+			w[t] = _mm256_loadu_si256((const __m256i*)(words + (b*16 + t)*HASH_LANES));
+		}
+
+		__m256i a = h[0], bb = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+		for (int t = 0; t < 64; t++){
+			if (t >= 16){
+				__m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+				__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR(w15, 7), ROTR(w15, 18)), _mm256_srli_epi32(w15, 3));
+				__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR(w2, 17), ROTR(w2, 19)), _mm256_srli_epi32(w2, 10));
+				w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+			}
+
+			__m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROTR(e, 6), ROTR(e, 11)), ROTR(e, 25));
+			__m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+			__m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(hh, S1), _mm256_add_epi32(_mm256_add_epi32(ch, SET1(SHA256_K[t])), w[t & 15]));
+			__m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ROTR(a, 2), ROTR(a, 13)), ROTR(a, 22));
+			__m256i maj = _mm256_or_si256(_mm256_and_si256(a, bb), _mm256_and_si256(c, _mm256_or_si256(a, bb)));
+			__m256i temp2 = _mm256_add_epi32(S0, maj);
+
+			hh = g;
+			g = f;
+			f = e;
+			e = _mm256_add_epi32(d, temp1);
+			d = c;
+			c = bb;
+			bb = a;
+			a = _mm256_add_epi32(temp1, temp2);
+		}
+
+		h[0] = _mm256_add_epi32(h[0], a);
+		h[1] = _mm256_add_epi32(h[1], bb);
+		h[2] = _mm256_add_epi32(h[2], c);
+		h[3] = _mm256_add_epi32(h[3], d);
+		h[4] = _mm256_add_epi32(h[4], e);
+		h[5] = _mm256_add_epi32(h[5], f);
+		h[6] = _mm256_add_epi32(h[6], g);
+		h[7] = _mm256_add_epi32(h[7], hh);
+	}
+
+	for (int i = 0; i < 8; i++){
+		_mm256_storeu_si256((__m256i*)(state + i*HASH_LANES), h[i]);
+	}
+}
+
+typedef void (*LanesFunction)(const unsigned int* words, int numBlocks, unsigned int* state);
+
+/*
+ * Hashes all the messages HASH_LANES at a time with the given lanes function.
+ * Message j is parts1[j] (len1 bytes) followed by parts2[j] (len2 bytes). parts2 is not used if len2 is zero.
+ */
+static void hashMulti(LanesFunction lanes, int digestSize, const unsigned char* const* parts1, int len1, const unsigned char* const* parts2, int len2,
+	int numMessages, unsigned char* digests){
+
+	int numBlocks = numPaddedBlocks(len1 + len2);
+	vector<unsigned char> padded(numBlocks * 64);
+	vector<unsigned int> words(numBlocks * 16 * HASH_LANES);
+	unsigned int state[8 * HASH_LANES];
+
+	for (int j = 0; j < numMessages; j += HASH_LANES){
+		int groupSize = (numMessages - j < HASH_LANES) ? numMessages - j : HASH_LANES;
+		loadLanes(parts1 + j, len1, (len2 > 0) ? parts2 + j : NULL, len2, groupSize, numBlocks, padded, words);
+		lanes(&words[0], numBlocks, state);
+		storeLanes(state, digestSize / 4, groupSize, digests + j*digestSize);
+	}
+}
+
+static void sha1Parts(const unsigned char* const* parts1, int len1, const unsigned char* const* parts2, int len2, int numMessages, unsigned char* digests){
+	static const bool avx2 = hasAvx2();
+	if (avx2){
+		hashMulti(sha1Lanes, SHA1_DIGEST_SIZE, parts1, len1, parts2, len2, numMessages, digests);
+		return;
+	}
+
+	SHA_CTX sha;
+	for (int j = 0; j < numMessages; j++){
+		SHA1_Init(&sha);
+		SHA1_Update(&sha, parts1[j], len1);
+		if (len2 > 0){
+			SHA1_Update(&sha, parts2[j], len2);
+		}
+		SHA1_Final(digests + j*SHA1_DIGEST_SIZE, &sha);
+	}
+}
+
+static void sha256Parts(const unsigned char* const* parts1, int len1, const unsigned char* const* parts2, int len2, int numMessages, unsigned char* digests){
+	static const bool avx2 = hasAvx2();
+	if (avx2){
+		hashMulti(sha256Lanes, SHA256_DIGEST_SIZE, parts1, len1, parts2, len2, numMessages, digests);
+		return;
+	}
+
+	SHA256_CTX sha;
+	for (int j = 0; j < numMessages; j++){
+		SHA256_Init(&sha);
+		SHA256_Update(&sha, parts1[j], len1);
+		if (len2 > 0){
+			SHA256_Update(&sha, parts2[j], len2);
+		}
+		SHA256_Final(digests + j*SHA256_DIGEST_SIZE, &sha);
+	}
+}
+
+/*
+ * Returns the start of each of the numMessages parts of the given length in the given array.
+ */
+static vector<const unsigned char*> splitParts(const unsigned char* part, int len, int numMessages){
+	vector<const unsigned char*> parts(numMessages);
+	for (int j = 0; j < numMessages; j++){
+		parts[j] = part + j*len;
+	}
+	return parts;
+}
+
+void sha1Multi(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests){
+	vector<const unsigned char*> parts1 = splitParts(part1, len1, numMessages);
+	vector<const unsigned char*> parts2 = splitParts(part2, len2, numMessages);
+	sha1Parts(parts1.data(), len1, parts2.data(), len2, numMessages, digests);
+}
+
+void sha256Multi(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests){
+	vector<const unsigned char*> parts1 = splitParts(part1, len1, numMessages);
+	vector<const unsigned char*> parts2 = splitParts(part2, len2, numMessages);
+	sha256Parts(parts1.data(), len1, parts2.data(), len2, numMessages, digests);
+}
+
+void sha1Multi(const unsigned char* const* messages, int len, int numMessages, unsigned char* digests){
+	sha1Parts(messages, len, NULL, 0, numMessages, digests);
+}
+
+void sha256Multi(const unsigned char* const* messages, int len, int numMessages, unsigned char* digests){
+	sha256Parts(messages, len, NULL, 0, numMessages, digests);
+}
@@ -0,0 +1,33 @@
+#ifndef MULTI_BUFFER_HASH_H
+#define MULTI_BUFFER_HASH_H
+
+#include "CpuFeatures.h"
+
+#define SHA1_DIGEST_SIZE 20
+#define SHA256_DIGEST_SIZE 32
+
+//Number of messages hashed together by the multi-buffer implementations.
+#define HASH_LANES 8
+
+/**
+* Multi-buffer hashing of many independent messages of the same length.
+* Message j is the concatenation of part1[j*len1 .. (j+1)*len1) and part2[j*len2 .. (j+1)*len2),
+* which is exactly the form of the decommitments (r_j, x_j) of the simple hash commitment.
+* The digest of message j is written to digests + j*digestSize.
+*
+* On AVX2 hosts the messages are hashed HASH_LANES at a time, each lane of a 256 bit register holding one message.
+* Otherwise the messages are hashed one by one with openssl.
+*/
+void sha1Multi(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests);
+
+void sha256Multi(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests);
+
+/**
+* Multi-buffer hashing of many independent messages of the same length that are not next to each other.
+* Message j is the len bytes that messages[j] points to, and its digest is written to digests + j*digestSize.
+*/
+void sha1Multi(const unsigned char* const* messages, int len, int numMessages, unsigned char* digests);
+
+void sha256Multi(const unsigned char* const* messages, int len, int numMessages, unsigned char* digests);
+
+#endif
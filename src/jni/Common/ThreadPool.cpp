@@ -0,0 +1,107 @@
+#include "ThreadPool.h"
+#include <atomic>
+
+using namespace std;
+
+//Number of ranges that each thread takes (on average) in parallelFor, so that threads that finish early can take more work.
+#define RANGES_PER_THREAD 4
+
+/* 
+ * function ThreadPool		: Starts the given number of worker threads.
+ */
+ThreadPool::ThreadPool(int numWorkers){
+	for (int i = 0; i < numWorkers; i++){
+		workers.push_back(thread(&ThreadPool::workerLoop, this));
+	}
+}
+
+/* 
+ * function workerLoop		: Runs the tasks of the pool. The workers run until the process exits.
+ */
+void ThreadPool::workerLoop(){
+	while (true){
+		function<void()> task;
+		{
+			unique_lock<mutex> lock(tasksLock);
+			tasksReady.wait(lock, [this]{ return !tasks.empty(); });
+			task = tasks.front();
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+/* 
+ * function getNumThreads		: Returns the number of threads that parallelFor uses, including the calling thread.
+ */
+int ThreadPool::getNumThreads(){
+	return (int) workers.size() + 1;
+}
+
+/* 
+ * function runRange		: Calls work on one range, and turns an exception of the work into a failure.
+ */
+static bool runRange(const function<bool(int first, int last)>& work, int first, int last){
+	try {
+		return work(first, last);
+	} catch (...) {
+		return false;
+	}
+}
+
+/* 
+ * function parallelFor		: Splits [0, size) into ranges, and calls work on each range by some thread.
+ * return					: True if all the calls succeeded; False, otherwise.
+ */
+bool ThreadPool::parallelFor(int size, const function<bool(int first, int last)>& work){
+	int numRanges = min(size, getNumThreads() * RANGES_PER_THREAD);
+	if (numRanges <= 1 || workers.empty()){
+		return (size <= 0) || runRange(work, 0, size);
+	}
+
+	//The state of the loop is shared by the threads that take part in it.
+	//Each thread takes the next range until all the ranges were taken.
+	atomic<int> nextRange(0);
+	atomic<bool> success(true);
+	int pendingTasks = (int) min(workers.size(), (size_t) numRanges - 1);
+	mutex doneLock;
+	condition_variable done;
+
+	auto runRanges = [&]{
+		int range;
+		while ((range = nextRange++) < numRanges){
+			int first = (int) ((long long) size * range / numRanges);
+			int last = (int) ((long long) size * (range + 1) / numRanges);
+			if (!runRange(work, first, last)){
+				success = false;
+			}
+		}
+	};
+
+	{
+		lock_guard<mutex> lock(tasksLock);
+		for (int i = pendingTasks; i > 0; i--){
+			tasks.push_back([&]{
+				runRanges();
+				lock_guard<mutex> lock(doneLock);
+				if (--pendingTasks == 0){
+					done.notify_one();
+				}
+			});
+		}
+	}
+	tasksReady.notify_all();
+
+	//The calling thread works too, and then waits for the tasks, which refer to the state on its stack.
+	runRanges();
+	unique_lock<mutex> lock(doneLock);
+	done.wait(lock, [&]{ return pendingTasks == 0; });
+
+	return success;
+}
+
+ThreadPool* getThreadPool(){
+	//The pool is never deleted, since its threads may still be waiting for tasks while the process exits.
+	static ThreadPool* pool = new ThreadPool(max(1u, thread::hardware_concurrency()) - 1);
+	return pool;
+}
@@ -0,0 +1,46 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*
+ * A fixed set of native threads that the batch functions of a library share, instead of starting threads on every call.
+ * It is built into each library that uses it, so each library has its own pool.
+ * An exception of a range (Crypto++ reports errors by exceptions) is caught by the thread that ran it and makes 
+ * parallelFor return false. No exception leaves parallelFor, so it can be called from the JNI functions.
+ * In the OpenSSL library each thread gets its own BN_CTX from getThreadBnCtx(), so the work can use the groups without any locking.
+ */
+class ThreadPool {
+private:
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()> > tasks;
+	std::mutex tasksLock;
+	std::condition_variable tasksReady;
+
+	void workerLoop();
+public:
+
+	ThreadPool(int numWorkers);
+
+	int getNumThreads();
+
+	/*
+	 * Calls work(first, last) on consecutive ranges that cover [0, size), using the workers and the calling thread.
+	 * Returns after all the ranges are done. Returns false if one of the calls returned false or threw an exception.
+	 */
+	bool parallelFor(int size, const std::function<bool(int first, int last)>& work);
+};
+
+/*
+ * Returns the pool of the library, which has a thread for each cpu (including the calling thread).
+ * The pool is created on the first call and lives until the process exits.
+ */
+ThreadPool* getThreadPool();
+
+#endif
@@ -67,53 +67,45 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_se
 	env->ReleaseByteArrayElements(keyBytes,key,0);
 }
 
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeBlock
-  (JNIEnv *env, jobject, jlong aes, jbyteArray inBytes, jbyteArray outBytes, jint outOffset, jboolean forEncrypt){
+/*
+ * Returns the block transformation of the given AES object, which is an AESEncryption or an AESDecryption object according to forEncrypt.
+ */
+static BlockTransformation* getTransformation(jlong aes, jboolean forEncrypt){
+	if (forEncrypt){
+		return (AESEncryption*)aes;
+	}
+	return (AESDecryption*)aes;
+}
 
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
-	  jbyte *out = env->GetByteArrayElements(outBytes, 0);
-	  
-	  if (forEncrypt){
-		 ((AESEncryption*)aes)->ProcessBlock((byte*)in, (byte*) out);
-		 env->SetByteArrayRegion(outBytes, outOffset, ((AESEncryption*)aes)->BlockSize(), out);
-	  } else {
-		  ((AESDecryption*)aes)->ProcessBlock((byte*)in, (byte*) out);
-		  env->SetByteArrayRegion(outBytes, outOffset, ((AESDecryption*)aes)->BlockSize(), out);
-	  }
+/*
+ * Computes or inverts the AES permutation on numBlocks consecutive blocks.
+ * All the blocks are passed to Crypto++ together, so that it can process them in parallel (with AES-NI when the cpu supports it).
+ */
+static void processBlocks(BlockTransformation* aes, const byte* in, byte* out, int numBlocks){
+	aes->AdvancedProcessBlocks(in, NULL, out, numBlocks * aes->BlockSize(), 0);
+}
 
-	  //make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
-	  env->ReleaseByteArrayElements(outBytes,out,0);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_processBlocks
+  (JNIEnv *env, jobject, jlong aes, jbyteArray inBytes, jint inOffset, jbyteArray outBytes, jint outOffset, jint numBlocks, jboolean forEncrypt){
+
+	  //Pin the arrays instead of copying them. The output is written in place.
+	  jbyte *in = (jbyte*) env->GetPrimitiveArrayCritical(inBytes, 0);
+	  jbyte *out = (jbyte*) env->GetPrimitiveArrayCritical(outBytes, 0);
+
+	  processBlocks(getTransformation(aes, forEncrypt), (byte*)in + inOffset, (byte*)out + outOffset, numBlocks);
+
+	  env->ReleasePrimitiveArrayCritical(outBytes, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inBytes, in, JNI_ABORT);
 }
 
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_optimizedCompute
-  (JNIEnv *env, jobject, jlong aes, jbyteArray inBytes, jbyteArray outBytes, jboolean forEncrypt){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_processBuffer
+  (JNIEnv *env, jobject, jlong aes, jobject inBuffer, jint inOffset, jobject outBuffer, jint outOffset, jint numBlocks, jboolean forEncrypt){
 
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
-	  
-	  int blockSize;
-	  if (forEncrypt){
-		blockSize = ((AESEncryption*)aes)->BlockSize();
-	  } else {
-		  blockSize = ((AESDecryption*)aes)->BlockSize();
-	  }
-
-	  int rounds = (env->GetArrayLength(inBytes))/blockSize;
-	  byte* inBlock = new byte[blockSize];
-	  byte* outBlock = new byte[blockSize];
-
-	  for (int i=0; i<rounds; i++){
-		  //memcpy(inBlock, in+(i*blockSize), blockSize);
-		  if (forEncrypt){
-			  ((AESEncryption*)aes)->ProcessBlock((byte*)(in+(i*blockSize)), outBlock);
-		  } else {
-			  ((AESDecryption*)aes)->ProcessBlock((byte*)(in+(i*blockSize)), outBlock);
-		  }
-		  env->SetByteArrayRegion(outBytes, i*blockSize, blockSize, (jbyte*)outBlock);
-	  }
+	  //Direct buffers are used in place, nothing is copied or pinned.
+	  byte *in = (byte*) env->GetDirectBufferAddress(inBuffer);
+	  byte *out = (byte*) env->GetDirectBufferAddress(outBuffer);
 
-	  //make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
+	  processBlocks(getTransformation(aes, forEncrypt), in + inOffset, out + outOffset, numBlocks);
 }
 
 JNIEXPORT jstring JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_getName
@@ -58,19 +58,19 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_se
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES
- * Method:    computeBlock
- * Signature: (J[B[BIZ)V
+ * Method:    processBlocks
+ * Signature: (J[BI[BIIZ)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_computeBlock
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jboolean);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_processBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint, jboolean);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES
- * Method:    optimizedCompute
- * Signature: (J[B[B)V
+ * Method:    processBuffer
+ * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/ByteBuffer;IIZ)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_optimizedCompute
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jboolean);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES_processBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint, jboolean);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_cryptopp_CryptoPpAES
@@ -156,3 +156,57 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_
 (JNIEnv *, jobject, jlong hashPtr){
 	delete((HashTransformation *) hashPtr);
 }
+
+
+/* function hashMany : This function computes the digests of many independent messages that are given in one array
+ * param hashPtr	   : The actual hash object pointer. It is cloned, so the message that was updated so far is kept
+ * param buffer		   : the byte array that contains the messages
+ * param offsets	   : the offset of each message in the buffer
+ * param lengths	   : the length of each message
+ * param out		   : the byte array to put the digests in. The digest of message i is put at offset i * digest size
+ * return			   : true if all the messages were hashed, false if crypto++ failed
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_hashMany
+(JNIEnv *env, jobject, jlong hashPtr, jbyteArray buffer, jintArray offsets, jintArray lengths, jbyteArray out){
+
+	//hash the messages with a fresh copy of the hash, so that the state of the given hash does not change.
+	//crypto++ reports its failures by exceptions, which should not get to the JVM.
+	HashTransformation *localHash;
+	try {
+		localHash = dynamic_cast<HashTransformation *>(((HashTransformation *)hashPtr)->Clone());
+	} catch (...) {
+		return false;
+	}
+	if (localHash == NULL)
+		return false;
+	localHash->Restart();
+	unsigned int digestSize = localHash->DigestSize();
+	int size = env->GetArrayLength(offsets);
+
+	//get the offsets and lengths before pinning the arrays, since no other JNI function may be called while they are pinned
+	jint* offsetsArr = env->GetIntArrayElements(offsets, 0);
+	jint* lengthsArr = env->GetIntArrayElements(lengths, 0);
+
+	//get the messages and the output without copying them, if the JVM allows it
+	byte* in = (byte*) env->GetPrimitiveArrayCritical(buffer, 0);
+	byte* digests = (byte*) env->GetPrimitiveArrayCritical(out, 0);
+
+	//CalculateDigest restarts the hash after each message
+	bool success = true;
+	try {
+		for (int i = 0; i < size; i++){
+			localHash->CalculateDigest(digests + i * digestSize, in + offsetsArr[i], lengthsArr[i]);
+		}
+	} catch (...) {
+		success = false;
+	}
+
+	//write the digests back and release the messages without copying them back
+	env->ReleasePrimitiveArrayCritical(out, digests, 0);
+	env->ReleasePrimitiveArrayCritical(buffer, in, JNI_ABORT);
+	env->ReleaseIntArrayElements(lengths, lengthsArr, JNI_ABORT);
+	env->ReleaseIntArrayElements(offsets, offsetsArr, JNI_ABORT);
+
+	delete localHash;
+	return success;
+}
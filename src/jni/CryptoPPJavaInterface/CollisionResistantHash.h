@@ -84,6 +84,15 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_deleteHash
   (JNIEnv *, jobject, jlong);
 
+
+/*
+ * Class:     edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash
+ * Method:    hashMany
+ * Signature: (J[B[I[I[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_hash_cryptopp_CryptoPpHash_hashMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray, jintArray, jbyteArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,7 @@
 #include "cryptlib.h"
 #include "gfpcrypt.h"
 #include "osrng.h"
+#include "nbtheory.h"
 
 // local includes
 #include "DlogGroup.h"
@@ -239,6 +240,32 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpD
 	 
 }
 
+/* function validateZpElements : This function checks the validity of each of the given elements in one call.
+								 Since p = 2q+1, the group is the group of quadratic residues mod p, so an element in the range [1...p-1]
+								 is valid if and only if its Jacobi symbol mod p is 1. This is much cheaper than computing element^q.
+ * param group			       : pointer to the group
+ * param elements		       : pointers to the elements to check
+ * return			           : array that holds for each element whether it is valid
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpElements
+  (JNIEnv *env, jobject, jlong group, jlongArray elements){
+	  int size = env->GetArrayLength(elements);
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  jboolean* valid = new jboolean[size];
+
+	  const Integer& p = ((DL_GroupParameters_GFP_DefaultSafePrime*) group)->GetModulus();
+	  for (int i = 0; i < size; i++){
+		  const Integer& e = *(Integer*) elementsArr[i];
+		  valid[i] = e.IsPositive() && (e < p) && (Jacobi(e, p) == 1);
+	  }
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  jbooleanArray result = env->NewBooleanArray(size);
+	  env->SetBooleanArrayRegion(result, 0, size, valid);
+	  delete[] valid;
+	  return result;
+}
+
 /* function deleteDlogZp   : This function frees the allocated memory
  * param groupPtr		   : pointer to the group
  */
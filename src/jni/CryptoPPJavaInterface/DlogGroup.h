@@ -128,6 +128,14 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpD
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpElement
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime
+ * Method:    validateZpElements
+ * Signature: (J[J)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_cryptopp_CryptoPpDlogZpSafePrime_validateZpElements
+  (JNIEnv *, jobject, jlong, jlongArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,7 @@
 
 // stdlib includes
 #include <iostream>
+#include <new>
 
 // java jni includes
 #include "jni.h"
@@ -41,6 +42,7 @@
 // local includes
 #include "RSAPermutation.h"
 #include "Utils.h"
+#include "../Common/ThreadPool.h"
 
 using namespace std;
 using namespace CryptoPP;
@@ -254,6 +256,70 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 	  return (jlong) utils.getPointerToInteger(result);
 }
 
+/*
+ * function computeRSABatch	: This function compute the RSA function on each of the accepted elements, in several threads
+ * param tpPtr				: The pointer to the RSA object 
+ * param elements			: The pointers to the elements for the computation
+ * return jlongArray		: The pointers to the results, in the order of the elements, or NULL if one of them failed
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_computeRSABatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements) {
+	  int size = env->GetArrayLength(elements);
+	  //the entries stay 0 until their results are created, so a failed batch knows which results to delete
+	  jlong* results = new (nothrow) jlong[size]();
+	  if (results == NULL)
+		  return NULL;
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  RSAFunction* rsa = (RSAFunction *) tpPtr;
+
+	  //operate the compute on the ranges of the elements by the threads of the pool
+	  bool success = getThreadPool()->parallelFor(size, [&](int first, int last) {
+		  for (int i = first; i < last; i++)
+			  results[i] = (jlong) new Integer(rsa -> ApplyFunction(*(Integer*) elementsArr[i]));
+		  return true;
+	  });
+
+	  //the elements were only read
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  //return the results' pointers as jlongArray, or NULL if crypto++ failed on one of the elements
+	  return batchResultsToJlongArray(env, results, size, success);
+}
+
+/*
+ * function invertRSABatch	: This function invert the RSA permutation on each of the accepted elements, in several threads.
+ *							  The inversion uses the CRT values of the key (crypto++ computes them if only d was given) 
+ *							  and blinds each element.
+ * param tpPtr				: The pointer to the RSA object 
+ * param elements			: The pointers to the elements to invert
+ * return jlongArray		: The pointers to the results, in the order of the elements, or NULL if one of them failed
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_invertRSABatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements) {
+	  int size = env->GetArrayLength(elements);
+	  //the entries stay 0 until their results are created, so a failed batch knows which results to delete
+	  jlong* results = new (nothrow) jlong[size]();
+	  if (results == NULL)
+		  return NULL;
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  InvertibleRSAFunction* rsa = (InvertibleRSAFunction *) tpPtr;
+
+	  //operate the invert on the ranges of the elements by the threads of the pool.
+	  //seeding the random number generator is costly, so each range seeds one for all its elements.
+	  bool success = getThreadPool()->parallelFor(size, [&](int first, int last) {
+		  AutoSeededRandomPool rng;
+		  for (int i = first; i < last; i++)
+			  results[i] = (jlong) new Integer(rsa -> CalculateInverse(rng, *(Integer*) elementsArr[i]));
+		  return true;
+	  });
+
+	  //the elements were only read
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  //return the results' pointers as jlongArray, or NULL if crypto++ failed on one of the elements
+	  return batchResultsToJlongArray(env, results, size, success);
+}
+
 /*
  * Delete the native object
  */
@@ -104,6 +104,22 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_invertRSA
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation
+ * Method:    computeRSABatch
+ * Signature: (J[J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_computeRSABatch
+  (JNIEnv *, jobject, jlong, jlongArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation
+ * Method:    invertRSABatch
+ * Signature: (J[J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation_invertRSABatch
+  (JNIEnv *, jobject, jlong, jlongArray);
+
 /*
  * Class:     edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRSAPermutation
  * Method:    deleteRSA
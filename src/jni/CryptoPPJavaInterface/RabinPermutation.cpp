@@ -28,20 +28,106 @@
 
 // stdlib includes
 #include <iostream>
+#include <new>
+#include <memory>
 
 // cryptopp includes
 #include "rabin.h"
 #include "cryptlib.h"
 #include "osrng.h"
 #include "nbtheory.h"
+#include "modarith.h"
 
 // local includes
 #include "RabinPermutation.h"
 #include "Utils.h"
+#include "../Common/ThreadPool.h"
 
 using namespace std;
 using namespace CryptoPP;
 
+/*
+ * InvertibleRabinFunction that computes the values that the inversions need once, when the key is set, 
+ * instead of in every inversion.
+ */
+class CachedRabinFunction : public InvertibleRabinFunction {
+private:
+	bool blum;											//p = q = 3 mod 4, so each square root is one exponentiation
+	Integer expP, expQ;									//(p+1)/4 and (q+1)/4
+	unique_ptr<MontgomeryRepresentation> montP, montQ;	//the Montgomery representations mod p and mod q
+
+	bool squareRootModPrime(const Integer& a, const Integer& prime, const Integer& exp, const MontgomeryRepresentation& mont, Integer& root) const;
+
+public:
+	void precompute();
+	Integer squareRoot(const Integer& x, const MontgomeryRepresentation& mp, const MontgomeryRepresentation& mq) const;
+	const MontgomeryRepresentation& getMontgomeryP() const { return *montP; }
+	const MontgomeryRepresentation& getMontgomeryQ() const { return *montQ; }
+};
+
+/*
+ * function precompute	: Checks the key and computes the values of the inversions. Should be called after Initialize.
+ */
+void CachedRabinFunction::precompute() {
+	DoQuickSanityCheck();
+
+	const Integer& p = GetPrime1();
+	const Integer& q = GetPrime2();
+	blum = (p % 4 == 3) && (q % 4 == 3);
+	expP = (p + 1) >> 2;
+	expQ = (q + 1) >> 2;
+	montP.reset(new MontgomeryRepresentation(p));
+	montQ.reset(new MontgomeryRepresentation(q));
+}
+
+/*
+ * function squareRootModPrime	: Computes the square root of a mod prime that is a quadratic residue mod prime
+ * param a						: The value, reduced mod prime
+ * param exp					: (prime+1)/4
+ * param mont					: The Montgomery representation mod prime
+ * param root					: The result
+ * return						: True if there is such a root; False, otherwise
+ */
+bool CachedRabinFunction::squareRootModPrime(const Integer& a, const Integer& prime, const Integer& exp, const MontgomeryRepresentation& mont, Integer& root) const {
+	if (a.IsZero())
+		return false;
+
+	if (blum) {
+		//a^((prime+1)/4) is a root of a if a has one, and it is a quadratic residue itself since -1 is not
+		Integer aMont = mont.ConvertIn(a);
+		Integer rootMont = mont.Exponentiate(aMont, exp);
+		if (mont.Square(rootMont) != aMont)
+			return false;
+		root = mont.ConvertOut(rootMont);
+		return true;
+	}
+
+	//other primes: take the one of the two roots that is a quadratic residue
+	if (Jacobi(a, prime) != 1)
+		return false;
+	root = ModularSquareRoot(a, prime);
+	if (Jacobi(root, prime) != 1)
+		root = prime - root;
+	return (Jacobi(root, prime) == 1);
+}
+
+/*
+ * function squareRoot	: Computes the square root of x that is a quadratic residue mod p and mod q
+ * param x				: The element to invert
+ * params mp, mq		: The Montgomery representations mod p and mod q. They use an inner workspace, 
+ *						  so each thread should pass its own copies.
+ * return				: The root, or 0 if x has no such root
+ */
+Integer CachedRabinFunction::squareRoot(const Integer& x, const MontgomeryRepresentation& mp, const MontgomeryRepresentation& mq) const {
+	Integer cp, cq;
+	if (!squareRootModPrime(x % GetPrime1(), GetPrime1(), expP, mp, cp) || 
+		!squareRootModPrime(x % GetPrime2(), GetPrime2(), expQ, mq, cq))
+		return Integer::Zero();
+
+	//combine the roots, using u = q^(-1) mod p
+	return CRT(cq, GetPrime2(), cp, GetPrime1(), GetMultiplicativeInverseOfPrime2ModPrime1());
+}
+
 /*
  * function initRabinAll    : This function initialize the Rabin object with public key and private key
  * param tpPtr				: The pointer to the trapdoor permutation object 
@@ -67,10 +153,11 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 	  m_u=utils.jbyteArrayToCryptoPPInteger(env, u);
 
 	  //create pointer to InvertibleRabinFunction object
-	  TrapdoorFunction *tpPtr = new InvertibleRabinFunction;
+	  TrapdoorFunction *tpPtr = new CachedRabinFunction;
 
 	  //initialize the Rabin object with the parameters
-	  ((InvertibleRabinFunction *) tpPtr) -> Initialize(modN, m_r, m_s, m_p, m_q, m_u);
+	  ((CachedRabinFunction *) tpPtr) -> Initialize(modN, m_r, m_s, m_p, m_q, m_u);
+	  ((CachedRabinFunction *) tpPtr) -> precompute();
 
 	  return (jlong) tpPtr; // return the pointer
 
@@ -115,10 +202,11 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
 	  AutoSeededRandomPool rng;
 	  
 	  //create pointer to InvertibleRabinFunction object
-	  TrapdoorFunction *tpPtr = new InvertibleRabinFunction;
+	  TrapdoorFunction *tpPtr = new CachedRabinFunction;
 
 	  //initialize the trapdoor object with the random values
-	  ((InvertibleRabinFunction *) tpPtr) -> Initialize(rng, numBits);
+	  ((CachedRabinFunction *) tpPtr) -> Initialize(rng, numBits);
+	  ((CachedRabinFunction *) tpPtr) -> precompute();
 
 	  return (jlong) tpPtr; // return the pointer
 }
@@ -302,60 +390,46 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_crypto
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabin
   (JNIEnv *env, jobject, jlong tpPtr, jlong element) {
-	  // Random Number Generator
-	  AutoSeededRandomPool rng;
 	  Utils utils;
+	  CachedRabinFunction* rabin = (CachedRabinFunction *) tpPtr;
 
-	  //get the Integer value to invert
-	  Integer x = *(Integer*) element;
+	  //invert, with copies of the Montgomery representations since other threads may use the object too.
+	  //if the element has no root that is a quadratic residue, the result is the Integer 0.
+	  MontgomeryRepresentation mp(rabin -> getMontgomeryP()), mq(rabin -> getMontgomeryQ());
+	  Integer out = rabin -> squareRoot(*(Integer*) element, mp, mq);
 
-	
-	  //invert
-	  ((InvertibleRabinFunction *) tpPtr) ->DoQuickSanityCheck();
-	  Integer mod = ((InvertibleRabinFunction *) tpPtr) -> GetModulus();
-	  ModularArithmetic modn(mod);
-	  Integer p = ((InvertibleRabinFunction *) tpPtr)->GetPrime1();
-	  Integer q = ((InvertibleRabinFunction *) tpPtr)->GetPrime2();
-	  Integer cp=x % p;
-	  Integer cq=x % q;
-	  cp = ModularSquareRoot(cp, p);
-	  cq = ModularSquareRoot(cq, q);
-
-	  Integer v =p.InverseMod(q);
-      Integer u = ((InvertibleRabinFunction *) tpPtr)->GetMultiplicativeInverseOfPrime2ModPrime1();
-
-	  Integer onep = modn.Multiply(u,q);
- 
-	  Integer oneq = modn.Multiply(v,p);
-	  
- 	  Integer outp1 = modn.Multiply(onep,cp);
-      Integer outp2 = modn.Multiply(onep,p-cp);
-      Integer outq1 = modn.Multiply(oneq,cq);
- 
-	  Integer outq2 = modn.Multiply(oneq,q-cq);
- 
-	  Integer out = (outp1 + outq1)% mod;
-      if ((Jacobi(out%p, p) == 1) && (Jacobi(out%q, q) == 1)){
- 
-		return (jlong) utils.getPointerToInteger(out);
-	  }
-	  
-	  out = (outp1 + outq2)%mod;
-      if ((Jacobi(out%p, p) == 1) && (Jacobi(out%q, q) == 1))
- 		return (jlong) utils.getPointerToInteger(out);
-	  
-	  out = (outp2 + outq1)%mod;
-	  if ((Jacobi(out%p, p) == 1) && (Jacobi(out%q, q) == 1))
-		  return (jlong) utils.getPointerToInteger(out);
-	  
-	  out = (outp2 + outq2)%mod;
-	  if ((Jacobi(out%p, p) == 1) && (Jacobi(out%q, q) == 1))
-		  return (jlong) utils.getPointerToInteger(out);
- 
-	  //If none of the above cases are true then retun a pointer to the Integer 0.
-	  out = 0;
-	  return (jlong) utils.getPointerToInteger(out);	
+	  return (jlong) utils.getPointerToInteger(out);
+}
 
+/*
+ * function invertRabinBatch	: This function invert the Rabin permutation on each of the accepted elements, in several threads
+ * param tpPtr					: The pointer to the Rabin object 
+ * param elements				: The pointers to the elements to invert
+ * return jlongArray			: The pointers to the results, in the order of the elements, or NULL if one of them failed
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_cryptopp_CryptoPpRabinPermutation_invertRabinBatch
+  (JNIEnv *env, jobject, jlong tpPtr, jlongArray elements) {
+	  int size = env->GetArrayLength(elements);
+	  //the entries stay 0 until their results are created, so a failed batch knows which results to delete
+	  jlong* results = new (nothrow) jlong[size]();
+	  if (results == NULL)
+		  return NULL;
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  CachedRabinFunction* rabin = (CachedRabinFunction *) tpPtr;
+
+	  //invert the ranges of the elements by the threads of the pool, each range with its own copies of the Montgomery representations
+	  bool success = getThreadPool()->parallelFor(size, [&](int first, int last) {
+		  MontgomeryRepresentation mp(rabin -> getMontgomeryP()), mq(rabin -> getMontgomeryQ());
+		  for (int i = first; i < last; i++)
+			  results[i] = (jlong) new Integer(rabin -> squareRoot(*(Integer*) elementsArr[i], mp, mq));
+		  return true;
+	  });
+
+	  //the elements were only read
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  //return the results' pointers as jlongArray, or NULL if crypto++ failed on one of the elements
+	  return batchResultsToJlongArray(env, results, size, success);
 }
 
 /*
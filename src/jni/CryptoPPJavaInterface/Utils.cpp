@@ -38,6 +38,26 @@
 
 using namespace std;
 
+/* function batchResultsToJlongArray	: Returns the pointers to the results of a batch function as a jlongArray, and deletes the given array.
+ *									  If the batch failed, the Integers that were created are deleted and NULL is returned.
+ * param results					: The pointers to the results. The entries that were not computed should be 0.
+ * param size						: The number of results
+ * param success					: Whether all the results were computed
+ * return							: The results' pointers, or NULL on failure
+ */
+jlongArray batchResultsToJlongArray(JNIEnv *env, jlong* results, int size, bool success) {
+	jlongArray result = NULL;
+	if (success) {
+		result = env->NewLongArray(size);
+		env->SetLongArrayRegion(result, 0, size, results);
+	} else {
+		for (int i = 0; i < size; i++)
+			delete (Integer*) results[i];
+	}
+	delete[] results;
+	return result;
+}
+
 /* function Utils	: constructor
  * return			: 
  */
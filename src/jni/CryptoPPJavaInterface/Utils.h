@@ -49,5 +49,11 @@ public:
 	bool HasSquareRoot(Integer value, Integer p, Integer q);
 };
 
+/*
+ * Returns the pointers to the results of a batch function, and deletes the given array.
+ * If the batch failed, deletes the Integers that were created (the other entries should be 0) and returns NULL.
+ */
+jlongArray batchResultsToJlongArray(JNIEnv *env, jlong* results, int size, bool success);
+
 
 #endif
@@ -0,0 +1,293 @@
+#include "AesBatchPrf.h"
+#include <immintrin.h>
+
+//Number of 512 bit registers that are encrypted together by the VAES kernels, each one of them holds 4 blocks.
+#define AES_WIDE_PIPELINE 4
+#define AES_WIDE_PIPELINE_BLOCKS (AES_WIDE_PIPELINE * 4)
+
+AES_BATCH_KEY* createAesBatchKey(const unsigned char* key, int bits){
+	if (bits != 128 && bits != 192 && bits != 256){
+		return NULL;
+	}
+
+	AES_BATCH_KEY* batchKey = (AES_BATCH_KEY*)_mm_malloc(sizeof(AES_BATCH_KEY), 16);
+	AES_set_encrypt_key(key, bits, &batchKey->encryptKey);
+	AES_set_decrypt_key_fast(&batchKey->decryptKey, &batchKey->encryptKey);
+	return batchKey;
+}
+
+void deleteAesBatchKey(AES_BATCH_KEY* key){
+	_mm_free(key);
+}
+
+/*
+ * The rounds of AES on N independent blocks. The loops over the blocks are unrolled by the compiler,
+ * so the blocks stay in registers and N aesenc instructions are in flight at each round.
+ */
+template<int N> static inline void encryptPipeline(block* b, const block* sched, int rounds){
+	for (int k = 0; k < N; k++){
+		b[k] = _mm_xor_si128(b[k], sched[0]);
+	}
+	for (int j = 1; j < rounds; j++){
+		block roundKey = sched[j];
+		for (int k = 0; k < N; k++){
+			b[k] = _mm_aesenc_si128(b[k], roundKey);
+		}
+	}
+	for (int k = 0; k < N; k++){
+		b[k] = _mm_aesenclast_si128(b[k], sched[rounds]);
+	}
+}
+
+template<int N> static inline void decryptPipeline(block* b, const block* sched, int rounds){
+	for (int k = 0; k < N; k++){
+		b[k] = _mm_xor_si128(b[k], sched[0]);
+	}
+	for (int j = 1; j < rounds; j++){
+		block roundKey = sched[j];
+		for (int k = 0; k < N; k++){
+			b[k] = _mm_aesdec_si128(b[k], roundKey);
+		}
+	}
+	for (int k = 0; k < N; k++){
+		b[k] = _mm_aesdeclast_si128(b[k], sched[rounds]);
+	}
+}
+
+/*
+ * sigma(xL || xR) = (xL ^ xR) || xL, where xL is the high half of the block.
+ */
+static inline block sigma(block x){
+	return _mm_xor_si128(_mm_shuffle_epi32(x, 78), _mm_and_si128(x, _mm_set_epi64x(-1, 0)));
+}
+
+static void encryptBlocksAesNi(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	const block* sched = key->rd_key;
+	int rounds = ROUNDS(key);
+	block b[AES_PIPELINE_BLOCKS];
+	int i = 0;
+	for (; i + AES_PIPELINE_BLOCKS <= numBlocks; i += AES_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			b[k] = _mm_loadu_si128((block*)in + i + k);
+		}
+		encryptPipeline<AES_PIPELINE_BLOCKS>(b, sched, rounds);
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			_mm_storeu_si128((block*)out + i + k, b[k]);
+		}
+	}
+	for (; i < numBlocks; i++){
+		b[0] = _mm_loadu_si128((block*)in + i);
+		encryptPipeline<1>(b, sched, rounds);
+		_mm_storeu_si128((block*)out + i, b[0]);
+	}
+}
+
+static void decryptBlocksAesNi(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	const block* sched = key->rd_key;
+	int rounds = ROUNDS(key);
+	block b[AES_PIPELINE_BLOCKS];
+	int i = 0;
+	for (; i + AES_PIPELINE_BLOCKS <= numBlocks; i += AES_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			b[k] = _mm_loadu_si128((block*)in + i + k);
+		}
+		decryptPipeline<AES_PIPELINE_BLOCKS>(b, sched, rounds);
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			_mm_storeu_si128((block*)out + i + k, b[k]);
+		}
+	}
+	for (; i < numBlocks; i++){
+		b[0] = _mm_loadu_si128((block*)in + i);
+		decryptPipeline<1>(b, sched, rounds);
+		_mm_storeu_si128((block*)out + i, b[0]);
+	}
+}
+
+static void counterBlocksAesNi(const AES_KEY* key, long long nonce, long long counter, unsigned char* out, int numBlocks){
+	const block* sched = key->rd_key;
+	int rounds = ROUNDS(key);
+	block b[AES_PIPELINE_BLOCKS];
+	int i = 0;
+	for (; i + AES_PIPELINE_BLOCKS <= numBlocks; i += AES_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			b[k] = _mm_set_epi64x(nonce, counter + i + k);
+		}
+		encryptPipeline<AES_PIPELINE_BLOCKS>(b, sched, rounds);
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			_mm_storeu_si128((block*)out + i + k, b[k]);
+		}
+	}
+	for (; i < numBlocks; i++){
+		b[0] = _mm_set_epi64x(nonce, counter + i);
+		encryptPipeline<1>(b, sched, rounds);
+		_mm_storeu_si128((block*)out + i, b[0]);
+	}
+}
+
+static void fixedKeyHashAesNi(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks, long long tweak){
+	const block* sched = key->rd_key;
+	int rounds = ROUNDS(key);
+	block b[AES_PIPELINE_BLOCKS], s[AES_PIPELINE_BLOCKS];
+	int i = 0;
+	for (; i + AES_PIPELINE_BLOCKS <= numBlocks; i += AES_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			s[k] = sigma(_mm_loadu_si128((block*)in + i + k));
+			b[k] = _mm_xor_si128(s[k], _mm_set_epi64x(0, tweak + i + k));
+		}
+		encryptPipeline<AES_PIPELINE_BLOCKS>(b, sched, rounds);
+		for (int k = 0; k < AES_PIPELINE_BLOCKS; k++){
+			_mm_storeu_si128((block*)out + i + k, _mm_xor_si128(b[k], s[k]));
+		}
+	}
+	for (; i < numBlocks; i++){
+		s[0] = sigma(_mm_loadu_si128((block*)in + i));
+		b[0] = _mm_xor_si128(s[0], _mm_set_epi64x(0, tweak + i));
+		encryptPipeline<1>(b, sched, rounds);
+		_mm_storeu_si128((block*)out + i, _mm_xor_si128(b[0], s[0]));
+	}
+}
+
+/*
+ * The VAES kernels. Each 512 bit register holds 4 blocks and each round key is broadcast to the 4 lanes.
+ * They handle AES_WIDE_PIPELINE_BLOCKS blocks at a time, and return the number of blocks that were handled.
+ * The remaining blocks are left to the AES-NI kernels.
+ */
+VAES_TARGET static inline void encryptPipelineWide(__m512i* b, const block* sched, int rounds){
+	__m512i roundKey = _mm512_broadcast_i32x4(sched[0]);
+	for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+		b[k] = _mm512_xor_si512(b[k], roundKey);
+	}
+	for (int j = 1; j < rounds; j++){
+		roundKey = _mm512_broadcast_i32x4(sched[j]);
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			b[k] = _mm512_aesenc_epi128(b[k], roundKey);
+		}
+	}
+	roundKey = _mm512_broadcast_i32x4(sched[rounds]);
+	for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+		b[k] = _mm512_aesenclast_epi128(b[k], roundKey);
+	}
+}
+
+VAES_TARGET static inline void decryptPipelineWide(__m512i* b, const block* sched, int rounds){
+	__m512i roundKey = _mm512_broadcast_i32x4(sched[0]);
+	for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+		b[k] = _mm512_xor_si512(b[k], roundKey);
+	}
+	for (int j = 1; j < rounds; j++){
+		roundKey = _mm512_broadcast_i32x4(sched[j]);
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			b[k] = _mm512_aesdec_epi128(b[k], roundKey);
+		}
+	}
+	roundKey = _mm512_broadcast_i32x4(sched[rounds]);
+	for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+		b[k] = _mm512_aesdeclast_epi128(b[k], roundKey);
+	}
+}
+
+VAES_TARGET static int encryptBlocksVaes(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	__m512i b[AES_WIDE_PIPELINE];
+	int i = 0;
+	for (; i + AES_WIDE_PIPELINE_BLOCKS <= numBlocks; i += AES_WIDE_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			b[k] = _mm512_loadu_si512(in + (i + 4 * k) * SIZE_OF_BLOCK);
+		}
+		encryptPipelineWide(b, key->rd_key, ROUNDS(key));
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			_mm512_storeu_si512(out + (i + 4 * k) * SIZE_OF_BLOCK, b[k]);
+		}
+	}
+	return i;
+}
+
+VAES_TARGET static int decryptBlocksVaes(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	__m512i b[AES_WIDE_PIPELINE];
+	int i = 0;
+	for (; i + AES_WIDE_PIPELINE_BLOCKS <= numBlocks; i += AES_WIDE_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			b[k] = _mm512_loadu_si512(in + (i + 4 * k) * SIZE_OF_BLOCK);
+		}
+		decryptPipelineWide(b, key->rd_key, ROUNDS(key));
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			_mm512_storeu_si512(out + (i + 4 * k) * SIZE_OF_BLOCK, b[k]);
+		}
+	}
+	return i;
+}
+
+VAES_TARGET static int counterBlocksVaes(const AES_KEY* key, long long nonce, long long counter, unsigned char* out, int numBlocks){
+	//Only the low half of each block (the counter) is incremented.
+	const __m512i step = _mm512_set_epi64(0, 4, 0, 4, 0, 4, 0, 4);
+	__m512i ctr = _mm512_set_epi64(nonce, counter + 3, nonce, counter + 2, nonce, counter + 1, nonce, counter);
+	__m512i b[AES_WIDE_PIPELINE];
+	int i = 0;
+	for (; i + AES_WIDE_PIPELINE_BLOCKS <= numBlocks; i += AES_WIDE_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			b[k] = ctr;
+			ctr = _mm512_add_epi64(ctr, step);
+		}
+		encryptPipelineWide(b, key->rd_key, ROUNDS(key));
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			_mm512_storeu_si512(out + (i + 4 * k) * SIZE_OF_BLOCK, b[k]);
+		}
+	}
+	return i;
+}
+
+VAES_TARGET static int fixedKeyHashVaes(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks, long long tweak){
+	const __m512i highHalves = _mm512_set_epi64(-1, 0, -1, 0, -1, 0, -1, 0);
+	const __m512i step = _mm512_set_epi64(0, 4, 0, 4, 0, 4, 0, 4);
+	__m512i tweaks = _mm512_set_epi64(0, tweak + 3, 0, tweak + 2, 0, tweak + 1, 0, tweak);
+	__m512i b[AES_WIDE_PIPELINE], s[AES_WIDE_PIPELINE];
+	int i = 0;
+	for (; i + AES_WIDE_PIPELINE_BLOCKS <= numBlocks; i += AES_WIDE_PIPELINE_BLOCKS){
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			__m512i x = _mm512_loadu_si512(in + (i + 4 * k) * SIZE_OF_BLOCK);
+			s[k] = _mm512_xor_si512(_mm512_shuffle_epi32(x, (_MM_PERM_ENUM)78), _mm512_and_si512(x, highHalves));
+			b[k] = _mm512_xor_si512(s[k], tweaks);
+			tweaks = _mm512_add_epi64(tweaks, step);
+		}
+		encryptPipelineWide(b, key->rd_key, ROUNDS(key));
+		for (int k = 0; k < AES_WIDE_PIPELINE; k++){
+			_mm512_storeu_si512(out + (i + 4 * k) * SIZE_OF_BLOCK, _mm512_xor_si512(b[k], s[k]));
+		}
+	}
+	return i;
+}
+
+void aesEncryptBlocks(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	static const bool vaes = hasVaes();
+	int done = 0;
+	if (vaes){
+		done = encryptBlocksVaes(key, in, out, numBlocks);
+	}
+	encryptBlocksAesNi(key, in + done * SIZE_OF_BLOCK, out + done * SIZE_OF_BLOCK, numBlocks - done);
+}
+
+void aesDecryptBlocks(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks){
+	static const bool vaes = hasVaes();
+	int done = 0;
+	if (vaes){
+		done = decryptBlocksVaes(key, in, out, numBlocks);
+	}
+	decryptBlocksAesNi(key, in + done * SIZE_OF_BLOCK, out + done * SIZE_OF_BLOCK, numBlocks - done);
+}
+
+void aesCounterBlocks(const AES_KEY* key, long long nonce, long long counter, unsigned char* out, int numBlocks){
+	static const bool vaes = hasVaes();
+	int done = 0;
+	if (vaes){
+		done = counterBlocksVaes(key, nonce, counter, out, numBlocks);
+	}
+	counterBlocksAesNi(key, nonce, counter + done, out + done * SIZE_OF_BLOCK, numBlocks - done);
+}
+
+void aesFixedKeyHash(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks, long long tweak){
+	static const bool vaes = hasVaes();
+	int done = 0;
+	if (vaes){
+		done = fixedKeyHashVaes(key, in, out, numBlocks, tweak);
+	}
+	fixedKeyHashAesNi(key, in + done * SIZE_OF_BLOCK, out + done * SIZE_OF_BLOCK, numBlocks - done, tweak + done);
+}
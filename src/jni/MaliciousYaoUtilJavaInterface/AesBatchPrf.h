@@ -0,0 +1,51 @@
+#ifndef AES_BATCH_PRF_H
+#define AES_BATCH_PRF_H
+
+#include "TedKrovetzAesNiWrapperC.h"
+
+//Number of blocks that are encrypted together by the AES-NI kernels, so that the latency of aesenc is hidden.
+#define AES_PIPELINE_BLOCKS 8
+
+/**
+* The expanded keys of one AES key, for both directions.
+* Must be 16 bytes aligned, so it should be created with createAesBatchKey.
+*/
+typedef struct { AES_KEY encryptKey; AES_KEY decryptKey; } AES_BATCH_KEY;
+
+/**
+* Expands the given key (of 128, 192 or 256 bits) and returns the expanded keys.
+* Returns NULL if the size of the key is not valid. The returned keys should be deleted using deleteAesBatchKey.
+*/
+AES_BATCH_KEY* createAesBatchKey(const unsigned char* key, int bits);
+
+void deleteAesBatchKey(AES_BATCH_KEY* key);
+
+/**
+* The functions below work on numBlocks consecutive blocks of SIZE_OF_BLOCK bytes.
+* The buffers do not have to be aligned (they can be pinned java arrays or direct buffers), and in may be equal to out.
+* On hosts with VAES and AVX-512 four blocks are encrypted in each aesenc, otherwise AES_PIPELINE_BLOCKS blocks are encrypted in parallel with AES-NI.
+*/
+
+/**
+* out[i] = AES_k(in[i]).
+*/
+void aesEncryptBlocks(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks);
+
+/**
+* out[i] = AES_k^-1(in[i]). The given key should be a decryption key.
+*/
+void aesDecryptBlocks(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks);
+
+/**
+* The PRF in counter mode: out[i] = AES_k(nonce || counter + i), where the counter is the low 64 bits of the block.
+* With nonce = counter = 0 these are the blocks that transformKeys uses as new keys.
+*/
+void aesCounterBlocks(const AES_KEY* key, long long nonce, long long counter, unsigned char* out, int numBlocks);
+
+/**
+* Fixed-key tweakable circular correlation robust hash, as used for garbling with a fixed AES key:
+* out[i] = pi(sigma(in[i]) ^ (tweak + i)) ^ sigma(in[i]), where pi is AES with the fixed key and sigma(xL || xR) = (xL ^ xR) || xL.
+*/
+void aesFixedKeyHash(const AES_KEY* key, const unsigned char* in, unsigned char* out, int numBlocks, long long tweak);
+
+#endif
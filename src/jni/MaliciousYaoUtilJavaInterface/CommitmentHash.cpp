@@ -0,0 +1,157 @@
+#include "CommitmentHash.h"
+#include <blake2.h>
+#include <immintrin.h>
+#include <string.h>
+#include <ctype.h>
+#include <vector>
+
+using namespace std;
+
+#ifdef _MSC_VER
+#define SHANI_TARGET
+#else
+#define SHANI_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+
+void Sha1CommitmentHash::hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const {
+	sha1Multi(part1, len1, part2, len2, numMessages, digests);
+}
+
+static const unsigned int SHA256_ROUND_CONSTANTS[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const unsigned int SHA256_INITIAL_STATE[8] = {
+	0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/*
+ * Computes the SHA-256 of the given padded message with the SHA extensions and writes it to digest.
+ * The instructions work on the state as the two registers ABEF and CDGH, and each sha256rnds2 does two rounds.
+ */
+SHANI_TARGET static void sha256ShaNi(const unsigned char* padded, int numBlocks, unsigned char* digest){
+	const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	__m128i tmp = _mm_loadu_si128((const __m128i*)&SHA256_INITIAL_STATE[0]);
+	__m128i state1 = _mm_loadu_si128((const __m128i*)&SHA256_INITIAL_STATE[4]);
+	tmp = _mm_shuffle_epi32(tmp, 0xB1);
+	state1 = _mm_shuffle_epi32(state1, 0x1B);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+	for (int b = 0; b < numBlocks; b++){
+		__m128i savedState0 = state0;
+		__m128i savedState1 = state1;
+
+		//The last four groups of four message words.
+		__m128i w[4];
+		for (int i = 0; i < 16; i++){
+			__m128i words;
+			if (i < 4){
+				words = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(padded + b*64 + i*16)), byteSwap);
+			} else {
+				//W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16], four words at a time.
+				words = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+				words = _mm_add_epi32(words, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+				words = _mm_sha256msg2_epu32(words, w[(i + 3) & 3]);
+			}
+			w[i & 3] = words;
+
+			__m128i msg = _mm_add_epi32(words, _mm_loadu_si128((const __m128i*)&SHA256_ROUND_CONSTANTS[i*4]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+		}
+
+		state0 = _mm_add_epi32(state0, savedState0);
+		state1 = _mm_add_epi32(state1, savedState1);
+	}
+
+	//Back from ABEF, CDGH to ABCD, EFGH.
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+	state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+	//The digest is the big endian state.
+	_mm_storeu_si128((__m128i*)digest, _mm_shuffle_epi8(state0, byteSwap));
+	_mm_storeu_si128((__m128i*)(digest + 16), _mm_shuffle_epi8(state1, byteSwap));
+}
+
+void Sha256CommitmentHash::hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const {
+	static const bool shaNi = hasShaNi();
+	if (!shaNi){
+		sha256Multi(part1, len1, part2, len2, numMessages, digests);
+		return;
+	}
+
+	//With the SHA extensions a single message is hashed faster than a lane of the multi-buffer implementation.
+	int msgLen = len1 + len2;
+	int numBlocks = (msgLen + 9 + 63) / 64;
+	int paddedLen = numBlocks * 64;
+	unsigned long long bitLen = (unsigned long long) msgLen * 8;
+	vector<unsigned char> padded(paddedLen);
+
+	for (int j = 0; j < numMessages; j++){
+		unsigned char* msg = &padded[0];
+		memcpy(msg, part1 + j*len1, len1);
+		memcpy(msg + len1, part2 + j*len2, len2);
+		memset(msg + msgLen, 0, paddedLen - msgLen);
+		msg[msgLen] = 0x80;
+		for (int i = 0; i < 8; i++){
+			msg[paddedLen - 1 - i] = (unsigned char)(bitLen >> (8 * i));
+		}
+		sha256ShaNi(msg, numBlocks, digests + j*SHA256_DIGEST_SIZE);
+	}
+}
+
+void Blake2sCommitmentHash::hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const {
+	//The two parts are hashed one after the other, so the messages are not copied.
+	blake2s_state state;
+	for (int j = 0; j < numMessages; j++){
+		blake2s_init(&state, BLAKE2S_DIGEST_SIZE);
+		blake2s_update(&state, part1 + j*len1, len1);
+		blake2s_update(&state, part2 + j*len2, len2);
+		blake2s_final(&state, digests + j*BLAKE2S_DIGEST_SIZE, BLAKE2S_DIGEST_SIZE);
+	}
+}
+
+/*
+ * Returns true if the given name equals the given lower case name, ignoring case and '-'.
+ */
+static bool matchesName(const char* name, const char* lowerCaseName){
+	for (; *name != '\0'; name++){
+		if (*name == '-'){
+			continue;
+		}
+		if (tolower((unsigned char)*name) != *lowerCaseName){
+			return false;
+		}
+		lowerCaseName++;
+	}
+	return *lowerCaseName == '\0';
+}
+
+const CommitmentHash* getCommitmentHash(const char* name){
+	static Sha1CommitmentHash sha1Hash;
+	static Sha256CommitmentHash sha256Hash;
+	static Blake2sCommitmentHash blake2sHash;
+
+	if (matchesName(name, "sha1")){
+		return &sha1Hash;
+	}
+	if (matchesName(name, "sha256")){
+		return &sha256Hash;
+	}
+	if (matchesName(name, "blake2s")){
+		return &blake2sHash;
+	}
+	return NULL;
+}
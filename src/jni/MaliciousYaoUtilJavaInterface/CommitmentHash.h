@@ -0,0 +1,63 @@
+#ifndef COMMITMENT_HASH_H
+#define COMMITMENT_HASH_H
+
+#include "../Common/MultiBufferHash.h"
+
+#define BLAKE2S_DIGEST_SIZE 32
+
+/**
+* The hash H of the simple hash commitment com = H(r, x).
+* Implementations hash many decommitments at once, so that each one can use the fastest code that the cpu supports.
+*/
+class CommitmentHash {
+public:
+	virtual ~CommitmentHash() {}
+
+	/**
+	* Returns the size of the digest, in bytes.
+	*/
+	virtual int getDigestSize() const = 0;
+
+	/**
+	* Computes digests + j*getDigestSize() = H(part1[j*len1 .. (j+1)*len1), part2[j*len2 .. (j+1)*len2)) for each of the numMessages messages.
+	*/
+	virtual void hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const = 0;
+};
+
+/**
+* SHA-1, using the multi-buffer implementation.
+*/
+class Sha1CommitmentHash : public CommitmentHash {
+public:
+	int getDigestSize() const { return SHA1_DIGEST_SIZE; }
+	void hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const;
+};
+
+/**
+* SHA-256, using the SHA extensions of the cpu when they are available and the multi-buffer implementation otherwise.
+*/
+class Sha256CommitmentHash : public CommitmentHash {
+public:
+	int getDigestSize() const { return SHA256_DIGEST_SIZE; }
+	void hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const;
+};
+
+/**
+* BLAKE2s with 32 bytes output and no key, computed by the blake2 library.
+* A decommitment (r, x) fits in one block of BLAKE2s, so each message takes a single compression.
+*/
+class Blake2sCommitmentHash : public CommitmentHash {
+public:
+	int getDigestSize() const { return BLAKE2S_DIGEST_SIZE; }
+	void hashMany(const unsigned char* part1, int len1, const unsigned char* part2, int len2, int numMessages, unsigned char* digests) const;
+};
+
+/**
+* Returns the hash of the given name, or NULL if the commitments can not be verified using this hash.
+* The name is the algorithm name of the java hash that the parties agreed on. The providers write it differently 
+* ("SHA-1" in Crypto++ and BouncyCastle, "SHA1" in OpenSSL), so case and '-' are ignored.
+* The returned object is shared and should not be deleted.
+*/
+const CommitmentHash* getCommitmentHash(const char* name);
+
+#endif
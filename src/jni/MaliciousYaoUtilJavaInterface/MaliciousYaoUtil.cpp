@@ -1,5 +1,7 @@
 #include "MaliciousYaoUtil.h"
 #include "TedKrovetzAesNiWrapperC.h"
+#include "CommitmentHash.h"
+#include "AesBatchPrf.h"
 #include <iostream>
 
 
@@ -48,16 +50,11 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	  block* originalKeysb = (block *)  _mm_malloc(sizeof(block) * n * 2, 16);
 	  block* probeResistantKeysb = (block *)  _mm_malloc(sizeof(block) * m * 2, 16);
 	  block* newKeysb = (block *)  _mm_malloc(sizeof(block) * n, 16);
-	  block * indexArray = (block *)_mm_malloc(sizeof(block) * n, 16);
-	
-	  for (int i = 0; i < n; i++){
-
-		indexArray[i] = _mm_set_epi32(0, 0, 0, i);
-	  }
 
+	  //The new keys are the encryptions of the indices 0, ..., n-1 under the seed.
 	  AES_KEY * aesSeedKey = (AES_KEY *)_mm_malloc(sizeof(AES_KEY), 16);
 	  AES_set_encrypt_key((const unsigned char *)seed, 128, aesSeedKey);
-	  AES_ecb_encrypt_chunk_in_out(indexArray, newKeysb, n, aesSeedKey);
+	  aesCounterBlocks(aesSeedKey, 0, 0, (unsigned char*)newKeysb, n);
 
 	  memcpy(originalKeysb, originalKeys, sizeof(block) *  n * 2);
 	  memcpy(probeResistantKeysb, probeResistantKeys, sizeof(block) *  m * 2);
@@ -85,7 +82,6 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 	 _mm_free(originalKeysb);
 	 _mm_free(probeResistantKeysb);
 	 _mm_free(newKeysb);
-	 _mm_free(indexArray);
 	 _mm_free(aesSeedKey);
 
 	 delete matrix;
@@ -136,96 +132,155 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_KProbeResistantMatr
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeysWithMask
   (JNIEnv *env, jobject, jbyteArray keysArray, jbyteArray maskBytes, int size){
 
-	  block* keysBlocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	 
-	  jbyte *keys = env->GetByteArrayElements(keysArray, 0);
-	  jbyte *maskArray = env->GetByteArrayElements(maskBytes, 0);
-	  
-	  memcpy(keysBlocks, keys, sizeof(block) * size);
-	   
 	  block mask;
-	  memcpy(&mask, maskArray, sizeof(block));
-	 
-	  for (int i = 0; i < size; i++) {
-		keysBlocks[i] =  _mm_xor_si128(keysBlocks[i], mask);
-	}
-
-	  env->ReleaseByteArrayElements(keysArray,keys,JNI_ABORT);
-	  env->ReleaseByteArrayElements(maskBytes,maskArray,JNI_ABORT);
-
-	  env->SetByteArrayRegion(keysArray, 0, size*SIZE_OF_BLOCK,  (jbyte*)keysBlocks);
-
-	   _mm_free(keysBlocks);
+	  env->GetByteArrayRegion(maskBytes, 0, SIZE_OF_BLOCK, (jbyte*)&mask);
 
+	  //Xor the keys in place, without copying them.
+	  jbyte *keys = (jbyte*) env->GetPrimitiveArrayCritical(keysArray, 0);
+	  xorKeysWithMask((block*)keys, mask, size);
+	  env->ReleasePrimitiveArrayCritical(keysArray, keys, 0);
 }
 
 
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeys
   (JNIEnv * env, jobject, jbyteArray keys1Array, jbyteArray keys2Array, jbyteArray output, int size){
 	  
-	  block* keys1Blocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	  block* keys2Blocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	  block* outputBlocks = (block *)  _mm_malloc(sizeof(block) * size, 16);
-	 
-	  jbyte *keys1 = env->GetByteArrayElements(keys1Array, 0);
-	  jbyte *keys2 = env->GetByteArrayElements(keys2Array, 0);
-	  
-	  memcpy(keys1Blocks, keys1, sizeof(block) * size);
-	  memcpy(keys2Blocks, keys2, sizeof(block) * size);
+	  jbyte *keys1 = (jbyte*) env->GetPrimitiveArrayCritical(keys1Array, 0);
+	  jbyte *keys2 = (jbyte*) env->GetPrimitiveArrayCritical(keys2Array, 0);
+	  jbyte *out = (jbyte*) env->GetPrimitiveArrayCritical(output, 0);
 	   
-	  for (int i = 0; i < size; i++) {
-		outputBlocks[i] =  _mm_xor_si128(keys1Blocks[i], keys2Blocks[i]);
-	}
+	  xorKeys((block*)keys1, (block*)keys2, (block*)out, size);
 
-	  env->ReleaseByteArrayElements(keys1Array,keys1,JNI_ABORT);
-	  env->ReleaseByteArrayElements(keys1Array,keys2,JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(output, out, 0);
+	  env->ReleasePrimitiveArrayCritical(keys2Array, keys2, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(keys1Array, keys1, JNI_ABORT);
+}
 
-	  env->SetByteArrayRegion(output, 0, size*SIZE_OF_BLOCK,  (jbyte*)outputBlocks);
 
-	   _mm_free(keys2Blocks);
-	   _mm_free(outputBlocks);
+/*
+ * Returns the commitment hash of the given java name, or NULL if it is not supported.
+ */
+static const CommitmentHash* getCommitmentHash(JNIEnv* env, jstring hashName){
+	const char* name = env->GetStringUTFChars(hashName, NULL);
+	if (name == NULL){
+		return NULL;
+	}
+	const CommitmentHash* hash = getCommitmentHash(name);
+	env->ReleaseStringUTFChars(hashName, name);
+	return hash;
 }
 
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_isCommitmentHashSupported
+	(JNIEnv * env, jobject, jstring hashName){
+		return getCommitmentHash(env, hashName) != NULL;
+}
 
-JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
-	(JNIEnv * env, jobject, jbyteArray commitment, jbyteArray rArray, jbyteArray xArray){
-
-		jbyte *comm = env->GetByteArrayElements(commitment, 0);
-		jbyte *r = env->GetByteArrayElements(rArray, 0);
-		jbyte *x = env->GetByteArrayElements(xArray, 0);
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
+	(JNIEnv * env, jobject, jbyteArray commitment, jbyteArray rArray, jbyteArray xArray, jbyteArray validBitmap, jstring hashName){
 
-		SHA_CTX sha;
-		
 		int rounds = env->GetArrayLength(xArray)/SIZE_OF_BLOCK;
-		int hashSize = env->GetArrayLength(rArray)/rounds;
-
-		char* output = new char[hashSize];
-		
-		for (int j=0; j<rounds; j++){
-			SHA1_Init(&sha);
-			SHA1_Update(&sha, r+j*hashSize, hashSize);
-			SHA1_Update(&sha, x+j*SIZE_OF_BLOCK, SIZE_OF_BLOCK);
-			SHA1_Final((unsigned char*) output, &sha);
-			
-			bool equal = true;
-			for (int i=0; i<hashSize; i++){
-				if (output[i] != (comm+j*hashSize)[i]){
-					cout<<"not equal. j = "<<j<< endl;
-					delete output;
-					env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
-					env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
-					env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
-
-					return false;
-				}
-			}
+
+		//An unknown hash can not verify anything.
+		const CommitmentHash* hash = getCommitmentHash(env, hashName);
+		if (hash == NULL){
+			return false;
 		}
 
-		delete output;
-		env->ReleaseByteArrayElements(commitment,comm,JNI_ABORT);
-		env->ReleaseByteArrayElements(rArray,r,JNI_ABORT);
-		env->ReleaseByteArrayElements(xArray,x,JNI_ABORT);
+		jbyte *comm = (jbyte*) env->GetPrimitiveArrayCritical(commitment, 0);
+		jbyte *r = (jbyte*) env->GetPrimitiveArrayCritical(rArray, 0);
+		jbyte *x = (jbyte*) env->GetPrimitiveArrayCritical(xArray, 0);
+		jbyte *bitmap = (jbyte*) env->GetPrimitiveArrayCritical(validBitmap, 0);
 
-		return true;
+		bool valid = verifyDecommitments(*hash, (unsigned char*)comm, (unsigned char*)r, (unsigned char*)x, rounds, (unsigned char*)bitmap);
+
+		env->ReleasePrimitiveArrayCritical(validBitmap, bitmap, 0);
+		env->ReleasePrimitiveArrayCritical(xArray, x, JNI_ABORT);
+		env->ReleasePrimitiveArrayCritical(rArray, r, JNI_ABORT);
+		env->ReleasePrimitiveArrayCritical(commitment, comm, JNI_ABORT);
+
+		return valid;
 }
 
+JNIEXPORT jlong JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_createKey
+  (JNIEnv *env, jobject, jbyteArray keyBytes){
+
+	  int size = env->GetArrayLength(keyBytes);
+	  jbyte *key = env->GetByteArrayElements(keyBytes, 0);
+
+	  //Returns 0 if the key size is not valid.
+	  AES_BATCH_KEY* batchKey = createAesBatchKey((unsigned char*)key, size * 8);
+
+	  env->ReleaseByteArrayElements(keyBytes, key, JNI_ABORT);
+	  return (jlong) batchKey;
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_deleteKey
+  (JNIEnv *, jobject, jlong key){
+
+	  deleteAesBatchKey((AES_BATCH_KEY*) key);
+}
+
+/*
+ * The array functions pin the java arrays instead of copying them. The input and the output can be the same array.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_encryptBlocks
+  (JNIEnv *env, jobject, jlong key, jbyteArray inArray, jint inOffset, jbyteArray outArray, jint outOffset, jint numBlocks){
+
+	  jbyte *in = (jbyte*) env->GetPrimitiveArrayCritical(inArray, 0);
+	  jbyte *out = (jbyte*) env->GetPrimitiveArrayCritical(outArray, 0);
+
+	  aesEncryptBlocks(&((AES_BATCH_KEY*) key)->encryptKey, (unsigned char*)in + inOffset, (unsigned char*)out + outOffset, numBlocks);
+
+	  env->ReleasePrimitiveArrayCritical(outArray, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inArray, in, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_decryptBlocks
+  (JNIEnv *env, jobject, jlong key, jbyteArray inArray, jint inOffset, jbyteArray outArray, jint outOffset, jint numBlocks){
+
+	  jbyte *in = (jbyte*) env->GetPrimitiveArrayCritical(inArray, 0);
+	  jbyte *out = (jbyte*) env->GetPrimitiveArrayCritical(outArray, 0);
+
+	  aesDecryptBlocks(&((AES_BATCH_KEY*) key)->decryptKey, (unsigned char*)in + inOffset, (unsigned char*)out + outOffset, numBlocks);
+
+	  env->ReleasePrimitiveArrayCritical(outArray, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inArray, in, JNI_ABORT);
+}
+
+/*
+ * The buffer functions work directly on the memory of direct ByteBuffers, so nothing is copied or pinned.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_encryptBuffer
+  (JNIEnv *env, jobject, jlong key, jobject inBuffer, jint inOffset, jobject outBuffer, jint outOffset, jint numBlocks){
+
+	  unsigned char* in = (unsigned char*) env->GetDirectBufferAddress(inBuffer);
+	  unsigned char* out = (unsigned char*) env->GetDirectBufferAddress(outBuffer);
+
+	  aesEncryptBlocks(&((AES_BATCH_KEY*) key)->encryptKey, in + inOffset, out + outOffset, numBlocks);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_decryptBuffer
+  (JNIEnv *env, jobject, jlong key, jobject inBuffer, jint inOffset, jobject outBuffer, jint outOffset, jint numBlocks){
+
+	  unsigned char* in = (unsigned char*) env->GetDirectBufferAddress(inBuffer);
+	  unsigned char* out = (unsigned char*) env->GetDirectBufferAddress(outBuffer);
+
+	  aesDecryptBlocks(&((AES_BATCH_KEY*) key)->decryptKey, in + inOffset, out + outOffset, numBlocks);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_counterBuffer
+  (JNIEnv *env, jobject, jlong key, jlong nonce, jlong counter, jobject outBuffer, jint outOffset, jint numBlocks){
+
+	  unsigned char* out = (unsigned char*) env->GetDirectBufferAddress(outBuffer);
+
+	  aesCounterBlocks(&((AES_BATCH_KEY*) key)->encryptKey, nonce, counter, out + outOffset, numBlocks);
+}
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_hashBuffer
+  (JNIEnv *env, jobject, jlong key, jobject inBuffer, jint inOffset, jobject outBuffer, jint outOffset, jint numBlocks, jlong tweak){
+
+	  unsigned char* in = (unsigned char*) env->GetDirectBufferAddress(inBuffer);
+	  unsigned char* out = (unsigned char*) env->GetDirectBufferAddress(outBuffer);
+
+	  aesFixedKeyHash(&((AES_BATCH_KEY*) key)->encryptKey, in + inOffset, out + outOffset, numBlocks, tweak);
+}
@@ -38,8 +38,38 @@ JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProt
 JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_xorKeys
   (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, int);
 
-JNIEXPORT bool JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
-	(JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray);
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_isCommitmentHashSupported
+	(JNIEnv *, jobject, jstring);
+
+JNIEXPORT jboolean JNICALL Java_edu_biu_protocols_yao_offlineOnline_specs_OnlineProtocolP2_verifyDecommitment
+	(JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jstring);
+
+/*
+ * Class:     edu_biu_protocols_yao_primitives_AesNiBatchPrf
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_createKey
+  (JNIEnv *, jobject, jbyteArray);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_deleteKey
+  (JNIEnv *, jobject, jlong);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_encryptBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_decryptBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_encryptBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_decryptBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_counterBuffer
+  (JNIEnv *, jobject, jlong, jlong, jlong, jobject, jint, jint);
+
+JNIEXPORT void JNICALL Java_edu_biu_protocols_yao_primitives_AesNiBatchPrf_hashBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint, jlong);
 
 #ifdef __cplusplus
 }
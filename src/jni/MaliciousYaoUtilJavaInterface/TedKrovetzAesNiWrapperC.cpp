@@ -24,7 +24,7 @@ void AES_128_Key_Expansion(const unsigned char *userkey, AES_KEY *aesKey)
 
 void AES_192_Key_Expansion(const unsigned char *userkey, AES_KEY *aesKey)
 {
-    __m128i x0,x1,x2,x3,tmp,*kp = (block *)&aesKey;
+    __m128i x0,x1,x2,x3,tmp,*kp = aesKey->rd_key;
     kp[0] = x0 = _mm_loadu_si128((block*)userkey);
     tmp = x3 = _mm_loadu_si128((block*)(userkey+16));
     x2 = _mm_setzero_si128();
@@ -69,6 +69,24 @@ void AES_set_encrypt_key(const unsigned char *userKey, const int bits, AES_KEY *
    
 }
 
+void AES_set_decrypt_key_fast(AES_KEY *dkey, const AES_KEY *ekey)
+{
+    int j = 0;
+    int i = ROUNDS(ekey);
+    dkey->rounds = i;
+    dkey->rd_key[i--] = ekey->rd_key[j++];
+    while (i)
+        dkey->rd_key[i--] = _mm_aesimc_si128(ekey->rd_key[j++]);
+    dkey->rd_key[i] = ekey->rd_key[j];
+}
+
+void AES_set_decrypt_key(const unsigned char *userKey, const int bits, AES_KEY *aesKey)
+{
+    AES_KEY temp_key;
+    AES_set_encrypt_key(userKey, bits, &temp_key);
+    AES_set_decrypt_key_fast(aesKey, &temp_key);
+}
+
 void AES_encryptC(block *in, block *out,  AES_KEY *aesKey)
 {
 	int j, rnds = ROUNDS(aesKey);
@@ -56,6 +56,8 @@ void AES_128_Key_Expansion(const unsigned char *userkey, AES_KEY* aesKey);
 void AES_192_Key_Expansion(const unsigned char *userkey, AES_KEY* aesKey);
 void AES_256_Key_Expansion(const unsigned char *userkey, AES_KEY* aesKey);
 void AES_set_encrypt_key(const unsigned char *userKey, const int bits, AES_KEY *aesKey);
+void AES_set_decrypt_key_fast(AES_KEY *dkey, const AES_KEY *ekey);
+void AES_set_decrypt_key(const unsigned char *userKey, const int bits, AES_KEY *aesKey);
 	
 void AES_encryptC(block *in, block *out, AES_KEY *aesKey);
 void AES_ecb_encrypt(block *blk, AES_KEY *aesKey);
@@ -1,4 +1,7 @@
 #include "Util.h"
+#include "CommitmentHash.h"
+#include <immintrin.h>
+#include <string.h>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -127,15 +130,84 @@ bool equalBlocks(block a, block b)
 
 
 
+/*
+ * The xor functions work in place on the given memory, which does not have to be aligned (it can be a pinned java array).
+ * On AVX2 hosts two keys are xored at a time.
+ */
+AVX2_TARGET static void xorKeysWithMaskAvx2(block* keys, block mask, int size){
+	__m256i wideMask = _mm256_broadcastsi128_si256(mask);
+	int i = 0;
+	for (; i + 2 <= size; i += 2) {
+		__m256i k = _mm256_loadu_si256((__m256i*)(keys + i));
+		_mm256_storeu_si256((__m256i*)(keys + i), _mm256_xor_si256(k, wideMask));
+	}
+	for (; i < size; i++) {
+		_mm_storeu_si128(keys + i, _mm_xor_si128(_mm_loadu_si128(keys + i), mask));
+	}
+}
+
+AVX2_TARGET static void xorKeysAvx2(block* keys1, block* keys2, block* output, int size){
+	int i = 0;
+	for (; i + 2 <= size; i += 2) {
+		__m256i k1 = _mm256_loadu_si256((__m256i*)(keys1 + i));
+		__m256i k2 = _mm256_loadu_si256((__m256i*)(keys2 + i));
+		_mm256_storeu_si256((__m256i*)(output + i), _mm256_xor_si256(k1, k2));
+	}
+	for (; i < size; i++) {
+		_mm_storeu_si128(output + i, _mm_xor_si128(_mm_loadu_si128(keys1 + i), _mm_loadu_si128(keys2 + i)));
+	}
+}
+
 void xorKeysWithMask(block* keys, block mask, int size){
-	
+	static const bool avx2 = hasAvx2();
+	if (avx2){
+		xorKeysWithMaskAvx2(keys, mask, size);
+		return;
+	}
+
 	for (int i = 0; i < size; i++) {
-		keys[i] =  _mm_xor_si128(keys[i], mask);
+		_mm_storeu_si128(keys + i, _mm_xor_si128(_mm_loadu_si128(keys + i), mask));
 	}	
 }
 
 void xorKeys(block* keys1, block* keys2, block* output, int size){
+	static const bool avx2 = hasAvx2();
+	if (avx2){
+		xorKeysAvx2(keys1, keys2, output, size);
+		return;
+	}
+
 	for (int i = 0; i < size; i++) {
-		output[i] =  _mm_xor_si128(keys1[i], keys2[i]);
+		_mm_storeu_si128(output + i, _mm_xor_si128(_mm_loadu_si128(keys1 + i), _mm_loadu_si128(keys2 + i)));
 	}
-}
\ No newline at end of file
+}
+
+/**
+* Checks that commitments[j] = H(r[j], x[j]) for each one of the size decommitments, where H is the given commitment hash.
+* Each r[j] is of the digest size and each x[j] is a key of SIZE_OF_BLOCK bytes. All the decommitments are hashed in one call,
+* so the hash can work on several of them at a time.
+* Bit j of validBitmap is set iff decommitment j is valid. The comparison does not stop at the first difference, 
+* so its running time does not depend on the content.
+* @return true if all the decommitments are valid.
+*/
+bool verifyDecommitments(const CommitmentHash& hash, const unsigned char* commitments, const unsigned char* r, const unsigned char* x, int size, unsigned char* validBitmap){
+	int hashSize = hash.getDigestSize();
+	unsigned char* digests = new unsigned char[size * hashSize];
+	hash.hashMany(r, hashSize, x, SIZE_OF_BLOCK, size, digests);
+
+	memset(validBitmap, 0, (size + 7) / 8);
+	unsigned char allDiff = 0;
+	for (int j = 0; j < size; j++){
+		unsigned char diff = 0;
+		for (int i = 0; i < hashSize; i++){
+			diff |= digests[j*hashSize + i] ^ commitments[j*hashSize + i];
+		}
+		allDiff |= diff;
+		//valid is 1 iff diff is 0.
+		unsigned char valid = (unsigned char)(1 & (((unsigned int)diff - 1) >> 8));
+		validBitmap[j / 8] |= valid << (j % 8);
+	}
+
+	delete [] digests;
+	return allDiff == 0;
+}
@@ -1,15 +1,21 @@
 #include <emmintrin.h>
 
+#include "../Common/CpuFeatures.h"
+
 
 typedef __m128i block;
 
+class CommitmentHash;
+
 #define SIZE_OF_BLOCK 16//size in bytes
 
 void restoreKeys(block* receivedKeys, char* matrix, int n, int m, block* restoredKeys);
 
 void xorKeysWithMask(block* keys, block mask, int size);
 
-void xorKeys(block* keys1, block* keys2, block* output);
+void xorKeys(block* keys1, block* keys2, block* output, int size);
+
+bool verifyDecommitments(const CommitmentHash& hash, const unsigned char* commitments, const unsigned char* r, const unsigned char* x, int size, unsigned char* validBitmap);
 
 void transformKeys(block* originalKeys, block* probeResistantKeys, block* newKeys, int n, int m, char* matrix);
 
@@ -57,118 +57,68 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_creat
 	  return (long)aesPointer;
 }
 
-/* function computeBlock : This function computes the aes permutation
- * param aesPointer		 : pointer to the aes struct
- * param inBytes		 : byte array to compute the aes permutation on.
- * param inOff			 : offset in the input byte array indicates the start point to begin the aes computation.
- * param outBytes		 : output bytes. The resulted bytes of compute.
- * param outOff			 : offset in the outBytes array to put the result from.
+/* function processBlocks	: This function computes or inverts the AES permutation on numBlocks consecutive blocks.
+ * param aesPointer			: pointer to the aes struct
+ * param in					: the input blocks.
+ * param out				: the output blocks. Can be equal to in.
+ * param numBlocks			: number of blocks to process.
+ * param forEncrypt			: true to compute the permutation, false to invert it.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeBlock
-  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray inBytes, jint inOff, jbyteArray outBytes, jint outOff){
-	
-	  jbyte *in =  env->GetByteArrayElements(inBytes, 0);
-	  jbyte *out = env->GetByteArrayElements(outBytes, 0);
+static void processBlocks(aes* aesPointer, const char* in, char* out, int numBlocks, bool forEncrypt){
 	  
-	  //aes_encrypt function gets an input array to compute and put the result in the same array.
-	  //In order not to change the input array we copy the it to the output array. 
-	  //This way the compute output will be in the output array, as we want.
-	  memcpy(out+outOff, in+inOff, 16);
+	  //aes_encrypt and aes_decrypt get a block and put the result in the same block.
+	  //In order not to change the input we move it to the output, and then process the output in place.
+	  //This way no temporary memory is needed.
+	  memmove(out, in, numBlocks*16);
 	  
-	  //Compute the data given in the input byte array. 
-	  //The computed data will be in the output array after the computation.
-	  aes_encrypt((aes*)aesPointer, ((char*)out)+outOff);
-	 
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes, in, 0);
-	  env->ReleaseByteArrayElements(outBytes, out, 0);
+	  for (int i=0; i<numBlocks; i++){
+		  if (forEncrypt){
+			  aes_encrypt(aesPointer, out + i*16);
+		  } else {
+			  aes_decrypt(aesPointer, out + i*16);
+		  }
+	  }
 }
 
-/* function invertBlock  : This function computes the aes permutation
- * param aesPointer		 : pointer to the aes struct
- * param inBytes		 : byte array to invert the aes permutation on.
- * param inOff			 : offset in the input byte array indicates the start point to begin the aes invert.
- * param outBytes		 : output bytes. The resulted bytes of invert.
- * param outOff			 : offset in the outBytes array to put the result from.
+/* function processBlocks	: This function computes or inverts the AES permutation on consecutive blocks of java arrays.
+ * param aesPointer			: pointer to the aes struct
+ * param inBytes			: byte array to compute the aes permutation on.
+ * param inOff				: offset of the first block in the input array.
+ * param outBytes			: output bytes. The resulted bytes of the computation.
+ * param outOff				: offset in the outBytes array to put the result from.
+ * param numBlocks			: number of blocks to process.
+ * param forEncrypt			: true to compute the permutation, false to invert it.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_invertBlock
-  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray inBytes, jint inOff, jbyteArray outBytes, jint outOff){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_processBlocks
+  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray inBytes, jint inOff, jbyteArray outBytes, jint outOff, jint numBlocks, jboolean forEncrypt){
 	  
-	  jbyte *in =  env->GetByteArrayElements(inBytes, 0);
-	  jbyte *out = env->GetByteArrayElements(outBytes, 0);
-
-	  //aes_decrypt function gets an input array to invert and put the result in the same array.
-	  //In order not to change the input array we copy the it to the output array. 
-	  //This way the invert output will be in the output array, as we want.
-	  memcpy(out+outOff, in+inOff, 16);
-
-	  //Invert the data given in the input byte array. 
-	  //The inverted data will be in the output array after the invertion.
-	  aes_decrypt((aes*)aesPointer, ((char*)out)+outOff);
-
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes, in, 0);
-	  env->ReleaseByteArrayElements(outBytes, out, 0);
-}
-
-/* function optimizedCompute	: This function computes the AES permutation on a big byte array, by computing each block separately.
- * param aesPointer				: pointer to the aes struct
- * param inBytes				: byte array to compute the aes permutation on.
- * param outBytes				: output bytes. The resulted bytes of compute.
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_optimizedCompute
-  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray inBytes, jbyteArray outBytes){
+	  //Pin the arrays instead of copying them. The output is written in place.
+	  jbyte *in = (jbyte*) env->GetPrimitiveArrayCritical(inBytes, 0);
+	  jbyte *out = (jbyte*) env->GetPrimitiveArrayCritical(outBytes, 0);
 	  
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
+	  processBlocks((aes*)aesPointer, (char*)in + inOff, (char*)out + outOff, numBlocks, forEncrypt != 0);
 	  
-	  int blockSize = 16; //In AES permutation in a CBC mode the block size is fixed, 16 bytes. 
-
-	  int rounds = (env->GetArrayLength(inBytes))/blockSize; //Calculate the number of blocks to compute
-
-	  //Prepare array to use in the AES permutation.
-	  char* inBlock = new char[blockSize];
-
-	  //For each block, compute the AES permutation and put the result in the output aray
-	  for (int i=0; i<rounds; i++){
-		  memcpy(inBlock, in+(i*blockSize), blockSize);
-		  
-		  aes_encrypt((aes*)aesPointer, inBlock);
-		  
-		  env->SetByteArrayRegion(outBytes, i*blockSize, blockSize, (jbyte*)inBlock);
-	  }
-	  delete(inBlock);
-	  //make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
+	  env->ReleasePrimitiveArrayCritical(outBytes, out, 0);
+	  env->ReleasePrimitiveArrayCritical(inBytes, in, JNI_ABORT);
 }
 
-/* function optimizedInvert	: This function inverts the AES permutation on a big byte array, by inverting each block separately.
+/* function processBuffer	: This function computes or inverts the AES permutation on consecutive blocks of direct buffers. 
+ *							  Nothing is copied or pinned.
  * param aesPointer			: pointer to the aes struct
- * param inBytes			: byte array to invert the aes permutation on.
- * param outBytes			: output bytes. The resulted bytes of invert.
+ * param inBuffer			: direct buffer to compute the aes permutation on.
+ * param inOff				: offset of the first block in the input buffer.
+ * param outBuffer			: output direct buffer. Can be inBuffer itself.
+ * param outOff				: offset in the output buffer to put the result from.
+ * param numBlocks			: number of blocks to process.
+ * param forEncrypt			: true to compute the permutation, false to invert it.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_optimizedInvert
-  (JNIEnv *env, jobject, jlong aesPointer, jbyteArray inBytes, jbyteArray outBytes){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_processBuffer
+  (JNIEnv *env, jobject, jlong aesPointer, jobject inBuffer, jint inOff, jobject outBuffer, jint outOff, jint numBlocks, jboolean forEncrypt){
 	  
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
+	  char *in = (char*) env->GetDirectBufferAddress(inBuffer);
+	  char *out = (char*) env->GetDirectBufferAddress(outBuffer);
 	  
-	  int blockSize = 16; //In AES permutation in a CBC mode the block size is fixed, 16 bytes. 
-
-	  int rounds = (env->GetArrayLength(inBytes))/blockSize; //Calculate the number of blocks to invert
-
-	  //Prepare array to use in the AES permutation.
-	  char* inBlock = new char[blockSize];
-
-	  //For each block, invert the AES permutation and put the result in the output aray
-	  for (int i=0; i<rounds; i++){
-		  memcpy(inBlock, in+(i*blockSize), blockSize);
-		  
-		  aes_decrypt((aes*)aesPointer, inBlock);
-		  
-		  env->SetByteArrayRegion(outBytes, i*blockSize, blockSize, (jbyte*)inBlock);
-	  }
-	  delete(inBlock);
-	  //make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
+	  processBlocks((aes*)aesPointer, in + inOff, out + outOff, numBlocks, forEncrypt != 0);
 }
 
 /* function deleteAES	: This function deletes the allocated memory for the AES permutation.
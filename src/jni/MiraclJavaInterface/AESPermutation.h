@@ -17,35 +17,19 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_creat
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
- * Method:    computeBlock
- * Signature: (J[BI[BI)V
+ * Method:    processBlocks
+ * Signature: (J[BI[BIIZ)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_computeBlock
-  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_processBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint, jboolean);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
- * Method:    invertBlock
- * Signature: (J[BI[BI)V
+ * Method:    processBuffer
+ * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/ByteBuffer;IIZ)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_invertBlock
-  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint);
-
-/*
- * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
- * Method:    optimizedCompute
- * Signature: (J[B[B)V
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_optimizedCompute
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
-
-/*
- * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
- * Method:    optimizedInvert
- * Signature: (J[B[B)V
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_optimizedInvert
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_miracl_MiraclAES_processBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint, jboolean);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_miracl_MiraclAES
@@ -26,6 +26,7 @@
 #include "stdafx.h"
 #include "EvaluationHashFunction.h"
 #include "SigmaProtocolOR.h"
+#include "SubproductTree.h"
 #include "NTL/GF2X.h"
 #include "NTL/GF2E.h"
 #include "NTL/GF2XFactoring.h"
@@ -33,6 +34,15 @@
 #include "NTL/GF2EX.h"
 #include "NTL/ZZ.h"
 
+/*
+ * Holds all the native memory of one proof: the sampled field elements and the interpolated polynomial.
+ * Java keeps a single pointer to it and frees everything with one call to deletePointers.
+ */
+struct ProofArena {
+	vec_GF2E elements;
+	GF2EX polynomial;
+};
+
 /* function initField : Initialize the field GF2E with irreducible polynomial.
 	This function is used by the prover.
  * param t			  : degree of the irreducible polynomial
@@ -62,59 +72,76 @@ void initField(jint t, jint randomNum){
 }
 
 /* function createRandomFieldElements : Samples random field elements in the GF2E field, 
-										return their coefficients in the return value and set their pointers to the pointerToElements argument.
+										write their coefficients to the elementsBytes argument and keep them in a new native arena.
  * param numElements				  : number of elements to sample
- * param pointerToElements		      : an array to fill with the sampled elements' pointers.
- * return jobjectArray				  : array of element's coefficients
+ * param elementsBytes			      : an array of numElements*t/8 bytes to fill with the sampled elements.
+ * return jlong						  : pointer to the arena that holds the sampled elements.
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_createRandomFieldElements
-  (JNIEnv * env, jobject, jint numElements, jlongArray pointerToElements){
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_createRandomFieldElements
+  (JNIEnv * env, jobject, jint numElements, jbyteArray elementsBytes){
 	 
 	  //call the function that samples the elements.
-	  return sampleRandomFieldElements(env, numElements, pointerToElements);
+	  return sampleRandomFieldElements(env, numElements, elementsBytes);
 }
 
 /* function sampleRandomFieldElements : Samples random field elements in the GF2E field, 
-										return their coefficients in the return value and set their pointers to the pointerToElements argument.
+										write their coefficients to the elementsBytes argument and keep them in a new native arena.
  * param numElements				  : number of elements to sample
- * param pointerToElements		      : an array to fill with the sampled elements' pointers.
- * return jobjectArray				  : array of element's coefficients
+ * param elementsBytes			      : an array of numElements*t/8 bytes to fill with the sampled elements.
+ * return jlong						  : pointer to the arena that holds the sampled elements.
  */
-jobjectArray sampleRandomFieldElements(JNIEnv * env, jint numElements, jlongArray pointerToElements){
+jlong sampleRandomFieldElements(JNIEnv * env, jint numElements, jbyteArray elementsBytes){
 	
-	  jclass byteArrCls = env->FindClass("[B") ; //Define byte class
-	  //create object array that will hold the challenges.
-	  jobjectArray outChallenges = env->NewObjectArray(numElements, byteArrCls, NULL); 
-	  
-	  jlong* pointers = env->GetLongArrayElements(pointerToElements, 0);
-	  
-	  //Samples random elements, puts their bytes in the output array and put their addresses in the pointers array.
-	  for (int i=0; i<numElements; i++){
-		  //sample random field element.
-		  GF2E* element = new GF2E;
-		  *element = random_GF2E();
-
-		  //Get the bytes of the random element.
-		  jbyteArray elArr = env->NewByteArray(NumBytes(rep(*element)));
-		  jbyte* el = env->GetByteArrayElements(elArr, 0);
-		  convertGF2EToBytes(*element, el);
-		  
-		  //put the bytes of the random element in the output array.
-		  env->SetObjectArrayElement(outChallenges, i, elArr);
-		 
-		  env->ReleaseByteArrayElements(elArr, el, 0);
-		  //put the element address in the pointers array
-		  pointers[i] = (jlong)element;
+	  //All the native memory of the proof is allocated once, in the arena.
+	  ProofArena* arena = new ProofArena;
+	  arena->elements.SetLength(numElements);
 
+	  //Samples random elements.
+	  for (int i=0; i<numElements; i++){
+		  arena->elements[i] = random_GF2E();
 	  }
 
-	  //release the allocated memory
-	  env->ReleaseLongArrayElements(pointerToElements, pointers, 0);
+	  //put the bytes of all the elements in the output array.
+	  jbyte* bytes = (jbyte*) env->GetPrimitiveArrayCritical(elementsBytes, 0);
+	  convertGF2EVectorToBytes(arena->elements, bytes, getElementSize());
+	  env->ReleasePrimitiveArrayCritical(elementsBytes, bytes, 0);
 	  
-	  return outChallenges;
+	  return (jlong)arena;
 }
 
+/* function getElementSize : Returns the number of bytes of a field element, t/8.
+ */
+int getElementSize(){
+	return GF2E::degree() / 8;
+}
 
+/* function convertGF2EVectorToBytes : Writes the bytes of the elements one after the other, each of them in exactly elementSize bytes.
+ * param elements					 : elements to convert to bytes
+ * param bytes						 : array of elements.length()*elementSize bytes that will contain the bytes
+ * param elementSize				 : number of bytes of each element
+ */
+void convertGF2EVectorToBytes(const vec_GF2E& elements, jbyte* bytes, int elementSize){
+	int size = elements.length();
+	for (int i=0; i<size; i++){
+		//BytesFromGF2X pads the element with zeros up to elementSize bytes.
+		BytesFromGF2X((unsigned char *)bytes + i*elementSize, rep(elements[i]), elementSize);
+	}
+}
+
+/* function convertBytesToGF2EVector : Creates elements out of consecutive elementSize byte blocks.
+ * param elements					 : vector to fill with the elements
+ * param bytes						 : the bytes of the elements
+ * param numElements				 : number of elements in the bytes
+ * param elementSize				 : number of bytes of each element
+ */
+void convertBytesToGF2EVector(vec_GF2E& elements, const jbyte* bytes, int numElements, int elementSize){
+	elements.SetLength(numElements);
+	GF2X e;
+	for (int i=0; i<numElements; i++){
+		GF2XFromBytes(e, (const unsigned char *)bytes + i*elementSize, elementSize);
+		conv(elements[i], e);
+	}
+}
 
 /* function convertGF2EToBytes : Get the bytes of the random element.
  * param element			   : element to convert to bytes
@@ -149,69 +176,43 @@ GF2E convertBytesToGF2E(JNIEnv * env, jbyteArray byteArr){
 
 
 /* function interpolate		: Interpolate the points to get a polynomial.
- * param t				    : polynomials degree
+ * param arena				: pointer to the arena that holds the pre calculated GF2E elements. The interpolated polynomial is put there.
  * param challenge		    : verifier's challenge
- * param fieldElements		: pointers to the pre calculated GF2E polynomials.
- * param sampledIndexes		: indexes of the pre calculated GF2E polynomials, such that the points are (sampledIndexes[i], fieldElements[i]).
- * return jlong				: pointer to the interpolated polynomial.
+ * param sampledIndexes		: indexes of the pre calculated GF2E elements, such that the points are (sampledIndexes[i], elements[i]).
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_interpolate
-  (JNIEnv * env, jobject, jbyteArray challenge, jlongArray fieldElements, jintArray sampledIndexes){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_interpolate
+  (JNIEnv * env, jobject, jlong arena, jbyteArray challenge, jintArray sampledIndexes){
 	  
 	  //Call the function that does the interpolate.
-	  return interpolate(env, challenge, fieldElements, sampledIndexes);
+	  interpolate(env, arena, challenge, sampledIndexes);
 	
 }
 
 /* function interpolate		: Interpolate the points to get a polynomial.
- * param t				    : polynomials degree
+ * param arena				: pointer to the arena that holds the pre calculated GF2E elements. The interpolated polynomial is put there.
  * param challenge		    : verifier's challenge
- * param fieldElements		: pointers to the pre calculated GF2E polynomials.
- * param sampledIndexes		: indexes of the pre calculated GF2E polynomials, such that the points are (sampledIndexes[i], fieldElements[i]).
- * return jlong				: pointer to the interpolated polynomial.
+ * param sampledIndexes		: indexes of the pre calculated GF2E elements, such that the points are (sampledIndexes[i], elements[i]).
  */
-jlong interpolate(JNIEnv * env, jbyteArray challenge, jlongArray fieldElements, jintArray sampledIndexes){
-	  //convert to native objects
-	  jint* indexes = env->GetIntArrayElements(sampledIndexes, 0);
-	
-	  //Create vectors of polynomials to the interpolate function.
-	  vec_GF2E xVector; //the x coordinates
-	  vec_GF2E yVector; //the y coordinates
+void interpolate(JNIEnv * env, jlong arena, jbyteArray challenge, jintArray sampledIndexes){
+	  ProofArena* proof = (ProofArena*) arena;
 
 	  int size = env->GetArrayLength(sampledIndexes);
-	 
-	  //set the length of the arrays to the number of points + the point (0,e)
-	  xVector.SetLength(size+1);
-	  yVector.SetLength(size+1);
 
-	  //put the first point in the coordinates arrays.
+	  //The x coordinates are the point 0 followed by the sampled indexes.
+	  vector<int> xIndexes(size+1);
+	  xIndexes[0] = 0;
+	  env->GetIntArrayRegion(sampledIndexes, 0, size, (jint*) &xIndexes[1]);
+
+	  //Create vector of the y coordinates: the challenge followed by the pre calculated elements.
+	  vec_GF2E yVector;
+	  yVector.SetLength(size+1);
 	  yVector[0] = convertBytesToGF2E(env, challenge);
-	  xVector[0] = to_GF2E(0);
-	  
-	  jlong* bElements  = env->GetLongArrayElements(fieldElements, 0); 
-	  
-	  //put all the other point in the coordinates arrays.
 	  for (int i=0; i<size; i++){
-		 
-		 //put the challenge polynomial in y array
-		 GF2E element = (*(GF2E*)bElements[i]); 
-		 yVector[i+1] = element; 
-		 
-		 //put the index polynomial in x array
-		 xVector[i+1] = generateIndexPolynomial(indexes[i]);
+		 yVector[i+1] = proof->elements[i];
 	  }
-
-	  
-	  //create a GF2EX polynomial 
-	  GF2EX* polynomial = new GF2EX;
-	  
-	  //interpolate the points, put the result polynomial in the created polynomial and return it.
-	  interpolate(*polynomial, xVector, yVector);
 	  
-	  //free the allocated memory
-	  env->ReleaseIntArrayElements(sampledIndexes, indexes, 0);
-	  env->ReleaseLongArrayElements(fieldElements, bElements, 0);
-	  return (jlong)polynomial;
+	  //interpolate the points using the subproduct tree of the x coordinates, put the result polynomial in the arena.
+	  getIndexTree(xIndexes)->interpolate(proof->polynomial, yVector);
 }
 
 
@@ -230,126 +231,76 @@ GF2E generateIndexPolynomial(int i){
 	return to_GF2E(indexPoly);
 }
 
-/* function getRestChallenges		: Interpolate the points to get a polynomial.
- * param polynomial				    : pointer to the interpolated polynomial
+/* function getRestChallenges		: Calculates the challenges of the statements with the witnesses.
+ * param arena						: pointer to the arena that holds the interpolated polynomial
  * param indexesInI					: x coordinates to calculate their y coordinats (the challenges).
- * return jobjectArray				: array of element's coefficients
+ * param challengesBytes			: array of indexesInI.length*t/8 bytes to fill with the challenges.
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getRestChallenges
-  (JNIEnv *env, jobject, jlong polynomial, jintArray indexesInI){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getRestChallenges
+  (JNIEnv *env, jobject, jlong arena, jintArray indexesInI, jbyteArray challengesBytes){
 	   
 	  //call the function that calculate the rest of the challenges.
-	  return calcRestChallenges(env, polynomial, indexesInI);
+	  calcRestChallenges(env, arena, indexesInI, challengesBytes);
 }
 
-jobjectArray calcRestChallenges(JNIEnv *env, jlong polynomial, jintArray indexesInI){
+void calcRestChallenges(JNIEnv *env, jlong arena, jintArray indexesInI, jbyteArray challengesBytes){
 	
-	//convert to native objects
-	  GF2EX* polynom = (GF2EX*) polynomial;
-	  jint* indexes = env->GetIntArrayElements(indexesInI, 0);
+	  ProofArena* proof = (ProofArena*) arena;
 
 	  int size = env->GetArrayLength(indexesInI);
-	  jclass byteArrCls = env->FindClass("[B") ; //Define byte class
-	  //create object array that will hold the challenges.
-	  jobjectArray outChallenges = env->NewObjectArray(size, byteArrCls, NULL); 
+	  vector<int> indexes(size);
+	  env->GetIntArrayRegion(indexesInI, 0, size, (jint*) indexes.data());
 
-	  //calculate the y coordinate (the challenge) to each one of the indexes (the indexes).
-	  for (int i=0; i<size; i++){
-
-		 //get the index polynomial
-		 GF2E element = generateIndexPolynomial(indexes[i]);
-		 
-		 //Evaluate the poltyomial on the index to get the challenge element.
-		 GF2E result = eval(*polynom, element);
-
-		 //Get the bytes of the challenge element.
-		 jbyteArray elArr = env->NewByteArray(NumBytes(rep(result)));
-		 jbyte* el = env->GetByteArrayElements(elArr, 0);
-		 convertGF2EToBytes(result, el);
-		  
-		 //put the bytes of the challenge element in the output array.
-		 env->SetObjectArrayElement(outChallenges, i, elArr);
-		 env->ReleaseByteArrayElements(elArr, el, 0);
-	  }
+	  //calculate the y coordinate (the challenge) to each one of the indexes in one multipoint evaluation.
+	  vec_GF2E results;
+	  getIndexTree(indexes)->evaluate(results, proof->polynomial);
 
-	  bool valid = true;
-	  for (int i=0; i<size; i++){
-		  jbyteArray elArr = (jbyteArray)env->GetObjectArrayElement(outChallenges, i);
-		  GF2E element = convertBytesToGF2E(env, elArr); 
-		  //create the index element
-		  GF2E indexElement = generateIndexPolynomial(indexes[i]);
-		 
-		  //compute Q(i)
-		  GF2E result = eval(*polynom, indexElement);
-		  //check that Q(i)=ei
-		  if (result != element){
-				valid = false;
-		  }
-	  }
-	  return outChallenges;
+	  //put the bytes of all the challenges in the output array.
+	  jbyte* bytes = (jbyte*) env->GetPrimitiveArrayCritical(challengesBytes, 0);
+	  convertGF2EVectorToBytes(results, bytes, getElementSize());
+	  env->ReleasePrimitiveArrayCritical(challengesBytes, bytes, 0);
 }
 
 /* function getPolynomialBytes		: Return the bytes of the polynomial's coefficients.
- * param poly						: pointer to the interpolated polynomial
- * return jobjectArray				: array of polynomial's coefficients.
+ * param arena						: pointer to the arena that holds the interpolated polynomial
+ * return jbyteArray				: the polynomial's coefficients, t/8 bytes each.
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getPolynomialBytes
-  (JNIEnv *env, jobject, jlong poly){
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getPolynomialBytes
+  (JNIEnv *env, jobject, jlong arena){
 	  
 	  //call the function that calculate the polynomial bytes.
-	  return calcPolynomialBytes(env, poly);
+	  return calcPolynomialBytes(env, arena);
 }
 
-jobjectArray calcPolynomialBytes(JNIEnv *env, jlong poly){
-	GF2EX* polynom = (GF2EX*) poly;
-	  long degree = deg(*polynom);
-
-	  jclass byteArrCls = env->FindClass("[B") ; //Define byte class
-	  //create object array that will hold the challenges.
-	  jobjectArray polynomBytes = env->NewObjectArray(degree+1, byteArrCls, NULL); 
-
-	  //convert each coefficient polynomial to byte array and put it in the output array.
-	  for (int i=0; i<=degree; i++){
-		  //get the coefficient polynomial
-		  GF2E coefficient = coeff(*polynom, i);
-			
-		  //get the bytes of the coefficient.
-		  jbyteArray elArr = env->NewByteArray(NumBytes(rep(coefficient)));
-		  jbyte* el = env->GetByteArrayElements(elArr, 0);
-		  convertGF2EToBytes(coefficient, el);
-		    
-		  //put the bytes of the coefficient element in the output array.
-		  env->SetObjectArrayElement(polynomBytes, i, elArr);
-		  env->ReleaseByteArrayElements(elArr, el, 0);
-	  }
+jbyteArray calcPolynomialBytes(JNIEnv *env, jlong arena){
+	  ProofArena* proof = (ProofArena*) arena;
+	  int elementSize = getElementSize();
+
+	  //create byte array that will hold all the coefficients.
+	  int numCoefficients = deg(proof->polynomial) + 1;
+	  jbyteArray polynomBytes = env->NewByteArray(numCoefficients * elementSize);
+
+	  //convert the coefficients to bytes and put them in the output array.
+	  jbyte* bytes = (jbyte*) env->GetPrimitiveArrayCritical(polynomBytes, 0);
+	  convertGF2EVectorToBytes(proof->polynomial.rep, bytes, elementSize);
+	  env->ReleasePrimitiveArrayCritical(polynomBytes, bytes, 0);
 
 	  return polynomBytes;
 }
 
-/* function deletePointers		: Delete the allocated memory of the polynomial and the field elements.
- * param polynomial				: pointer to the polynomial
- * param fieldElements			: array of pointers to field elements.
+/* function deletePointers		: Delete the allocated memory of the proof - the polynomial and the field elements.
+ * param arena					: pointer to the arena of the proof
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_deletePointers
-  (JNIEnv * env, jobject, jlong polynomial, jlongArray fieldElements){
+  (JNIEnv * env, jobject, jlong arena){
 	  
 	  //call the function that deletes the allocated memory.
-	  deleteMemory(env, polynomial, fieldElements);
+	  deleteMemory(arena);
 }
 
-void deleteMemory(JNIEnv *env, jlong polynomial, jlongArray fieldElements){
-	 
-	  int size = env->GetArrayLength(fieldElements);
-	  
-	  jlong* elements  = env->GetLongArrayElements(fieldElements, 0); 
-	  
-	  //delete all field elements.
-	  for (int i=0; i<size; i++){
-		 delete ((GF2E*)elements[i]); 
-	  }
-
-	  //delete the allocated memory for the polynomial.
-	  delete((GF2EX*)polynomial);
+void deleteMemory(jlong arena){
+	  //The arena owns all the memory of the proof.
+	  delete((ProofArena*)arena);
 }
 
 /* function initField : Initialize the field GF2E with irreducible polynomial.
@@ -404,76 +355,71 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_
 }
 
 /* function checkPolynomialValidity : Check if the degree pf the polynom is n-k, if Q(i)=ei for all i=1,,n and if Q(0)=e.
- * param polynomial					: array of the polynom coefficients
+ * param polynomial					: the polynom coefficients, t/8 bytes each
  * param k							: number of true statments. the degree of the polynom should be n-k
  * param verifierChallenge			: pointer to the verifier element
- * param proverChallenges			: array that holds the coeficients of elements in the field
- * param t							: degree of the challenges polynomials.
+ * param proverChallenges			: the challenges of the statements, t/8 bytes each
  * return jboolean					: true if all checks return true.
  */
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleVerifierComputation_checkPolynomialValidity
-  (JNIEnv *env, jobject, jobjectArray polynomial, jint k, jlong verifierChallenge, jobjectArray proverChallenges){
+  (JNIEnv *env, jobject, jbyteArray polynomial, jint k, jlong verifierChallenge, jbyteArray proverChallenges){
 	  
 	  bool valid = true;
-	  GF2EX* polynom = new GF2EX;
+	  int elementSize = getElementSize();
+
 	  //Create the polynomial out of the coefficeints array.
-	  *polynom = createPolynomial(env, polynomial);
+	  GF2EX polynom;
+	  createPolynomial(env, polynomial, polynom);
 	  
+	  //Create the challenges out of the challenges array.
+	  int size = env->GetArrayLength(proverChallenges) / elementSize;
+	  vec_GF2E challenges;
+	  jbyte* bytes = (jbyte*) env->GetPrimitiveArrayCritical(proverChallenges, 0);
+	  convertBytesToGF2EVector(challenges, bytes, size, elementSize);
+	  env->ReleasePrimitiveArrayCritical(proverChallenges, bytes, JNI_ABORT);
+
 	  //check if the degree of the polynomial os n-k, while n is the number of challenges.
-	  int size = env -> GetArrayLength(proverChallenges);
-	  if (deg(*polynom) != (size - k)){
+	  if (deg(polynom) != (size - k)){
 		  valid = false;
 	  }
 	  
-	  //check if Q(0)=e.
-	  GF2E zero = to_GF2E(0);
-	  GF2E e = eval(*polynom, zero); //Q(0)
+	  //check if Q(0)=e. Q(0) is the free coefficient of the polynomial.
+	  GF2E e = coeff(polynom, 0); //Q(0)
 	  GF2E* challengePointer = (GF2E*) verifierChallenge;
 	  if (e != *challengePointer){
 		  valid = false;
 	  }
 	  
+	  //compute Q(1),...,Q(n) in one multipoint evaluation on the cached tree of the indexes.
+	  vec_GF2E results;
+	  getIndexTree(size)->evaluate(results, polynom);
+
 	  //for each one of the challenges, check that Q(i)=ei
 	  for (int i = 0; i<size; i++){
-		  //create the challenge element out of the byte array.
-		  jbyteArray challenge = (jbyteArray) env -> GetObjectArrayElement(proverChallenges, i);
-	      GF2E challengeElement = convertBytesToGF2E(env, challenge);
-
-		  //create the index element
-		  GF2E indexElement = generateIndexPolynomial(i+1);
-		 
-		  //compute Q(i)
-		  GF2E result = eval(*polynom, indexElement);
-		  //check that Q(i)=ei
-		  if (result != challengeElement){
+		  if (results[i] != challenges[i]){
 				valid = false;
 		  }
 	  }
 
 	  delete(challengePointer);
-	  delete(polynom);
 	  return valid;
 }
 
 /* function createPolynomial : create the polynomial out of the given coefficients array
- * param polynomialBytes	 : byte array of the polynom coefficients
- * param t					 : degree of the challenges polynomials.
- * return GF2EX				 : the created polinomial.
+ * param polynomialBytes	 : the polynom coefficients, t/8 bytes each
+ * param polynom			 : the created polinomial.
  */
-GF2EX createPolynomial(JNIEnv *env, jobjectArray polynomialBytes){
-	int deg = env->GetArrayLength(polynomialBytes);
-	GF2EX polynom;
-
-	//set each coefficient to the polynomial.
-	for (int i=0; i<deg; i++){
-		//create the polynomial of the coefficient
-		jbyteArray coeff = (jbyteArray) env -> GetObjectArrayElement(polynomialBytes, i);
-		
-	    //Set the coeeficient to the GF2EX polynomial
-	    GF2E coeffElement = convertBytesToGF2E(env, coeff);
-		SetCoeff(polynom, i, coeffElement);
-	}
-	return polynom;
+void createPolynomial(JNIEnv *env, jbyteArray polynomialBytes, GF2EX& polynom){
+	int elementSize = getElementSize();
+	int numCoefficients = env->GetArrayLength(polynomialBytes) / elementSize;
+
+	//set all the coefficients to the polynomial.
+	jbyte* bytes = (jbyte*) env->GetPrimitiveArrayCritical(polynomialBytes, 0);
+	convertBytesToGF2EVector(polynom.rep, bytes, numCoefficients, elementSize);
+	env->ReleasePrimitiveArrayCritical(polynomialBytes, bytes, JNI_ABORT);
+
+	//remove the leading zero coefficients, like SetCoeff does.
+	polynom.normalize();
 }
 
 /* function initField : Initialize the field GF2E with irreducible polynomial.
@@ -490,37 +436,37 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_
 }
 
 
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_createRandomFieldElements
-  (JNIEnv *env, jobject, jint numElements, jlongArray pointerToElements){
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_createRandomFieldElements
+  (JNIEnv *env, jobject, jint numElements, jbyteArray elementsBytes){
 	  
 	  //Call the function that samples the elements.
-	  return sampleRandomFieldElements(env, numElements, pointerToElements);
+	  return sampleRandomFieldElements(env, numElements, elementsBytes);
 }
 
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_interpolate
-  (JNIEnv *env, jobject, jbyteArray challenge, jlongArray fieldElements, jintArray indexes){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_interpolate
+  (JNIEnv *env, jobject, jlong arena, jbyteArray challenge, jintArray indexes){
 
 	  //Call the function that does the interpolate.
-	  return interpolate(env, challenge, fieldElements, indexes);
+	  interpolate(env, arena, challenge, indexes);
 }
 
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getRestChallenges
-  (JNIEnv *env, jobject, jlong polynomial, jint start, jint end, jintArray indexes){
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getRestChallenges
+  (JNIEnv *env, jobject, jlong arena, jintArray indexes, jbyteArray challengesBytes){
 
 	  //call the function that calculate the rest of the challenges.
-	  return calcRestChallenges(env, polynomial, indexes);
+	  calcRestChallenges(env, arena, indexes, challengesBytes);
 }
 
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getPolynomialBytes
-  (JNIEnv *env, jobject, jlong poly){
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getPolynomialBytes
+  (JNIEnv *env, jobject, jlong arena){
 
 	  //call the function that calculate the polynomial bytes.
-	  return calcPolynomialBytes(env, poly);
+	  return calcPolynomialBytes(env, arena);
 }
 
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_deletePointers
-  (JNIEnv *env, jobject, jlong polynomial, jlongArray fieldElements){
+  (JNIEnv *env, jobject, jlong arena){
 
 	  //call the function that deletes the allocated memory.
-	  deleteMemory(env, polynomial, fieldElements);
-}
\ No newline at end of file
+	  deleteMemory(arena);
+}
@@ -18,42 +18,42 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleProver
  * Method:    createRandomFieldElements
- * Signature: (I[J)[[B
+ * Signature: (I[B)J
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_createRandomFieldElements
-  (JNIEnv *, jobject, jint, jlongArray);
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_createRandomFieldElements
+  (JNIEnv *, jobject, jint, jbyteArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleProver
  * Method:    interpolate
- * Signature: (I[B[J[I)J
+ * Signature: (J[B[I)V
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_interpolate
-  (JNIEnv *, jobject, jbyteArray, jlongArray, jintArray);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_interpolate
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleProver
  * Method:    getRestChallenges
- * Signature: (J[II)[[B
+ * Signature: (J[I[B)V
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getRestChallenges
-  (JNIEnv *, jobject, jlong, jintArray);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getRestChallenges
+  (JNIEnv *, jobject, jlong, jintArray, jbyteArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleProver
  * Method:    getPolynomialBytes
- * Signature: (J)[[B
+ * Signature: (J)[B
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getPolynomialBytes
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_getPolynomialBytes
   (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleProver
  * Method:    deletePointers
- * Signature: (J[J)V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleProverComputation_deletePointers
-  (JNIEnv *, jobject, jlong, jlongArray);
+  (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleVerifier
@@ -83,10 +83,10 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleVerifier
  * Method:    checkPolynomialValidity
- * Signature: ([[BIJ[[BI)Z
+ * Signature: ([BIJ[B)Z
  */
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleVerifierComputation_checkPolynomialValidity
-  (JNIEnv *, jobject, jobjectArray, jint, jlong, jobjectArray);
+  (JNIEnv *, jobject, jbyteArray, jint, jlong, jbyteArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
@@ -99,51 +99,54 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
  * Method:    createRandomFieldElements
- * Signature: (I[J)[[B
+ * Signature: (I[B)J
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_createRandomFieldElements
-  (JNIEnv *, jobject, jint, jlongArray);
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_createRandomFieldElements
+  (JNIEnv *, jobject, jint, jbyteArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
  * Method:    interpolate
- * Signature: (I[B[J[I)J
+ * Signature: (J[B[I)V
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_interpolate
-  (JNIEnv *, jobject, jbyteArray, jlongArray, jintArray);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_interpolate
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
  * Method:    getRestChallenges
- * Signature: (JIII[I)[[B
+ * Signature: (J[I[B)V
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getRestChallenges
-  (JNIEnv *, jobject, jlong, jint, jint, jintArray);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getRestChallenges
+  (JNIEnv *, jobject, jlong, jintArray, jbyteArray);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
  * Method:    getPolynomialBytes
- * Signature: (J)[[B
+ * Signature: (J)[B
  */
-JNIEXPORT jobjectArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getPolynomialBytes
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_getPolynomialBytes
   (JNIEnv *, jobject, jlong);
 
 /*
  * Class:     edu_biu_scapi_interactiveMidProtocols_SigmaProtocol_orMultiple_SigmaORMultipleSimulator
  * Method:    deletePointers
- * Signature: (J[J)V
+ * Signature: (J)V
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_interactiveMidProtocols_sigmaProtocol_orMultiple_SigmaORMultipleSimulator_deletePointers
-  (JNIEnv *, jobject, jlong, jlongArray);
+  (JNIEnv *, jobject, jlong);
 
 
 void initField(jint t, jint randomNum);
-jobjectArray sampleRandomFieldElements(JNIEnv * env, jint numElements, jlongArray pointerToElements);
-jlong interpolate(JNIEnv * env, jbyteArray challenge, jlongArray fieldElements, jintArray sampledIndexes);
-jobjectArray calcRestChallenges(JNIEnv *env, jlong polynomial, jintArray indexesInI);
-jobjectArray calcPolynomialBytes(JNIEnv *env, jlong poly);
-void deleteMemory(JNIEnv *env, jlong polynomial, jlongArray fieldElements);
-GF2EX createPolynomial(JNIEnv *env, jobjectArray polynomialBytes);
+jlong sampleRandomFieldElements(JNIEnv * env, jint numElements, jbyteArray elementsBytes);
+void interpolate(JNIEnv * env, jlong arena, jbyteArray challenge, jintArray sampledIndexes);
+void calcRestChallenges(JNIEnv *env, jlong arena, jintArray indexesInI, jbyteArray challengesBytes);
+jbyteArray calcPolynomialBytes(JNIEnv *env, jlong arena);
+void deleteMemory(jlong arena);
+void createPolynomial(JNIEnv *env, jbyteArray polynomialBytes, GF2EX& polynom);
+int getElementSize();
+void convertGF2EVectorToBytes(const vec_GF2E& elements, jbyte* bytes, int elementSize);
+void convertBytesToGF2EVector(vec_GF2E& elements, const jbyte* bytes, int numElements, int elementSize);
 void convertGF2EToBytes(GF2E element, jbyte* byteArr);
 GF2E convertBytesToGF2E(JNIEnv * env, jbyteArray byteArr);
 GF2E generateIndexPolynomial(int i);
@@ -0,0 +1,192 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#include "stdafx.h"
+#include <map>
+#include <mutex>
+#include "SubproductTree.h"
+#include "SigmaProtocolOR.h"
+
+//Below this number of points the remainder is evaluated directly on each point (Horner), which is faster than going down the tree.
+#define EVALUATION_LEAF_SIZE 8
+
+//Maximum number of trees kept in the cache. The cache is cleared when it gets bigger.
+#define MAX_CACHED_TREES 32
+
+SubproductTree::SubproductTree(const vec_GF2E& points) : numPoints(points.length()), points(points)
+{
+	if (numPoints == 0){
+		//The empty product.
+		nodes.resize(1);
+		set(nodes[0]);
+		return;
+	}
+
+	//A binary tree over n leaves has less than 4n nodes when stored in an array.
+	nodes.resize(4 * numPoints);
+	build(0, 0, numPoints);
+
+	//Compute the interpolation weights 1/M'(x_i). M'(x_i) is the product of (x_i - x_j) for all j!=i, so it is not zero for distinct points.
+	GF2EX derivative;
+	diff(derivative, root());
+	evaluate(weights, derivative);
+	for (int i = 0; i < numPoints; i++){
+		inv(weights[i], weights[i]);
+	}
+}
+
+/*
+ * Builds the node that covers the points [lo, hi).
+ */
+void SubproductTree::build(int node, int lo, int hi)
+{
+	if (hi - lo == 1){
+		//The leaf is the linear polynomial X - x_lo.
+		SetX(nodes[node]);
+		sub(nodes[node], nodes[node], points[lo]);
+		return;
+	}
+
+	int mid = (lo + hi) / 2;
+	build(2 * node + 1, lo, mid);
+	build(2 * node + 2, mid, hi);
+	mul(nodes[node], nodes[2 * node + 1], nodes[2 * node + 2]);
+}
+
+void SubproductTree::evaluate(vec_GF2E& values, const GF2EX& f) const
+{
+	values.SetLength(numPoints);
+	if (numPoints == 0){
+		return;
+	}
+
+	//Reduce f by the root first, then go down the tree.
+	GF2EX r;
+	rem(r, f, root());
+	evaluate(values, r, 0, 0, numPoints);
+}
+
+/*
+ * f is already reduced modulo the polynomial of the node, so f(x_i) = (f mod node)(x_i) for every point of the node.
+ */
+void SubproductTree::evaluate(vec_GF2E& values, const GF2EX& f, int node, int lo, int hi) const
+{
+	if (hi - lo <= EVALUATION_LEAF_SIZE){
+		for (int i = lo; i < hi; i++){
+			eval(values[i], f, points[i]);
+		}
+		return;
+	}
+
+	int mid = (lo + hi) / 2;
+	GF2EX r;
+	rem(r, f, nodes[2 * node + 1]);
+	evaluate(values, r, 2 * node + 1, lo, mid);
+	rem(r, f, nodes[2 * node + 2]);
+	evaluate(values, r, 2 * node + 2, mid, hi);
+}
+
+void SubproductTree::interpolate(GF2EX& f, const vec_GF2E& values) const
+{
+	if (numPoints == 0){
+		clear(f);
+		return;
+	}
+
+	//By Lagrange, f = sum(c_i * M(X)/(X - x_i)) where c_i = y_i/M'(x_i).
+	vec_GF2E c;
+	c.SetLength(numPoints);
+	for (int i = 0; i < numPoints; i++){
+		mul(c[i], values[i], weights[i]);
+	}
+
+	combine(f, c, 0, 0, numPoints);
+}
+
+/*
+ * Computes sum(c_i * M_node(X)/(X - x_i)) over the points of the node.
+ */
+void SubproductTree::combine(GF2EX& f, const vec_GF2E& c, int node, int lo, int hi) const
+{
+	if (hi - lo == 1){
+		conv(f, c[lo]);
+		return;
+	}
+
+	int mid = (lo + hi) / 2;
+	GF2EX left, right;
+	combine(left, c, 2 * node + 1, lo, mid);
+	combine(right, c, 2 * node + 2, mid, hi);
+
+	//f = left * M_right + right * M_left
+	mul(left, left, nodes[2 * node + 2]);
+	mul(right, right, nodes[2 * node + 1]);
+	add(f, left, right);
+}
+
+//The cached trees, by their index sets. All the trees belong to the field of cachedModulus.
+static map<vector<int>, shared_ptr<SubproductTree> > indexTrees;
+static GF2X cachedModulus;
+static mutex indexTreesLock;
+
+shared_ptr<SubproductTree> getIndexTree(const vector<int>& indexes)
+{
+	lock_guard<mutex> lock(indexTreesLock);
+
+	//Trees of another field can not be used.
+	if (cachedModulus != GF2E::modulus().val()){
+		indexTrees.clear();
+		cachedModulus = GF2E::modulus().val();
+	}
+
+	map<vector<int>, shared_ptr<SubproductTree> >::iterator it = indexTrees.find(indexes);
+	if (it != indexTrees.end()){
+		return it->second;
+	}
+
+	//Create the points out of the indexes and build a new tree.
+	vec_GF2E points;
+	int size = indexes.size();
+	points.SetLength(size);
+	for (int i = 0; i < size; i++){
+		points[i] = generateIndexPolynomial(indexes[i]);
+	}
+	shared_ptr<SubproductTree> tree(new SubproductTree(points));
+
+	if (indexTrees.size() >= MAX_CACHED_TREES){
+		indexTrees.clear();
+	}
+	indexTrees[indexes] = tree;
+	return tree;
+}
+
+shared_ptr<SubproductTree> getIndexTree(int n)
+{
+	vector<int> indexes(n);
+	for (int i = 0; i < n; i++){
+		indexes[i] = i + 1;
+	}
+	return getIndexTree(indexes);
+}
@@ -0,0 +1,94 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+*
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+*
+*/
+
+#pragma once
+#include <vector>
+#include <memory>
+#include "NTL/GF2X.h"
+#include "NTL/GF2E.h"
+#include "NTL/vec_GF2E.h"
+#include "NTL/GF2EX.h"
+
+NTL_CLIENT
+
+
+/********************************************************************
+	file base:	SubproductTree
+	file ext:	h
+
+	purpose:	Fast multipoint evaluation and interpolation over GF2E.
+				The tree is built over the points x_0,...,x_{n-1}: every leaf holds (X - x_i) and every inner node holds the
+				product of its children, so the root is M(X) = prod(X - x_i).
+				Evaluating a polynomial on all the points is done by reducing it modulo the nodes from the root down to the leaves,
+				and interpolation combines the weights y_i/M'(x_i) from the leaves up to the root.
+				Both take O(M(n)log(n)) field operations instead of the O(n^2) of the point by point functions of NTL.
+
+				The points used by the SigmaORMultiple protocol are always "index polynomials" of integer indexes, so the trees are
+				cached by their index sets. The cache belongs to the current GF2E modulus and is dropped once the field changes.
+*********************************************************************/
+class SubproductTree
+{
+private:
+
+	int numPoints;
+	vec_GF2E points;
+	vector<GF2EX> nodes;			//nodes of the tree. Node k has children 2k+1 and 2k+2.
+	vec_GF2E weights;				//1/M'(x_i), used by the interpolation.
+
+	void build(int node, int lo, int hi);
+	void evaluate(vec_GF2E& values, const GF2EX& f, int node, int lo, int hi) const;
+	void combine(GF2EX& f, const vec_GF2E& c, int node, int lo, int hi) const;
+
+public:
+
+	SubproductTree(const vec_GF2E& points);
+
+	int size() const { return numPoints; }
+
+	/*
+	 * Returns the product of (X - x_i) over all points.
+	 */
+	const GF2EX& root() const { return nodes[0]; }
+
+	/*
+	 * Evaluates f on all the points of the tree. values[i] = f(x_i).
+	 */
+	void evaluate(vec_GF2E& values, const GF2EX& f) const;
+
+	/*
+	 * Computes the polynomial f of degree < n such that f(x_i) = values[i].
+	 */
+	void interpolate(GF2EX& f, const vec_GF2E& values) const;
+};
+
+/*
+ * Returns a (cached) tree over the points generateIndexPolynomial(indexes[i]).
+ */
+shared_ptr<SubproductTree> getIndexTree(const vector<int>& indexes);
+
+/*
+ * Returns a (cached) tree over the points generateIndexPolynomial(1),...,generateIndexPolynomial(n).
+ */
+shared_ptr<SubproductTree> getIndexTree(int n);
@@ -0,0 +1,224 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "AesCtrPrg.h"
+#include "../Common/ThreadPool.h"
+#include <openssl/evp.h>
+#include <openssl/crypto.h>
+#include <string.h>
+
+using namespace std;
+
+#define AES_BLOCK_BYTES 16
+
+//Size of the internal buffer, that holds the next bytes of the stream for short requests.
+#define PRG_BUFFER_SIZE 4096
+
+//Requests of at least this number of bytes are generated by all the threads of the pool. 
+#define PRG_PARALLEL_BYTES (1 << 18)
+
+/*
+ * The state of an AES-CTR PRG. 
+ * The stream is AES_k(0), AES_k(1), ..., where k is the seed and the counter is a 128 bit big endian number.
+ * Since the counter of each block is known, any part of the stream can be generated independently.
+ */
+typedef struct {
+	EVP_CIPHER_CTX* ctx;					//AES in counter mode, with the seed as the key.
+	unsigned long long counter;				//The number of the next block of the stream that was not generated yet.
+	unsigned char buffer[PRG_BUFFER_SIZE];	//Bytes of the stream that were generated before the block counter.
+	int position;							//Index of the first byte in the buffer that was not used yet.
+} AES_CTR_PRG;
+
+/*
+ * Writes numBlocks blocks of the stream, starting from the block number counter, to out.
+ * The counter mode encrypts zeroes in place, so no input buffer is needed.
+ * Returns false if openssl failed.
+ */
+static bool generateBlocks(EVP_CIPHER_CTX* ctx, unsigned long long counter, unsigned char* out, int numBlocks){
+	unsigned char iv[AES_BLOCK_BYTES] = { 0 };
+	for (int i = AES_BLOCK_BYTES - 1; i >= AES_BLOCK_BYTES - 8; i--){
+		iv[i] = (unsigned char) counter;
+		counter >>= 8;
+	}
+
+	int len;
+	memset(out, 0, numBlocks * AES_BLOCK_BYTES);
+	return (1 == EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv)) && 
+		   (1 == EVP_EncryptUpdate(ctx, out, &len, out, numBlocks * AES_BLOCK_BYTES)) && 
+		   (len == numBlocks * AES_BLOCK_BYTES);
+}
+
+/*
+ * Writes the next numBlocks blocks of the stream to out. Long requests are split between the threads of the pool.
+ * Returns false if openssl failed. The blocks are skipped anyway, so that the stream never repeats.
+ */
+static bool generateStream(AES_CTR_PRG* prg, unsigned char* out, int numBlocks){
+	unsigned long long counter = prg->counter;
+	bool success;
+	if ((long long) numBlocks * AES_BLOCK_BYTES >= PRG_PARALLEL_BYTES){
+		success = getThreadPool()->parallelFor(numBlocks, [&](int first, int last){
+			//Each range uses its own copy of the expanded key.
+			EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+			bool done = (ctx != NULL) && (1 == EVP_CIPHER_CTX_copy(ctx, prg->ctx)) && 
+						generateBlocks(ctx, counter + first, out + (long long) first * AES_BLOCK_BYTES, last - first);
+			EVP_CIPHER_CTX_free(ctx);
+			return done;
+		});
+	} else {
+		success = generateBlocks(prg->ctx, counter, out, numBlocks);
+	}
+	prg->counter += numBlocks;
+	return success;
+}
+
+/*
+ * Writes the next len bytes of the stream to out. 
+ * Short requests are taken from the internal buffer. Long requests are generated directly into out.
+ * Returns false if openssl failed. In this case out is zeroed and the buffer is emptied, 
+ * so that zeroes are never returned as pseudorandom bytes.
+ */
+static bool fillBytes(AES_CTR_PRG* prg, unsigned char* out, int len){
+	unsigned char* start = out;
+	int requested = len;
+	bool success = true;
+
+	//Use the bytes that are left in the buffer.
+	int available = PRG_BUFFER_SIZE - prg->position;
+	int n = (len < available) ? len : available;
+	memcpy(out, prg->buffer + prg->position, n);
+	prg->position += n;
+	out += n;
+	len -= n;
+
+	//Generate the whole blocks of a long request in place.
+	if (len >= PRG_BUFFER_SIZE){
+		int numBlocks = len / AES_BLOCK_BYTES;
+		success = generateStream(prg, out, numBlocks);
+		out += (long long) numBlocks * AES_BLOCK_BYTES;
+		len -= numBlocks * AES_BLOCK_BYTES;
+	}
+
+	//Refill the buffer and take the rest of the bytes from it.
+	if (success && (len > 0)){
+		success = generateStream(prg, prg->buffer, PRG_BUFFER_SIZE / AES_BLOCK_BYTES);
+		memcpy(out, prg->buffer, len);
+		prg->position = len;
+	}
+
+	if (!success){
+		OPENSSL_cleanse(start, requested);
+		OPENSSL_cleanse(prg->buffer, PRG_BUFFER_SIZE);
+		prg->position = PRG_BUFFER_SIZE;
+	}
+	return success;
+}
+
+/* 
+ * function createPrg		: Creates an AES-CTR PRG with the given seed.
+ * param seed				: The seed, which is used as the AES key. Should be 16, 24 or 32 bytes long.
+ * return					: A pointer to the created PRG, or 0 if the seed size is not valid or openssl failed.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_createPrg
+  (JNIEnv *env, jobject, jbyteArray seed){
+	  const EVP_CIPHER* cipher;
+	  switch(env->GetArrayLength(seed)){
+		case 16: cipher = EVP_aes_128_ctr();
+				 break;
+		case 24: cipher = EVP_aes_192_ctr();
+				 break;
+		case 32: cipher = EVP_aes_256_ctr();
+				 break;
+		default: return 0;
+	  }
+
+	  jbyte* key = env->GetByteArrayElements(seed, 0);
+
+	  EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+	  bool success = (ctx != NULL) && (1 == EVP_EncryptInit_ex(ctx, cipher, NULL, (unsigned char*) key, NULL));
+
+	  //The seed is secret, so the copy (if the JVM made one) is released without being written back.
+	  env->ReleaseByteArrayElements(seed, key, JNI_ABORT);
+
+	  if (!success){
+		  EVP_CIPHER_CTX_free(ctx);
+		  return 0;
+	  }
+
+	  AES_CTR_PRG* prg = new AES_CTR_PRG();
+	  prg->ctx = ctx;
+	  prg->counter = 0;
+	  //The buffer is empty until the first request.
+	  prg->position = PRG_BUFFER_SIZE;
+
+	  return (jlong) prg;
+}
+
+/* 
+ * function getBytes		: Fills the given array with the next bytes of the stream.
+ * param prg				: Pointer to the native PRG.
+ * param out				: The output array.
+ * param outOffset			: The offset within the output array to fill the bytes from.
+ * param outLen				: The number of bytes to generate.
+ * return					: True if the bytes were generated, false if openssl failed. In this case the output bytes are zeroed.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_getBytes
+  (JNIEnv *env, jobject, jlong prg, jbyteArray out, jint outOffset, jint outLen){
+	  //Pin the array and write the bytes in place.
+	  jbyte* output = (jbyte*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  bool success = fillBytes((AES_CTR_PRG*) prg, (unsigned char*) output + outOffset, outLen);
+
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  return success;
+}
+
+/* 
+ * function fillBuffer		: Fills the given direct buffer with the next bytes of the stream. Nothing is copied or pinned.
+ * param prg				: Pointer to the native PRG.
+ * param out				: The output direct buffer.
+ * param outOffset			: The offset within the buffer to fill the bytes from.
+ * param outLen				: The number of bytes to generate.
+ * return					: True if the bytes were generated, false if openssl failed. In this case the output bytes are zeroed.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_fillBuffer
+  (JNIEnv *env, jobject, jlong prg, jobject out, jint outOffset, jint outLen){
+	  unsigned char* output = (unsigned char*) env->GetDirectBufferAddress(out);
+
+	  return fillBytes((AES_CTR_PRG*) prg, output + outOffset, outLen);
+}
+
+/* 
+ * function deletePrg		: Deletes the native PRG.
+ * param prg				: Pointer to the native PRG.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_deletePrg
+  (JNIEnv *, jobject, jlong prg){
+	  EVP_CIPHER_CTX_free(((AES_CTR_PRG*) prg)->ctx);
+	  //Clear the bytes of the stream that were not used.
+	  OPENSSL_cleanse(((AES_CTR_PRG*) prg)->buffer, PRG_BUFFER_SIZE);
+	  delete (AES_CTR_PRG*) prg;
+}
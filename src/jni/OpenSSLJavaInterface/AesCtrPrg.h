@@ -0,0 +1,69 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+/* Header for class edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg */
+#include <jni.h>
+
+#ifndef _Included_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+#define _Included_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+ * Method:    createPrg
+ * Signature: ([B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_createPrg
+  (JNIEnv *, jobject, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+ * Method:    getBytes
+ * Signature: (J[BII)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_getBytes
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+ * Method:    fillBuffer
+ * Signature: (JLjava/nio/ByteBuffer;II)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_fillBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg
+ * Method:    deletePrg
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLAesCtrPrg_deletePrg
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
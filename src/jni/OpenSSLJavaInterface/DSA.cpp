@@ -26,8 +26,8 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DSA.h"
+#include "ThreadContext.h"
 #include <openssl/dsa.h>
-#include <openssl/rand.h>
 #include <iostream>
 
 using namespace std;
@@ -117,12 +117,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_digita
 	  //Convert the given data into c++ notation.
 	  jbyte* message  = (jbyte*) env->GetByteArrayElements(msg, 0);
 	  
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
+	  //Reseed the random generator if its reseed interval has passed.
+	  reseedRandomIfNeeded();
 
 	  //Allocate a new byte array to hold the output.
 	  int size = DSA_size((DSA *) dsa);
@@ -26,8 +26,13 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DlogEC.h"
+#include "ThreadContext.h"
+#include "../Common/ThreadPool.h"
 #include <openssl/ec.h>
+#include <openssl/obj_mac.h>
 #include <iostream>
+#include <string.h>
+#include <vector>
 
 using namespace std;
 
@@ -114,52 +119,54 @@ JNIEXPORT jboolean JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_Op
 	  return ((DlogEC*)dlog)->checkCurveMembership((EC_POINT*)point);
 }
 
+/* 
+ * function checkMembership				: Checks for each of the given points whether it is in the group, using the threads of the native pool.
+ * param dlog							: Pointer to the dlog group.
+ * param points							: The points to check.
+ * return								: Array that holds for each point whether it is in the group.
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_checkMembership
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points){
+	  int size = env->GetArrayLength(points);
+	  jlong* pointsArr = env->GetLongArrayElements(points, 0);
+	  bool* member = new bool[size];
+
+	  ((DlogEC*)dlog)->checkMembership((const EC_POINT**) pointsArr, member, size);
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+
+	  jboolean* memberArr = new jboolean[size];
+	  for (int i = 0; i < size; i++){
+		  memberArr[i] = member[i];
+	  }
+	  jbooleanArray result = env->NewBooleanArray(size);
+	  env->SetBooleanArrayRegion(result, 0, size, memberArr);
+
+	  delete[] member;
+	  delete[] memberArr;
+	  return result;
+}
+
 /* 
  * function simultaneousMultiply		: Computes the product of several exponentiations with distinct bases.
  * param dlog							: Pointer to the dlog group.
  * param points							: Array of points.
- * params exponents						: Array of exponents.
+ * params exponents						: The exponents, packed. Each exponent takes exponentSize bytes (big endian, non negative).
+ * param exponentSize					: The size of each exponent in bytes.
  * return								: Pointer to the result's point.
  */
 JNIEXPORT jlong JNICALL JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_simultaneousMultiply
-  (JNIEnv *env, jobject, jlong dlog, jlongArray points, jobjectArray exponents){
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points, jbyteArray exponents, jint exponentSize){
 	
 	  int size = env->GetArrayLength(points); //Number of points.
 	  jlong* pointsArr  = env->GetLongArrayElements(points, 0); //Convert JllongArray to long array. 
-	  BIGNUM ** exponentsArr =  new BIGNUM*[size]; //Create an array to hold the exponents.
-	  int i;
-	  
-	  jbyteArray exponentBytes;
-	  //Convert each exponent bytes to a BIGNUM object.
-	  for(i=0; i<size; i++){
-		  //Get the exponent bytes.
-		  exponentBytes = (jbyteArray) env->GetObjectArrayElement(exponents, i);
-		  jbyte* exponent_bytes  = (jbyte*) env->GetByteArrayElements(exponentBytes, 0);
-		  //Convert to BIGNUM.
-		  if(NULL == (exponentsArr[i] = BN_bin2bn((unsigned char*)exponent_bytes, env->GetArrayLength(exponentBytes), NULL))){
-			  //release the memory
-			  for(int j=0; j<i; j++){
-				   BN_free(exponentsArr[j]);
-			  }
-			  env ->ReleaseByteArrayElements(exponentBytes, exponent_bytes, 0);
-			  env ->ReleaseLongArrayElements(points, pointsArr, 0);
-			  delete(exponentsArr);
-			  return 0;
-
-		  }
-		  //Release the memory.
-		  env ->ReleaseByteArrayElements(exponentBytes, exponent_bytes, 0);
-	  }
+	  jbyte* exponentsArr = env->GetByteArrayElements(exponents, 0);
 
 	  //Call the function in the Dlog group that computes the simultaneous multiply.
-	  EC_POINT *result = ((DlogEC*)dlog)->simultaneousMultiply((const EC_POINT**) pointsArr, (const BIGNUM **) exponentsArr, size);
+	  EC_POINT *result = ((DlogEC*)dlog)->simultaneousMultiply((const EC_POINT**) pointsArr, (unsigned char*) exponentsArr, exponentSize, size);
 	  
-	  //release the memory
-	  for(i=0; i<size; i++){
-		   BN_free(exponentsArr[i]);
-	  }
-	  delete(exponentsArr);
-	  env ->ReleaseLongArrayElements(points, pointsArr, 0);
+	  //Release the java arrays. They were only read.
+	  env->ReleaseByteArrayElements(exponents, exponentsArr, JNI_ABORT);
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
 	  
 	  return (long) result;
 }
@@ -201,6 +208,195 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
 	  return (long) result; //return the result
 }
 
+/* 
+ * function createFixedBaseTable	: Precomputes the multiples of the given base, to be used by exponentiateWithTable.
+ * param dlog						: Pointer to the dlog group.
+ * param base						: The point that will be raised by the table.
+ * param window						: The number of exponent bits that each addition handles, or 0 to use the largest window that fits the budget.
+ * param maxBytes					: The memory that the table may take. A smaller window is used if the table does not fit.
+ * return							: Pointer to the created table.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_createFixedBaseTable
+  (JNIEnv *, jobject, jlong dlog, jlong base, jint window, jlong maxBytes){
+
+	  return (long) new ECFixedBaseTable((DlogEC*) dlog, (EC_POINT*) base, window, maxBytes);
+}
+
+/* 
+ * function exponentiateWithTable	: Raises the base of the given table to the given exponent.
+ * param dlog						: Pointer to the dlog group.
+ * param table						: Pointer to the table of the base.
+ * param exponentBytes				: The exponent (non negative).
+ * return							: Pointer to the result's point.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateWithTable
+  (JNIEnv *env, jobject, jlong dlog, jlong table, jbyteArray exponentBytes){
+	  //Create the exponent BIGNUM.
+	  BIGNUM *exponent;
+	  jbyte* exponent_bytes  = (jbyte*) env->GetByteArrayElements(exponentBytes, 0);
+	  if(NULL == (exponent = BN_bin2bn((unsigned char*)exponent_bytes, env->GetArrayLength(exponentBytes), NULL))) {
+		  env ->ReleaseByteArrayElements(exponentBytes, (jbyte*) exponent_bytes, JNI_ABORT);
+		  return 0;
+	  }
+	  env ->ReleaseByteArrayElements(exponentBytes, (jbyte*) exponent_bytes, JNI_ABORT);
+
+	  EC_POINT* result = ((DlogEC*)dlog)->newPoint();
+	  if ((result != NULL) && !((ECFixedBaseTable*) table)->exponentiate((DlogEC*)dlog, result, exponent)){
+		  EC_POINT_free(result);
+		  result = NULL;
+	  }
+
+	  BN_free(exponent);
+
+	  return (long) result;
+}
+
+/* 
+ * function deleteFixedBaseTable	: Deletes the given table.
+ * param table						: Pointer to the table.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deleteFixedBaseTable
+  (JNIEnv *, jobject, jlong table){
+	  delete (ECFixedBaseTable*) table;
+}
+
+/* 
+ * function pointsToArray	: Returns a java array with the pointers of the given points, or null if the points were not computed.
+ */
+static jlongArray pointsToArray(JNIEnv *env, bool success, EC_POINT** points, int size){
+	if (!success){
+		return NULL;
+	}
+
+	jlongArray result = env->NewLongArray(size);
+	jlong* pointers = env->GetLongArrayElements(result, 0);
+	for (int i = 0; i < size; i++){
+		pointers[i] = (jlong) points[i];
+	}
+	env->ReleaseLongArrayElements(result, pointers, 0);
+	return result;
+}
+
+/* 
+ * function exponentiateBatch	: Raises each base to the respective exponent, using the threads of the native pool.
+ * param dlog					: Pointer to the dlog group.
+ * param bases					: Pointers to the bases.
+ * param exponents				: The exponents, packed. Each exponent takes exponentSize bytes (big endian, non negative).
+ * param exponentSize			: The size of each exponent in bytes.
+ * return						: Array of pointers to the results' points, or null on failure.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateBatch
+  (JNIEnv *env, jobject, jlong dlog, jlongArray bases, jbyteArray exponents, jint exponentSize){
+	  int size = env->GetArrayLength(bases);
+	  jlong* basesArr = env->GetLongArrayElements(bases, 0);
+	  jbyte* exponentsArr = env->GetByteArrayElements(exponents, 0);
+	  EC_POINT** results = new EC_POINT*[size];
+
+	  //Call the function in the Dlog group that computes all the exponentiations.
+	  bool success = ((DlogEC*)dlog)->exponentiateBatch((const EC_POINT**) basesArr, (unsigned char*) exponentsArr, exponentSize, results, size);
+
+	  //Release the java arrays. They were only read.
+	  env->ReleaseByteArrayElements(exponents, exponentsArr, JNI_ABORT);
+	  env->ReleaseLongArrayElements(bases, basesArr, JNI_ABORT);
+
+	  jlongArray result = pointsToArray(env, success, results, size);
+	  delete[] results;
+	  return result;
+}
+
+/* 
+ * function fixedBaseExponentiateBatch	: Raises a fixed base to each of the exponents, using pre computed values and the threads of the native pool.
+ * param dlog							: Pointer to the dlog group.
+ * param table							: Pointer to the table of the base, or 0 to raise the generator using the pre computed values of the curve.
+ * param exponents						: The exponents, packed. Each exponent takes exponentSize bytes (big endian, non negative).
+ * param exponentSize					: The size of each exponent in bytes.
+ * return								: Array of pointers to the results' points, or null on failure.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_fixedBaseExponentiateBatch
+  (JNIEnv *env, jobject, jlong dlog, jlong table, jbyteArray exponents, jint exponentSize){
+	  int size = (exponentSize > 0) ? env->GetArrayLength(exponents) / exponentSize : 0;
+	  jbyte* exponentsArr = env->GetByteArrayElements(exponents, 0);
+	  EC_POINT** results = new EC_POINT*[size];
+
+	  //Compute all the exponentiations, with the table of the base or with the pre computed values of the generator.
+	  bool success = (table != 0) ? 
+		  ((ECFixedBaseTable*) table)->exponentiateBatch((DlogEC*)dlog, (unsigned char*) exponentsArr, exponentSize, results, size) : 
+		  ((DlogEC*)dlog)->fixedBaseExponentiateBatch((unsigned char*) exponentsArr, exponentSize, results, size);
+
+	  //Release the java array. It was only read.
+	  env->ReleaseByteArrayElements(exponents, exponentsArr, JNI_ABORT);
+
+	  jlongArray result = pointsToArray(env, success, results, size);
+	  delete[] results;
+	  return result;
+}
+
+/* 
+ * function encodePoints	: Encodes the given points, one after the other, using the threads of the native pool.
+ * param dlog				: Pointer to the dlog group.
+ * param points				: Pointers to the points.
+ * param compressed			: Whether to use the compressed encoding (only x and the sign of y) or the uncompressed encoding (x and y).
+ * return					: The encodings, each one in the size that getEncodingSize returns, or null on failure.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_encodePoints
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points, jboolean compressed){
+	  int size = env->GetArrayLength(points);
+	  int encodingSize = ((DlogEC*)dlog)->getEncodingSize(0 != compressed);
+	  jlong* pointsArr = env->GetLongArrayElements(points, 0);
+	  unsigned char* encoded = new unsigned char[(size_t) size * encodingSize];
+
+	  bool success = ((DlogEC*)dlog)->encodePoints((const EC_POINT**) pointsArr, size, 0 != compressed, encoded);
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+
+	  jbyteArray result = NULL;
+	  if (success){
+		  result = env->NewByteArray(size * encodingSize);
+		  env->SetByteArrayRegion(result, 0, size * encodingSize, (jbyte*) encoded);
+	  }
+	  delete[] encoded;
+	  return result;
+}
+
+/* 
+ * function decodePoints	: Decodes the given points, and checks that each one of them is on the curve.
+ * param dlog				: Pointer to the dlog group.
+ * param encoded			: The encodings of the points, one after the other, as encodePoints returns them.
+ * param encodingSize		: The size of each encoding.
+ * return					: Pointers to the decoded points, or null if one of the encodings is not a point on the curve.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_decodePoints
+  (JNIEnv *env, jobject, jlong dlog, jbyteArray encoded, jint encodingSize){
+	  int size = (encodingSize > 0) ? env->GetArrayLength(encoded) / encodingSize : 0;
+	  jbyte* encodedArr = env->GetByteArrayElements(encoded, 0);
+	  EC_POINT** results = new EC_POINT*[size];
+
+	  bool success = ((DlogEC*)dlog)->decodePoints((unsigned char*) encodedArr, encodingSize, results, size);
+	  env->ReleaseByteArrayElements(encoded, encodedArr, JNI_ABORT);
+
+	  jlongArray result = pointsToArray(env, success, results, size);
+	  delete[] results;
+	  return result;
+}
+
+/* 
+ * function releasePoints		: Releases the given points in bulk. The group keeps them for the next results of its functions.
+ * param dlog					: Pointer to the dlog group.
+ * param points					: Pointers to the points. The java side should not use them anymore.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_releasePoints
+  (JNIEnv *env, jobject, jlong dlog, jlongArray points){
+	  int size = env->GetArrayLength(points);
+	  jlong* pointsArr = env->GetLongArrayElements(points, 0);
+	  EC_POINT** released = new EC_POINT*[size];
+	  for (int i = 0; i < size; i++){
+		  released[i] = (EC_POINT*) pointsArr[i];
+	  }
+	  env->ReleaseLongArrayElements(points, pointsArr, JNI_ABORT);
+
+	  ((DlogEC*)dlog)->releasePoints(released, size);
+	  delete[] released;
+}
+
 /* 
  * function deleteDlog			: Deletes the allocated memory.
  * param dlog					: Pointer to the dlog group.
@@ -215,7 +411,7 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapter
  * param curveP					: Pointer to the curve.
  * params ctx					: Pointer to CTX struct.
  */
-DlogEC::DlogEC(EC_GROUP* curveP, BN_CTX* ctx){
+DlogEC::DlogEC(EC_GROUP* curveP, BN_CTX* ctx) : pointPool(EC_POINT_free){
 
 	this->curveP = curveP;
 	this->ctx = ctx;
@@ -238,11 +434,27 @@ EC_GROUP* DlogEC::getCurve(){
 }
 
 /* 
- * function getCTX		: Returns the CTX structure.
+ * function getCTX		: Returns the CTX structure of the calling thread, since the group can be used by several threads.
  * return				: ctx.
  */
 BN_CTX* DlogEC::getCTX(){
-	return ctx;
+	return getThreadBnCtx();
+}
+
+/* 
+ * function newPoint		: Returns a new point of the curve, which is reused from the released points if possible.
+ * return					: The point. Its value is arbitrary.
+ */
+EC_POINT* DlogEC::newPoint(){
+	EC_POINT* point = pointPool.take();
+	return (point != NULL) ? point : EC_POINT_new(curveP);
+}
+
+/* 
+ * function releasePoints		: Releases the given points, which may be reused by newPoint.
+ */
+void DlogEC::releasePoints(EC_POINT** points, int size){
+	pointPool.release(points, size);
 }
 
 /* 
@@ -254,7 +466,7 @@ EC_POINT* DlogEC::createInfinityPoint(){
 	EC_POINT *point;  
 
 	//Create the pointer to a point.
-	if(NULL == (point = EC_POINT_new(curveP))) return 0;
+	if(NULL == (point = newPoint())) return 0;
 
 	//Set the point to be the infinity.
 	if(0 == (EC_POINT_set_to_infinity(curveP, point))){
@@ -274,14 +486,14 @@ EC_POINT* DlogEC::inversePoint(EC_POINT* point){
 
 	//Create an inverse point and copy the given point to it.
 	EC_POINT *inverse;
-	if(NULL == (inverse = EC_POINT_new(curveP))) return 0;
+	if(NULL == (inverse = newPoint())) return 0;
 	if(0 == (EC_POINT_copy(inverse, point))) {
 		EC_POINT_free(inverse);
 		return 0;
 	}
 
 	//Inverse the given value and set the inversed value instead.
-	if(0 == (EC_POINT_invert(curveP,  inverse, ctx))){
+	if(0 == (EC_POINT_invert(curveP,  inverse, getCTX()))){
 		EC_POINT_free(inverse);
 		return 0;
 	}
@@ -298,10 +510,10 @@ EC_POINT* DlogEC::inversePoint(EC_POINT* point){
 EC_POINT* DlogEC::exponentiate(EC_POINT* base, BIGNUM* exponent){
 	//Prepare a point that will contain the exponentiate result.
 	EC_POINT *result;
-	if(NULL == (result = EC_POINT_new(curveP))) return 0;
+	if(NULL == (result = newPoint())) return 0;
 
 	//Compute the exponentiate.
-	if(0 == (EC_POINT_mul(curveP, result, NULL, base, exponent, ctx))) {
+	if(0 == (EC_POINT_mul(curveP, result, NULL, base, exponent, getCTX()))) {
 		EC_POINT_free(result);
 		return 0;
 	}
@@ -318,10 +530,10 @@ EC_POINT* DlogEC::exponentiate(EC_POINT* base, BIGNUM* exponent){
 EC_POINT* DlogEC::multiply(EC_POINT* point1, EC_POINT* point2){
 	//Prepare a point that will contain the multiplication result.
 	EC_POINT *result;
-	if(NULL == (result = EC_POINT_new(curveP))) return 0;
+	if(NULL == (result = newPoint())) return 0;
 
 	//Compute the multiplication.
-	if(0 == (EC_POINT_add(curveP, result, point1, point2, ctx))){
+	if(0 == (EC_POINT_add(curveP, result, point1, point2, getCTX()))){
 		EC_POINT_free(result);
 		return 0;
 	}
@@ -337,30 +549,226 @@ EC_POINT* DlogEC::multiply(EC_POINT* point1, EC_POINT* point2){
 BOOL DlogEC::checkCurveMembership(EC_POINT* point){
 
 	//Call the function that checks membership.
-	int result = EC_POINT_is_on_curve(curveP, point, ctx);
+	int result = EC_POINT_is_on_curve(curveP, point, getCTX());
 
 	return result;
 }
 
+/* 
+ * function checkMembership				: Checks for each of the given points whether it is in the group, using the threads of the pool.
+ *										  A point is in the group if it is on the curve and, when the curve has a cofactor, its order divides q.
+ * param points							: The points to check.
+ * param results						: Array of size flags that gets the membership of the respective points.
+ */
+void DlogEC::checkMembership(const EC_POINT** points, bool* results, int size){
+	getThreadPool()->parallelFor(size, [&](int first, int last){
+		BN_CTX* ctx = getCTX();
+		BIGNUM* order = BN_new();
+		BIGNUM* cofactor = BN_new();
+		EC_POINT* multiple = EC_POINT_new(curveP);
+		bool ok = (NULL != order) && (NULL != cofactor) && (NULL != multiple) && 
+			(0 != EC_GROUP_get_order(curveP, order, ctx)) && (0 != EC_GROUP_get_cofactor(curveP, cofactor, ctx));
+
+		for (int i = first; i < last; i++){
+			if (!ok || (1 != EC_POINT_is_on_curve(curveP, points[i], ctx))){
+				results[i] = false;
+			} else if (BN_is_one(cofactor) || EC_POINT_is_at_infinity(curveP, points[i])){
+				//When the cofactor is 1 the group is the whole curve.
+				results[i] = true;
+			} else {
+				results[i] = (0 != EC_POINT_mul(curveP, multiple, NULL, points[i], order, ctx)) && EC_POINT_is_at_infinity(curveP, multiple);
+			}
+		}
+
+		BN_free(order);
+		BN_free(cofactor);
+		EC_POINT_free(multiple);
+		return true;
+	});
+}
+
 /* 
  * function simultaneousMultiply		: Computes the product of several exponentiations with distinct bases.
- * param pointsArr						: Bases array.
- * param exponentArr					: exponents array.
+ *										  Up to BUCKET_MULTIPLY_THRESHOLD bases EC_POINTs_mul of OpenSSL is used. Larger inputs use the bucket 
+ *										  method of Pippenger (see bucketMultiply), which is faster for many bases and uses the threads of the pool.
+ *										  Curves that OpenSSL implements with its own optimized code (like P-256 on 64 bit platforms) always use
+ *										  EC_POINTs_mul, since their multiplication is faster than the generic additions of the bucket method.
+ * param points							: Bases array.
+ * param exponents						: The exponents, each one in exponentSize bytes (big endian).
+ * param size							: The number of bases.
  * return								: The result's point.
  */
-EC_POINT* DlogEC::simultaneousMultiply(const EC_POINT** pointsArr, const BIGNUM** exponentsArr, int size){
-	//Prepare a point that will contain the multiplication result.
+EC_POINT* DlogEC::simultaneousMultiply(const EC_POINT** points, const unsigned char* exponents, int exponentSize, int size){
+	if ((size > BUCKET_MULTIPLY_THRESHOLD) && hasGenericArithmetic()){
+		return bucketMultiply(points, exponents, exponentSize, size);
+	}
+
+	//Prepare a point that will contain the multiplication result, and the exponents.
 	EC_POINT *result;
-	if(NULL == (result = EC_POINT_new(curveP))) return 0;
+	if(NULL == (result = newPoint())) return 0;
+	BIGNUM** exponentsArr = new BIGNUM*[size];
+	bool success = true;
+	for (int i = 0; i < size; i++){
+		exponentsArr[i] = BN_bin2bn(exponents + (size_t) i * exponentSize, exponentSize, NULL);
+		success = success && (exponentsArr[i] != NULL);
+	}
 
 	//Computes the simultaneous multiply.
-	if(0 == (EC_POINTs_mul(curveP, result, NULL, size, pointsArr, exponentsArr, ctx))){
+	success = success && (0 != EC_POINTs_mul(curveP, result, NULL, size, points, (const BIGNUM**) exponentsArr, getCTX()));
+
+	for (int i = 0; i < size; i++){
+		BN_free(exponentsArr[i]);
+	}
+	delete[] exponentsArr;
+	if (!success){
 		EC_POINT_free(result);
 		return 0;
 	}
-
 	return result;
+}
 
+/* 
+ * function hasGenericArithmetic	: Checks if the curve uses the generic arithmetic of OpenSSL, or an optimized implementation of a named curve.
+ * return							: True for the generic implementations of prime and binary curves; False, otherwise.
+ */
+bool DlogEC::hasGenericArithmetic(){
+	const EC_METHOD* method = EC_GROUP_method_of(curveP);
+	return (EC_METHOD_get_field_type(method) != NID_X9_62_prime_field) || (method == EC_GFp_mont_method()) || 
+		(method == EC_GFp_nist_method()) || (method == EC_GFp_simple_method());
+}
+
+/* 
+ * function bucketWindow		: Returns the window of the bucket method that takes the smallest number of additions for the given input.
+ *								  Each window of the exponents takes an addition for each base and two additions for each bucket.
+ */
+static int bucketWindow(int size, int bits){
+	int best = 1;
+	double bestCost = 0;
+	for (int window = 1; window <= BUCKET_MAX_WINDOW; window++){
+		double cost = (double) ((bits + window - 1) / window + 1) * (size + (2 << (window - 1)));
+		if ((window == 1) || (cost < bestCost)){
+			best = window;
+			bestCost = cost;
+		}
+	}
+	return best;
+}
+
+/* 
+ * function bucketMultiply		: Computes the product of several exponentiations with the bucket method of Pippenger.
+ *								  The exponents are split to windows, and each window is written as a signed digit (with a carry to the next window).
+ *								  For each window, every base is added to the bucket of its digit (or its inverse, for a negative digit), and the 
+ *								  window's sum is sum_j j * bucket[j], which is computed with 2 additions per bucket. The windows are independent, 
+ *								  so they are split among the threads of the pool, and the calling thread combines their sums with doublings.
+ * param points					: Bases array.
+ * param exponents				: The exponents, each one in exponentSize bytes (big endian).
+ * param size					: The number of bases.
+ * return						: The result's point.
+ */
+EC_POINT* DlogEC::bucketMultiply(const EC_POINT** points, const unsigned char* exponents, int exponentSize, int size){
+	int bits = exponentSize * 8;
+	int window = bucketWindow(size, bits);
+	int numWindows = (bits + window - 1) / window + 1;
+	int numBuckets = 1 << (window - 1);
+	ThreadPool* pool = getThreadPool();
+
+	//Recode the exponents to signed digits in [-2^(window-1), 2^(window-1)]. digits[i * numWindows + w] is digit w of exponent i.
+	vector<int> digits((size_t) size * numWindows);
+	pool->parallelFor(size, [&](int first, int last){
+		for (int i = first; i < last; i++){
+			const unsigned char* exponent = exponents + (size_t) i * exponentSize;
+			int carry = 0;
+			for (int w = 0; w < numWindows; w++){
+				int digit = carry;
+				for (int b = 0; (b < window) && (w * window + b < bits); b++){
+					int bit = w * window + b;
+					digit += ((exponent[exponentSize - 1 - bit / 8] >> (bit % 8)) & 1) << b;
+				}
+				carry = (digit > numBuckets) ? 1 : 0;
+				digits[(size_t) i * numWindows + w] = digit - (carry << window);
+			}
+		}
+		return true;
+	});
+
+	//Each base and its inverse. On prime curves they are made affine, since adding an affine point is cheaper.
+	bool affine = (EC_METHOD_get_field_type(EC_GROUP_method_of(curveP)) == NID_X9_62_prime_field);
+	vector<EC_POINT*> signedPoints(2 * (size_t) size, (EC_POINT*) NULL);
+	bool success = pool->parallelFor(size, [&](int first, int last){
+		BN_CTX* ctx = getCTX();
+		bool ok = true;
+		for (int i = first; ok && (i < last); i++){
+			ok = (NULL != (signedPoints[2 * i] = EC_POINT_dup(points[i], curveP))) && 
+				(NULL != (signedPoints[2 * i + 1] = EC_POINT_dup(points[i], curveP))) && 
+				(0 != EC_POINT_invert(curveP, signedPoints[2 * i + 1], ctx));
+		}
+		return ok && (!affine || (0 != EC_POINTs_make_affine(curveP, 2 * (last - first), &signedPoints[2 * first], ctx)));
+	});
+
+	//The sum of each window.
+	vector<EC_POINT*> windowSums(numWindows, (EC_POINT*) NULL);
+	success = success && pool->parallelFor(numWindows, [&](int first, int last){
+		BN_CTX* ctx = getCTX();
+		vector<EC_POINT*> buckets(numBuckets);
+		for (int j = 0; j < numBuckets; j++){
+			buckets[j] = EC_POINT_new(curveP);
+		}
+		EC_POINT* running = EC_POINT_new(curveP);
+
+		bool ok = (running != NULL);
+		for (int j = 0; j < numBuckets; j++){
+			ok = ok && (buckets[j] != NULL);
+		}
+		for (int w = first; ok && (w < last); w++){
+			for (int j = 0; ok && (j < numBuckets); j++){
+				ok = (0 != EC_POINT_set_to_infinity(curveP, buckets[j]));
+			}
+			for (int i = 0; ok && (i < size); i++){
+				int digit = digits[(size_t) i * numWindows + w];
+				if (digit > 0){
+					ok = (0 != EC_POINT_add(curveP, buckets[digit - 1], buckets[digit - 1], signedPoints[2 * i], ctx));
+				} else if (digit < 0){
+					ok = (0 != EC_POINT_add(curveP, buckets[-digit - 1], buckets[-digit - 1], signedPoints[2 * i + 1], ctx));
+				}
+			}
+			//sum_j j * bucket[j-1] = sum_j (bucket[j-1] + ... + bucket[numBuckets-1]).
+			ok = ok && (NULL != (windowSums[w] = EC_POINT_new(curveP))) && 
+				(0 != EC_POINT_set_to_infinity(curveP, running)) && (0 != EC_POINT_set_to_infinity(curveP, windowSums[w]));
+			for (int j = numBuckets - 1; ok && (j >= 0); j--){
+				ok = (0 != EC_POINT_add(curveP, running, running, buckets[j], ctx)) && 
+					(0 != EC_POINT_add(curveP, windowSums[w], windowSums[w], running, ctx));
+			}
+		}
+
+		for (int j = 0; j < numBuckets; j++){
+			EC_POINT_free(buckets[j]);
+		}
+		EC_POINT_free(running);
+		return ok;
+	});
+
+	//result = sum_w 2^(window * w) * windowSums[w], by Horner's rule from the top window.
+	EC_POINT* result = NULL;
+	BN_CTX* ctx = getCTX();
+	success = success && (NULL != (result = newPoint())) && (0 != EC_POINT_copy(result, windowSums[numWindows - 1]));
+	for (int w = numWindows - 2; success && (w >= 0); w--){
+		for (int b = 0; success && (b < window); b++){
+			success = (0 != EC_POINT_dbl(curveP, result, result, ctx));
+		}
+		success = success && (0 != EC_POINT_add(curveP, result, result, windowSums[w], ctx));
+	}
+
+	for (size_t i = 0; i < signedPoints.size(); i++){
+		EC_POINT_free(signedPoints[i]);
+	}
+	for (int w = 0; w < numWindows; w++){
+		EC_POINT_free(windowSums[w]);
+	}
+	if (!success && (result != NULL)){
+		EC_POINT_free(result);
+		result = NULL;
+	}
+	return result;
 }
 	
 /* 
@@ -368,7 +776,7 @@ EC_POINT* DlogEC::simultaneousMultiply(const EC_POINT** pointsArr, const BIGNUM*
  * return					: True if the group is valid; False, otherwise.
  */
 BOOL DlogEC::validate(){
-	return EC_GROUP_check(curveP, ctx);
+	return EC_GROUP_check(curveP, getCTX());
 }
 
 /* 
@@ -379,18 +787,16 @@ BOOL DlogEC::validate(){
 EC_POINT* DlogEC::exponentiateWithPreComputedValues(BIGNUM* exponent){
 	//Prepare a point that will contain the exponentiate result.
 	EC_POINT *result;
-	if(NULL == (result = EC_POINT_new(curveP))) return 0;
+	if(NULL == (result = newPoint())) return 0;
 
 	//If there are no pre computes values, calculate them.
-	if (EC_GROUP_have_precompute_mult(curveP) == 0){
-		if(0 == (EC_GROUP_precompute_mult(curveP, ctx))) {
-			EC_POINT_free(result);
-			return 0;
-		}
+	if (!precomputeGenerator()){
+		EC_POINT_free(result);
+		return 0;
 	}
 
 	//Calculate the exponentiate with the pre computed values.
-	if(0 == (EC_POINT_mul(curveP, result, exponent, NULL, NULL, ctx))){
+	if(0 == (EC_POINT_mul(curveP, result, exponent, NULL, NULL, getCTX()))){
 		EC_POINT_free(result);
 		return 0;
 	}
@@ -398,3 +804,339 @@ EC_POINT* DlogEC::exponentiateWithPreComputedValues(BIGNUM* exponent){
 	return result;
 
 }
+
+/* 
+ * function precomputeGenerator		: Computes the pre computed values of the generator, if they were not computed yet.
+ *									  The lock makes sure that only one thread computes them, and that no thread uses them before they are ready.
+ * return							: True if the values are ready; False, otherwise.
+ */
+bool DlogEC::precomputeGenerator(){
+	lock_guard<mutex> lock(precomputeLock);
+	if (EC_GROUP_have_precompute_mult(curveP) == 0){
+		return 0 != EC_GROUP_precompute_mult(curveP, getCTX());
+	}
+	return true;
+}
+
+/* 
+ * function mulBatch		: Computes results[i] = mul(results[i], exponents[i], i) for each i, using the threads of the pool.
+ * param dlog				: The group, which allocates the results.
+ * param exponents			: The exponents, each one in exponentSize bytes (big endian).
+ * param mul				: Computes one result, using the given BN_CTX of the calling thread.
+ * return					: True on success; False, otherwise. On failure no result is allocated.
+ */
+static bool mulBatch(DlogEC* dlog, const unsigned char* exponents, int exponentSize, EC_POINT** results, int size, 
+					 const function<bool(EC_POINT* result, const BIGNUM* exponent, int i, BN_CTX* ctx)>& mul){
+	for (int i = 0; i < size; i++){
+		results[i] = NULL;
+	}
+
+	bool success = getThreadPool()->parallelFor(size, [&](int first, int last){
+		//Each range uses one BIGNUM for its exponents, and the BN_CTX of the thread that computes it.
+		BIGNUM* exponent = BN_new();
+		if (exponent == NULL) return false;
+		BN_CTX* ctx = dlog->getCTX();
+		bool ok = true;
+		for (int i = first; ok && (i < last); i++){
+			ok = (NULL != BN_bin2bn(exponents + (size_t) i * exponentSize, exponentSize, exponent)) && 
+				(NULL != (results[i] = dlog->newPoint())) && mul(results[i], exponent, i, ctx);
+		}
+		BN_free(exponent);
+		return ok;
+	});
+
+	if (!success){
+		for (int i = 0; i < size; i++){
+			if (results[i] != NULL){
+				EC_POINT_free(results[i]);
+				results[i] = NULL;
+			}
+		}
+	}
+	return success;
+}
+
+/* 
+ * function exponentiateBatch		: Raises each base to the respective exponent.
+ * param bases						: The bases.
+ * param exponents					: The exponents, each one in exponentSize bytes (big endian).
+ * param results					: Array of size points that gets the results.
+ * return							: True on success; False, otherwise.
+ */
+bool DlogEC::exponentiateBatch(const EC_POINT** bases, const unsigned char* exponents, int exponentSize, EC_POINT** results, int size){
+	return mulBatch(this, exponents, exponentSize, results, size, [&](EC_POINT* result, const BIGNUM* exponent, int i, BN_CTX* ctx){
+		return 0 != EC_POINT_mul(curveP, result, NULL, bases[i], exponent, ctx);
+	});
+}
+
+/* 
+ * function fixedBaseExponentiateBatch		: Raises the generator to each of the exponents, using the pre computed values.
+ * param exponents							: The exponents, each one in exponentSize bytes (big endian).
+ * param results							: Array of size points that gets the results.
+ * return									: True on success; False, otherwise.
+ */
+bool DlogEC::fixedBaseExponentiateBatch(const unsigned char* exponents, int exponentSize, EC_POINT** results, int size){
+	if (!precomputeGenerator()){
+		return false;
+	}
+	return mulBatch(this, exponents, exponentSize, results, size, [&](EC_POINT* result, const BIGNUM* exponent, int, BN_CTX* ctx){
+		return 0 != EC_POINT_mul(curveP, result, exponent, NULL, NULL, ctx);
+	});
+}
+
+/* 
+ * function isPrimeField		: Returns true if the curve is over a prime field, and false if it is over a binary field.
+ */
+bool DlogEC::isPrimeField(){
+	return NID_X9_62_prime_field == EC_METHOD_get_field_type(EC_GROUP_method_of(curveP));
+}
+
+/* 
+ * function getEncodingSize		: Returns the size of the encoding of a point of the curve.
+ * param compressed				: Whether the compressed encoding (x and the sign of y) or the uncompressed encoding (x and y) is used.
+ *								  Points over binary fields are always uncompressed, since OpenSSL can decompress them only when it 
+ *								  is built with OPENSSL_EC_BIN_PT_COMP.
+ */
+int DlogEC::getEncodingSize(bool compressed){
+	int fieldSize = (EC_GROUP_get_degree(curveP) + 7) / 8;
+	return (compressed && isPrimeField()) ? 1 + fieldSize : 1 + 2 * fieldSize;
+}
+
+/* 
+ * function encodePoints		: Writes the encodings of the given points one after the other.
+ *								  The point at infinity is encoded as zeros. The other points use the standard encoding (SEC 1).
+ *								  Each range of points is converted to affine coordinates together, so that it takes a single field inversion.
+ * param encoded				: Array of size * getEncodingSize(compressed) bytes that gets the encodings.
+ * return						: True on success; False, otherwise.
+ */
+bool DlogEC::encodePoints(const EC_POINT** points, int size, bool compressed, unsigned char* encoded){
+	//Points over binary fields are always kept in affine coordinates, so only points over prime fields need the conversion.
+	//They are also never compressed (see getEncodingSize).
+	bool makeAffine = isPrimeField();
+	compressed = compressed && makeAffine;
+	size_t encodingSize = getEncodingSize(compressed);
+	point_conversion_form_t form = compressed ? POINT_CONVERSION_COMPRESSED : POINT_CONVERSION_UNCOMPRESSED;
+
+	return getThreadPool()->parallelFor(size, [&](int first, int last){
+		//The given points may be used by other threads, so the conversion is done on copies.
+		int count = last - first;
+		EC_POINT** copies = new EC_POINT*[count];
+		BN_CTX* ctx = getCTX();
+		bool ok = true;
+		int copied = 0;
+		if (makeAffine){
+			for (; ok && (copied < count); copied++){
+				ok = (NULL != (copies[copied] = EC_POINT_dup(points[first + copied], curveP)));
+			}
+			if (!ok){
+				copied--;
+			}
+			ok = ok && (0 != EC_POINTs_make_affine(curveP, count, copies, ctx));
+		}
+
+		for (int i = 0; ok && (i < count); i++){
+			const EC_POINT* point = makeAffine ? copies[i] : points[first + i];
+			unsigned char* out = encoded + (first + i) * encodingSize;
+			if (EC_POINT_is_at_infinity(curveP, point)){
+				memset(out, 0, encodingSize);
+			} else {
+				ok = (encodingSize == EC_POINT_point2oct(curveP, point, form, out, encodingSize, ctx));
+			}
+		}
+
+		for (int i = 0; i < copied; i++){
+			EC_POINT_free(copies[i]);
+		}
+		delete[] copies;
+		return ok;
+	});
+}
+
+/* 
+ * function decodePoints		: Decodes the points that encodePoints encoded, and checks that each one of them is on the curve.
+ * param encodingSize			: The size of each encoding.
+ * param points					: Array of size points that gets the decoded points.
+ * return						: True if all the points are valid; False, otherwise. On failure no point is allocated.
+ */
+bool DlogEC::decodePoints(const unsigned char* encoded, int encodingSize, EC_POINT** points, int size){
+	for (int i = 0; i < size; i++){
+		points[i] = NULL;
+	}
+
+	bool success = getThreadPool()->parallelFor(size, [&](int first, int last){
+		BN_CTX* ctx = getCTX();
+		bool ok = true;
+		for (int i = first; ok && (i < last); i++){
+			const unsigned char* in = encoded + (size_t) i * encodingSize;
+			ok = (NULL != (points[i] = newPoint()));
+			if (ok && (in[0] == 0)){
+				//The point at infinity. All of its encoding should be zeros.
+				for (int j = 1; ok && (j < encodingSize); j++){
+					ok = (in[j] == 0);
+				}
+				ok = ok && (0 != EC_POINT_set_to_infinity(curveP, points[i]));
+			} else if (ok){
+				ok = (0 != EC_POINT_oct2point(curveP, points[i], in, encodingSize, ctx)) && 
+					(1 == EC_POINT_is_on_curve(curveP, points[i], ctx));
+			}
+		}
+		return ok;
+	});
+
+	if (!success){
+		for (int i = 0; i < size; i++){
+			if (points[i] != NULL){
+				EC_POINT_free(points[i]);
+				points[i] = NULL;
+			}
+		}
+	}
+	return success;
+}
+
+/* 
+ * function ECFixedBaseTable	: Precomputes the multiples of the given base.
+ * param dlog					: The group of the base.
+ * param base					: The fixed base.
+ * param window					: The requested window, or 0 (or less) for the largest window.
+ * param maxBytes				: The memory budget of the table. The window is reduced until the table fits in it.
+ */
+ECFixedBaseTable::ECFixedBaseTable(DlogEC* dlog, const EC_POINT* base, int window, long long maxBytes){
+	EC_GROUP* curve = dlog->getCurve();
+	BN_CTX* ctx = dlog->getCTX();
+	multiples = NULL;
+
+	//The points of the group have order q, so the exponents can always be reduced to the size of q.
+	//One more window holds the carry of the signed digits.
+	BIGNUM* order = BN_new();
+	int bits = (0 != EC_GROUP_get_order(curve, order, ctx)) ? BN_num_bits(order) : 0;
+	BN_free(order);
+	if (bits == 0){
+		return;
+	}
+
+	long long pointBytes = EC_POINT_OVERHEAD + 3 * ((EC_GROUP_get_degree(curve) + 7) / 8);
+	if ((window <= 0) || (window > EC_FIXED_BASE_MAX_WINDOW)){
+		window = EC_FIXED_BASE_MAX_WINDOW;
+	}
+	while ((window > 1) && (((bits + window - 1) / window + 1) * (1LL << (window - 1)) * pointBytes > maxBytes)){
+		window--;
+	}
+	this->window = window;
+	numWindows = (bits + window - 1) / window + 1;
+
+	int digits = 1 << (window - 1);
+	int size = numWindows * digits;
+	multiples = new EC_POINT*[size];
+	for (int i = 0; i < size; i++){
+		multiples[i] = EC_POINT_new(curve);
+	}
+
+	//windowBase = 2^(window * i) * base.
+	EC_POINT* windowBase = EC_POINT_dup(base, curve);
+	bool success = (windowBase != NULL);
+	for (int i = 0; success && (i < numWindows); i++){
+		EC_POINT** row = multiples + i * digits;
+		success = (0 != EC_POINT_copy(row[0], windowBase));
+		for (int j = 1; success && (j < digits); j++){
+			success = (0 != EC_POINT_add(curve, row[j], row[j - 1], windowBase, ctx));
+		}
+		//2^(window * (i+1)) * base = 2 * (2^(window-1) * 2^(window * i) * base).
+		success = success && (0 != EC_POINT_dbl(curve, windowBase, row[digits - 1], ctx));
+	}
+	EC_POINT_free(windowBase);
+
+	//The additions of exponentiate are cheaper when the points of the table are affine. If this fails the table is still correct.
+	if (success){
+		EC_POINTs_make_affine(curve, size, multiples, ctx);
+	} else {
+		for (int i = 0; i < size; i++){
+			EC_POINT_free(multiples[i]);
+		}
+		delete[] multiples;
+		multiples = NULL;
+	}
+}
+
+/* 
+ * function ~ECFixedBaseTable	: Deletes the precomputed multiples.
+ */
+ECFixedBaseTable::~ECFixedBaseTable(){
+	if (multiples != NULL){
+		for (int i = 0; i < numWindows * (1 << (window - 1)); i++){
+			EC_POINT_free(multiples[i]);
+		}
+		delete[] multiples;
+	}
+}
+
+/* 
+ * function exponentiate		: Computes result = base ^ exponent, by adding the multiple of each signed digit of the exponent.
+ * param dlog					: The group of the base.
+ * return						: True on success; False, otherwise.
+ */
+bool ECFixedBaseTable::exponentiate(DlogEC* dlog, EC_POINT* result, const BIGNUM* exponent){
+	if (multiples == NULL){
+		return false;
+	}
+
+	EC_GROUP* curve = dlog->getCurve();
+	BN_CTX* ctx = dlog->getCTX();
+	int digits = 1 << (window - 1);
+
+	//Exponents that are longer than the table are reduced modulo q.
+	BIGNUM* reduced = NULL;
+	if (BN_num_bits(exponent) > (numWindows - 1) * window){
+		reduced = BN_new();
+		BIGNUM* order = BN_new();
+		bool ok = (NULL != reduced) && (NULL != order) && (0 != EC_GROUP_get_order(curve, order, ctx)) && 
+			(0 != BN_nnmod(reduced, exponent, order, ctx));
+		BN_free(order);
+		if (!ok){
+			BN_free(reduced);
+			return false;
+		}
+		exponent = reduced;
+	}
+
+	//Each window of the exponent is a digit in [0, 2^window). Digits above 2^(window-1) are replaced by digit - 2^window, 
+	//and a carry to the next window, so that only the positive multiples are kept in the table.
+	EC_POINT* negative = EC_POINT_new(curve);
+	bool success = (NULL != negative) && (0 != EC_POINT_set_to_infinity(curve, result));
+	int carry = 0;
+	for (int i = 0; success && (i < numWindows); i++){
+		int digit = carry;
+		for (int b = window - 1; b >= 0; b--){
+			digit += BN_is_bit_set(exponent, i * window + b) << b;
+		}
+		carry = (digit > digits) ? 1 : 0;
+		digit -= carry << window;
+
+		if (digit > 0){
+			success = (0 != EC_POINT_add(curve, result, result, multiples[i * digits + digit - 1], ctx));
+		} else if (digit < 0){
+			success = (0 != EC_POINT_copy(negative, multiples[i * digits - digit - 1])) && 
+				(0 != EC_POINT_invert(curve, negative, ctx)) && 
+				(0 != EC_POINT_add(curve, result, result, negative, ctx));
+		}
+	}
+
+	EC_POINT_free(negative);
+	if (reduced != NULL){
+		BN_free(reduced);
+	}
+	return success;
+}
+
+/* 
+ * function exponentiateBatch	: Raises the base to each of the exponents.
+ * param dlog					: The group of the base.
+ * param exponents				: The exponents, each one in exponentSize bytes (big endian).
+ * param results				: Array of size points that gets the results.
+ * return						: True on success; False, otherwise.
+ */
+bool ECFixedBaseTable::exponentiateBatch(DlogEC* dlog, const unsigned char* exponents, int exponentSize, EC_POINT** results, int size){
+	return mulBatch(dlog, exponents, exponentSize, results, size, [&](EC_POINT* result, const BIGNUM* exponent, int, BN_CTX*){
+		return exponentiate(dlog, result, exponent);
+	});
+}
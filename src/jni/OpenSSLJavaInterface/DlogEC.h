@@ -26,6 +26,8 @@
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
 #include <openssl/ec.h>
+#include <mutex>
+#include "ElementPool.h"
 /* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogECAbs */
 
 #ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
@@ -73,13 +75,21 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapte
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_checkCurveMembership
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    checkMembership
+ * Signature: (J[J)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_checkMembership
+  (JNIEnv *, jobject, jlong, jlongArray);
+
 /*
  * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
  * Method:    simultaneousMultiply
- * Signature: (J[J[[B)J
+ * Signature: (J[J[BI)J
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_simultaneousMultiply
-  (JNIEnv *, jobject, jlong, jlongArray, jobjectArray);
+  (JNIEnv *, jobject, jlong, jlongArray, jbyteArray, jint);
 
 /*
  * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
@@ -97,6 +107,70 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAda
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateWithPreComputedValues
   (JNIEnv *, jobject, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    createFixedBaseTable
+ * Signature: (JJIJ)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_createFixedBaseTable
+  (JNIEnv *, jobject, jlong, jlong, jint, jlong);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    exponentiateWithTable
+ * Signature: (JJ[B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateWithTable
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    deleteFixedBaseTable
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_deleteFixedBaseTable
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    exponentiateBatch
+ * Signature: (J[J[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_exponentiateBatch
+  (JNIEnv *, jobject, jlong, jlongArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    fixedBaseExponentiateBatch
+ * Signature: (JJ[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_fixedBaseExponentiateBatch
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    encodePoints
+ * Signature: (J[JZ)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_encodePoints
+  (JNIEnv *, jobject, jlong, jlongArray, jboolean);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    decodePoints
+ * Signature: (J[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_decodePoints
+  (JNIEnv *, jobject, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
+ * Method:    releasePoints
+ * Signature: (J[J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC_releasePoints
+  (JNIEnv *, jobject, jlong, jlongArray);
+
 /*
  * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapterDlogEC
  * Method:    deleteDlog
@@ -108,11 +182,23 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLAdapter
 #ifdef __cplusplus
 }
 
+//The number of bases above which simultaneousMultiply uses the bucket method instead of EC_POINTs_mul.
+#define BUCKET_MULTIPLY_THRESHOLD 128
+//The largest window of the bucket method.
+#define BUCKET_MAX_WINDOW 16
+
 class DlogEC {
 private:
 
 	EC_GROUP* curveP;
-	BN_CTX* ctx;
+	BN_CTX* ctx;				//Used only to build the group. The operations use the BN_CTX of the calling thread.
+	std::mutex precomputeLock;	//Guards the lazy computation of the generator's precomputed values.
+	ElementPool<EC_POINT> pointPool;	//Points that were released by the java side, for reuse.
+
+	bool precomputeGenerator();
+	bool hasGenericArithmetic();
+	bool isPrimeField();
+	EC_POINT* bucketMultiply(const EC_POINT** points, const unsigned char* exponents, int exponentSize, int size);
 public:
 
 	DlogEC(EC_GROUP* curveP, BN_CTX* ctx);
@@ -120,15 +206,48 @@ public:
 
 	EC_GROUP* getCurve();
 	BN_CTX* getCTX();
+	EC_POINT* newPoint();
+	void releasePoints(EC_POINT** points, int size);
 
 	EC_POINT* createInfinityPoint();
 	EC_POINT* inversePoint(EC_POINT*);
 	EC_POINT* exponentiate(EC_POINT* base, BIGNUM* exponent);
 	EC_POINT* multiply(EC_POINT* point1, EC_POINT* point2);
 	BOOL checkCurveMembership(EC_POINT* point);
-	EC_POINT* simultaneousMultiply(const EC_POINT** pointsArr, const BIGNUM** exponentsArr, int size);
+	void checkMembership(const EC_POINT** points, bool* results, int size);
+	EC_POINT* simultaneousMultiply(const EC_POINT** points, const unsigned char* exponents, int exponentSize, int size);
 	BOOL validate();
 	EC_POINT* exponentiateWithPreComputedValues(BIGNUM* exponent);
+	bool exponentiateBatch(const EC_POINT** bases, const unsigned char* exponents, int exponentSize, EC_POINT** results, int size);
+	bool fixedBaseExponentiateBatch(const unsigned char* exponents, int exponentSize, EC_POINT** results, int size);
+	int getEncodingSize(bool compressed);
+	bool encodePoints(const EC_POINT** points, int size, bool compressed, unsigned char* encoded);
+	bool decodePoints(const unsigned char* encoded, int encodingSize, EC_POINT** points, int size);
+};
+
+//The largest window of the fixed base tables.
+#define EC_FIXED_BASE_MAX_WINDOW 12
+//Approximate memory of an EC_POINT besides its coordinates (the structs and the allocations), used to keep the tables in their budget.
+#define EC_POINT_OVERHEAD 128
+
+/*
+ * Precomputed multiples of a fixed base point, j * 2^(window * i) * base for every window i of the exponent and every digit 1 <= j <= 2^(window-1).
+ * The exponent is recoded to signed digits, so an exponentiation takes one addition for each window of the exponent and no doublings.
+ * The table is only read after it is built, so several threads can use it at the same time.
+ */
+class ECFixedBaseTable {
+private:
+
+	int window;
+	int numWindows;
+	EC_POINT** multiples;	//Affine when possible. multiples[i * 2^(window-1) + j - 1] = j * 2^(window * i) * base.
+public:
+
+	ECFixedBaseTable(DlogEC* dlog, const EC_POINT* base, int window, long long maxBytes);
+	~ECFixedBaseTable();
+
+	bool exponentiate(DlogEC* dlog, EC_POINT* result, const BIGNUM* exponent);
+	bool exponentiateBatch(DlogEC* dlog, const unsigned char* exponents, int exponentSize, EC_POINT** results, int size);
 };
 
 
@@ -27,10 +27,13 @@
 #include <jni.h>
 #include "DlogFp.h"
 #include "DlogEC.h"
+#include "../Common/ThreadPool.h"
 #include <openssl/ec.h>
 #include <openssl/rand.h>
+#include <openssl/obj_mac.h>
 #include <cstring>	// For memcpy
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
@@ -100,6 +103,96 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogEC
 	  return (long) dlog;
 }
 
+/* 
+ * function toBignum		: Converts the given java bytes (big endian) to a new BIGNUM. Returns NULL on failure.
+ */
+static BIGNUM* toBignum(JNIEnv *env, jbyteArray bytes){
+	jbyte* bytesArr = env->GetByteArrayElements(bytes, 0);
+	BIGNUM* result = BN_bin2bn((unsigned char*) bytesArr, env->GetArrayLength(bytes), NULL);
+	env->ReleaseByteArrayElements(bytes, bytesArr, JNI_ABORT);
+	return result;
+}
+
+/* 
+ * function hasParams		: Checks if the given curve has the given parameters.
+ * param params				: p, a, b, the coordinates of the generator and the order, in this order.
+ * return					: True if all the parameters are equal; False, otherwise.
+ */
+static bool hasParams(EC_GROUP* curve, BIGNUM** params, BN_CTX* ctx){
+	BIGNUM* curveParams[6];
+	for (int i = 0; i < 6; i++){
+		curveParams[i] = BN_new();
+	}
+
+	bool equal = (0 != EC_GROUP_get_curve_GFp(curve, curveParams[0], curveParams[1], curveParams[2], ctx)) && 
+		(NULL != EC_GROUP_get0_generator(curve)) && 
+		(0 != EC_POINT_get_affine_coordinates_GFp(curve, EC_GROUP_get0_generator(curve), curveParams[3], curveParams[4], ctx)) && 
+		(0 != EC_GROUP_get_order(curve, curveParams[5], ctx));
+	for (int i = 0; equal && (i < 6); i++){
+		equal = (0 == BN_cmp(curveParams[i], params[i]));
+	}
+
+	for (int i = 0; i < 6; i++){
+		BN_free(curveParams[i]);
+	}
+	return equal;
+}
+
+/* 
+ * function createNamedCurve	: Creates the named curve of OpenSSL that has the given parameters, if there is one.
+ *								  OpenSSL has optimized implementations for some of its named curves (for example P-224, P-256 and P-521 on 64 bit 
+ *								  platforms), which are only used by curves that are created by name and not by their parameters.
+ * param pBytes					: Bytes of the group's modulus.
+ * param aBytes					: The parameter a of the curve equation, y^2 = x^3 + a*x + b (mod p).
+ * param bBytes					: The parameter b of the curve equation.
+ * param xBytes, yBytes			: The coordinates of the generator.
+ * param qBytes					: Bytes of the group's order.
+ * return						: Pointer to the created curve, already initialized with its generator and order, or 0 if OpenSSL has no such named curve.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createNamedCurve
+  (JNIEnv *env, jobject, jbyteArray pBytes, jbyteArray aBytes, jbyteArray bBytes, jbyteArray xBytes, jbyteArray yBytes, jbyteArray qBytes){
+
+	  BIGNUM* params[6] = {toBignum(env, pBytes), toBignum(env, aBytes), toBignum(env, bBytes), 
+						   toBignum(env, xBytes), toBignum(env, yBytes), toBignum(env, qBytes)};
+	  BN_CTX* ctx = BN_CTX_new();
+	  bool valid = (ctx != NULL);
+	  for (int i = 0; i < 6; i++){
+		  valid = valid && (params[i] != NULL);
+	  }
+
+	  //Go over the named curves with the same field size, and look for the one with the same parameters.
+	  EC_GROUP* curve = NULL;
+	  size_t numCurves = EC_get_builtin_curves(NULL, 0);
+	  EC_builtin_curve* curves = new EC_builtin_curve[numCurves];
+	  EC_get_builtin_curves(curves, numCurves);
+	  for (size_t i = 0; valid && (curve == NULL) && (i < numCurves); i++){
+		  EC_GROUP* named = EC_GROUP_new_by_curve_name(curves[i].nid);
+		  if (named == NULL){
+			  continue;
+		  }
+		  if ((EC_METHOD_get_field_type(EC_GROUP_method_of(named)) == NID_X9_62_prime_field) && 
+			  (EC_GROUP_get_degree(named) == BN_num_bits(params[0])) && hasParams(named, params, ctx)){
+			  curve = named;
+		  } else {
+			  EC_GROUP_free(named);
+		  }
+	  }
+	  delete[] curves;
+
+	  for (int i = 0; i < 6; i++){
+		  BN_free(params[i]);
+	  }
+
+	  if (curve == NULL){
+		  BN_CTX_free(ctx);
+		  return 0;
+	  }
+
+	  //Create Dlog group with the curve and ctx.
+	  DlogEC* dlog = new DlogEC(curve, ctx);
+	  return (long) dlog;
+}
+
 /* 
  * function initCurve		: Initialize the Fp curve with generator and order.
  * param dlog				: Pointer to the native Dlog object.
@@ -133,119 +226,466 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF
 }
 
 /* 
- * function encodeByteArrayToPoint		: Encodes the given byte array into a point. 
- *										  If the given byte array can not be encoded to a point, returns 0.
- * param dlog							: Pointer to the native Dlog object.
- * param binaryString					: The byte array to encode.
- * param k								: k is the maximum length of a string to be converted to a Group Element of this group. 
- *										  If a string exceeds the k length it cannot be converted.
- * return								: The created point or 0 if the point cannot be created.
+ * function SswuMap		: Prepares the simplified SWU map of the given curve. 
+ *						  Z is chosen like in RFC 9380 (appendix H.2), so the map is the map_to_curve_simple_swu of the RFC.
+ * param curve			: The curve, y^2 = x^3 + a*x + b (mod p).
  */
-JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArrayToPoint
-  (JNIEnv *env, jobject, jlong dlog, jbyteArray binaryString, jint k){
-	 //Pseudo-code:
-		/*If the length of binaryString exceeds k then throw IndexOutOfBoundsException.
-
-          Let L be the length in bytes of p
+SswuMap::SswuMap(EC_GROUP* curve, BN_CTX* ctx){
+	p = BN_new();
+	a = BN_new();
+	b = BN_new();
+	z = BN_new();
+	minusBOverA = BN_new();
+	bOverZA = BN_new();
+	aOverB = BN_new();
+	BIGNUM* inverse = BN_new();
+	BIGNUM* gx = BN_new();
+
+	valid = (NULL != gx) && (0 != EC_GROUP_get_curve_GFp(curve, p, a, b, ctx)) && !BN_is_zero(a) && !BN_is_zero(b) && 
+		(NULL != BN_mod_inverse(inverse, a, p, ctx)) && BN_mod_mul(minusBOverA, b, inverse, p, ctx) && BN_mod_sub(minusBOverA, p, minusBOverA, p, ctx) && 
+		(NULL != BN_mod_inverse(inverse, b, p, ctx)) && BN_mod_mul(aOverB, a, inverse, p, ctx);
+
+	//Look for Z in the order 1, -1, 2, -2, ... such that: Z is not a square, Z != -1, x^3 + a*x + b - Z has no root (so it is irreducible),
+	//and g(b / (Z * a)) is a square, where g(x) = x^3 + a*x + b.
+	bool found = false;
+	for (int i = 1; valid && !found && (i < 1000); i++){
+		BN_set_word(z, (i + 1) / 2);
+		if (i % 2 == 0){
+			BN_sub(z, p, z);
+		}
+		if ((i == 2) || (BN_kronecker(z, p, ctx) != -1) || !hasNoRoot(z, ctx)){
+			continue;
+		}
+		//bOverZA = b / (Z * a) = -(-b/a) / Z.
+		valid = (NULL != BN_mod_inverse(inverse, z, p, ctx)) && BN_mod_mul(bOverZA, minusBOverA, inverse, p, ctx) && 
+			BN_mod_sub(bOverZA, p, bOverZA, p, ctx) && curveFunction(gx, bOverZA, ctx);
+		found = valid && (BN_kronecker(gx, p, ctx) == 1);
+	}
+	valid = valid && found;
 
-          Choose a random byte array r of length L  k  2 bytes 
+	BN_free(inverse);
+	BN_free(gx);
+}
 
-          Prepare a string newString of the following form: r || binaryString || binaryString.length (where || denotes concatenation) (i.e., the least significant byte of newString is the length of binaryString in bytes)
+SswuMap::~SswuMap(){
+	BN_free(p);
+	BN_free(a);
+	BN_free(b);
+	BN_free(z);
+	BN_free(minusBOverA);
+	BN_free(bOverZA);
+	BN_free(aOverB);
+}
 
-          Convert the result to a BigInteger (bIString)
+/* 
+ * function isValid		: Returns true if the map was prepared; False if the curve has no simplified SWU map (when a = 0 or b = 0).
+ */
+bool SswuMap::isValid(){
+	return valid;
+}
 
-          Compute the elliptic curve equation for this x and see if there exists a y such that (x,y) satisfies the equation.
+/* 
+ * function curveFunction		: Computes gx = x^3 + a*x + b (mod p).
+ */
+bool SswuMap::curveFunction(BIGNUM* gx, const BIGNUM* x, BN_CTX* ctx){
+	BN_CTX_start(ctx);
+	BIGNUM* t = BN_CTX_get(ctx);
+	bool ok = (NULL != t) && BN_mod_sqr(t, x, p, ctx) && BN_mod_add(t, t, a, p, ctx) && BN_mod_mul(t, t, x, p, ctx) && BN_mod_add(gx, t, b, p, ctx);
+	BN_CTX_end(ctx);
+	return ok;
+}
 
-          If yes, return (x,y)
+/* 
+ * function hasNoRoot		: Checks that the cubic polynomial f(x) = x^3 + a*x + b - c has no root in the field.
+ *							  f has no root if and only if its discriminant is a nonzero square (so it has 0 or 3 roots) and x^p != x (mod f), 
+ *							  since x^p = x (mod f) when f has 3 roots.
+ */
+bool SswuMap::hasNoRoot(const BIGNUM* c, BN_CTX* ctx){
+	BN_CTX_start(ctx);
+	BIGNUM* c0 = BN_CTX_get(ctx);
+	BIGNUM* t = BN_CTX_get(ctx);
+	BIGNUM* disc = BN_CTX_get(ctx);
+	BIGNUM* d[5];
+	BIGNUM* r[3];
+	BIGNUM* x[3];
+	for (int i = 0; i < 5; i++) d[i] = BN_CTX_get(ctx);
+	for (int i = 0; i < 3; i++) r[i] = BN_CTX_get(ctx);
+	for (int i = 0; i < 3; i++) x[i] = BN_CTX_get(ctx);
+	
+	//c0 = b - c, the constant coefficient of f. The discriminant is -4a^3 - 27c0^2.
+	bool ok = (NULL != x[2]) && BN_mod_sub(c0, b, c, p, ctx) && 
+		BN_mod_sqr(t, a, p, ctx) && BN_mod_mul(t, t, a, p, ctx) && BN_mul_word(t, 4) && 
+		BN_mod_sqr(disc, c0, p, ctx) && BN_mul_word(disc, 27) && BN_add(disc, disc, t) && BN_nnmod(disc, disc, p, ctx) && 
+		BN_mod_sub(disc, p, disc, p, ctx);
+	if (!ok || (BN_kronecker(disc, p, ctx) != 1)){
+		BN_CTX_end(ctx);
+		return false;
+	}
 
-          Else, go back to step 3 (choose a random r etc.) up to 80 times (This is an arbitrary hard-coded number).
+	//Compute x^p mod f by square and multiply. The polynomials are r[0] + r[1]*x + r[2]*x^2.
+	BN_one(r[0]);
+	BN_zero(r[1]);
+	BN_zero(r[2]);
+	for (int bit = BN_num_bits(p) - 1; ok && (bit >= 0); bit--){
+		//d = r^2, of degree 4.
+		ok = BN_mod_sqr(d[0], r[0], p, ctx) && BN_mod_mul(d[1], r[0], r[1], p, ctx) && BN_mod_add(d[1], d[1], d[1], p, ctx) && 
+			BN_mod_mul(d[2], r[0], r[2], p, ctx) && BN_mod_add(d[2], d[2], d[2], p, ctx) && BN_mod_sqr(t, r[1], p, ctx) && BN_mod_add(d[2], d[2], t, p, ctx) && 
+			BN_mod_mul(d[3], r[1], r[2], p, ctx) && BN_mod_add(d[3], d[3], d[3], p, ctx) && BN_mod_sqr(d[4], r[2], p, ctx);
+		
+		//Reduce with x^3 = -a*x - c0 and x^4 = -a*x^2 - c0*x.
+		ok = ok && BN_mod_mul(t, a, d[4], p, ctx) && BN_mod_sub(r[2], d[2], t, p, ctx) && 
+			BN_mod_mul(t, c0, d[4], p, ctx) && BN_mod_sub(r[1], d[1], t, p, ctx) && BN_mod_mul(t, a, d[3], p, ctx) && BN_mod_sub(r[1], r[1], t, p, ctx) && 
+			BN_mod_mul(t, c0, d[3], p, ctx) && BN_mod_sub(r[0], d[0], t, p, ctx);
+
+		//Multiply by x if the bit is set: (r0 + r1*x + r2*x^2) * x = -c0*r2 + (r0 - a*r2)*x + r1*x^2.
+		if (ok && BN_is_bit_set(p, bit)){
+			ok = BN_mod_mul(d[0], c0, r[2], p, ctx) && BN_mod_sub(d[0], p, d[0], p, ctx) && 
+				BN_mod_mul(t, a, r[2], p, ctx) && BN_mod_sub(d[1], r[0], t, p, ctx) && (NULL != BN_copy(r[2], r[1])) && 
+				(NULL != BN_copy(r[1], d[1])) && (NULL != BN_copy(r[0], d[0]));
+		}
+	}
+	bool result = ok && !(BN_is_zero(r[0]) && BN_is_one(r[1]) && BN_is_zero(r[2]));
+	BN_CTX_end(ctx);
+	return result;
+}
 
-          If did not find y such that (x,y) satisfies the equation after 80 trials then return null.
-		 */
+/* 
+ * function map			: Computes the point of the given field element u, by map_to_curve_simple_swu of RFC 9380:
+ *						  tv1 = Z^2*u^4 + Z*u^2, x1 = (-b/a) * (1 + 1/tv1) (or b/(Z*a) if tv1 = 0), x2 = Z*u^2*x1.
+ *						  If g(x1) is a square the point is (x1, sqrt(g(x1))), and otherwise (x2, sqrt(g(x2))), with the parity of y as the parity of u.
+ *						  Every u is mapped to a point, so the map takes the same operations for every input.
+ * param point			: The point that gets the result.
+ * param u				: The field element, 0 <= u < p.
+ * return				: True on success; False, otherwise.
+ */
+bool SswuMap::map(EC_GROUP* curve, EC_POINT* point, const BIGNUM* u, BN_CTX* ctx){
+	BN_CTX_start(ctx);
+	BIGNUM* zu2 = BN_CTX_get(ctx);
+	BIGNUM* tv1 = BN_CTX_get(ctx);
+	BIGNUM* x1 = BN_CTX_get(ctx);
+	BIGNUM* gx1 = BN_CTX_get(ctx);
+	BIGNUM* x2 = BN_CTX_get(ctx);
+	BIGNUM* gx2 = BN_CTX_get(ctx);
+	BIGNUM* y = BN_CTX_get(ctx);
+
+	bool ok = (NULL != y) && BN_mod_sqr(zu2, u, p, ctx) && BN_mod_mul(zu2, zu2, z, p, ctx) && 
+		BN_mod_sqr(tv1, zu2, p, ctx) && BN_mod_add(tv1, tv1, zu2, p, ctx);
+	if (ok && BN_is_zero(tv1)){
+		ok = (NULL != BN_copy(x1, bOverZA));
+	} else if (ok){
+		ok = (NULL != BN_mod_inverse(tv1, tv1, p, ctx)) && BN_add_word(tv1, 1) && BN_mod_mul(x1, minusBOverA, tv1, p, ctx);
+	}
+	ok = ok && curveFunction(gx1, x1, ctx) && BN_mod_mul(x2, zu2, x1, p, ctx) && curveFunction(gx2, x2, ctx);
+
+	//One of g(x1) and g(x2) is a square, since g(x2) = Z^3 * u^6 * g(x1) and Z is not a square.
+	bool firstIsSquare = ok && (BN_kronecker(gx1, p, ctx) >= 0);
+	const BIGNUM* x = firstIsSquare ? x1 : x2;
+	ok = ok && (NULL != BN_mod_sqrt(y, firstIsSquare ? gx1 : gx2, p, ctx));
+	if (ok && !BN_is_zero(y) && (BN_is_odd(y) != BN_is_odd(u))){
+		ok = BN_sub(y, p, y);
+	}
+	ok = ok && (1 == EC_POINT_set_affine_coordinates_GFp(curve, point, x, y, ctx));
 
-	jbyte* string  = (jbyte*) env->GetByteArrayElements(binaryString, 0);
-	int len = env->GetArrayLength(binaryString);
+	BN_CTX_end(ctx);
+	return ok;
+}
 
-	EC_GROUP* curve = ((DlogEC*) dlog)->getCurve();
+/* 
+ * function invert		: Finds the field elements that map computes the given point from.
+ *						  Let t = Z*u^2 and k = a*x/b. If x = x1 then 1/(t^2 + t) = -k - 1, and if x = x2 then t^2 + (1 + k)*t + (1 + k) = 0.
+ *						  Each of the quadratic equations has up to two solutions t, and u = +-sqrt(t/Z) with the parity of y. 
+ *						  Every candidate is checked by computing map on it.
+ * param point			: The point.
+ * param preimages		: Array of SSWU_MAX_PREIMAGES elements that gets the new preimages. The caller should free them.
+ * return				: The number of preimages.
+ */
+int SswuMap::invert(EC_GROUP* curve, const EC_POINT* point, BIGNUM** preimages, BN_CTX* ctx){
+	int numPreimages = 0;
+	BN_CTX_start(ctx);
+	BIGNUM* x = BN_CTX_get(ctx);
+	BIGNUM* y = BN_CTX_get(ctx);
+	BIGNUM* k = BN_CTX_get(ctx);
+	BIGNUM* coefficient = BN_CTX_get(ctx);
+	BIGNUM* constant = BN_CTX_get(ctx);
+	BIGNUM* disc = BN_CTX_get(ctx);
+	BIGNUM* root = BN_CTX_get(ctx);
+	BIGNUM* t = BN_CTX_get(ctx);
+	BIGNUM* zInverse = BN_CTX_get(ctx);
+	BIGNUM* half = BN_CTX_get(ctx);
+	EC_POINT* candidatePoint = EC_POINT_new(curve);
+
+	bool ok = (NULL != half) && (NULL != candidatePoint) && !EC_POINT_is_at_infinity(curve, point) && 
+		(0 != EC_POINT_get_affine_coordinates_GFp(curve, point, x, y, ctx)) && BN_mod_mul(k, aOverB, x, p, ctx) && 
+		(NULL != BN_mod_inverse(zInverse, z, p, ctx)) && (NULL != BN_copy(half, p)) && BN_add_word(half, 1) && BN_rshift1(half, half);
+
+	//The preimage u = 0 of the exceptional case, which the equations do not find.
+	BIGNUM* candidates[SSWU_MAX_PREIMAGES];
+	int numCandidates = 0;
+	if (ok){
+		candidates[numCandidates] = BN_new();
+		BN_zero(candidates[numCandidates++]);
+	}
 
-	if (len > k){
-		env ->ReleaseByteArrayElements(binaryString, string, 0);
-		return 0;
+	for (int branch = 0; ok && (branch < 2); branch++){
+		//The equation t^2 + coefficient*t + constant = 0.
+		if (branch == 0){
+			//t^2 + t - 1/(-k - 1) = 0.
+			BN_one(coefficient);
+			ok = (NULL != BN_copy(constant, k)) && BN_add_word(constant, 1) && BN_nnmod(constant, constant, p, ctx);
+			if (ok && BN_is_zero(constant)){
+				continue;
+			}
+			ok = (NULL != BN_mod_inverse(constant, constant, p, ctx));
+		} else {
+			ok = (NULL != BN_copy(coefficient, k)) && BN_add_word(coefficient, 1) && BN_nnmod(coefficient, coefficient, p, ctx) && 
+				(NULL != BN_copy(constant, coefficient));
+		}
+
+		//disc = coefficient^2 - 4*constant, t = (-coefficient +- sqrt(disc)) / 2. The loop below keeps t/Z = u^2 in t.
+		ok = ok && BN_mod_sqr(disc, coefficient, p, ctx) && BN_mod_lshift(t, constant, 2, p, ctx) && BN_mod_sub(disc, disc, t, p, ctx);
+		if (!ok || (BN_kronecker(disc, p, ctx) < 0)){
+			continue;
+		}
+		ok = (NULL != BN_mod_sqrt(root, disc, p, ctx));
+		for (int sign = 0; ok && (sign < 2); sign++){
+			ok = (sign == 0 ? BN_mod_sub(t, root, coefficient, p, ctx) : BN_mod_sub(t, p, root, p, ctx) && BN_mod_sub(t, t, coefficient, p, ctx)) && 
+				BN_mod_mul(t, t, half, p, ctx) && BN_mod_mul(t, t, zInverse, p, ctx);
+			if (!ok || BN_is_zero(t) || (BN_kronecker(t, p, ctx) != 1)){
+				continue;
+			}
+			BIGNUM* u = BN_new();
+			ok = (NULL != u) && (NULL != BN_mod_sqrt(u, t, p, ctx));
+			if (ok && (BN_is_odd(u) != BN_is_odd(y))){
+				ok = BN_sub(u, p, u);
+			}
+			candidates[numCandidates++] = u;
+		}
 	}
-	
-	BIGNUM *x, *y, *p, *a, *b;
-	x = BN_new();
-	y = BN_new();
-	a = BN_new();
-	b = BN_new();
-	p = BN_new();
-	if (0 == (EC_GROUP_get_curve_GFp(curve, p, a, b, ((DlogEC*) dlog)->getCTX()))){
-		env ->ReleaseByteArrayElements(binaryString, string, 0);
-		BN_free(a);
-		BN_free(b);
-		BN_free(p);
-		BN_free(x);
-		BN_free(y);
+
+	//Keep the candidates that are mapped to the point, without duplicates.
+	for (int i = 0; i < numCandidates; i++){
+		bool preimage = ok && (candidates[i] != NULL) && map(curve, candidatePoint, candidates[i], ctx) && 
+			(0 == EC_POINT_cmp(curve, candidatePoint, point, ctx));
+		for (int j = 0; preimage && (j < numPreimages); j++){
+			preimage = (0 != BN_cmp(preimages[j], candidates[i]));
+		}
+		if (preimage){
+			preimages[numPreimages++] = candidates[i];
+		} else {
+			BN_free(candidates[i]);
+		}
 	}
 
-	BN_free(a);
-	BN_free(b);
-	int l = BN_num_bytes(p);
+	EC_POINT_free(candidatePoint);
+	BN_CTX_end(ctx);
+	return numPreimages;
+}
 
-	jbyte* randomArray = new jbyte[l-k-2];
-		
-	jbyte* newString = new jbyte[l - k - 1 + len];
-	memcpy(newString+l-k-2, string, len);
-	newString[l - k - 2 + len] = (char) len;
-
-	//Create an inverse point and copy the given point to it.
-	EC_POINT *point;
-	if(NULL == (point = EC_POINT_new(curve))){
-		env ->ReleaseByteArrayElements(binaryString, string, 0);
+/* 
+ * function encodeWithRandomPadding		: Encodes the given byte array into a point, by the random padding that was used by SCAPI since its first 
+ *										  version (and that the other libraries use too).
+ *										  The x coordinate is r || binaryString || binaryString.length, where r is a random string of 
+ *										  l - k - 2 bytes (l is the length in bytes of p). If there is no point with this x, r is chosen again, up to 80 times.
+ * return								: The created point or NULL if the point cannot be created.
+ */
+static EC_POINT* encodeWithRandomPadding(DlogEC* dlog, const unsigned char* string, int len, int k){
+	EC_GROUP* curve = dlog->getCurve();
+	BN_CTX* ctx = dlog->getCTX();
+
+	BIGNUM* p = BN_new();
+	BIGNUM* x = BN_new();
+	EC_POINT* point = dlog->newPoint();
+	if ((NULL == p) || (NULL == x) || (NULL == point) || (0 == EC_GROUP_get_curve_GFp(curve, p, NULL, NULL, ctx))){
 		BN_free(p);
 		BN_free(x);
-		BN_free(y);
-		delete(randomArray);
-		delete(newString);
-		return 0;
+		EC_POINT_free(point);
+		return NULL;
 	}
+	int l = BN_num_bytes(p);
+	BN_free(p);
+
+	unsigned char* newString = new unsigned char[l - k - 1 + len];
+	memcpy(newString + l - k - 2, string, len);
+	newString[l - k - 2 + len] = (unsigned char) len;
 
 	int counter = 0;
-	bool success = 0;
+	bool success = false;
 	do{
-			RAND_bytes((unsigned char*) randomArray, l-k-2);
-			memcpy(newString, randomArray, l-k-2);
+		RAND_bytes(newString, l - k - 2);
 			
-			//Convert the result to a BigInteger (bIString)
-			if(NULL == (x = BN_bin2bn((unsigned char*)newString, l - k - 1 + len, NULL))) break;
+		//Convert the result to a BigInteger (bIString). The same BIGNUM is used in all the trials.
+		if (NULL == BN_bin2bn(newString, l - k - 1 + len, x)) break;
 
-			int numBytes = BN_num_bytes(x);
-			//If the nmber is negative, make it positive.
-			if(BN_is_bit_set(x, numBytes*8)){	
-				BN_set_bit(x, numBytes*8);
-			}
-
-			//Try to create a point aith the generated x value.
-			//if failed, go back to choose a random r etc.
-			success = EC_POINT_set_compressed_coordinates_GFp(curve, point, x, 0, ((DlogEC*) dlog)->getCTX());
-			counter++;
-	} while((!success) && (counter <= 80)); //we limit the amount of times we try to 80 which is an arbitrary number.
+		//Try to create a point with the generated x value.
+		//if failed, go back to choose a random r etc.
+		success = (1 == EC_POINT_set_compressed_coordinates_GFp(curve, point, x, 0, ctx));
+		counter++;
+	} while ((!success) && (counter <= 80)); //we limit the amount of times we try to 80 which is an arbitrary number.
 
 	//Delete the allocated memory.
-	env ->ReleaseByteArrayElements(binaryString, string, 0);
 	BN_free(x);
-	BN_free(y);
-	BN_free(p);
-	delete(randomArray);
-	delete(newString);
+	delete[] newString;
 
-	//If a point could not be created, return 0;
+	//If a point could not be created, return NULL.
 	if (!success){
 		EC_POINT_free(point);
-		return 0;
+		return NULL;
 	}
+	return point;
+}
+
+/* 
+ * function encodeWithMap		: Encodes the given byte array into the point SSWU(u), where u = binaryString || binaryString.length.
+ *								  The encoding is deterministic and takes the same field operations for every byte array, without retries.
+ * return						: The created point or NULL if the point cannot be created.
+ */
+static EC_POINT* encodeWithMap(DlogEC* dlog, SswuMap* map, const unsigned char* string, int len){
+	EC_GROUP* curve = dlog->getCurve();
+	BN_CTX* ctx = dlog->getCTX();
+
+	unsigned char* newString = new unsigned char[len + 1];
+	memcpy(newString, string, len);
+	newString[len] = (unsigned char) len;
+
+	BIGNUM* u = BN_bin2bn(newString, len + 1, NULL);
+	EC_POINT* point = dlog->newPoint();
+	delete[] newString;
+
+	bool success = (NULL != u) && (NULL != point) && map->map(curve, point, u, ctx);
+	BN_free(u);
+	if (!success){
+		EC_POINT_free(point);
+		return NULL;
+	}
+	return point;
+}
+
+/* 
+ * function encodeByteArray		: Encodes the given byte array into a point, with the map if it is given, or by random padding.
+ * return						: The created point or NULL if the point cannot be created.
+ */
+static EC_POINT* encodeByteArray(DlogEC* dlog, SswuMap* map, const unsigned char* string, int len, int k){
+	if (len > k){
+		return NULL;
+	}
+	return (map != NULL) ? encodeWithMap(dlog, map, string, len) : encodeWithRandomPadding(dlog, string, len, k);
+}
+
+/* 
+ * function encodeByteArrayToPoint		: Encodes the given byte array into a point. 
+ *										  If the given byte array can not be encoded to a point, returns 0.
+ * param dlog							: Pointer to the native Dlog object.
+ * param map							: Pointer to the SSWU map of the curve, or 0 to encode by random padding.
+ * param binaryString					: The byte array to encode.
+ * param k								: k is the maximum length of a string to be converted to a Group Element of this group. 
+ *										  If a string exceeds the k length it cannot be converted.
+ * return								: The created point or 0 if the point cannot be created.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArrayToPoint
+  (JNIEnv *env, jobject, jlong dlog, jlong map, jbyteArray binaryString, jint k){
+
+	jbyte* string  = (jbyte*) env->GetByteArrayElements(binaryString, 0);
+	int len = env->GetArrayLength(binaryString);
+
+	EC_POINT* point = encodeByteArray((DlogEC*) dlog, (SswuMap*) map, (unsigned char*) string, len, k);
+	env->ReleaseByteArrayElements(binaryString, string, JNI_ABORT);
 
-	//Return the created point.
 	return (long) point;
 }
 
+/* 
+ * function encodeByteArraysToPoints	: Encodes each of the given byte arrays into a point, using the threads of the native pool.
+ * param dlog							: Pointer to the native Dlog object.
+ * param map							: Pointer to the SSWU map of the curve, or 0 to encode by random padding.
+ * param binaryStrings					: The byte arrays to encode.
+ * param k								: The maximum length of a byte array that can be encoded.
+ * return								: Pointers to the created points. The entries of the byte arrays that can not be encoded are 0.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArraysToPoints
+  (JNIEnv *env, jobject, jlong dlog, jlong map, jobjectArray binaryStrings, jint k){
+	
+	//Copy the byte arrays, since the java arrays can not be used by the threads of the pool.
+	int size = env->GetArrayLength(binaryStrings);
+	vector<vector<unsigned char> > strings(size);
+	for (int i = 0; i < size; i++){
+		jbyteArray binaryString = (jbyteArray) env->GetObjectArrayElement(binaryStrings, i);
+		strings[i].resize(env->GetArrayLength(binaryString));
+		if (!strings[i].empty()){
+			env->GetByteArrayRegion(binaryString, 0, (jsize) strings[i].size(), (jbyte*) &strings[i][0]);
+		}
+		env->DeleteLocalRef(binaryString);
+	}
+
+	jlong* points = new jlong[size];
+	getThreadPool()->parallelFor(size, [&](int first, int last){
+		for (int i = first; i < last; i++){
+			const unsigned char* string = strings[i].empty() ? NULL : &strings[i][0];
+			points[i] = (long) encodeByteArray((DlogEC*) dlog, (SswuMap*) map, string, (int) strings[i].size(), k);
+		}
+		return true;
+	});
+
+	jlongArray result = env->NewLongArray(size);
+	env->SetLongArrayRegion(result, 0, size, points);
+	delete[] points;
+	return result;
+}
+
+/* 
+ * function decodePointToByteArray		: Decodes a point that was created by encodeByteArrayToPoint with the SSWU map, back to the byte array.
+ * param dlog							: Pointer to the native Dlog object.
+ * param map							: Pointer to the SSWU map of the curve.
+ * param point							: The point to decode.
+ * param k								: The maximum length of a byte array that can be encoded.
+ * return								: The decoded byte array, or null if the point is not an encoding of a byte array.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_decodePointToByteArray
+  (JNIEnv *env, jobject, jlong dlog, jlong map, jlong point, jint k){
+	  
+	BN_CTX* ctx = ((DlogEC*) dlog)->getCTX();
+	BIGNUM* preimages[SSWU_MAX_PREIMAGES];
+	int numPreimages = ((SswuMap*) map)->invert(((DlogEC*) dlog)->getCurve(), (EC_POINT*) point, preimages, ctx);
+
+	//The point may have several preimages, but only the one of the encoding has the form binaryString || binaryString.length.
+	//The length of a byte array that can be encoded is much smaller than the field, so another preimage has this form with negligible probability.
+	jbyteArray result = NULL;
+	for (int i = 0; i < numPreimages; i++){
+		int len = (int) BN_mod_word(preimages[i], 256);
+		if ((result == NULL) && (len <= k) && (BN_num_bits(preimages[i]) <= 8 * (len + 1))){
+			unsigned char* newString = new unsigned char[len + 1];
+			BN_bn2bin(preimages[i], newString + len + 1 - BN_num_bytes(preimages[i]));
+			memset(newString, 0, len + 1 - BN_num_bytes(preimages[i]));
+
+			result = env->NewByteArray(len);
+			env->SetByteArrayRegion(result, 0, len, (jbyte*) newString);
+			delete[] newString;
+		}
+		BN_free(preimages[i]);
+	}
+	return result;
+}
+
+/* 
+ * function createEncodingMap	: Creates the simplified SWU map of the curve, which encodes byte arrays into points deterministically.
+ * param dlog					: Pointer to the native Dlog object.
+ * return						: Pointer to the map, or 0 if the curve has no such map (when a = 0 or b = 0).
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createEncodingMap
+  (JNIEnv *, jobject, jlong dlog){
+	
+	SswuMap* map = new SswuMap(((DlogEC*) dlog)->getCurve(), ((DlogEC*) dlog)->getCTX());
+	if (!map->isValid()){
+		delete map;
+		return 0;
+	}
+	return (long) map;
+}
+
+/* 
+ * function deleteEncodingMap	: Deletes the map.
+ * param map					: Pointer to the map.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_deleteEncodingMap
+  (JNIEnv *, jobject, jlong map){
+	delete (SswuMap*) map;
+}
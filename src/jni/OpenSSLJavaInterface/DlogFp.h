@@ -25,6 +25,7 @@
 
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
+#include <openssl/ec.h>
 /* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp */
 
 #ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
@@ -40,6 +41,14 @@ extern "C" {
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createCurve
   (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    createNamedCurve
+ * Signature: ([B[B[B[B[B[B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createNamedCurve
+  (JNIEnv *, jobject, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray, jbyteArray);
+
 /*
  * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
  * Method:    initCurve
@@ -54,9 +63,72 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECF
  * Signature: (J[BI)J
  */
 JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArrayToPoint
-  (JNIEnv *, jobject, jlong, jbyteArray, jint);
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    encodeByteArraysToPoints
+ * Signature: (JJ[[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_encodeByteArraysToPoints
+  (JNIEnv *, jobject, jlong, jlong, jobjectArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    decodePointToByteArray
+ * Signature: (JJJI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_decodePointToByteArray
+  (JNIEnv *, jobject, jlong, jlong, jlong, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    createEncodingMap
+ * Signature: (J)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_createEncodingMap
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp
+ * Method:    deleteEncodingMap
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogECFp_deleteEncodingMap
+  (JNIEnv *, jobject, jlong);
 
 #ifdef __cplusplus
 }
 #endif
+
+//The maximal number of field elements that the simplified SWU map computes the same point from.
+#define SSWU_MAX_PREIMAGES 5
+
+/*
+ * The simplified SWU map of RFC 9380 (map_to_curve_simple_swu), from the field to a curve y^2 = x^3 + a*x + b with a, b != 0.
+ * It maps every field element to a point with the same operations and without randomness, and it can be inverted, 
+ * so it is used to encode byte arrays into points deterministically.
+ */
+class SswuMap {
+private:
+
+	BIGNUM *p, *a, *b;
+	BIGNUM* z;				//The non square Z of the map.
+	BIGNUM* minusBOverA;	//-b/a.
+	BIGNUM* bOverZA;		//b/(Z*a), the x of the exceptional field elements.
+	BIGNUM* aOverB;			//a/b, used by the inverse.
+	bool valid;
+
+	bool curveFunction(BIGNUM* gx, const BIGNUM* x, BN_CTX* ctx);
+	bool hasNoRoot(const BIGNUM* c, BN_CTX* ctx);
+public:
+
+	SswuMap(EC_GROUP* curve, BN_CTX* ctx);
+	~SswuMap();
+
+	bool isValid();
+	bool map(EC_GROUP* curve, EC_POINT* point, const BIGNUM* u, BN_CTX* ctx);
+	int invert(EC_GROUP* curve, const EC_POINT* point, BIGNUM** preimages, BN_CTX* ctx);
+};
+
 #endif
@@ -26,8 +26,12 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "DlogZp.h"
+#include "ThreadContext.h"
+#include "../Common/ThreadPool.h"
 #include <openssl/dh.h>
 #include <openssl/rand.h>
+#include <openssl/crypto.h>
+#include <string.h>
 #include <iostream>
 
 using namespace std;
@@ -201,7 +205,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  DH* dh = ((DlogZp*) dlog) -> getDlog();
 	  
 	  //Prepare a result element.
-	  BIGNUM* result = BN_new();
+	  BIGNUM* result = ((DlogZp*) dlog) -> newElement();
 	  //Invert the given element and put the result in result.
 	  BN_mod_inverse(result, (BIGNUM*) element, dh->p, ((DlogZp*) dlog) ->getCTX());
 
@@ -219,8 +223,6 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
   (JNIEnv *env, jobject, jlong dlog, jlong base, jbyteArray exponent){
 	  jbyte* exponent_bytes  = (jbyte*) env->GetByteArrayElements(exponent, 0);
 
-	  DH* dh = ((DlogZp*) dlog) -> getDlog();
-	  
 	  //Convert the exponent into a BIGNUM object.
 	  BIGNUM* expBN;
 	  if(NULL == (expBN = BN_bin2bn((unsigned char*)exponent_bytes, env->GetArrayLength(exponent), NULL))){
@@ -230,9 +232,10 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  env ->ReleaseByteArrayElements(exponent, (jbyte*) exponent_bytes, 0);
 
 	  //Prepare a result element.
-	  BIGNUM* result = BN_new();
+	  BIGNUM* result = ((DlogZp*) dlog) -> newElement();
 	  //Raise the given element and put the result in result.
-	  if(0 == (BN_mod_exp(result, (BIGNUM *) base, expBN, dh->p, ((DlogZp*) dlog) -> getCTX()))){
+	  if(!((DlogZp*) dlog) -> exponentiate(result, (BIGNUM *) base, expBN)){
+		  BN_free(result);
 		  BN_free(expBN);
 		  return 0;
 	  }
@@ -256,7 +259,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZp
 	  DH* dh = ((DlogZp*) dlog) -> getDlog();
 	  	 
 	  //Prepare a result element.
-	  BIGNUM* result = BN_new();
+	  BIGNUM* result = ((DlogZp*) dlog) -> newElement();
 	  //Multiply the elements.
 	  if(0 == (BN_mod_mul(result, (BIGNUM*) element1, (BIGNUM*) element2, dh->p, ((DlogZp*) dlog) -> getCTX()))) return 0;
 	  
@@ -335,15 +338,194 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlo
 	  return ((DlogZp*) dlog) -> validateElement((BIGNUM*) element);
 }
 
+/* 
+ * function validateZpElements		: Checks the validity of each of the given elements, using the threads of the native pool.
+ * param dlog						: Pointer to the native Dlog group.
+ * params elements					: Pointers to the elements to check.
+ * return							: Array that holds for each element whether it is valid.
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpElements
+  (JNIEnv *env, jobject, jlong dlog, jlongArray elements){
+	  int size = env->GetArrayLength(elements);
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  bool* valid = new bool[size];
+
+	  ((DlogZp*) dlog) -> validateElements((BIGNUM**) elementsArr, valid, size);
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  jboolean* validArr = new jboolean[size];
+	  for (int i = 0; i < size; i++){
+		  validArr[i] = valid[i];
+	  }
+	  jbooleanArray result = env->NewBooleanArray(size);
+	  env->SetBooleanArrayRegion(result, 0, size, validArr);
+
+	  delete[] valid;
+	  delete[] validArr;
+	  return result;
+}
+
+/* 
+ * function createFixedBaseTable	: Precomputes the powers of the given base, to be used by exponentiateWithTable.
+ * param dlog						: Pointer to the native Dlog group.
+ * param base						: The element that will be raised by the table.
+ * return							: Pointer to the created table.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_createFixedBaseTable
+  (JNIEnv *, jobject, jlong dlog, jlong base){
+
+	  return (long) new ZpFixedBaseTable((DlogZp*) dlog, (BIGNUM*) base);
+}
+
+/* 
+ * function exponentiateWithTable	: Raises the base of the given table to the given exponent.
+ * param dlog						: Pointer to the native Dlog group.
+ * param table						: Pointer to the table of the base.
+ * param exponent
+ * return							: Pointer to the result's element.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_exponentiateWithTable
+  (JNIEnv *env, jobject, jlong dlog, jlong table, jbyteArray exponent){
+	  jbyte* exponent_bytes  = (jbyte*) env->GetByteArrayElements(exponent, 0);
+
+	  //Convert the exponent into a BIGNUM object.
+	  BIGNUM* expBN;
+	  if(NULL == (expBN = BN_bin2bn((unsigned char*)exponent_bytes, env->GetArrayLength(exponent), NULL))){
+		  env ->ReleaseByteArrayElements(exponent, (jbyte*) exponent_bytes, JNI_ABORT);
+		  return 0;
+	  }
+	  env ->ReleaseByteArrayElements(exponent, (jbyte*) exponent_bytes, JNI_ABORT);
+
+	  BIGNUM* result = ((DlogZp*) dlog) -> newElement();
+	  if(!((ZpFixedBaseTable*) table) -> exponentiate((DlogZp*) dlog, result, expBN)){
+		  BN_free(result);
+		  BN_free(expBN);
+		  return 0;
+	  }
+
+	  BN_free(expBN);
+
+	  return (long) result;
+}
+
+/* 
+ * function deleteFixedBaseTable	: Deletes the given table.
+ * param table						: Pointer to the table.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_deleteFixedBaseTable
+  (JNIEnv *, jobject, jlong table){
+	  delete (ZpFixedBaseTable*) table;
+}
+
+/* 
+ * function elementsToArray	: Returns a java array with the pointers of the given elements, or null if the elements were not computed.
+ */
+static jlongArray elementsToArray(JNIEnv *env, bool success, BIGNUM** elements, int size){
+	if (!success){
+		return NULL;
+	}
+
+	jlongArray result = env->NewLongArray(size);
+	jlong* pointers = env->GetLongArrayElements(result, 0);
+	for (int i = 0; i < size; i++){
+		pointers[i] = (jlong) elements[i];
+	}
+	env->ReleaseLongArrayElements(result, pointers, 0);
+	return result;
+}
+
+/* 
+ * function exponentiateBatch	: Raises each base to the respective exponent, using the threads of the native pool.
+ * param dlog					: Pointer to the native Dlog group.
+ * param bases					: Pointers to the bases.
+ * param exponents				: The exponents, packed. Each exponent takes exponentSize bytes (big endian, non negative).
+ * param exponentSize			: The size of each exponent in bytes.
+ * return						: Array of pointers to the results' elements, or null on failure.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_exponentiateBatch
+  (JNIEnv *env, jobject, jlong dlog, jlongArray bases, jbyteArray exponents, jint exponentSize){
+	  int size = env->GetArrayLength(bases);
+	  jlong* basesArr = env->GetLongArrayElements(bases, 0);
+	  jbyte* exponentsArr = env->GetByteArrayElements(exponents, 0);
+	  BIGNUM** results = new BIGNUM*[size];
+
+	  bool success = ((DlogZp*) dlog) -> exponentiateBatch((const BIGNUM**) basesArr, (unsigned char*) exponentsArr, exponentSize, results, size);
+
+	  //Release the java arrays. They were only read.
+	  env->ReleaseByteArrayElements(exponents, exponentsArr, JNI_ABORT);
+	  env->ReleaseLongArrayElements(bases, basesArr, JNI_ABORT);
+
+	  jlongArray result = elementsToArray(env, success, results, size);
+	  delete[] results;
+	  return result;
+}
+
+/* 
+ * function fixedBaseExponentiateBatch	: Raises the base of the given table to each of the exponents, using the threads of the native pool.
+ * param dlog							: Pointer to the native Dlog group.
+ * param table							: Pointer to the table of the base.
+ * param exponents						: The exponents, packed. Each exponent takes exponentSize bytes (big endian, non negative).
+ * param exponentSize					: The size of each exponent in bytes.
+ * return								: Array of pointers to the results' elements, or null on failure.
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_fixedBaseExponentiateBatch
+  (JNIEnv *env, jobject, jlong dlog, jlong table, jbyteArray exponents, jint exponentSize){
+	  int size = (exponentSize > 0) ? env->GetArrayLength(exponents) / exponentSize : 0;
+	  jbyte* exponentsArr = env->GetByteArrayElements(exponents, 0);
+	  BIGNUM** results = new BIGNUM*[size];
+
+	  bool success = ((ZpFixedBaseTable*) table) -> exponentiateBatch((DlogZp*) dlog, (unsigned char*) exponentsArr, exponentSize, results, size);
+
+	  //Release the java array. It was only read.
+	  env->ReleaseByteArrayElements(exponents, exponentsArr, JNI_ABORT);
+
+	  jlongArray result = elementsToArray(env, success, results, size);
+	  delete[] results;
+	  return result;
+}
+
+/* 
+ * function releaseElements		: Releases the given elements in bulk. The group keeps them for the next results of its functions.
+ * param dlog					: Pointer to the native Dlog group.
+ * param elements				: Pointers to the elements. The java side should not use them anymore.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_releaseElements
+  (JNIEnv *env, jobject, jlong dlog, jlongArray elements){
+	  int size = env->GetArrayLength(elements);
+	  jlong* elementsArr = env->GetLongArrayElements(elements, 0);
+	  BIGNUM** released = new BIGNUM*[size];
+	  for (int i = 0; i < size; i++){
+		  released[i] = (BIGNUM*) elementsArr[i];
+	  }
+	  env->ReleaseLongArrayElements(elements, elementsArr, JNI_ABORT);
+
+	  ((DlogZp*) dlog) -> releaseElements(released, size);
+	  delete[] released;
+}
+
 /* 
  * function DlogZp		: Construct a Zp* dlog group.
  * param dh				: Pointer to a DH struct contains p, q, g.
  * params ctx			: Pointer to CTX struct.
  */
-DlogZp::DlogZp(DH* dh, BN_CTX* ctx){
+DlogZp::DlogZp(DH* dh, BN_CTX* ctx) : elementPool(BN_free){
 
 	this->dlog = dh;
 	this->ctx = ctx;
+
+	//Compute the Montgomery context of p once, instead of in every exponentiation.
+	//If it can not be computed, the group falls back to BN_mod_exp.
+	mont = BN_MONT_CTX_new();
+	if ((mont != NULL) && (0 == BN_MONT_CTX_set(mont, dh->p, ctx))){
+		BN_MONT_CTX_free(mont);
+		mont = NULL;
+	}
+
+	//Check whether p = 2q + 1, which allows validating the elements without exponentiation.
+	BIGNUM* twoQPlusOne = BN_new();
+	safePrime = (twoQPlusOne != NULL) && (dh->q != NULL) && BN_lshift1(twoQPlusOne, dh->q) && BN_add_word(twoQPlusOne, 1) && 
+		(BN_cmp(twoQPlusOne, dh->p) == 0);
+	BN_free(twoQPlusOne);
 }
 
 /* 
@@ -351,6 +533,9 @@ DlogZp::DlogZp(DH* dh, BN_CTX* ctx){
  */
 DlogZp::~DlogZp(){
 	//Release the allocated memory.
+	if (mont != NULL){
+		BN_MONT_CTX_free(mont);
+	}
 	BN_CTX_free(ctx);
 	DH_free(dlog);
 }
@@ -363,10 +548,46 @@ DH* DlogZp::getDlog(){
 }
 
 /* 
- * function getCTX		: Returns the pointer to the CTX struct.
+ * function getCTX		: Returns the CTX struct of the calling thread, since the group can be used by several threads.
  */
 BN_CTX* DlogZp::getCTX(){
-	return ctx;
+	return getThreadBnCtx();
+}
+
+/* 
+ * function getMont		: Returns the Montgomery context of p, or NULL if it could not be computed.
+ */
+BN_MONT_CTX* DlogZp::getMont(){
+	return mont;
+}
+
+/* 
+ * function newElement		: Returns a new element, which is reused from the released elements if possible.
+ * return					: The element. Its value is arbitrary.
+ */
+BIGNUM* DlogZp::newElement(){
+	BIGNUM* element = elementPool.take();
+	return (element != NULL) ? element : BN_new();
+}
+
+/* 
+ * function releaseElements		: Releases the given elements, which may be reused by newElement.
+ */
+void DlogZp::releaseElements(BIGNUM** elements, int size){
+	elementPool.release(elements, size);
+}
+
+/* 
+ * function exponentiate		: Computes result = base ^ exponent mod p.
+ * return						: True on success; False, otherwise.
+ */
+bool DlogZp::exponentiate(BIGNUM* result, const BIGNUM* base, const BIGNUM* exponent){
+	if (mont == NULL){
+		return 0 != BN_mod_exp(result, base, exponent, dlog->p, getCTX());
+	}
+
+	//The exponents are usually secret (ElGamal and Cramer-Shoup keys and randomness), so the constant time version is used.
+	return 0 != BN_mod_exp_mont_consttime(result, base, exponent, dlog->p, getCTX(), mont);
 }
 
 /* 
@@ -376,37 +597,242 @@ BN_CTX* DlogZp::getCTX(){
  */
 bool DlogZp::validateElement(BIGNUM* el){
 	
-	//A valid element in the grou pshould satisfy the following:
+	//A valid element in the group should satisfy the following:
 	//	1. 0 < el < p.
 	//	2. el ^ q = 1 mod p.
-	bool result = true;
 	BIGNUM* p = dlog -> p;
-
-	//Check that the element is bigger than 0.
-	BIGNUM* zero = BN_new();
-	BN_zero(zero);
-	if (BN_cmp(el, zero) <= 0 ){
-		result = false;
+	if (BN_is_zero(el) || BN_is_negative(el) || (BN_cmp(el, p) >= 0)){
+		return false;
 	}
 	
-	//Check that the element is smaller than p.
-	if (BN_cmp(el, p) > 0 ){
-		result = false;
+	BN_CTX* ctx = getCTX();
+
+	//When p = 2q + 1 the group is the group of quadratic residues mod p, so the second condition is equivalent to 
+	//the Legendre symbol of the element being 1. Computing the symbol is much cheaper than the exponentiation.
+	if (safePrime){
+		return BN_kronecker(el, p, ctx) == 1;
 	}
-	
-	BIGNUM* q = dlog -> q;
-	BIGNUM* exp = BN_new();
-	
+
 	//Check that the element raised to q is 1 mod p.
-	int suc = BN_mod_exp(exp, el, q, p,  ctx);
-	
-	if (!BN_is_one(exp)){
-		result = false;
-	}
+	BIGNUM* exp = BN_new();
+	int suc = (mont == NULL) ? BN_mod_exp(exp, el, dlog -> q, p,  ctx) : BN_mod_exp_mont(exp, el, dlog -> q, p, ctx, mont);
+	bool result = (suc != 0) && BN_is_one(exp);
 	
 	//Release the allocated memory.
-	BN_free(zero);
 	BN_free(exp);
 
 	return result;
 }
+
+/* 
+ * function validateElements	: Checks the validity of each of the given elements, using the threads of the pool.
+ * params elements				: Elements to check.
+ * params results				: Array of size flags that gets the validity of the respective elements.
+ */
+void DlogZp::validateElements(BIGNUM** elements, bool* results, int size){
+	getThreadPool()->parallelFor(size, [&](int first, int last){
+		for (int i = first; i < last; i++){
+			results[i] = validateElement(elements[i]);
+		}
+		return true;
+	});
+}
+
+/* 
+ * function exponentiateBatch	: Computes results[i] = exp(results[i], exponents[i], i) for each i, using the threads of the pool.
+ * param dlog					: The group, which allocates the results.
+ * param exponents				: The exponents, each one in exponentSize bytes (big endian).
+ * return						: True on success; False, otherwise. On failure no result is allocated.
+ */
+static bool exponentiateBatch(DlogZp* dlog, const unsigned char* exponents, int exponentSize, BIGNUM** results, int size, 
+							  const function<bool(BIGNUM* result, const BIGNUM* exponent, int i)>& exp){
+	for (int i = 0; i < size; i++){
+		results[i] = NULL;
+	}
+
+	bool success = getThreadPool()->parallelFor(size, [&](int first, int last){
+		BIGNUM* exponent = BN_new();
+		if (exponent == NULL) return false;
+		bool ok = true;
+		for (int i = first; ok && (i < last); i++){
+			ok = (NULL != BN_bin2bn(exponents + (size_t) i * exponentSize, exponentSize, exponent)) && 
+				(NULL != (results[i] = dlog->newElement())) && exp(results[i], exponent, i);
+		}
+		BN_free(exponent);
+		return ok;
+	});
+
+	if (!success){
+		for (int i = 0; i < size; i++){
+			if (results[i] != NULL){
+				BN_free(results[i]);
+				results[i] = NULL;
+			}
+		}
+	}
+	return success;
+}
+
+/* 
+ * function exponentiateBatch	: Raises each base to the respective exponent.
+ * param bases					: The bases.
+ * param exponents				: The exponents, each one in exponentSize bytes (big endian).
+ * param results				: Array of size elements that gets the results.
+ * return						: True on success; False, otherwise.
+ */
+bool DlogZp::exponentiateBatch(const BIGNUM** bases, const unsigned char* exponents, int exponentSize, BIGNUM** results, int size){
+	return ::exponentiateBatch(this, exponents, exponentSize, results, size, [&](BIGNUM* result, const BIGNUM* exponent, int i){
+		return exponentiate(result, bases[i], exponent);
+	});
+}
+
+/* 
+ * function toFixedSize		: Writes the given non negative number to size bytes (big endian), padded with zeros in the start.
+ * return					: True on success; False, if the number does not fit.
+ */
+static bool toFixedSize(const BIGNUM* number, unsigned char* buffer, int size){
+	int length = BN_num_bytes(number);
+	if (length > size){
+		return false;
+	}
+	memset(buffer, 0, size - length);
+	BN_bn2bin(number, buffer + size - length);
+	return true;
+}
+
+/* 
+ * function ZpFixedBaseTable	: Precomputes the powers of the given base.
+ * param dlog					: The group of the base.
+ * param base					: The fixed base.
+ */
+ZpFixedBaseTable::ZpFixedBaseTable(DlogZp* dlog, const BIGNUM* base){
+	BIGNUM* p = dlog->getDlog()->p;
+	BN_CTX* ctx = dlog->getCTX();
+	BN_MONT_CTX* mont = dlog->getMont();
+	int digits = 1 << FIXED_BASE_WINDOW;
+
+	//The elements of the group have order q, so the exponents can always be reduced to the size of q.
+	numWindows = (BN_num_bits(dlog->getDlog()->q) + FIXED_BASE_WINDOW - 1) / FIXED_BASE_WINDOW;
+	elementSize = BN_num_bytes(p);
+	powers = NULL;
+	if (mont == NULL){
+		return;
+	}
+
+	powers = new unsigned char[(size_t) numWindows * digits * elementSize];
+
+	//windowBase = base^(2^(FIXED_BASE_WINDOW * i)), in Montgomery form.
+	BIGNUM* windowBase = BN_new();
+	BIGNUM* power = BN_new();
+	BN_nnmod(windowBase, base, p, ctx);
+	BN_to_montgomery(windowBase, windowBase, mont, ctx);
+
+	for (int i = 0; i < numWindows; i++){
+		unsigned char* row = powers + (size_t) i * digits * elementSize;
+		//The power of the digit 0 is 1, so that every window takes one multiplication.
+		BN_to_montgomery(power, BN_value_one(), mont, ctx);
+		for (int j = 0; j < digits; j++){
+			toFixedSize(power, row + j * elementSize, elementSize);
+			BN_mod_mul_montgomery(power, power, windowBase, mont, ctx);
+		}
+		//After the last digit, power = base^(2^FIXED_BASE_WINDOW * 2^(FIXED_BASE_WINDOW * i)), which is the base of the next window.
+		BN_copy(windowBase, power);
+	}
+
+	BN_free(power);
+	BN_free(windowBase);
+}
+
+/* 
+ * function ~ZpFixedBaseTable	: Deletes the precomputed powers.
+ */
+ZpFixedBaseTable::~ZpFixedBaseTable(){
+	if (powers != NULL){
+		delete[] powers;
+	}
+}
+
+/* 
+ * function selectPower		: Copies the power of the given digit in the given window to entry.
+ *							  All the powers of the window are read and the right one is kept by a mask, so that the memory 
+ *							  accesses do not depend on the digit.
+ */
+void ZpFixedBaseTable::selectPower(int window, unsigned int digit, unsigned char* entry){
+	const unsigned char* row = powers + (size_t) window * (1 << FIXED_BASE_WINDOW) * elementSize;
+	memset(entry, 0, elementSize);
+	for (unsigned int j = 0; j < (1u << FIXED_BASE_WINDOW); j++){
+		//mask is 0xff if j = digit and 0 otherwise, without branching on the digit.
+		unsigned char mask = (unsigned char) (0 - (((j ^ digit) - 1) >> (sizeof(unsigned int) * 8 - 1)));
+		const unsigned char* power = row + j * elementSize;
+		for (int k = 0; k < elementSize; k++){
+			entry[k] |= power[k] & mask;
+		}
+	}
+}
+
+/* 
+ * function exponentiate		: Computes result = base ^ exponent mod p, by multiplying the power of each window of the exponent.
+ *								  The exponents may be secret (for example, the randomness of ElGamal), so this takes the same 
+ *								  multiplications and table reads for every exponent of the size of q.
+ * param dlog					: The group of the base.
+ * return						: True on success; False, otherwise.
+ */
+bool ZpFixedBaseTable::exponentiate(DlogZp* dlog, BIGNUM* result, const BIGNUM* exponent){
+	if (powers == NULL){
+		return false;
+	}
+
+	BN_CTX* ctx = dlog->getCTX();
+	BN_MONT_CTX* mont = dlog->getMont();
+
+	//Exponents that are longer than the table are reduced modulo q.
+	bool success = true;
+	BIGNUM* reduced = NULL;
+	if (BN_num_bits(exponent) > numWindows * FIXED_BASE_WINDOW){
+		reduced = BN_new();
+		success = (reduced != NULL) && (0 != BN_nnmod(reduced, exponent, dlog->getDlog()->q, ctx));
+		exponent = reduced;
+	}
+
+	//The digits are read from a copy of the exponent in a fixed number of bytes, so that they do not depend on its length.
+	int exponentSize = (numWindows * FIXED_BASE_WINDOW + 7) / 8;
+	unsigned char* exponentBytes = new unsigned char[exponentSize];
+	unsigned char* entry = new unsigned char[elementSize];
+	BIGNUM* acc = BN_new();
+	BIGNUM* power = BN_new();
+	success = success && toFixedSize(exponent, exponentBytes, exponentSize) && (0 != BN_to_montgomery(acc, BN_value_one(), mont, ctx));
+	for (int i = 0; success && (i < numWindows); i++){
+		unsigned int digit = 0;
+		for (int b = FIXED_BASE_WINDOW - 1; b >= 0; b--){
+			int bit = i * FIXED_BASE_WINDOW + b;
+			digit = (digit << 1) | ((exponentBytes[exponentSize - 1 - bit / 8] >> (bit % 8)) & 1);
+		}
+		selectPower(i, digit, entry);
+		success = (NULL != BN_bin2bn(entry, elementSize, power)) && (0 != BN_mod_mul_montgomery(acc, acc, power, mont, ctx));
+	}
+	success = success && (0 != BN_from_montgomery(result, acc, mont, ctx));
+
+	OPENSSL_cleanse(exponentBytes, exponentSize);
+	OPENSSL_cleanse(entry, elementSize);
+	delete[] exponentBytes;
+	delete[] entry;
+	BN_clear_free(power);
+	BN_clear_free(acc);
+	if (reduced != NULL){
+		BN_clear_free(reduced);
+	}
+	return success;
+}
+
+/* 
+ * function exponentiateBatch	: Raises the base to each of the exponents.
+ * param dlog					: The group of the base.
+ * param exponents				: The exponents, each one in exponentSize bytes (big endian).
+ * param results				: Array of size elements that gets the results.
+ * return						: True on success; False, otherwise.
+ */
+bool ZpFixedBaseTable::exponentiateBatch(DlogZp* dlog, const unsigned char* exponents, int exponentSize, BIGNUM** results, int size){
+	return ::exponentiateBatch(dlog, exponents, exponentSize, results, size, [&](BIGNUM* result, const BIGNUM* exponent, int){
+		return exponentiate(dlog, result, exponent);
+	});
+}
@@ -26,6 +26,7 @@
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
 #include <openssl/dh.h>
+#include "ElementPool.h"
 /* Header for class edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime */
 
 #ifndef _Included_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
@@ -129,6 +130,62 @@ JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlo
 JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpElement
   (JNIEnv *, jobject, jlong, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    validateZpElements
+ * Signature: (J[J)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_validateZpElements
+  (JNIEnv *, jobject, jlong, jlongArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    createFixedBaseTable
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_createFixedBaseTable
+  (JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    exponentiateWithTable
+ * Signature: (JJ[B)J
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_exponentiateWithTable
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    deleteFixedBaseTable
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_deleteFixedBaseTable
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    exponentiateBatch
+ * Signature: (J[J[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_exponentiateBatch
+  (JNIEnv *, jobject, jlong, jlongArray, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    fixedBaseExponentiateBatch
+ * Signature: (JJ[BI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_fixedBaseExponentiateBatch
+  (JNIEnv *, jobject, jlong, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime
+ * Method:    releaseElements
+ * Signature: (J[J)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_OpenSSLDlogZpSafePrime_releaseElements
+  (JNIEnv *, jobject, jlong, jlongArray);
+
 #ifdef __cplusplus
 }
 
@@ -136,7 +193,10 @@ class DlogZp {
 private:
 
 	DH* dlog;
-	BN_CTX* ctx;
+	BN_CTX* ctx;		//Used only to build the group. The operations use the BN_CTX of the calling thread.
+	BN_MONT_CTX* mont;	//Montgomery context of p, computed once for all the operations of the group.
+	bool safePrime;		//True if p = 2q + 1. The elements are then validated by their Legendre symbol.
+	ElementPool<BIGNUM> elementPool;	//Elements that were released by the java side, for reuse.
 public:
 
 	DlogZp(DH* dlog, BN_CTX* ctx);
@@ -144,7 +204,40 @@ public:
 
 	DH* getDlog();
 	BN_CTX* getCTX();
+	BN_MONT_CTX* getMont();
+	BIGNUM* newElement();
+	void releaseElements(BIGNUM** elements, int size);
+	bool exponentiate(BIGNUM* result, const BIGNUM* base, const BIGNUM* exponent);
 	bool validateElement(BIGNUM* element);
+	void validateElements(BIGNUM** elements, bool* results, int size);
+	bool exponentiateBatch(const BIGNUM** bases, const unsigned char* exponents, int exponentSize, BIGNUM** results, int size);
+};
+
+//Number of exponent bits that are handled by each multiplication of the fixed-base exponentiation.
+#define FIXED_BASE_WINDOW 5
+
+/*
+ * Precomputed powers of a fixed base, base^(j * 2^(FIXED_BASE_WINDOW * i)) for every window i of the exponent and every digit j.
+ * An exponentiation then takes one multiplication per window, without any squaring.
+ * The exponentiation does not branch on the digits and reads every power of each window, so it can be used with secret exponents.
+ * The table of a 2048 bit group takes about 3.5MB.
+ */
+class ZpFixedBaseTable {
+private:
+
+	int numWindows;
+	int elementSize;		//The size of p in bytes.
+	unsigned char* powers;	//In Montgomery form, each one in elementSize bytes (big endian). 
+							//The power of window i and digit j starts at (i * (1 << FIXED_BASE_WINDOW) + j) * elementSize.
+
+	void selectPower(int window, unsigned int digit, unsigned char* entry);
+public:
+
+	ZpFixedBaseTable(DlogZp* dlog, const BIGNUM* base);
+	~ZpFixedBaseTable();
+
+	bool exponentiate(DlogZp* dlog, BIGNUM* result, const BIGNUM* exponent);
+	bool exponentiateBatch(DlogZp* dlog, const unsigned char* exponents, int exponentSize, BIGNUM** results, int size);
 };
 
 #endif
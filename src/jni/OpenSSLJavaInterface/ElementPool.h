@@ -0,0 +1,90 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#ifndef _Included_ElementPool
+#define _Included_ElementPool
+
+#include <vector>
+#include <mutex>
+
+//The maximal number of released elements that a group keeps for reuse. Elements that are released beyond it are freed.
+#define MAX_POOLED_ELEMENTS 4096
+
+/*
+ * Native elements (EC_POINT or BIGNUM) that were released in bulk by the java side, kept by their group for reuse.
+ * New elements are taken from the pool before they are allocated, so that short lived intermediates of a protocol round
+ * do not go through the allocator. The pool is bounded, and it can be used by several threads.
+ */
+template<typename T> class ElementPool {
+private:
+
+	std::vector<T*> elements;
+	std::mutex lock;
+	void (*freeElement)(T*);
+public:
+
+	ElementPool(void (*freeElement)(T*)) : freeElement(freeElement) {}
+
+	~ElementPool(){
+		for (size_t i = 0; i < elements.size(); i++){
+			freeElement(elements[i]);
+		}
+	}
+
+	/*
+	 * Returns a released element, or NULL if the pool is empty. The value of the returned element is arbitrary.
+	 */
+	T* take(){
+		std::lock_guard<std::mutex> guard(lock);
+		if (elements.empty()){
+			return NULL;
+		}
+		T* element = elements.back();
+		elements.pop_back();
+		return element;
+	}
+
+	/*
+	 * Keeps the given elements for reuse, up to MAX_POOLED_ELEMENTS, and frees the rest.
+	 */
+	void release(T** released, int size){
+		int i = 0;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			for (; (i < size) && (elements.size() < MAX_POOLED_ELEMENTS); i++){
+				if (released[i] != NULL){
+					elements.push_back(released[i]);
+				}
+			}
+		}
+		for (; i < size; i++){
+			if (released[i] != NULL){
+				freeElement(released[i]);
+			}
+		}
+	}
+};
+
+#endif
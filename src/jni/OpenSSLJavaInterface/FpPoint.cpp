@@ -66,7 +66,7 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_dlog_openSSL_ECFpPointOpen
 	  env ->ReleaseByteArrayElements(yBytes, (jbyte*) y_bytes, 0);
 
 	   // Create the element.
-	  if(NULL == (point = EC_POINT_new(curve))) {
+	  if(NULL == (point = ((DlogEC*) dlog)->newPoint())) {
 		  BN_free(x);
 		  BN_free(y);
 		  return 0;
@@ -0,0 +1,183 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "HKDF.h"
+#include "Hmac.h"
+#include "../Common/ThreadPool.h"
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/crypto.h>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Computes HKDF with the given hash: PRK = HMAC(salt, source), and then HKDF-Expand(PRK, info) of outLen bytes.
+ * The given Hmac is keyed by this function, so it can be reused for any number of keys.
+ */
+static bool deriveKey(HMAC_CTX* ctx, const EVP_MD* md, const unsigned char* salt, int saltLen, const unsigned char* source, int sourceLen, 
+					  const unsigned char* info, int infoLen, unsigned char* out, int outLen){
+	unsigned char prk[EVP_MAX_MD_SIZE];
+	unsigned int prkLen = 0;
+
+	//HMAC_Init_ex keeps the previous key when it gets a NULL key, so an empty salt should still be given by a pointer.
+	static const unsigned char emptySalt[1] = { 0 };
+	if (salt == NULL){
+		salt = emptySalt;
+	}
+
+	//Extract.
+	bool success = HMAC_Init_ex(ctx, salt, saltLen, md, NULL) &&
+				   HMAC_Update(ctx, source, sourceLen) &&
+				   HMAC_Final(ctx, prk, &prkLen) &&
+				   HMAC_Init_ex(ctx, prk, prkLen, NULL, NULL);
+
+	//Expand.
+	success = success && hkdfExpand(ctx, info, infoLen, out, outLen);
+
+	OPENSSL_cleanse(prk, sizeof(prk));
+	return success;
+}
+
+/* 
+ * function getDigest	: Returns the OpenSSL hash with the given name.
+ * return				: Pointer to the hash, or 0 if OpenSSL does not have a hash with the given name. The hash is static, so it should not be deleted.
+ */
+JNIEXPORT jlong JNICALL Java_edu_biu_scapi_primitives_kdf_openSSL_OpenSSLHKDF_getDigest
+  (JNIEnv *env, jobject, jstring hashName){
+	  OpenSSL_add_all_digests();
+
+	  //Get the hash name from java.
+	  const char* name = env->GetStringUTFChars(hashName, NULL);
+	  const EVP_MD *md = EVP_get_digestbyname(name);
+	  env->ReleaseStringUTFChars(hashName, name);
+
+	  return (jlong) md;
+}
+
+/* 
+ * function getDigestSize	: Returns the output size of the given hash.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_kdf_openSSL_OpenSSLHKDF_getDigestSize
+  (JNIEnv *, jobject, jlong md){
+	  return EVP_MD_size((const EVP_MD*) md);
+}
+
+/* 
+ * function deriveNative	: Derives one key with HKDF in one call.
+ * param md					: Pointer to the hash.
+ * param salt				: The key of the extract step.
+ * param source				: The array that contains the entropy source.
+ * param inOff				: The offset of the entropy source in the array.
+ * param inLen				: The length of the entropy source.
+ * param info				: The context information of the expand step.
+ * param outLen				: The length of the derived key.
+ * return					: The derived key, or null if the derivation failed.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_kdf_openSSL_OpenSSLHKDF_deriveNative
+  (JNIEnv *env, jobject, jlong md, jbyteArray salt, jbyteArray source, jint inOff, jint inLen, jbyteArray info, jint outLen){
+	  vector<unsigned char> key(outLen);
+	  int saltLen = env->GetArrayLength(salt);
+	  int infoLen = env->GetArrayLength(info);
+
+	  //Get the inputs without copying them, if the JVM allows it.
+	  unsigned char* saltBytes = (unsigned char*) env->GetPrimitiveArrayCritical(salt, 0);
+	  unsigned char* sourceBytes = (unsigned char*) env->GetPrimitiveArrayCritical(source, 0);
+	  unsigned char* infoBytes = (unsigned char*) env->GetPrimitiveArrayCritical(info, 0);
+
+	  HMAC_CTX ctx;
+	  HMAC_CTX_init(&ctx);
+	  bool success = deriveKey(&ctx, (const EVP_MD*) md, saltBytes, saltLen, sourceBytes + inOff, inLen, infoBytes, infoLen, key.data(), outLen);
+	  HMAC_CTX_cleanup(&ctx);
+
+	  env->ReleasePrimitiveArrayCritical(info, infoBytes, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(source, sourceBytes, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(salt, saltBytes, JNI_ABORT);
+
+	  //Copy the key to a java array.
+	  jbyteArray result = NULL;
+	  if (success){
+		  result = env->NewByteArray(outLen);
+		  env->SetByteArrayRegion(result, 0, outLen, (jbyte*) key.data());
+	  }
+	  OPENSSL_cleanse(key.data(), outLen);
+	  return result;
+}
+
+/* 
+ * function deriveManyNative	: Derives a key for each of the given salts, from the same entropy source and context information.
+ *								  The keys are split between the threads of the native pool.
+ * param md						: Pointer to the hash.
+ * param salts					: The keys of the extract step.
+ * param source					: The array that contains the entropy source.
+ * param inOff					: The offset of the entropy source in the array.
+ * param inLen					: The length of the entropy source.
+ * param info					: The context information of the expand step.
+ * param outLen					: The length of each derived key.
+ * return						: The derived keys, one after the other, or null if one of the derivations failed.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_kdf_openSSL_OpenSSLHKDF_deriveManyNative
+  (JNIEnv *env, jobject, jlong md, jobjectArray salts, jbyteArray source, jint inOff, jint inLen, jbyteArray info, jint outLen){
+	  int size = env->GetArrayLength(salts);
+
+	  //Copy the inputs, since the threads of the pool can not use the java arrays.
+	  vector<vector<unsigned char> > saltBytes(size);
+	  for (int i = 0; i < size; i++){
+		  jbyteArray salt = (jbyteArray) env->GetObjectArrayElement(salts, i);
+		  saltBytes[i].resize(env->GetArrayLength(salt));
+		  env->GetByteArrayRegion(salt, 0, (jsize) saltBytes[i].size(), (jbyte*) saltBytes[i].data());
+		  env->DeleteLocalRef(salt);
+	  }
+	  vector<unsigned char> sourceBytes(inLen);
+	  env->GetByteArrayRegion(source, inOff, inLen, (jbyte*) sourceBytes.data());
+	  vector<unsigned char> infoBytes(env->GetArrayLength(info));
+	  env->GetByteArrayRegion(info, 0, (jsize) infoBytes.size(), (jbyte*) infoBytes.data());
+
+	  //Each thread derives its keys with its own Hmac.
+	  vector<unsigned char> keys((size_t) size * outLen);
+	  bool success = getThreadPool()->parallelFor(size, [&](int first, int last){
+		  HMAC_CTX ctx;
+		  HMAC_CTX_init(&ctx);
+		  bool success = true;
+		  for (int i = first; i < last && success; i++){
+			  success = deriveKey(&ctx, (const EVP_MD*) md, saltBytes[i].data(), (int) saltBytes[i].size(), sourceBytes.data(), inLen, 
+								  infoBytes.data(), (int) infoBytes.size(), keys.data() + (size_t) i * outLen, outLen);
+		  }
+		  HMAC_CTX_cleanup(&ctx);
+		  return success;
+	  });
+	  OPENSSL_cleanse(sourceBytes.data(), inLen);
+
+	  //Copy the keys to a java array.
+	  jbyteArray result = NULL;
+	  if (success){
+		  result = env->NewByteArray((jsize) keys.size());
+		  env->SetByteArrayRegion(result, 0, (jsize) keys.size(), (jbyte*) keys.data());
+	  }
+	  OPENSSL_cleanse(keys.data(), keys.size());
+	  return result;
+}
@@ -26,11 +26,20 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "Hash.h"
+#include "../Common/ThreadPool.h"
+#include "../Common/MultiBufferHash.h"
 #include <openssl/evp.h>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
+//Below this number of bytes a batch is hashed by the calling thread, since splitting it between threads costs more than it saves.
+#define HASH_MANY_PARALLEL_BYTES (1 << 16)
+
+//Shorter runs of messages of the same length are hashed one by one, since the multi-buffer hash fills all its lanes anyway.
+#define HASH_MANY_MIN_MULTI_BUFFER_RUN (HASH_LANES / 2)
+
 /* 
  * function createHash		: Create a native hash function.
  * param hashName			: The name of the requested hash.
@@ -79,45 +88,42 @@ JNIEXPORT jstring JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
 }
 
 /* 
- * function updateHash	: Update the hash function with the given message.
+ * function updateHash	: Update the hash function with the given part of the message.
+ *						  The array is pinned instead of copied, so only the hashed bytes are read, and it is released without copying it back.
  * param hash			: Pointer to the native hash.
- * param message		: The message to update the hash with.
+ * param message		: The array that contains the message to update the hash with.
+ * param offset			: The offset of the message in the array.
  * param len			: The length of the message.
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_updateHash
-  (JNIEnv *env, jobject, jlong hash, jbyteArray message, jlong len){
-	  //convert the message to c++ notation.
-	  jbyte* msg = env->GetByteArrayElements(message, 0);
+  (JNIEnv *env, jobject, jlong hash, jbyteArray message, jint offset, jint len){
+	  //Get the message without copying it, if the JVM allows it.
+	  jbyte* msg = (jbyte*) env->GetPrimitiveArrayCritical(message, 0);
 
 	  //Update the hash with the message.
-	  EVP_DigestUpdate((EVP_MD_CTX *) hash, msg, len);
+	  EVP_DigestUpdate((EVP_MD_CTX *) hash, msg + offset, len);
 
-	  env->ReleaseByteArrayElements(message, msg, 0);
+	  env->ReleasePrimitiveArrayCritical(message, msg, JNI_ABORT);
 }
 
 /* 
  * function finalHash	: Finalize the hash function.
  * param result			: Array to hold the hashed message.
+ * param offset			: The offset in the array to put the hashed message from.
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_finalHash
-  (JNIEnv *env, jobject, jlong hash, jbyteArray result){
-	  //Get the size of the hashed message.
-	  int size = EVP_MD_CTX_size((EVP_MD_CTX *)hash);
-	  
-	  //Allocate a new byte array with the size of the specific hash algorithm.
-	  unsigned char* ret = new unsigned char[size]; 
-
-	  //Compute the hash function and put the result in ret.
-	  EVP_DigestFinal_ex((EVP_MD_CTX *)hash, ret, NULL);
+  (JNIEnv *env, jobject, jlong hash, jbyteArray result, jint offset){
+	  //Compute the hash function. The digest of every hash fits in EVP_MAX_MD_SIZE bytes.
+	  unsigned char ret[EVP_MAX_MD_SIZE];
+	  unsigned int size = 0;
+	  EVP_DigestFinal_ex((EVP_MD_CTX *)hash, ret, &size);
 	  
-	  //Initialize the hash structure again to enable repeated calls.
-	  EVP_DigestInit((EVP_MD_CTX *)hash, EVP_MD_CTX_md((EVP_MD_CTX *)hash));
+	  //Initialize the hash structure again to enable repeated calls. 
+	  //Since the digest does not change, EVP_DigestInit_ex reuses the allocated state instead of resetting the whole context.
+	  EVP_DigestInit_ex((EVP_MD_CTX *)hash, EVP_MD_CTX_md((EVP_MD_CTX *)hash), NULL);
 	  
 	  //Put the result of the final computation in the output array passed from java.
-	  env->SetByteArrayRegion(result, 0, size, (jbyte*)((char*)ret)); 
-	  
-	  //Make sure to release the dynamically allocated memory. Will not be deleted by the JVM.
-	  delete ret;
+	  env->SetByteArrayRegion(result, offset, size, (jbyte*) ret); 
 }
 
 /* 
@@ -136,4 +142,85 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_ge
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_deleteHash
   (JNIEnv *, jobject, jlong hash){
 	  EVP_MD_CTX_destroy((EVP_MD_CTX *)hash);
+}
+
+/* 
+ * function hashMany	: Computes the digests of many independent messages that are given in one array.
+ *						  Each message is hashed with its own context, so large batches are split between the threads of the native pool.
+ *						  In SHA-1 and SHA-256, consecutive messages of the same length are hashed together by the multi-buffer hash.
+ * param hash			: Pointer to the native hash. Only its digest type is used, so the message that was updated so far is kept.
+ * param buffer			: The array that contains the messages.
+ * param offsets		: The offset of each message in the buffer.
+ * param lengths		: The length of each message.
+ * param out			: Array to hold the digests. The digest of message i is put at offset i * digest size.
+ * return				: True if all the messages were hashed, false if OpenSSL or the pool failed.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_hashMany
+  (JNIEnv *env, jobject, jlong hash, jbyteArray buffer, jintArray offsets, jintArray lengths, jbyteArray out){
+	  const EVP_MD* md = EVP_MD_CTX_md((EVP_MD_CTX *)hash);
+	  int digestSize = EVP_MD_size(md);
+	  int size = env->GetArrayLength(offsets);
+	  
+	  //Get the offsets and lengths before pinning the arrays, since no other JNI function may be called while they are pinned.
+	  jint* offsetsArr = env->GetIntArrayElements(offsets, 0);
+	  jint* lengthsArr = env->GetIntArrayElements(lengths, 0);
+	  long long totalBytes = 0;
+	  for (int i = 0; i < size; i++){
+		  totalBytes += lengthsArr[i];
+	  }
+
+	  //Get the messages and the output without copying them, if the JVM allows it.
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(buffer, 0);
+	  unsigned char* digests = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  int type = EVP_MD_type(md);
+	  bool multiBuffer = (type == NID_sha1) || (type == NID_sha256);
+
+	  //Hashes the messages first, ..., last-1. Runs of messages of the same length go to the multi-buffer hash, and the rest use one context.
+	  auto hashRange = [&](int first, int last){
+		  EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+		  bool success = (ctx != NULL);
+		  vector<const unsigned char*> messages;
+		  int i = first;
+		  while (i < last && success){
+			  int end = i + 1;
+			  while (multiBuffer && end < last && lengthsArr[end] == lengthsArr[i]){
+				  end++;
+			  }
+			  if (end - i >= HASH_MANY_MIN_MULTI_BUFFER_RUN){
+				  messages.resize(end - i);
+				  for (int j = i; j < end; j++){
+					  messages[j - i] = in + offsetsArr[j];
+				  }
+				  if (type == NID_sha256){
+					  sha256Multi(messages.data(), lengthsArr[i], end - i, digests + i * digestSize);
+				  } else{
+					  sha1Multi(messages.data(), lengthsArr[i], end - i, digests + i * digestSize);
+				  }
+				  i = end;
+				  continue;
+			  }
+			  for (; i < end && success; i++){
+				  success = EVP_DigestInit_ex(ctx, md, NULL) &&
+							EVP_DigestUpdate(ctx, in + offsetsArr[i], lengthsArr[i]) &&
+							EVP_DigestFinal_ex(ctx, digests + i * digestSize, NULL);
+			  }
+		  }
+		  EVP_MD_CTX_destroy(ctx);
+		  return success;
+	  };
+
+	  bool success;
+	  if (totalBytes < HASH_MANY_PARALLEL_BYTES){
+		  success = hashRange(0, size);
+	  } else{
+		  success = getThreadPool()->parallelFor(size, hashRange);
+	  }
+
+	  //Write the digests back and release the messages without copying them back.
+	  env->ReleasePrimitiveArrayCritical(out, digests, 0);
+	  env->ReleasePrimitiveArrayCritical(buffer, in, JNI_ABORT);
+	  env->ReleaseIntArrayElements(lengths, lengthsArr, JNI_ABORT);
+	  env->ReleaseIntArrayElements(offsets, offsetsArr, JNI_ABORT);
+	  return success;
 }
\ No newline at end of file
@@ -51,18 +51,18 @@ JNIEXPORT jstring JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
 /*
  * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
  * Method:    updateHash
- * Signature: (J[BJ)V
+ * Signature: (J[BII)V
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_updateHash
-  (JNIEnv *, jobject, jlong, jbyteArray, jlong);
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
  * Method:    finalHash
- * Signature: (J[B)V
+ * Signature: (J[BI)V
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_finalHash
-  (JNIEnv *, jobject, jlong, jbyteArray);
+  (JNIEnv *, jobject, jlong, jbyteArray, jint);
 
 /*
  * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
@@ -80,6 +80,14 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_ge
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_deleteHash
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash
+ * Method:    hashMany
+ * Signature: (J[B[I[I[B)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_hash_openSSL_OpenSSLHash_hashMany
+  (JNIEnv *, jobject, jlong, jbyteArray, jintArray, jintArray, jbyteArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,8 @@
 #include <jni.h>
 #include "Hmac.h"
 #include <openssl/hmac.h>
+#include <openssl/crypto.h>
+#include <string.h>
 #include <iostream>
 
 using namespace std;
@@ -67,11 +69,12 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_set
 	  //Convert the given key into c++ notation.
 	  jbyte* keyBytes  = (jbyte*) env->GetByteArrayElements(key, 0);
 	  
-	  //Initialize the Hmac object with the given key.
+	  //Initialize the Hmac object with the given key. 
+	  //This hashes the inner and outer pads of the key once, and the Hmac keeps their states for all the following macs.
 	  HMAC_Init_ex((HMAC_CTX *)hmac, keyBytes, env->GetArrayLength(key),  NULL, NULL);
 	
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(key, keyBytes, 0);
+	  //Make sure to release the memory created in c++. The key was not changed, so there is no need to copy it back.
+	  env->ReleaseByteArrayElements(key, keyBytes, JNI_ABORT);
 }
 
 /* 
@@ -106,14 +109,14 @@ JNIEXPORT jstring JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_
  */
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateNative
   (JNIEnv *env, jobject, jlong hmac, jbyteArray in, jint inOffset, jint len){
-	  //Convert the given data into c++ notation.
-	  jbyte* input  = (jbyte*) env->GetByteArrayElements(in, 0);
+	  //Get the data without copying it, if the JVM allows it.
+	  jbyte* input  = (jbyte*) env->GetPrimitiveArrayCritical(in, 0);
 
 	  //Update the Hmac object.
 	  HMAC_Update((HMAC_CTX*)hmac, (const unsigned char*)(input+inOffset), len);
 
-	  //Release the allocated memory.
-	  env->ReleaseByteArrayElements(in, input, 0);
+	  //Release the array without copying it back.
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
 }
 
 /* 
@@ -121,30 +124,28 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
  * param hmac				: Pointer to the native Hmac object.
  * param out				: Output array that should hols the Hmac's result.
  * param outOffset			: The offset within the output array that the reHmac result should start from.
+ * return					: True if the Hmac was computed, false if openssl failed. In this case the output array is not changed.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal
   (JNIEnv *env, jobject, jlong hmac, jbyteArray out, jint outOffset){
 	  
-	  int size = EVP_MD_size(((HMAC_CTX *)hmac)->md); //Get the size of the hash output.
-	  unsigned char* output = new unsigned char[size];//Create a char array to hold the result.
+	  //The output of every hash fits in EVP_MAX_MD_SIZE bytes.
+	  unsigned char output[EVP_MAX_MD_SIZE];
+	  unsigned int size = 0;
 	  
-	  //Compute the final function and copy the output the the given output array
-	  if (0 == (HMAC_Final((HMAC_CTX *)hmac, output, NULL))){
-		  delete output;
-	  }
+	  //Compute the final function.
+	  bool success = (HMAC_Final((HMAC_CTX *)hmac, output, &size) != 0);
 
-	  env->SetByteArrayRegion(out, outOffset, size, (jbyte*)output); 
+	  //Reset the Hmac in order to enable repeated calls, also after a failure. 
+	  //Without a new key, HMAC_Init_ex copies the stored inner pad state instead of hashing the key pads again.
+	  success = (HMAC_Init_ex((HMAC_CTX *)hmac, NULL, 0, NULL, NULL) != 0) && success;
 
-	  //initialize the Hmac again in order to enable repeated calls.
-	  const EVP_MD *md = ((HMAC_CTX *)hmac)->md;
-	  unsigned char* key = ((HMAC_CTX *)hmac)->key;
-	  int keyLen =  ((HMAC_CTX *)hmac)->key_length;
-	  if (0 == (HMAC_Init_ex((HMAC_CTX *)hmac, key, keyLen,  md, NULL))){
-		  delete(output);
+	  //Copy the output to the given output array.
+	  if (success){
+		  env->SetByteArrayRegion(out, outOffset, size, (jbyte*)output); 
 	  }
-
-	  //Release the allocated memory.
-	  delete output;
+	  OPENSSL_cleanse(output, sizeof(output));
+	  return success;
 }
 
 /* 
@@ -154,3 +155,62 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_del
   (JNIEnv *, jobject, jlong hmac){
 	  HMAC_CTX_cleanup((HMAC_CTX*)hmac);
 }
+
+bool hkdfExpand(HMAC_CTX* ctx, const unsigned char* info, int infoLen, unsigned char* out, int outLen){
+	int hashSize = EVP_MD_size(ctx->md);
+	unsigned char block[EVP_MAX_MD_SIZE];	//K(i) of the current round.
+	bool success = true;
+
+	//Each round costs the compression functions of its data and of the outer hash, since the Hmac is reset from its stored pad states.
+	for (int i = 1, done = 0; (done < outLen) && success; i++){
+		//The round is put in one byte, as the java implementation does.
+		unsigned char round = (unsigned char) i;
+
+		success = ((i == 1) || HMAC_Update(ctx, block, hashSize)) &&
+				  HMAC_Update(ctx, info, infoLen) &&
+				  HMAC_Update(ctx, &round, 1) &&
+				  HMAC_Final(ctx, block, NULL) &&
+				  HMAC_Init_ex(ctx, NULL, 0, NULL, NULL);
+
+		//Copy K(i) to the output. The last round is truncated to the required length.
+		int len = (outLen - done < hashSize) ? outLen - done : hashSize;
+		memcpy(out + done, block, len);
+		done += len;
+	}
+
+	//Leave the Hmac ready for the next call also after a failure.
+	if (!success){
+		HMAC_Init_ex(ctx, NULL, 0, NULL, NULL);
+	}
+	OPENSSL_cleanse(block, sizeof(block));
+	return success;
+}
+
+/* 
+ * function expandNative	: Computes HKDF-Expand in one call, using the key of the Hmac as the pseudorandom key.
+ * param hmac				: Pointer to the native Hmac object.
+ * param info				: The context information.
+ * param out				: Output array that should hold the derived bytes.
+ * param outOffset			: The offset within the output array to put the derived bytes from.
+ * param outLen				: The number of bytes to derive.
+ * return					: True if the bytes were derived, false if openssl failed. In this case the output bytes are zeroed.
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_expandNative
+  (JNIEnv *env, jobject, jlong hmac, jbyteArray info, jbyteArray out, jint outOffset, jint outLen){
+	  int infoLen = env->GetArrayLength(info);
+
+	  //Get the arrays without copying them, if the JVM allows it.
+	  unsigned char* infoBytes = (unsigned char*) env->GetPrimitiveArrayCritical(info, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+
+	  bool success = hkdfExpand((HMAC_CTX *)hmac, infoBytes, infoLen, output + outOffset, outLen);
+	  //Do not leave a partial key in the output.
+	  if (!success){
+		  OPENSSL_cleanse(output + outOffset, outLen);
+	  }
+
+	  //Write the derived bytes back and release the info without copying it back.
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(info, infoBytes, JNI_ABORT);
+	  return success;
+}
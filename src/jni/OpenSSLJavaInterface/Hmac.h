@@ -25,10 +25,20 @@
 
 /* DO NOT EDIT THIS FILE - it is machine generated */
 #include <jni.h>
+#include <openssl/hmac.h>
 /* Header for class edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC */
 
 #ifndef _Included_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
 #define _Included_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+
+/*
+ * HKDF-Expand (RFC 5869) with the key of the given hmac as the pseudorandom key.
+ * Puts in out the first outLen bytes of K(1),...,K(t), where K(i) = HMAC(PRK, (K(i-1), info, i)).
+ * The hmac should be reset (as it is after setKey and after each mac) and it is left reset.
+ * Returns false if one of the OpenSSL functions failed.
+ */
+bool hkdfExpand(HMAC_CTX* ctx, const unsigned char* info, int infoLen, unsigned char* out, int outLen);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,9 +79,9 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 /*
  * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
  * Method:    updateFinal
- * Signature: (J[BI)V
+ * Signature: (J[BI)Z
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_updateFinal
   (JNIEnv *, jobject, jlong, jbyteArray, jint);
 
 /*
@@ -82,6 +92,14 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_upd
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_deleteNative
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC
+ * Method:    expandNative
+ * Signature: (J[B[BII)Z
+ */
+JNIEXPORT jboolean JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLHMAC_expandNative
+  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+
 #ifdef __cplusplus
 }
 #endif
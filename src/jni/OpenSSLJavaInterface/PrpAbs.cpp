@@ -32,114 +32,46 @@
 using namespace std;
 
 /* 
- * function computeBlock		: Compute the PRP on the given block.
- * param prp					: pointer to the PRP object.
- * param in						: The input block to cumpute the permutation on.
- * param out					: The output block to hold the permutation result.
+ * function processBlocks		: Computes or inverts the PRP on consecutive blocks, according to the direction of the given cipher.
+ *								  All the blocks are passed to OpenSSL in one update, so the ECB implementation can pipeline them.
+ * param prp					: pointer to the PRP object (the compute or the invert object).
+ * param in						: The input blocks.
+ * param inOffset				: The offset of the first block within the input array.
+ * param out					: The output array to hold the result. Can be the input array itself.
  * param outOffset				: The offset within the output array to put the result from.
- * param blockSize				: The block size of the given prp.
+ * param len					: The number of bytes to process. Must be a multiple of the block size.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_computeBlock
-  (JNIEnv *env, jobject, jlong prp, jbyteArray in, jbyteArray out, jint outOffset, jint blockSize){
-	  //Convert the given data into c++ notation.
-	  jbyte* input  = (jbyte*) env->GetByteArrayElements(in, 0);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_processBlocks
+  (JNIEnv *env, jobject, jlong prp, jbyteArray in, jint inOffset, jbyteArray out, jint outOffset, jint len){
 	  int size;
-	  
-	  //Allocate a new byte array with the size of the specific prp algorithm.
-	  unsigned char* ret = new unsigned char[blockSize]; 
 
-	  //Compute the prp on the given input array, put the result in ret.
-	  EVP_EncryptUpdate ((EVP_CIPHER_CTX*)prp, ret, &size, (unsigned char*)input, blockSize);
+	  //Pin the arrays instead of copying them. The output is written in place.
+	  jbyte* input  = (jbyte*) env->GetPrimitiveArrayCritical(in, 0);
+	  jbyte* output = (jbyte*) env->GetPrimitiveArrayCritical(out, 0);
 	  
-	  //Put the result of the final computation in the output array passed from java.
-	  env->SetByteArrayRegion(out, outOffset, blockSize, (jbyte*)((char*)ret)); 
+	  //The padding of the PRP objects is disabled, so all the blocks are processed in this update.
+	  EVP_CipherUpdate ((EVP_CIPHER_CTX*)prp, (unsigned char*)output + outOffset, &size, (unsigned char*)input + inOffset, len);
 	  
-	  //Make sure to release the dynamically allocated memory. Will not be deleted by the JVM.
-	  delete ret;
-	  env->ReleaseByteArrayElements(in, input, 0);
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
 }
 
 /* 
- * function invertBlock			: inverts the PRP on the given block.
- * param prp					: pointer to the PRP object.
- * param in						: The input block to invert the permutation on.
- * param out					: The output block to hold the permutation result.
- * param outOffset				: The offset within the output array to put the result from.
- * param blockSize				: The block size of the given prp.
+ * function processBuffer		: Computes or inverts the PRP on consecutive blocks of direct buffers. Nothing is copied or pinned.
+ * param prp					: pointer to the PRP object (the compute or the invert object).
+ * param in						: The input direct buffer.
+ * param inOffset				: The offset of the first block within the input buffer.
+ * param out					: The output direct buffer. Can be the input buffer itself.
+ * param outOffset				: The offset within the output buffer to put the result from.
+ * param len					: The number of bytes to process. Must be a multiple of the block size.
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_invertBlock
-  (JNIEnv *env, jobject, jlong prp, jbyteArray in, jbyteArray out, jint outOffset, jint blockSize){
-	  //Convert the given data into c++ notation.
-	  jbyte* input  = (jbyte*) env->GetByteArrayElements(in, 0);
-	  
-	  //Allocate a new byte array with the size of the specific prp algorithm.
-	  unsigned char* ret = new unsigned char[env->GetArrayLength(out)]; 
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_processBuffer
+  (JNIEnv *env, jobject, jlong prp, jobject in, jint inOffset, jobject out, jint outOffset, jint len){
 	  int size;
-	  
-	  //Invert the prp on the given input array, put the result in ret.
-	  EVP_DecryptUpdate ((EVP_CIPHER_CTX*)prp, ret, &size, (unsigned char*)input, blockSize);
-	  
-	  //Put the result of the final computation in the output array passed from java.
-	  env->SetByteArrayRegion(out, outOffset, blockSize, (jbyte*)((char*)ret)); 
-	  
-	  //Make sure to release the dynamically allocated memory. Will not be deleted by the JVM.
-	  delete ret;
-	  env->ReleaseByteArrayElements(in, input, 0);
-}
-
-/* 
- * function doOptimizedCompute		: Compute the PRP on the given input array. The array can be longer than one block.
- * param prp						: pointer to the PRP object.
- * param inBytes					: The input array to cumpute the permutation on.
- * param outBytes					: The output array to hold the permutation result.
- * param blockSize					: The block size of the given prp.
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedCompute
-  (JNIEnv *env, jobject, jlong prp, jbyteArray inBytes, jbyteArray outBytes, jint blockSize){
-	  //Convert the arrays into c++ notation.
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
-	  
-	  //Calculate the number of blocks in the given input array.
-	  //int rounds = (env->GetArrayLength(inBytes))/blockSize;
-	  int size = env->GetArrayLength(inBytes);
-	  //Allocate a new byte array with the block size of the specific prp algorithm.
-	  unsigned char* outBlock = new unsigned char[size];
-	  
-	  //Compute the prp on each block and put the result in the output array.
-	  EVP_EncryptUpdate ((EVP_CIPHER_CTX*)prp, outBlock, &size, (unsigned char*)in, size);
-	  env->SetByteArrayRegion(outBytes, 0, size, (jbyte*)outBlock);
-
-	  //Mke sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
-	  delete (outBlock);
-}
-
-/* 
- * function doOptimizedInvert		: Inverts the PRP on the given input array. The array can be longer than one block.
- * param prp						: pointer to the PRP object.
- * param inBytes					: The input array to invert the permutation on.
- * param outBytes					: The output array to hold the permutation result.
- * param blockSize					: The block size of the given prp.
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedInvert
-  (JNIEnv *env, jobject, jlong prp, jbyteArray inBytes, jbyteArray outBytes, jint blockSize){
-	  //Convert the arrays into c++ notation.
-	  jbyte *in = env->GetByteArrayElements(inBytes, 0);
-	  
-	  //Calculate the number of blocks in the given input array.
-	  //int rounds = (env->GetArrayLength(inBytes))/blockSize;
-	 int size = env->GetArrayLength(inBytes);
-	  //Allocate a new byte array with the block size of the specific prp algorithm.
-	  unsigned char* outBlock = new unsigned char[size];
-	  //int size;
-	  EVP_DecryptUpdate ((EVP_CIPHER_CTX*)prp, outBlock, &size, (unsigned char*)(in), size);
+	  unsigned char* input = (unsigned char*) env->GetDirectBufferAddress(in);
+	  unsigned char* output = (unsigned char*) env->GetDirectBufferAddress(out);
 
-	  //Invert the prp on each block and put the result in the output array.
-	  env->SetByteArrayRegion(outBytes, 0, size, (jbyte*)outBlock);  
-	 
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(inBytes,in,0);
-	  delete (outBlock);
+	  EVP_CipherUpdate ((EVP_CIPHER_CTX*)prp, output + outOffset, &size, input + inOffset, len);
 }
 
 /* 
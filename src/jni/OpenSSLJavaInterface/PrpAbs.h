@@ -34,35 +34,19 @@ extern "C" {
 #endif
 /*
  * Class:     edu_biu_scapi_primitives_prf_openSSL_openSSLPRP
- * Method:    computeBlock
- * Signature: (J[B[BI)V
+ * Method:    processBlocks
+ * Signature: (J[BI[BII)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_computeBlock
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_processBlocks
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jbyteArray, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_openSSL_openSSLPRP
- * Method:    invertBlock
- * Signature: (J[B[BI)V
+ * Method:    processBuffer
+ * Signature: (JLjava/nio/ByteBuffer;ILjava/nio/ByteBuffer;II)V
  */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_invertBlock
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint, jint);
-
-/*
- * Class:     edu_biu_scapi_primitives_prf_openSSL_openSSLPRP
- * Method:    doOptimizedCompute
- * Signature: (J[B[B)V
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedCompute
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint);
-
-/*
- * Class:     edu_biu_scapi_primitives_prf_openSSL_openSSLPRP
- * Method:    doOptimizedInvert
- * Signature: (J[B[B)V
- */
-JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_doOptimizedInvert
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray, jint);
+JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prf_openSSL_OpenSSLPRP_processBuffer
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint);
 
 /*
  * Class:     edu_biu_scapi_primitives_prf_openSSL_openSSLPRP
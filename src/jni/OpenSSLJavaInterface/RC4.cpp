@@ -28,7 +28,7 @@
 #include "RC4.h"
 #include <openssl/rc4.h>
 #include <iostream>
-#include <cstdlib>
+#include <cstring>
 
 using namespace std;
 
@@ -70,21 +70,14 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_init
 JNIEXPORT void JNICALL Java_edu_biu_scapi_primitives_prg_openSSL_OpenSSLRC4_generateBytes
   (JNIEnv *env, jobject, jlong rc4, jint outLen, jbyteArray out, jint outOffset){
 	  
-	  //Create an input array full with zeros. (It will be xored with the pseudo random bytes in order to get the generated bytes).
-	  unsigned char* in = (unsigned char*) calloc (outLen, sizeof(char));
-	  
-	  //Prepare the output array.
-	  unsigned char* output = new unsigned char[outLen];
-
-	  //Generate the pseudo random bytes.
-	  RC4((RC4_KEY*) rc4, outLen, in, output);
+	  //Pin the output array and generate the bytes in place.
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0) + outOffset;
 
-	  //Copy the output bytes to the given output array.
-	  env->SetByteArrayRegion(out, outOffset, outLen, (jbyte*)output);
+	  //Zero the output bytes. RC4 xors them with the pseudo random bytes in place in order to get the generated bytes.
+	  memset(output, 0, outLen);
+	  RC4((RC4_KEY*) rc4, outLen, output, output);
 
-	  //Release the allocated memory.
-	  free(in);
-	  delete output;
+	  env->ReleasePrimitiveArrayCritical(out, output - outOffset, 0);
 }
 
 /* 
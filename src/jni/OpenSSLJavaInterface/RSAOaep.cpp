@@ -26,8 +26,8 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "RSAOaep.h"
+#include "ThreadContext.h"
 #include <openssl/rsa.h>
-#include <openssl/rand.h>
 #include <iostream>
 
 using namespace std;
@@ -152,12 +152,8 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_asymmetricCrypto_encryp
 	  //Convert the given data into c++ notation.
 	  jbyte* plaintext  = (jbyte*) env->GetByteArrayElements(plaintextBytes, 0);
 	  
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
+	  //Reseed the random generator if its reseed interval has passed.
+	  reseedRandomIfNeeded();
 
 	  //Allocate a new byte array to hold the output.
 	  int size = RSA_size((RSA *) rsa);
@@ -26,10 +26,10 @@
 #include "StdAfx.h"
 #include <jni.h>
 #include "RSAPermutation.h"
+#include "ThreadContext.h"
+#include "../Common/ThreadPool.h"
 #include <openssl/rsa.h>
-#include <openssl/rand.h>
 #include <iostream>
-#include <openssl/err.h>
 
 using namespace std;
 
@@ -162,14 +162,6 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
   (JNIEnv *env, jobject, jlong rsa, jbyteArray element) {
 	  //Convert the given data into c++ notation.
 	  jbyte* el  = (jbyte*) env->GetByteArrayElements(element, 0);
-	  ERR_load_crypto_strings();
-
-	  //Seed the random geneartor.
-#ifdef _WIN32
-	  RAND_screen(); // only defined for windows, reseeds from screen contents
-#else
-	  RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
-#endif
 
 	  //Allocate a new byte array to hold the output.
 	  int size = RSA_size((RSA *) rsa);
@@ -190,7 +182,7 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
 	 
 	  //Release the allocated memory.
 	  env->ReleaseByteArrayElements(element, el, 0);
-	  delete ret;
+	  delete[] ret;
 
 	  return result;
 }
@@ -225,11 +217,81 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
 
 	  //Release the allocated memory.
 	  env->ReleaseByteArrayElements(element, el, 0);
-	  delete ret;
+	  delete[] ret;
 
 	  return result;
 }
 
+/*
+ * function processRSABatch	: Applies the given RSA operation on each of the packed elements, using the threads of the native pool.
+ * param rsa				: The native RSA object.
+ * param elements			: The elements, packed. Each element takes RSA_size bytes (big endian).
+ * param numElements		: The number of elements.
+ * param operation			: RSA_public_encrypt or RSA_private_decrypt.
+ * return jbyteArray		: The results, packed the same way in one array, or null if one of the elements is not smaller than the modulus.
+ */
+static jbyteArray processRSABatch(JNIEnv *env, RSA* rsa, jbyteArray elements, jint numElements, 
+								  int (*operation)(int, const unsigned char*, unsigned char*, RSA*, int)){
+	  int size = RSA_size(rsa);
+	  if ((numElements <= 0) || ((jlong) numElements * size != env->GetArrayLength(elements))){
+		  return NULL;
+	  }
+
+	  jbyteArray result = env->NewByteArray(numElements * size);
+	  if (result == NULL){
+		  return NULL;
+	  }
+
+	  unsigned char* in = (unsigned char*) env->GetPrimitiveArrayCritical(elements, 0);
+	  unsigned char* out = (unsigned char*) env->GetPrimitiveArrayCritical(result, 0);
+
+	  //The first element is computed by this thread alone, since this is where the RSA object creates 
+	  //the Montgomery contexts and the blinding that it caches. The other threads then only use them.
+	  bool success = (size == operation(size, in, out, rsa, RSA_NO_PADDING));
+	  success = success && getThreadPool()->parallelFor(numElements - 1, [&](int first, int last){
+		  for (int i = first + 1; i <= last; i++){
+			  size_t offset = (size_t) i * size;
+			  if (size != operation(size, in + offset, out + offset, rsa, RSA_NO_PADDING)){
+				  return false;
+			  }
+		  }
+		  return true;
+	  });
+
+	  //Release the arrays. The elements were only read.
+	  env->ReleasePrimitiveArrayCritical(result, out, 0);
+	  env->ReleasePrimitiveArrayCritical(elements, in, JNI_ABORT);
+
+	  return success ? result : NULL;
+}
+
+/*
+ * function computeRSABatch	: Computes the RSA permutation on each of the given elements.
+ * param rsa				: Pointer to the native RSA object.
+ * param elements			: The elements, packed. Each element takes RSA_size bytes (big endian).
+ * param numElements		: The number of elements.
+ * return jbyteArray		: The results, packed the same way, or null on failure.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_computeRSABatch
+  (JNIEnv *env, jobject, jlong rsa, jbyteArray elements, jint numElements){
+	  return processRSABatch(env, (RSA*) rsa, elements, numElements, RSA_public_encrypt);
+}
+
+/*
+ * function invertRSABatch	: Inverts the RSA permutation on each of the given elements. 
+ *							  OpenSSL uses the CRT values of the key (if given) and blinds each element.
+ * param rsa				: Pointer to the native RSA object.
+ * param elements			: The elements, packed. Each element takes RSA_size bytes (big endian).
+ * param numElements		: The number of elements.
+ * return jbyteArray		: The results, packed the same way, or null on failure.
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_invertRSABatch
+  (JNIEnv *env, jobject, jlong rsa, jbyteArray elements, jint numElements){
+	  //The blinding uses the random generator.
+	  reseedRandomIfNeeded();
+	  return processRSABatch(env, (RSA*) rsa, elements, numElements, RSA_private_decrypt);
+}
+
 /*
  * function deleteRSA		: Deletes the native RSA object. 
  * param rsa				: Pointer to the native RSA object.
@@ -72,6 +72,22 @@ JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_o
 JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_invertRSA
   (JNIEnv *, jobject, jlong, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation
+ * Method:    computeRSABatch
+ * Signature: (J[BI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_computeRSABatch
+  (JNIEnv *, jobject, jlong, jbyteArray, jint);
+
+/*
+ * Class:     edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation
+ * Method:    invertRSABatch
+ * Signature: (J[BI)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation_invertRSABatch
+  (JNIEnv *, jobject, jlong, jbyteArray, jint);
+
 /*
  * Class:     edu_biu_scapi_primitives_trapdoorPermutation_openSSL_OpenSSLRSAPermutation
  * Method:    deleteRSA
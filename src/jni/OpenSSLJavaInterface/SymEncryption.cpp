@@ -27,11 +27,15 @@
 #include <jni.h>
 #include "SymEncryption.h"
 #include <openssl/evp.h>
+#include <openssl/crypto.h>
 #include <iostream>
 #include <cstring>
 
 using namespace std;
 
+//Size of the tag that the GCM mode appends to the ciphertext.
+#define GCM_TAG_SIZE 16
+
 /* 
  * function createEncryption		: Creates an EVP_CIPHER_CTX object that perform the encryption.
  * return							: a pointer to the created object.
@@ -67,110 +71,110 @@ JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_Op
 }
 
 /* 
- * function encrypt			: Encrypts the given plaintext using the given iv.
+ * function getBlockSize	: Returns the block size of the current encryption. Modes that do not pad (like CTR and GCM) have block size 1.
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getBlockSize
+  (JNIEnv *, jobject, jlong enc){
+	  return EVP_CIPHER_CTX_block_size((EVP_CIPHER_CTX *)enc);
+}
+
+/* 
+ * function encrypt			: Encrypts the given plaintext using the given iv, and puts the ciphertext in the given output array.
+ *							  The arrays are pinned instead of copied, and the ciphertext is written directly to the output.
+ *							  In GCM mode the tag is appended to the ciphertext.
  * param enc				: A pointer to the native object that does the encryption.
- * param plaintextBytes		: The bytes of the plaintext that should be encrypt.
- * return					: The encrypted data.
+ * param in					: The array that contains the plaintext.
+ * param inOffset			: The offset of the plaintext in the array.
+ * param inLen				: The length of the plaintext.
+ * param ivBytes			: The iv to use.
+ * param out				: The output array. Should have room for the padded plaintext and the tag. Can be the input array.
+ * param outOffset			: The offset in the output array to put the ciphertext from.
+ * return					: The length of the ciphertext, or -1 if the encryption failed.
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt
-  (JNIEnv *env, jobject, jlong enc, jbyteArray plaintextBytes, jbyteArray ivBytes){
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt
+  (JNIEnv *env, jobject, jlong enc, jbyteArray in, jint inOffset, jint inLen, jbyteArray ivBytes, jbyteArray out, jint outOffset){
+	  EVP_CIPHER_CTX* ctx = (EVP_CIPHER_CTX *)enc;
+	  bool isGcm = (EVP_CIPHER_CTX_mode(ctx) == EVP_CIPH_GCM_MODE);
 	  
-	  //Convert the given data into c++ notation.
-	  jbyte* plaintext  = (jbyte*) env->GetByteArrayElements(plaintextBytes, 0);
-	  jbyte* iv  = (jbyte*) env->GetByteArrayElements(ivBytes, 0);
+	  //Get the arrays without copying them, if the JVM allows it.
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* iv = (unsigned char*) env->GetPrimitiveArrayCritical(ivBytes, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+	  unsigned char* ciphertext = output + outOffset;
 	  
-	  //Initialize the encryption objects with the key.
-	  if (0 == (EVP_EncryptInit ((EVP_CIPHER_CTX *)enc, NULL, NULL, (unsigned char*) iv))){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  return 0;
-	  }
-	  
-	  int blockSize = EVP_CIPHER_CTX_block_size((EVP_CIPHER_CTX *)enc);
-	  int plaintextSize = env->GetArrayLength(plaintextBytes);  
+	  int size = 0, rem = 0;
 
-	  //Before the encryption, tha plaintext should be padded.
-	  //The padding scheme aligns the plaintext to size blockSize (and if the plaintext already aligned, it add an entire blockSize bytes.
-	  //As a result, the size of the ciphertext should be at most of size plaintextSize + blockSize.
-	  unsigned char* out  = new unsigned char[plaintextSize+blockSize];
+	  //Set the iv. The cipher and the key that setKey set are kept, so the key schedule is not computed again.
+	  //Then, encrypt the plaintext. The padding (in CBC mode) aligns the ciphertext to the block size.
+	  bool success = EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv) &&
+					 EVP_EncryptUpdate(ctx, ciphertext, &size, input + inOffset, inLen) &&
+					 EVP_EncryptFinal_ex(ctx, ciphertext + size, &rem) &&
+					 (!isGcm || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_SIZE, ciphertext + size + rem));
 
-	  int size, rem;
-	  
-	  //Encrypt the plaintext.
-	  if (0 == (EVP_EncryptUpdate ((EVP_CIPHER_CTX*)enc, out, &size, (unsigned char*)plaintext, plaintextSize))){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete (out);
-		  return 0;
-	  }
-	  if(0 == EVP_EncryptFinal_ex((EVP_CIPHER_CTX*)enc, out+size, &rem)){
-		  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete (out);
-		  return 0;
-	  }
-		 
-	  //Create a jbyteArray that contains the encrypted data.
-	  jbyteArray result = env ->NewByteArray(size+rem);
-	  env->SetByteArrayRegion(result, 0, size+rem, (jbyte*)out);
-	 
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(plaintextBytes, plaintext, 0);
-	  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-	  delete (out);
+	  //Write the ciphertext back and release the other arrays without copying them back.
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(ivBytes, iv, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
 
-	  return result;
+	  if (!success){
+		  return -1;
+	  }
+	  return size + rem + (isGcm ? GCM_TAG_SIZE : 0);
 }
 
 /* 
- * function decrypt			: Encrypts the given plaintext using the given iv.
+ * function decrypt			: Decrypts the given ciphertext using the given iv, and puts the plaintext in the given output array.
+ *							  The arrays are pinned instead of copied, and the plaintext is written directly to the output.
+ *							  In GCM mode the ciphertext ends with the tag, and the decryption fails if the tag is not valid.
  * param dec				: A pointer to the native object that does the decryption.
- * param cipherBytes		: The bytes of the ciphertext that should be decrypted.
- * return					: The decrypted data.
+ * param in					: The array that contains the ciphertext.
+ * param inOffset			: The offset of the ciphertext in the array.
+ * param inLen				: The length of the ciphertext.
+ * param ivBytes			: The iv that the ciphertext was encrypted with.
+ * param out				: The output array. Should have room for inLen bytes. Can be the input array.
+ * param outOffset			: The offset in the output array to put the plaintext from.
+ * return					: The length of the plaintext, or -1 if the ciphertext is not valid. Then the output is erased.
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
-  (JNIEnv *env, jobject, jlong dec, jbyteArray cipherBytes, jbyteArray ivBytes){	  
-	  //Convert the given data into c++ notation.
-	  jbyte* cipher  = (jbyte*) env->GetByteArrayElements(cipherBytes, 0);
-	  jbyte* iv  = (jbyte*) env->GetByteArrayElements(ivBytes, 0);
-	  
-	   //Initialize the encryption object with the key.
-	  if (0 == EVP_DecryptInit ((EVP_CIPHER_CTX *)dec, NULL, NULL, (unsigned char*) iv)){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  return 0;
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
+  (JNIEnv *env, jobject, jlong dec, jbyteArray in, jint inOffset, jint inLen, jbyteArray ivBytes, jbyteArray out, jint outOffset){
+	  EVP_CIPHER_CTX* ctx = (EVP_CIPHER_CTX *)dec;
+	  bool isGcm = (EVP_CIPHER_CTX_mode(ctx) == EVP_CIPH_GCM_MODE);
+	  int cipherLen = isGcm ? inLen - GCM_TAG_SIZE : inLen;
+	  if (cipherLen < 0){
+		  return -1;
 	  }
-	  
-	  int cipherSize = env->GetArrayLength(cipherBytes);  
-	  //Allocate a new byte array of size cipherSize.
-	  unsigned char* out = new unsigned char[cipherSize];
-	  
-	  int size, rem;
-	  
-	  //Decrypt the ciphertext.
-	  if (0 == (EVP_DecryptUpdate ((EVP_CIPHER_CTX*)dec, out, &size, (unsigned char*)cipher, cipherSize))){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete(out);
-		  return 0;
-	  }
-	  if (0 == (EVP_DecryptFinal_ex((EVP_CIPHER_CTX*)dec, out+size, &rem))){
-		  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-		  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-		  delete(out);
-		  return 0;
+
+	  //Get the arrays without copying them, if the JVM allows it.
+	  unsigned char* input = (unsigned char*) env->GetPrimitiveArrayCritical(in, 0);
+	  unsigned char* iv = (unsigned char*) env->GetPrimitiveArrayCritical(ivBytes, 0);
+	  unsigned char* output = (unsigned char*) env->GetPrimitiveArrayCritical(out, 0);
+	  unsigned char* ciphertext = input + inOffset;
+	  unsigned char* plaintext = output + outOffset;
+
+	  int size = 0, rem = 0;
+
+	  //Set the iv (and in GCM mode, the expected tag), and decrypt the ciphertext. 
+	  //The final function checks the padding (in CBC mode) or the tag (in GCM mode).
+	  bool success = EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv) &&
+					 (!isGcm || EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, GCM_TAG_SIZE, ciphertext + cipherLen)) &&
+					 EVP_DecryptUpdate(ctx, plaintext, &size, ciphertext, cipherLen) &&
+					 EVP_DecryptFinal_ex(ctx, plaintext + size, &rem);
+
+	  //The update already wrote the plaintext of a ciphertext that failed the tag (or the padding) check. 
+	  //Erase it, so unauthenticated data never reaches the caller.
+	  if (!success){
+		  OPENSSL_cleanse(plaintext, cipherLen);
 	  }
-		 
-	  //Create a jbyteArray that contains the decrypted data.
-	  jbyteArray result = env ->NewByteArray(size+rem);
-	  env->SetByteArrayRegion(result, 0, size+rem, (jbyte*)out);
-	 
-	  //Make sure to release the memory created in c++. The JVM will not release it automatically.
-	  env->ReleaseByteArrayElements(cipherBytes, cipher, 0);
-	  env->ReleaseByteArrayElements(ivBytes, iv, 0);
-	  delete (out);
 
-	  return result;
+	  //Write the plaintext back and release the other arrays without copying them back.
+	  env->ReleasePrimitiveArrayCritical(out, output, 0);
+	  env->ReleasePrimitiveArrayCritical(ivBytes, iv, JNI_ABORT);
+	  env->ReleasePrimitiveArrayCritical(in, input, JNI_ABORT);
+
+	  if (!success){
+		  return -1;
+	  }
+	  return size + rem;
 }
 
 /* 
@@ -272,3 +276,35 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_Op
 	  env->ReleaseByteArrayElements(key, keyBytes, 0);
 	  env->ReleaseStringUTFChars(prpName, str);
 }
+
+/* 
+ * function setKey			: Initializes the GCM encryption and decryption objects with a prp object and a key.
+ * param enc				: A pointer to the native object that does the encryption.
+ * param dec				: A pointer to the native object that does the decryption.
+ * param prpName			: The name of the underlying prp object to use.
+ * param key				: The bytes of the key to initialize the objects with.
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEncRandomIV_setKey
+	(JNIEnv *env, jobject, jlong enc, jlong dec, jstring, jbyteArray key){
+	  //Convert the given data into c++ notation.
+	  jbyte* keyBytes  = (jbyte*) env->GetByteArrayElements(key, 0);
+
+	  //GCM is only provided for AES, so the actual object to use depends only on the key size.
+	  const EVP_CIPHER* cipher = NULL;
+	  switch(env->GetArrayLength(key)*8)  {
+			case 128: cipher = EVP_aes_128_gcm();
+							   break;
+			case 192: cipher = EVP_aes_192_gcm();
+							   break;
+			case 256: cipher = EVP_aes_256_gcm();
+							   break;
+			default: break;
+	  }
+	  
+	  //Initialize the encryption objects with the key. The iv is set for each message, and its default length in GCM mode is 12 bytes.
+	  EVP_EncryptInit_ex ((EVP_CIPHER_CTX *)enc, cipher, NULL, (unsigned char*)keyBytes, NULL);
+	  EVP_DecryptInit_ex ((EVP_CIPHER_CTX *)dec, cipher, NULL, (unsigned char*)keyBytes, NULL);
+	  
+	  //Release the allocated memory.
+	  env->ReleaseByteArrayElements(key, keyBytes, JNI_ABORT);
+}
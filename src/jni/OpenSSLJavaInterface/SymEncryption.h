@@ -56,21 +56,29 @@ JNIEXPORT jlong JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_O
 JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getIVSize
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
+ * Method:    getBlockSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_getBlockSize
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
  * Method:    encrypt
- * Signature: (J[B[B)[B
+ * Signature: (J[BII[B[BI)I
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_encrypt
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jbyteArray, jint);
 
 /*
  * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
  * Method:    decrypt
- * Signature: (J[B[B)[B
+ * Signature: (J[BII[B[BI)I
  */
-JNIEXPORT jbyteArray JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
-  (JNIEnv *, jobject, jlong, jbyteArray, jbyteArray);
+JNIEXPORT jint JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs_decrypt
+  (JNIEnv *, jobject, jlong, jbyteArray, jint, jint, jbyteArray, jbyteArray, jint);
 
 /*
  * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLEncWithIVAbs
@@ -96,6 +104,14 @@ JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_Op
 JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLCTREncRandomIV_setKey
   (JNIEnv *, jobject, jlong, jlong, jstring, jbyteArray);
 
+/*
+ * Class:     edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEncRandomIV
+ * Method:    setKey
+ * Signature: (JJLjava/lang/String;[B)V
+ */
+JNIEXPORT void JNICALL Java_edu_biu_scapi_midLayer_symmetricCrypto_encryption_OpenSSLGCMEncRandomIV_setKey
+  (JNIEnv *, jobject, jlong, jlong, jstring, jbyteArray);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,127 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#include "StdAfx.h"
+#include <jni.h>
+#include "ThreadContext.h"
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <openssl/err.h>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+using namespace std;
+
+/*
+ * Holds the BN_CTX of one thread, and frees it when the thread exits.
+ */
+class ThreadBnCtx {
+public:
+	BN_CTX* ctx;
+
+	ThreadBnCtx(){
+		ctx = BN_CTX_new();
+	}
+
+	~ThreadBnCtx(){
+		BN_CTX_free(ctx);
+	}
+};
+
+BN_CTX* getThreadBnCtx(){
+	static thread_local ThreadBnCtx threadCtx;
+	return threadCtx.ctx;
+}
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+static mutex* opensslLocks = NULL;
+
+static void opensslLockingCallback(int mode, int n, const char*, int){
+	if (mode & CRYPTO_LOCK){
+		opensslLocks[n].lock();
+	} else {
+		opensslLocks[n].unlock();
+	}
+}
+#endif
+
+void initOpenSSLThreading(){
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	//Another library in the process may have already set the callbacks.
+	if (CRYPTO_get_locking_callback() != NULL){
+		return;
+	}
+	opensslLocks = new mutex[CRYPTO_num_locks()];
+	CRYPTO_set_locking_callback(opensslLockingCallback);
+#endif
+}
+
+//The reseed schedule can be changed at compile time.
+#ifndef RAND_RESEED_OPERATIONS
+#define RAND_RESEED_OPERATIONS (1 << 16)
+#endif
+#ifndef RAND_RESEED_SECONDS
+#define RAND_RESEED_SECONDS 600
+#endif
+
+void reseedRandomIfNeeded(){
+	typedef chrono::steady_clock::duration::rep Ticks;
+	static atomic<int> operationsLeft(0);
+	//The deadline is kept as ticks of the steady clock, so that it can be read without the lock.
+	static atomic<Ticks> nextReseedTicks(0);
+	static mutex reseedLock;
+
+	//The common case only decrements the counter and reads the clock.
+	int left = --operationsLeft;
+	Ticks now = chrono::steady_clock::now().time_since_epoch().count();
+	if (left > 0 && now < nextReseedTicks){
+		return;
+	}
+
+	lock_guard<mutex> lock(reseedLock);
+	//Another thread may have reseeded while this one waited for the lock.
+	if (operationsLeft > 0 && now < nextReseedTicks){
+		return;
+	}
+
+#ifdef _WIN32
+	RAND_screen(); // only defined for windows, reseeds from screen contents
+#else
+	RAND_poll(); // reseeds using hardware state (clock, interrupts, etc).
+#endif
+	operationsLeft = RAND_RESEED_OPERATIONS;
+	nextReseedTicks = now + chrono::duration_cast<chrono::steady_clock::duration>(chrono::seconds(RAND_RESEED_SECONDS)).count();
+}
+
+/*
+ * Called by the JVM when the library is loaded.
+ */
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM*, void*){
+	initOpenSSLThreading();
+	//The error strings are loaded once, instead of by the operations that may fail.
+	ERR_load_crypto_strings();
+	return JNI_VERSION_1_6;
+}
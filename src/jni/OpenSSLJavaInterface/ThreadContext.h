@@ -0,0 +1,52 @@
+/**
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+* Copyright (c) 2012 - SCAPI (http://crypto.biu.ac.il/scapi)
+* This file is part of the SCAPI project.
+* DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+* 
+* Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+* and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+* 
+* The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+* 
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* 
+* We request that any publication and/or code referring to and/or based on SCAPI contain an appropriate citation to SCAPI, including a reference to
+* http://crypto.biu.ac.il/SCAPI.
+* 
+* SCAPI uses Crypto++, Miracl, NTL and Bouncy Castle. Please see these projects for any further licensing issues.
+* %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+* 
+*/
+
+#ifndef _Included_ThreadContext
+#define _Included_ThreadContext
+
+#include <openssl/bn.h>
+
+/*
+ * BN_CTX is not thread safe, so the native groups do not own one.
+ * Each thread that calls the library gets its own BN_CTX, which is freed when the thread exits.
+ * This way one group object (and its precomputed values) can be shared by all the threads of the JVM.
+ */
+BN_CTX* getThreadBnCtx();
+
+/*
+ * Sets the locking callbacks that openssl 1.0 needs in order to be used by several threads,
+ * unless the application has already set them. Newer versions of openssl do not need it.
+ */
+void initOpenSSLThreading();
+
+/*
+ * Reseeds the random generator of openssl from the operating system on a schedule: 
+ * on the first call, and then once every RAND_RESEED_OPERATIONS calls or RAND_RESEED_SECONDS seconds (the earlier of them).
+ * Should be called by the operations that use randomness instead of seeding the generator on each call, 
+ * since gathering entropy costs much more than the operations themselves.
+ */
+void reseedRandomIfNeeded();
+
+#endif